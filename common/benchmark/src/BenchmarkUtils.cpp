@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include "Model/MapFormat.h"
+
+#include <fmt/format.h>
+
+#include <iterator>
+#include <string>
+
+namespace TrenchBroom {
+    struct Point {
+        double x, y, z;
+    };
+
+    static void appendFace(std::string& result, const Model::MapFormat format, const Point& p1, const Point& p2, const Point& p3, const std::string& texture, const float offset, const Point& xAxis, const Point& yAxis) {
+        fmt::format_to(std::back_inserter(result), "( {} {} {} ) ( {} {} {} ) ( {} {} {} ) {} ", p1.x, p1.y, p1.z, p2.x, p2.y, p2.z, p3.x, p3.y, p3.z, texture);
+        switch (format) {
+            case Model::MapFormat::Valve:
+                fmt::format_to(std::back_inserter(result), "[ {} {} {} {} ] [ {} {} {} 0 ] 0 1 1\n", xAxis.x, xAxis.y, xAxis.z, offset, yAxis.x, yAxis.y, yAxis.z);
+                break;
+            case Model::MapFormat::Quake2:
+                fmt::format_to(std::back_inserter(result), "{} 0 0 1 1 0 0 0\n", offset);
+                break;
+            default:
+                fmt::format_to(std::back_inserter(result), "{} 0 0 1 1\n", offset);
+                break;
+        }
+    }
+
+    static void appendBrush(std::string& result, const BenchmarkMapOptions& options, const size_t index) {
+        const auto fraction = options.fractionalCoordinates ? static_cast<double>(index % 7) / 7.0 : 0.0;
+        const auto x0 = static_cast<double>(index % 100) * 64.0 - 3200.0 + fraction;
+        const auto y0 = static_cast<double>(index / 100) * 64.0 - 6400.0 + fraction;
+        const auto z0 = -16.0 - fraction;
+        const auto x1 = x0 + 32.0;
+        const auto y1 = y0 + 32.0;
+        const auto z1 = 16.0 + fraction;
+        const auto offset = static_cast<float>(fraction * 64.0);
+
+        const auto xAxis = Point{1.0, 0.0, 0.0};
+        const auto yAxis = Point{0.0, 1.0, 0.0};
+        const auto zAxis = Point{0.0, 0.0, -1.0};
+        const auto format = options.format;
+
+        fmt::format_to(std::back_inserter(result), "// brush {}\n{{\n", index);
+        appendFace(result, format, {x0, y0, z0}, {x0, y0 + 1.0, z0}, {x0, y0, z0 + 1.0}, "base_wall", offset, yAxis, zAxis);
+        appendFace(result, format, {x0, y0, z0}, {x0, y0, z0 + 1.0}, {x0 + 1.0, y0, z0}, "base_wall", offset, xAxis, zAxis);
+        appendFace(result, format, {x0, y0, z0}, {x0 + 1.0, y0, z0}, {x0, y0 + 1.0, z0}, "base_floor", offset, xAxis, yAxis);
+        appendFace(result, format, {x1, y1, z1}, {x1, y1 + 1.0, z1}, {x1 + 1.0, y1, z1}, "base_floor", offset, xAxis, yAxis);
+        appendFace(result, format, {x1, y1, z1}, {x1 + 1.0, y1, z1}, {x1, y1, z1 + 1.0}, "base_wall", offset, xAxis, zAxis);
+        appendFace(result, format, {x1, y1, z1}, {x1, y1, z1 + 1.0}, {x1, y1 + 1.0, z1}, "base_wall", offset, yAxis, zAxis);
+        if (options.bevelBrushes) {
+            // bevel the edge at x1, y1
+            appendFace(result, format, {x1 - 8.0, y1, z1}, {x1 - 8.0, y1, z0}, {x1, y1 - 8.0, z1}, "base_trim", offset, xAxis, zAxis);
+        }
+        result += "}\n";
+    }
+
+    static void appendPointEntity(std::string& result, const BenchmarkMapOptions& options, const size_t index) {
+        const auto count = options.pointEntityCount;
+        fmt::format_to(std::back_inserter(result), "// entity {}\n{{\n", index + 1u);
+        fmt::format_to(std::back_inserter(result), "\"classname\" \"{}\"\n", index % 3 == 0 ? "light" : "monster_army");
+        fmt::format_to(std::back_inserter(result), "\"origin\" \"{} {} 64\"\n", (index % 1000) * 16, (index / 1000) * 16);
+        fmt::format_to(std::back_inserter(result), "\"angle\" \"{}\"\n", (index % 8) * 45);
+        fmt::format_to(std::back_inserter(result), "\"spawnflags\" \"{}\"\n", (index % 4) * 256);
+        fmt::format_to(std::back_inserter(result), "\"targetname\" \"target_{}\"\n", index);
+        fmt::format_to(std::back_inserter(result), "\"target\" \"target_{}\"\n", (index + 1u) % count);
+        for (const auto& key : options.pointEntityPropertyKeys) {
+            fmt::format_to(std::back_inserter(result), "\"{}\" \"{}\"\n", key, index % 10);
+        }
+        result += "}\n";
+    }
+
+    std::string createBenchmarkMap(const BenchmarkMapOptions& options) {
+        auto result = std::string();
+        fmt::format_to(std::back_inserter(result), "// Game: Quake\n// Format: {}\n", Model::formatName(options.format));
+
+        result += "// entity 0\n{\n\"classname\" \"worldspawn\"\n";
+        for (size_t i = 0u; i < options.brushCount; ++i) {
+            appendBrush(result, options, i);
+        }
+        result += "}\n";
+
+        for (size_t i = 0u; i < options.pointEntityCount; ++i) {
+            appendPointEntity(result, options, i);
+        }
+
+        return result;
+    }
+}
@@ -19,8 +19,11 @@
 
 #pragma once
 
+#include "Model/MapFormat.h"
+
 #include <chrono>
 #include <string>
+#include <vector>
 
 #ifdef __GNUC__
 #define TB_NOINLINE __attribute__((noinline))
@@ -39,4 +42,36 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
            std::chrono::duration<double>(end - start).count() * 1000.0);
 }
 
+namespace TrenchBroom {
+    /**
+     * Describes the contents of a generated benchmark map.
+     */
+    struct BenchmarkMapOptions {
+        Model::MapFormat format = Model::MapFormat::Standard;
+        /**
+         * The number of cuboid brushes in the worldspawn entity. The brushes are laid out in rows of 100.
+         */
+        size_t brushCount = 0u;
+        /**
+         * If true, the coordinates and texture offsets of all but every seventh brush are fractional.
+         */
+        bool fractionalCoordinates = false;
+        /**
+         * If true, every brush has a seventh face that bevels one of its vertical edges.
+         */
+        bool bevelBrushes = false;
+        /**
+         * The number of point entities. Each entity targets the next one.
+         */
+        size_t pointEntityCount = 0u;
+        /**
+         * The keys of additional properties that every point entity has.
+         */
+        std::vector<std::string> pointEntityPropertyKeys;
+    };
 
+    /**
+     * Creates a map with the given contents, formatted like the editor saves it.
+     */
+    std::string createBenchmarkMap(const BenchmarkMapOptions& options);
+}
@@ -0,0 +1,546 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Assets/EntityModel.h"
+#include "Assets/Palette.h"
+#include "IO/Bsp29Parser.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/EntityModelParser.h"
+#include "IO/Md2Parser.h"
+#include "IO/Md3Parser.h"
+#include "IO/MdlParser.h"
+#include "IO/Path.h"
+
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        template <typename T>
+        static void append(std::string& buffer, const T value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        static void appendString(std::string& buffer, const std::string& str, const size_t length) {
+            auto padded = str;
+            padded.resize(length, '\0');
+            buffer.append(padded);
+        }
+
+        template <typename T>
+        static void replace(std::string& buffer, const size_t offset, const T value) {
+            buffer.replace(offset, sizeof(T), reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /**
+         * Returns the position of the given vertex of a wavy strip of triangles. Consecutive triples of vertices form
+         * the triangles of the strip, and the strips of different surfaces are placed next to each other.
+         */
+        static vm::vec3f stripVertex(const size_t vertexIndex, const size_t surfaceIndex) {
+            const auto x = static_cast<float>((vertexIndex / 2) % 200);
+            const auto y = static_cast<float>((vertexIndex % 2) * 4 + surfaceIndex * 8);
+            const auto z = static_cast<float>(vertexIndex % 7);
+            return vm::vec3f(x, y, z);
+        }
+
+        /**
+         * Creates an MDL model with a single skin. All frames share the same triangles, which form a strip.
+         */
+        static std::string createMdl(const size_t vertexCount, const size_t frameCount) {
+            static const int32_t Ident = (('O'<<24) + ('P'<<16) + ('D'<<8) + 'I');
+            static const size_t SkinWidth = 296;
+            static const size_t SkinHeight = 194;
+
+            const auto triangleCount = vertexCount - 2;
+
+            std::string result;
+
+            append<int32_t>(result, Ident);
+            append<int32_t>(result, 6);
+            append<float>(result, 1.0f); // scale
+            append<float>(result, 1.0f);
+            append<float>(result, 1.0f);
+            append<float>(result, -100.0f); // origin
+            append<float>(result, -100.0f);
+            append<float>(result, -100.0f);
+            append<float>(result, 200.0f); // radius
+            append<float>(result, 0.0f); // eye position
+            append<float>(result, 0.0f);
+            append<float>(result, 0.0f);
+            append<int32_t>(result, 1); // skins
+            append<int32_t>(result, static_cast<int32_t>(SkinWidth));
+            append<int32_t>(result, static_cast<int32_t>(SkinHeight));
+            append<int32_t>(result, static_cast<int32_t>(vertexCount));
+            append<int32_t>(result, static_cast<int32_t>(triangleCount));
+            append<int32_t>(result, static_cast<int32_t>(frameCount));
+            append<int32_t>(result, 0); // sync type
+            append<int32_t>(result, 0); // flags
+            append<float>(result, 0.0f); // size
+
+            append<int32_t>(result, 0); // single skin
+            for (size_t i = 0; i < SkinWidth * SkinHeight; ++i) {
+                append<uint8_t>(result, static_cast<uint8_t>(i % 256));
+            }
+
+            for (size_t i = 0; i < vertexCount; ++i) {
+                append<int32_t>(result, i % 2 == 0 ? 1 : 0); // on seam
+                append<int32_t>(result, static_cast<int32_t>(i % SkinWidth));
+                append<int32_t>(result, static_cast<int32_t>(i % SkinHeight));
+            }
+
+            for (size_t i = 0; i < triangleCount; ++i) {
+                append<int32_t>(result, i % 3 == 0 ? 1 : 0); // front
+                append<int32_t>(result, static_cast<int32_t>(i + 0));
+                append<int32_t>(result, static_cast<int32_t>(i + 1));
+                append<int32_t>(result, static_cast<int32_t>(i + 2));
+            }
+
+            for (size_t f = 0; f < frameCount; ++f) {
+                append<int32_t>(result, 0); // single frame
+                append<uint32_t>(result, 0); // packed bounds
+                append<uint32_t>(result, 0);
+                appendString(result, "frame" + std::to_string(f), 16);
+                for (size_t i = 0; i < vertexCount; ++i) {
+                    const auto position = stripVertex(i + f, 0);
+                    append<uint8_t>(result, static_cast<uint8_t>(position.x()));
+                    append<uint8_t>(result, static_cast<uint8_t>(position.y()));
+                    append<uint8_t>(result, static_cast<uint8_t>(position.z()));
+                    append<uint8_t>(result, 0); // normal
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * Creates an MD2 model without skins. The GL commands of every frame consist of triangle strips and fans with
+         * the given number of vertices each. The parser only reads the GL commands, so the model has no texture
+         * coordinates or triangles.
+         */
+        static std::string createMd2(const size_t vertexCount, const size_t frameCount, const size_t verticesPerCommand) {
+            static const int32_t Ident = (('2'<<24) + ('P'<<16) + ('D'<<8) + 'I');
+            static const int32_t HeaderLength = 68;
+
+            const auto commandCount = vertexCount / verticesPerCommand;
+            const auto commandLength = (1 + commandCount * (1 + verticesPerCommand * 3)) * sizeof(int32_t);
+            const auto frameLength = 6 * sizeof(float) + 16 + vertexCount * 4;
+            const auto frameOffset = static_cast<int32_t>(HeaderLength);
+            const auto commandOffset = frameOffset + static_cast<int32_t>(frameCount * frameLength);
+
+            std::string result;
+
+            append<int32_t>(result, Ident);
+            append<int32_t>(result, 8);
+            append<int32_t>(result, 256); // skin width
+            append<int32_t>(result, 256); // skin height
+            append<int32_t>(result, static_cast<int32_t>(frameLength));
+            append<int32_t>(result, 0); // skins
+            append<int32_t>(result, static_cast<int32_t>(vertexCount));
+            append<int32_t>(result, 0); // tex coords
+            append<int32_t>(result, 0); // triangles
+            append<int32_t>(result, static_cast<int32_t>(commandLength / sizeof(int32_t)));
+            append<int32_t>(result, static_cast<int32_t>(frameCount));
+            append<int32_t>(result, HeaderLength); // skin offset
+            append<int32_t>(result, HeaderLength); // tex coord offset
+            append<int32_t>(result, HeaderLength); // triangle offset
+            append<int32_t>(result, frameOffset);
+            append<int32_t>(result, commandOffset);
+            append<int32_t>(result, commandOffset + static_cast<int32_t>(commandLength));
+
+            for (size_t f = 0; f < frameCount; ++f) {
+                append<float>(result, 1.0f); // scale
+                append<float>(result, 1.0f);
+                append<float>(result, 1.0f);
+                append<float>(result, -100.0f); // offset
+                append<float>(result, -100.0f);
+                append<float>(result, -100.0f);
+                appendString(result, "frame" + std::to_string(f), 16);
+                for (size_t i = 0; i < vertexCount; ++i) {
+                    const auto position = stripVertex(i + f, 0);
+                    append<uint8_t>(result, static_cast<uint8_t>(position.x()));
+                    append<uint8_t>(result, static_cast<uint8_t>(position.y()));
+                    append<uint8_t>(result, static_cast<uint8_t>(position.z()));
+                    append<uint8_t>(result, 0); // normal
+                }
+            }
+
+            for (size_t c = 0; c < commandCount; ++c) {
+                // alternate between strips (positive vertex count) and fans (negative vertex count)
+                const auto count = static_cast<int32_t>(verticesPerCommand);
+                append<int32_t>(result, c % 2 == 0 ? count : -count);
+                for (size_t i = 0; i < verticesPerCommand; ++i) {
+                    const auto vertexIndex = c * verticesPerCommand + i;
+                    append<float>(result, static_cast<float>(i % 2));
+                    append<float>(result, static_cast<float>(c % 3) / 2.0f);
+                    append<int32_t>(result, static_cast<int32_t>(vertexIndex));
+                }
+            }
+            append<int32_t>(result, 0); // end of commands
+
+            return result;
+        }
+
+        /**
+         * Creates an MD3 model with a single frame and several surfaces without shaders. The vertices of each surface
+         * form a wavy strip of triangles.
+         */
+        static std::string createMd3(const size_t surfaceCount, const size_t verticesPerSurface) {
+            static const int32_t Ident = (('3'<<24) + ('P'<<16) + ('D'<<8) + 'I');
+            static const int32_t HeaderLength = 108;
+            static const int32_t FrameLength = 56;
+            static const int32_t SurfaceHeaderLength = 108;
+
+            const auto trianglesPerSurface = verticesPerSurface - 2;
+            const auto triangleLength = static_cast<int32_t>(trianglesPerSurface * 3 * sizeof(int32_t));
+            const auto texCoordLength = static_cast<int32_t>(verticesPerSurface * 2 * sizeof(float));
+            const auto vertexLength = static_cast<int32_t>(verticesPerSurface * 4 * sizeof(int16_t));
+            const auto surfaceLength = SurfaceHeaderLength + triangleLength + texCoordLength + vertexLength;
+
+            std::string result;
+
+            append<int32_t>(result, Ident);
+            append<int32_t>(result, 15);
+            appendString(result, "benchmark", 64);
+            append<int32_t>(result, 0); // flags
+            append<int32_t>(result, 1); // frames
+            append<int32_t>(result, 0); // tags
+            append<int32_t>(result, static_cast<int32_t>(surfaceCount));
+            append<int32_t>(result, 0); // skins
+            append<int32_t>(result, HeaderLength); // frame offset
+            append<int32_t>(result, HeaderLength + FrameLength); // tag offset
+            append<int32_t>(result, HeaderLength + FrameLength); // surface offset
+            append<int32_t>(result, HeaderLength + FrameLength + static_cast<int32_t>(surfaceCount) * surfaceLength);
+
+            for (size_t i = 0; i < 3; ++i) {
+                append<float>(result, -512.0f);
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                append<float>(result, 512.0f);
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                append<float>(result, 0.0f);
+            }
+            append<float>(result, 512.0f);
+            appendString(result, "frame", 16);
+
+            for (size_t s = 0; s < surfaceCount; ++s) {
+                append<int32_t>(result, Ident);
+                appendString(result, "surface" + std::to_string(s), 64);
+                append<int32_t>(result, 0); // flags
+                append<int32_t>(result, 1); // frames
+                append<int32_t>(result, 0); // shaders
+                append<int32_t>(result, static_cast<int32_t>(verticesPerSurface));
+                append<int32_t>(result, static_cast<int32_t>(trianglesPerSurface));
+                append<int32_t>(result, SurfaceHeaderLength); // triangle offset
+                append<int32_t>(result, SurfaceHeaderLength + triangleLength); // shader offset
+                append<int32_t>(result, SurfaceHeaderLength + triangleLength); // tex coord offset
+                append<int32_t>(result, SurfaceHeaderLength + triangleLength + texCoordLength); // vertex offset
+                append<int32_t>(result, surfaceLength); // end offset
+
+                for (size_t i = 0; i < trianglesPerSurface; ++i) {
+                    append<int32_t>(result, static_cast<int32_t>(i + 0));
+                    append<int32_t>(result, static_cast<int32_t>(i + 1));
+                    append<int32_t>(result, static_cast<int32_t>(i + 2));
+                }
+
+                for (size_t i = 0; i < verticesPerSurface; ++i) {
+                    append<float>(result, static_cast<float>(i % 2));
+                    append<float>(result, static_cast<float>(i % 3) / 2.0f);
+                }
+
+                for (size_t i = 0; i < verticesPerSurface; ++i) {
+                    // MD3 vertices are stored in units of 1/64
+                    const auto position = stripVertex(i, s) * 64.0f / 8.0f;
+                    append<int16_t>(result, static_cast<int16_t>(position.x()));
+                    append<int16_t>(result, static_cast<int16_t>(position.y()));
+                    append<int16_t>(result, static_cast<int16_t>(position.z()));
+                    append<int16_t>(result, 0); // normal
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * Creates a BSP29 file with a single model and a single texture. The faces of the model are the quads of a
+         * height field. Only the lumps that the parser reads are filled in.
+         */
+        static std::string createBsp29(const size_t faceCount) {
+            static const size_t LumpCount = 15;
+            static const size_t HeaderLength = 4 + LumpCount * 2 * sizeof(int32_t);
+            static const size_t TextureSize = 64;
+
+            enum Lump : size_t {
+                Textures = 2,
+                Vertices = 3,
+                TexInfos = 6,
+                Faces = 7,
+                Edges = 12,
+                FaceEdges = 13,
+                Models = 14
+            };
+
+            // the faces form a grid of quads, every row has GridWidth quads
+            static const size_t GridWidth = 64;
+            const auto gridHeight = (faceCount + GridWidth - 1) / GridWidth;
+            const auto vertexCount = (GridWidth + 1) * (gridHeight + 1);
+
+            std::string result;
+            result.resize(HeaderLength, '\0');
+            replace<int32_t>(result, 0, 29);
+
+            const auto beginLump = [&](const Lump lump) {
+                replace<int32_t>(result, 4 + lump * 2 * sizeof(int32_t), static_cast<int32_t>(result.size()));
+            };
+            const auto endLump = [&](const Lump lump) {
+                const auto offset = static_cast<size_t>(*reinterpret_cast<const int32_t*>(result.data() + 4 + lump * 2 * sizeof(int32_t)));
+                replace<int32_t>(result, 4 + lump * 2 * sizeof(int32_t) + sizeof(int32_t), static_cast<int32_t>(result.size() - offset));
+            };
+
+            beginLump(Textures);
+            append<int32_t>(result, 1); // texture count
+            append<int32_t>(result, static_cast<int32_t>(2 * sizeof(int32_t))); // texture offset
+            appendString(result, "benchmark", 16);
+            append<int32_t>(result, static_cast<int32_t>(TextureSize));
+            append<int32_t>(result, static_cast<int32_t>(TextureSize));
+            auto mipOffset = 16 + 6 * sizeof(int32_t);
+            for (size_t i = 0; i < 4; ++i) {
+                append<int32_t>(result, static_cast<int32_t>(mipOffset));
+                mipOffset += (TextureSize >> i) * (TextureSize >> i);
+            }
+            for (size_t i = 0; i < 4; ++i) {
+                for (size_t j = 0; j < (TextureSize >> i) * (TextureSize >> i); ++j) {
+                    append<uint8_t>(result, static_cast<uint8_t>(j % 256));
+                }
+            }
+            endLump(Textures);
+
+            beginLump(Vertices);
+            for (size_t y = 0; y <= gridHeight; ++y) {
+                for (size_t x = 0; x <= GridWidth; ++x) {
+                    append<float>(result, static_cast<float>(x * 16));
+                    append<float>(result, static_cast<float>(y * 16));
+                    append<float>(result, static_cast<float>((x * y) % 7) * 4.0f);
+                }
+            }
+            endLump(Vertices);
+
+            beginLump(TexInfos);
+            append<float>(result, 1.0f); // s axis and offset
+            append<float>(result, 0.0f);
+            append<float>(result, 0.0f);
+            append<float>(result, 0.0f);
+            append<float>(result, 0.0f); // t axis and offset
+            append<float>(result, 1.0f);
+            append<float>(result, 0.0f);
+            append<float>(result, 0.0f);
+            append<uint32_t>(result, 0); // texture index
+            append<uint32_t>(result, 0); // flags
+            endLump(TexInfos);
+
+            // edge 0 is unused because its index cannot be negated, every face has four edges of its own
+            beginLump(Edges);
+            append<uint16_t>(result, 0);
+            append<uint16_t>(result, 0);
+            for (size_t f = 0; f < faceCount; ++f) {
+                const auto x = f % GridWidth;
+                const auto y = f / GridWidth;
+                const auto v0 = y * (GridWidth + 1) + x;
+                const auto v1 = v0 + 1;
+                const auto v2 = v1 + GridWidth + 1;
+                const auto v3 = v0 + GridWidth + 1;
+                const size_t corners[] = { v0, v1, v2, v3, v0 };
+                for (size_t i = 0; i < 4; ++i) {
+                    append<uint16_t>(result, static_cast<uint16_t>(corners[i]));
+                    append<uint16_t>(result, static_cast<uint16_t>(corners[i + 1]));
+                }
+            }
+            endLump(Edges);
+
+            // use the edges in reverse for every other face
+            beginLump(FaceEdges);
+            for (size_t f = 0; f < faceCount; ++f) {
+                for (size_t i = 0; i < 4; ++i) {
+                    const auto edgeIndex = static_cast<int32_t>(1 + f * 4 + (f % 2 == 0 ? i : 3 - i));
+                    append<int32_t>(result, f % 2 == 0 ? edgeIndex : -edgeIndex);
+                }
+            }
+            endLump(FaceEdges);
+
+            beginLump(Faces);
+            for (size_t f = 0; f < faceCount; ++f) {
+                append<uint16_t>(result, 0); // plane
+                append<uint16_t>(result, 0); // side
+                append<int32_t>(result, static_cast<int32_t>(f * 4)); // first face edge
+                append<uint16_t>(result, 4); // face edge count
+                append<uint16_t>(result, 0); // texture info
+                append<uint32_t>(result, 0); // light styles
+                append<int32_t>(result, -1); // light map offset
+            }
+            endLump(Faces);
+
+            beginLump(Models);
+            for (size_t i = 0; i < 14; ++i) {
+                append<float>(result, 0.0f); // bounds, origin and node indices
+            }
+            append<int32_t>(result, 0); // first face
+            append<int32_t>(result, static_cast<int32_t>(faceCount));
+            endLump(Models);
+
+            return result;
+        }
+
+        /**
+         * Initializes a model with the given parser and loads all of its frames, then intersects every frame with a
+         * ray so that the frame's spacial tree is built.
+         */
+        static std::unique_ptr<Assets::EntityModel> loadAllFrames(EntityModelParser& parser, Logger& logger) {
+            auto model = parser.initializeModel(logger);
+            for (size_t i = 0; i < model->frameCount(); ++i) {
+                parser.loadFrame(i, *model, logger);
+            }
+
+            const auto ray = vm::ray3f(vm::vec3f(-1024.0f, -1024.0f, -1024.0f), vm::normalize(vm::vec3f(1.0f, 1.0f, 1.0f)));
+            for (const auto* frame : model->frames()) {
+                frame->intersect(ray);
+            }
+            return model;
+        }
+
+        static void checkAllFramesLoaded(const Assets::EntityModel* model, const size_t frameCount) {
+            REQUIRE(model != nullptr);
+            REQUIRE(model->frameCount() == frameCount);
+            for (const auto* frame : model->frames()) {
+                CHECK(frame->loaded());
+            }
+        }
+
+        TEST_CASE("EntityModelParserBenchmark.loadMdl", "[EntityModelParserBenchmark]") {
+            // roughly the size of the Quake player model
+            static const size_t VertexCount = 324;
+            static const size_t FrameCount = 64;
+
+            NullLogger logger;
+            const auto palette = Assets::Palette(std::vector<unsigned char>(768, 128));
+
+            const auto mdl = createMdl(VertexCount, FrameCount);
+            const auto* begin = mdl.data();
+            const auto* end = mdl.data() + mdl.size();
+
+            std::unique_ptr<Assets::EntityModel> model;
+            timeLambda([&]() {
+                for (size_t i = 0; i < 100; ++i) {
+                    auto parser = MdlParser("benchmark", begin, end, palette);
+                    model = loadAllFrames(parser, logger);
+                }
+            }, "load MDL with " + std::to_string(FrameCount) + " frames of " + std::to_string(VertexCount) + " vertices 100 times");
+
+            checkAllFramesLoaded(model.get(), FrameCount);
+        }
+
+        TEST_CASE("EntityModelParserBenchmark.loadMd2", "[EntityModelParserBenchmark]") {
+            // roughly the size of a Quake 2 player model
+            static const size_t VertexCount = 480;
+            static const size_t FrameCount = 64;
+            static const size_t VerticesPerCommand = 12;
+
+            NullLogger logger;
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const auto palette = Assets::Palette(std::vector<unsigned char>(768, 128));
+
+            const auto md2 = createMd2(VertexCount, FrameCount, VerticesPerCommand);
+            const auto* begin = md2.data();
+            const auto* end = md2.data() + md2.size();
+
+            std::unique_ptr<Assets::EntityModel> model;
+            timeLambda([&]() {
+                for (size_t i = 0; i < 100; ++i) {
+                    auto parser = Md2Parser("benchmark", begin, end, palette, fs);
+                    model = loadAllFrames(parser, logger);
+                }
+            }, "load MD2 with " + std::to_string(FrameCount) + " frames of " + std::to_string(VertexCount) + " vertices 100 times");
+
+            checkAllFramesLoaded(model.get(), FrameCount);
+        }
+
+        TEST_CASE("EntityModelParserBenchmark.loadMd3", "[EntityModelParserBenchmark]") {
+            NullLogger logger;
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+
+            const auto loadMd3 = [&](const size_t surfaceCount, const size_t verticesPerSurface, const size_t repetitions) {
+                const auto md3 = createMd3(surfaceCount, verticesPerSurface);
+                const auto* begin = md3.data();
+                const auto* end = md3.data() + md3.size();
+
+                std::unique_ptr<Assets::EntityModel> model;
+                timeLambda([&]() {
+                    for (size_t i = 0; i < repetitions; ++i) {
+                        auto parser = Md3Parser("benchmark", begin, end, fs);
+                        model = loadAllFrames(parser, logger);
+                    }
+                }, "load MD3 with " + std::to_string(surfaceCount) + " surfaces of " + std::to_string(verticesPerSurface) + " vertices " + std::to_string(repetitions) + " times");
+
+                checkAllFramesLoaded(model.get(), 1u);
+                CHECK(model->surfaceCount() == surfaceCount);
+            };
+
+            // roughly the size of a Quake 3 weapon model
+            loadMd3(4, 500, 100);
+            // a model with many large surfaces, which stresses building the spacial tree
+            loadMd3(8, 20000, 10);
+        }
+
+        TEST_CASE("EntityModelParserBenchmark.loadBsp29", "[EntityModelParserBenchmark]") {
+            NullLogger logger;
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const auto palette = Assets::Palette(std::vector<unsigned char>(768, 128));
+
+            const auto loadBsp29 = [&](const size_t faceCount, const size_t repetitions) {
+                const auto bsp = createBsp29(faceCount);
+                const auto* begin = bsp.data();
+                const auto* end = bsp.data() + bsp.size();
+
+                std::unique_ptr<Assets::EntityModel> model;
+                timeLambda([&]() {
+                    for (size_t i = 0; i < repetitions; ++i) {
+                        auto parser = Bsp29Parser("benchmark", begin, end, palette, fs);
+                        model = loadAllFrames(parser, logger);
+                    }
+                }, "load BSP29 with " + std::to_string(faceCount) + " faces " + std::to_string(repetitions) + " times");
+
+                checkAllFramesLoaded(model.get(), 1u);
+            };
+
+            // roughly the size of an item box
+            loadBsp29(64, 100);
+            // large enough to decode the faces in parallel
+            loadBsp29(8192, 10);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/EntityDefinition.h"
+#include "IO/DiskIO.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
+#include "IO/FgdParser.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+
+#include <kdl/vector_utils.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumIncludedFiles = 16;
+        static constexpr size_t NumClassesPerFile = 250;
+
+        /**
+         * Creates a host FGD file that declares some base classes and includes several files with point classes
+         * inheriting from them.
+         */
+        static void createFgdFiles(TestEnvironment& env) {
+            std::stringstream host;
+            host << "@baseclass = Targetname [ targetname(target_source) : \"Name\" ]\n"
+                 << "@baseclass = Target [ target(target_destination) : \"Target\" ]\n"
+                 << "@baseclass = Appearflags [\n"
+                 << "    spawnflags(Flags) = [\n"
+                 << "        256 : \"Not on Easy\" : 0\n"
+                 << "        512 : \"Not on Normal\" : 0\n"
+                 << "        1024 : \"Not on Hard\" : 0\n"
+                 << "    ]\n"
+                 << "]\n";
+
+            for (size_t i = 0; i < NumIncludedFiles; ++i) {
+                const auto fileName = "include" + std::to_string(i) + ".fgd";
+                host << "@include \"" << fileName << "\"\n";
+
+                std::stringstream str;
+                for (size_t j = 0; j < NumClassesPerFile; ++j) {
+                    str << "@PointClass base(Targetname, Target, Appearflags) size(-16 -16 -24, 16 16 32) color(0 255 0) "
+                        << "model({ \"path\": \":progs/monster" << j << ".mdl\" }) = "
+                        << "monster_" << i << "_" << j << " : \"Monster " << j << "\"\n"
+                        << "[\n"
+                        << "    health(integer) : \"Health\" : 100\n"
+                        << "    speed(float) : \"Speed\" : \"1.5\"\n"
+                        << "    message(string) : \"Message\" : \"Hello\"\n"
+                        << "    style(choices) : \"Style\" : 0 =\n"
+                        << "    [\n"
+                        << "        0 : \"Normal\"\n"
+                        << "        1 : \"Flicker\"\n"
+                        << "        2 : \"Pulse\"\n"
+                        << "    ]\n"
+                        << "]\n";
+                }
+                env.createFile(Path(fileName), str.str());
+            }
+
+            env.createFile(Path("host.fgd"), host.str());
+        }
+
+        static void parseFgd(const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache) {
+            auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+
+            FgdParser parser(reader.stringView(), Color(1.0f, 1.0f, 1.0f, 1.0f), file->path(), std::move(cache));
+
+            TestParserStatus status;
+            auto defs = parser.parseDefinitions(status);
+            REQUIRE(defs.size() == NumIncludedFiles * NumClassesPerFile);
+            kdl::vec_clear_and_delete(defs);
+        }
+
+        TEST_CASE("FgdParserBenchmark.benchParseIncludedFiles", "[FgdParserBenchmark]") {
+            TestEnvironment env("FgdParserBenchmark");
+            createFgdFiles(env);
+
+            const auto path = env.dir() + Path("host.fgd");
+            const auto numClasses = std::to_string(NumIncludedFiles * NumClassesPerFile);
+
+            timeLambda([&]() {
+                parseFgd(path, nullptr);
+            }, "parse " + numClasses + " classes from " + std::to_string(NumIncludedFiles) + " included files");
+
+            auto cache = std::make_shared<EntityDefinitionClassInfoCache>();
+            parseFgd(path, cache);
+
+            timeLambda([&]() {
+                parseFgd(path, cache);
+            }, "reparse " + numClasses + " unchanged classes with a warm cache");
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/IOUtils.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 20000;
+
+        static std::string createMap() {
+            auto options = BenchmarkMapOptions{};
+            options.brushCount = NumBrushes;
+            options.fractionalCoordinates = true;
+            options.bevelBrushes = true;
+            return createBenchmarkMap(options);
+        }
+
+        TEST_CASE("MapCacheBenchmark.reopenMap", "[MapCacheBenchmark]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+
+            // save the map like the editor does, so that the cache belongs to the saved file
+            TestParserStatus status;
+            auto world = WorldReader(createMap(), Model::MapFormat::Standard).read(worldBounds, status);
+            REQUIRE(world->defaultLayer()->childCount() == NumBrushes);
+
+            std::stringstream str;
+            writeGameComment(str, "Quake", Model::formatName(Model::MapFormat::Standard));
+            NodeWriter(*world, str).writeMap();
+
+            TestEnvironment env("MapCacheBenchmark");
+            const auto mapPath = env.dir() + Path("test.map");
+            env.createFile(Path("test.map"), str.str());
+
+            timeLambda([&]() {
+                MapCache::write(*world, worldBounds, mapPath);
+            }, "write cache for " + std::to_string(NumBrushes) + " brushes");
+
+            std::unique_ptr<Model::WorldNode> parsedWorld;
+            timeLambda([&]() {
+                auto file = Disk::openFile(mapPath);
+                auto reader = file->reader().buffer();
+                parsedWorld = WorldReader(reader.stringView(), Model::MapFormat::Standard).read(worldBounds, status);
+            }, "reopen by parsing the map file");
+
+            std::unique_ptr<Model::WorldNode> cachedWorld;
+            timeLambda([&]() {
+                auto file = Disk::openFile(mapPath);
+                auto reader = file->reader().buffer();
+                cachedWorld = MapCache::read(mapPath, reader.stringView(), Model::MapFormat::Standard, worldBounds, status);
+            }, "reopen from the map cache");
+
+            REQUIRE(parsedWorld != nullptr);
+            REQUIRE(cachedWorld != nullptr);
+            CHECK(cachedWorld->defaultLayer()->childCount() == parsedWorld->defaultLayer()->childCount());
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 20000;
+
+        static std::string createMap() {
+            auto options = BenchmarkMapOptions{};
+            options.brushCount = NumBrushes;
+            options.fractionalCoordinates = true;
+            return createBenchmarkMap(options);
+        }
+
+        TEST_CASE("MapFileSerializerBenchmark.loadAndSaveMap", "[MapFileSerializerBenchmark]") {
+            const auto map = createMap();
+            const auto worldBounds = vm::bbox3(8192.0);
+
+            std::unique_ptr<Model::WorldNode> world;
+            timeLambda([&]() {
+                TestParserStatus status;
+                WorldReader reader(map, Model::MapFormat::Standard);
+                world = reader.read(worldBounds, status);
+            }, "load " + std::to_string(map.size() / 1024) + " KiB map");
+
+            REQUIRE(world != nullptr);
+            REQUIRE(world->defaultLayer()->childCount() == NumBrushes);
+
+            std::string saved;
+            timeLambda([&]() {
+                std::stringstream str;
+                NodeWriter writer(*world, str);
+                writer.writeMap();
+                saved = str.str();
+            }, "save " + std::to_string(NumBrushes) + " brushes");
+
+            CHECK(saved.size() > map.size() / 2u);
+        }
+    }
+}
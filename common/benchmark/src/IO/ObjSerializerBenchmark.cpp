@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST_CASE("ObjSerializerBenchmark.benchExportLargeMap", "[ObjSerializerBenchmark]") {
+            const auto mapPath = Disk::getCurrentWorkingDir() + Path("fixture/benchmark/AABBTree/ne_ruins.map");
+            const auto file = Disk::openFile(mapPath);
+            auto fileReader = file->reader().buffer();
+
+            TestParserStatus status;
+            WorldReader worldReader(fileReader.stringView(), Model::MapFormat::Standard);
+
+            const vm::bbox3 worldBounds(8192.0);
+            auto world = worldReader.read(worldBounds, status);
+
+            const auto objPath = Disk::getCurrentWorkingDir() + Path("ne_ruins_benchmark.obj");
+            timeLambda([&]() {
+                NodeWriter writer(*world, std::make_unique<ObjFileSerializer>(objPath));
+                writer.setExporting(true);
+                writer.writeMap();
+            }, "Export map to OBJ");
+
+            Disk::deleteFile(objPath);
+            Disk::deleteFile(objPath.replaceExtension("mtl"));
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/FileMatcher.h"
+#include "IO/OverlayFileSystem.h"
+#include "IO/PackageIndex.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/ZipFileSystem.h"
+
+#include <miniz/miniz.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumPackages = 50;
+        static constexpr size_t NumTexturesPerPackage = 200;
+        static constexpr size_t NumLookups = 100000;
+
+        static Path texturePath(const size_t package, const size_t texture) {
+            return Path("textures/set" + std::to_string(package % 10) + "/texture" + std::to_string(package * NumTexturesPerPackage + texture) + ".wal");
+        }
+
+        /**
+         * Writes a game directory with many packages, like a game with several large mods installed.
+         */
+        static std::vector<Path> createPackages(const TestEnvironment& env) {
+            auto result = std::vector<Path>{};
+            for (size_t i = 0; i < NumPackages; ++i) {
+                const auto path = env.dir() + Path("pak" + std::to_string(i) + ".pk3");
+
+                mz_zip_archive archive;
+                mz_zip_zero_struct(&archive);
+                REQUIRE(mz_zip_writer_init_file(&archive, path.asString().c_str(), 0));
+
+                const auto data = std::string("texture");
+                for (size_t j = 0; j < NumTexturesPerPackage; ++j) {
+                    const auto name = texturePath(i, j).asString("/");
+                    REQUIRE(mz_zip_writer_add_mem(&archive, name.c_str(), data.data(), data.size(), MZ_DEFAULT_COMPRESSION));
+                }
+
+                REQUIRE(mz_zip_writer_finalize_archive(&archive));
+                REQUIRE(mz_zip_writer_end(&archive));
+                result.push_back(path);
+            }
+            return result;
+        }
+
+        static void benchLookups(const FileSystem& fs, const std::string& description) {
+            auto found = size_t(0);
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumLookups; ++i) {
+                    // look up textures of the packages that are searched last
+                    if (fs.fileExists(texturePath(i % 5, i % NumTexturesPerPackage))) {
+                        ++found;
+                    }
+                }
+            }, "look up " + std::to_string(NumLookups) + " files in " + description);
+            CHECK(found == NumLookups);
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < 100; ++i) {
+                    fs.findItemsRecursively(Path("textures"), FileExtensionMatcher("wal"));
+                }
+            }, "find all textures 100 times in " + description);
+        }
+
+        TEST_CASE("OverlayFileSystemBenchmark.lookUpFiles", "[OverlayFileSystemBenchmark]") {
+            TestEnvironment env("OverlayFileSystemBenchmark");
+            const auto packagePaths = createPackages(env);
+
+            auto chain = std::shared_ptr<FileSystem>{};
+            for (const auto& packagePath : packagePaths) {
+                chain = std::make_shared<ZipFileSystem>(chain, packagePath);
+            }
+            benchLookups(*chain, std::to_string(NumPackages) + " chained packages");
+
+            auto packages = std::vector<std::shared_ptr<FileSystem>>{};
+            timeLambda([&]() {
+                packages.clear();
+                for (auto it = packagePaths.rbegin(); it != packagePaths.rend(); ++it) {
+                    packages.push_back(std::make_shared<ZipFileSystem>(*it));
+                }
+            }, "read " + std::to_string(NumPackages) + " packages");
+
+            auto index = std::shared_ptr<const PackageIndex>{};
+            timeLambda([&]() {
+                index = std::make_shared<const PackageIndex>(packages);
+            }, "index " + std::to_string(NumPackages) + " packages");
+
+            OverlayFileSystem overlay;
+            overlay.addPackages(index);
+            benchLookups(overlay, std::to_string(NumPackages) + " indexed packages");
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/Path.h"
+#include "IO/Quake3ShaderFileSystem.h"
+#include "IO/TestEnvironment.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumShaderFiles = 300;
+        static constexpr size_t NumShadersPerFile = 50;
+
+        /**
+         * Creates a shader tree with several shader scripts. Every other shader has a texture image, and the editor
+         * images refer to the texture images with the wrong extension, like many shader scripts do.
+         */
+        static void createShaderTree(TestEnvironment& env) {
+            env.createDirectory(Path("scripts"));
+            for (size_t i = 0; i < NumShaderFiles; ++i) {
+                const auto textureDir = Path("textures/set" + std::to_string(i));
+                env.createDirectory(textureDir);
+
+                std::stringstream str;
+                for (size_t j = 0; j < NumShadersPerFile; ++j) {
+                    const auto shaderPath = textureDir + Path("shader" + std::to_string(j));
+                    str << shaderPath.asString("/") << "\n"
+                        << "{\n"
+                        << "    qer_editorimage " << shaderPath.asString("/") << ".tga\n"
+                        << "    surfaceparm nolightmap\n"
+                        << "    {\n"
+                        << "        map " << shaderPath.asString("/") << ".tga\n"
+                        << "        blendFunc GL_ONE GL_ONE\n"
+                        << "    }\n"
+                        << "}\n";
+
+                    if (j % 2 == 0) {
+                        env.createFile(shaderPath.addExtension("jpg"), "");
+                    }
+                }
+                env.createFile(Path("scripts/set" + std::to_string(i) + ".shader"), str.str());
+            }
+        }
+
+        TEST_CASE("Quake3ShaderFileSystemBenchmark.benchLoadShaders", "[Quake3ShaderFileSystemBenchmark]") {
+            TestEnvironment env("Quake3ShaderFileSystemBenchmark");
+            createShaderTree(env);
+
+            NullLogger logger;
+            timeLambda([&]() {
+                std::shared_ptr<FileSystem> fs = std::make_shared<DiskFileSystem>(env.dir());
+                fs = std::make_shared<Quake3ShaderFileSystem>(fs, Path("scripts"), std::vector<Path>{ Path("textures") }, logger);
+            }, "load " + std::to_string(NumShaderFiles * NumShadersPerFile) + " shaders from " + std::to_string(NumShaderFiles) + " shader files");
+        }
+    }
+}
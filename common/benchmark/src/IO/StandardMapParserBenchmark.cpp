@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/StandardMapParser.h"
+#include "IO/TestParserStatus.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/EntityProperties.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 20000;
+
+        /**
+         * Parses a map without building any nodes so that only the tokenizer and the parser are measured.
+         */
+        class NullMapParser : public StandardMapParser {
+        public:
+            NullMapParser(std::string_view str, const Model::MapFormat format) :
+            StandardMapParser(str, format, format) {}
+
+            void parse(ParserStatus& status) {
+                parseEntities(status);
+            }
+        private:
+            void onBeginEntity(size_t /* line */, std::vector<Model::EntityProperty> /* properties */, ParserStatus& /* status */) override {}
+            void onEndEntity(size_t /* startLine */, size_t /* lineCount */, ParserStatus& /* status */) override {}
+            void onBeginBrush(size_t /* line */, ParserStatus& /* status */) override {}
+            void onEndBrush(size_t /* startLine */, size_t /* lineCount */, ParserStatus& /* status */) override {}
+            void onStandardBrushFace(size_t /* line */, Model::MapFormat /* targetMapFormat */, const vm::vec3& /* point1 */, const vm::vec3& /* point2 */, const vm::vec3& /* point3 */, const Model::BrushFaceAttributes& /* attribs */, ParserStatus& /* status */) override {}
+            void onValveBrushFace(size_t /* line */, Model::MapFormat /* targetMapFormat */, const vm::vec3& /* point1 */, const vm::vec3& /* point2 */, const vm::vec3& /* point3 */, const Model::BrushFaceAttributes& /* attribs */, const vm::vec3& /* texAxisX */, const vm::vec3& /* texAxisY */, ParserStatus& /* status */) override {}
+        };
+
+        static std::string createMap(const Model::MapFormat format) {
+            auto options = BenchmarkMapOptions{};
+            options.format = format;
+            options.brushCount = NumBrushes;
+            options.fractionalCoordinates = true;
+            return createBenchmarkMap(options);
+        }
+
+        static void benchmarkParse(const Model::MapFormat format, const std::string& name) {
+            const auto map = createMap(format);
+
+            timeLambda([&]() {
+                NullMapParser parser(map, format);
+                TestParserStatus status;
+                parser.parse(status);
+            }, "parse " + std::to_string(map.size() / 1024) + " KiB " + name + " map");
+        }
+
+        TEST_CASE("StandardMapParserBenchmark.parseStandardMap", "[StandardMapParserBenchmark]") {
+            benchmarkParse(Model::MapFormat::Standard, "Standard");
+        }
+
+        TEST_CASE("StandardMapParserBenchmark.parseValveMap", "[StandardMapParserBenchmark]") {
+            benchmarkParse(Model::MapFormat::Valve, "Valve");
+        }
+
+        TEST_CASE("StandardMapParserBenchmark.parseQuake2Map", "[StandardMapParserBenchmark]") {
+            benchmarkParse(Model::MapFormat::Quake2, "Quake2");
+        }
+    }
+}
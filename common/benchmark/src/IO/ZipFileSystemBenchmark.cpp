@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/File.h"
+#include "IO/FileCache.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/ZipFileSystem.h"
+
+#include <kdl/parallel.h>
+
+#include <miniz/miniz.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumEntries = 1000;
+        static constexpr size_t EntrySize = 32 * 1024;
+        static constexpr size_t NumOpens = 10000;
+
+        /**
+         * Writes a package with many compressible entries, like the texture and model files of a large pk3.
+         */
+        static Path createPackage(const TestEnvironment& env) {
+            const auto path = env.dir() + Path("benchmark.pk3");
+
+            mz_zip_archive archive;
+            mz_zip_zero_struct(&archive);
+            REQUIRE(mz_zip_writer_init_file(&archive, path.asString().c_str(), 0));
+
+            auto data = std::string(EntrySize, '\0');
+            for (size_t i = 0; i < NumEntries; ++i) {
+                for (size_t j = 0; j < EntrySize; ++j) {
+                    data[j] = static_cast<char>((i + j / 16) % 64);
+                }
+                const auto name = "textures/set" + std::to_string(i / 100) + "/texture" + std::to_string(i) + ".wal";
+                REQUIRE(mz_zip_writer_add_mem(&archive, name.c_str(), data.data(), data.size(), MZ_DEFAULT_COMPRESSION));
+            }
+
+            REQUIRE(mz_zip_writer_finalize_archive(&archive));
+            REQUIRE(mz_zip_writer_end(&archive));
+            return path;
+        }
+
+        static std::vector<Path> entryPaths() {
+            auto result = std::vector<Path>{};
+            result.reserve(NumEntries);
+            for (size_t i = 0; i < NumEntries; ++i) {
+                result.push_back(Path("textures/set" + std::to_string(i / 100) + "/texture" + std::to_string(i) + ".wal"));
+            }
+            return result;
+        }
+
+        TEST_CASE("ZipFileSystemBenchmark.openFiles", "[ZipFileSystemBenchmark]") {
+            TestEnvironment env("ZipFileSystemBenchmark");
+            const auto packagePath = createPackage(env);
+            const auto paths = entryPaths();
+
+            const ZipFileSystem uncached(packagePath);
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumOpens; ++i) {
+                    uncached.openFile(paths[i % paths.size()]);
+                }
+            }, "open " + std::to_string(NumOpens) + " entries sequentially");
+
+            timeLambda([&]() {
+                kdl::parallel_for(NumOpens, [&](const size_t i) {
+                    uncached.openFile(paths[i % paths.size()]);
+                });
+            }, "open " + std::to_string(NumOpens) + " entries in parallel");
+
+            auto cache = std::make_shared<FileCache>(2u * NumEntries * EntrySize);
+            const ZipFileSystem cached(packagePath, cache);
+            timeLambda([&]() {
+                kdl::parallel_for(NumOpens, [&](const size_t i) {
+                    cached.openFile(paths[i % paths.size()]);
+                });
+            }, "open " + std::to_string(NumOpens) + " entries in parallel with cache");
+
+            CHECK(cache->count() == NumEntries);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileLogger.h"
+#include "Logger.h"
+#include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "IO/Path.h"
+#include "IO/SimpleParserStatus.h"
+
+#include <cstdio>
+#include <string>
+
+#include <QString>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    static constexpr size_t NumWarnings = 50'000;
+
+    /**
+     * Writes and flushes every message immediately, like FileLogger used to.
+     */
+    class SynchronousFileLogger : public Logger {
+    private:
+        FILE* m_file;
+    public:
+        explicit SynchronousFileLogger(const IO::Path& path) :
+        m_file(IO::openPathAsFILE(path, "w")) {}
+
+        ~SynchronousFileLogger() override {
+            fclose(m_file);
+        }
+    private:
+        void doLog(const LogLevel /* level */, const std::string& message) override {
+            std::fprintf(m_file, "%s\n", message.c_str());
+            std::fflush(m_file);
+        }
+
+        void doLog(const LogLevel level, const QString& message) override {
+            log(level, message.toStdString());
+        }
+    };
+
+    static void logParserWarnings(Logger& logger) {
+        IO::SimpleParserStatus status(logger, "benchmark.map");
+        for (size_t i = 0; i < NumWarnings; ++i) {
+            status.warn(i + 1u, 1u, "Skipping face: invalid texture axes");
+        }
+    }
+
+    TEST_CASE("LoggerBenchmark.benchParserWarnings", "[LoggerBenchmark]") {
+        const auto syncPath = IO::Disk::getCurrentWorkingDir() + IO::Path("sync_logger_benchmark.log");
+        const auto asyncPath = IO::Disk::getCurrentWorkingDir() + IO::Path("async_logger_benchmark.log");
+
+        {
+            SynchronousFileLogger logger(syncPath);
+            timeLambda([&]() { logParserWarnings(logger); }, "log " + std::to_string(NumWarnings) + " parser warnings synchronously");
+        }
+
+        {
+            FileLogger logger(asyncPath);
+            timeLambda([&]() { logParserWarnings(logger); }, "log " + std::to_string(NumWarnings) + " parser warnings asynchronously");
+            timeLambda([&]() { logger.flush(); }, "flush asynchronous log");
+        }
+
+        IO::Disk::deleteFile(syncPath);
+        IO::Disk::deleteFile(asyncPath);
+    }
+}
@@ -0,0 +1,189 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushError.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushHullCache.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 10'000;
+
+        static std::vector<vm::vec3> makeCylinderPoints(const size_t sides, const FloatType radius, const FloatType height) {
+            std::vector<vm::vec3> points;
+            for (size_t i = 0; i < sides; ++i) {
+                const auto angle = static_cast<FloatType>(i) * vm::C::two_pi() / static_cast<FloatType>(sides);
+                const auto x = std::round(radius * std::cos(angle));
+                const auto y = std::round(radius * std::sin(angle));
+                points.emplace_back(x, y, 0.0);
+                points.emplace_back(x, y, height);
+            }
+            return points;
+        }
+
+        static void benchCreateBrushes(const vm::bbox3& worldBounds, const std::vector<BrushFace>& faces, const std::string& message) {
+            std::vector<std::vector<BrushFace>> faceLists(NumBrushes, faces);
+
+            size_t brushCount = 0;
+            timeLambda([&]() {
+                for (auto& faceList : faceLists) {
+                    if (Brush::create(worldBounds, std::move(faceList)).is_success()) {
+                        ++brushCount;
+                    }
+                }
+            }, "create " + std::to_string(NumBrushes) + " brushes from " + message);
+
+            CHECK(brushCount == NumBrushes);
+        }
+
+        TEST_CASE("BrushBenchmark.benchCreateBrushesFromFaces", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            const Brush cube = builder.createCube(64.0, "").value();
+            benchCreateBrushes(worldBounds, cube.faces(), "cube faces");
+
+            const Brush cylinder = builder.createBrush(makeCylinderPoints(16, 128.0, 64.0), "").value();
+            benchCreateBrushes(worldBounds, cylinder.faces(), "16 sided cylinder faces");
+
+            // the faces of the larger cube do not intersect the smaller cube and can be rejected early
+            const Brush largeCube = builder.createCube(128.0, "").value();
+            benchCreateBrushes(worldBounds, kdl::vec_concat(cube.faces(), largeCube.faces()), "cube faces with redundant faces");
+        }
+
+        TEST_CASE("BrushBenchmark.benchBuildBrushes", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            for (const auto mapFormat : { MapFormat::Standard, MapFormat::Valve }) {
+                const BrushBuilder builder(mapFormat, worldBounds);
+                const auto points = makeCylinderPoints(16, 128.0, 64.0);
+
+                size_t brushCount = 0;
+                timeLambda([&]() {
+                    for (size_t i = 0; i < NumBrushes; ++i) {
+                        if (builder.createBrush(points, "some_texture").is_success()) {
+                            ++brushCount;
+                        }
+                    }
+                }, "build " + std::to_string(NumBrushes) + " 16 sided cylinders in " + formatName(mapFormat) + " format");
+
+                CHECK(brushCount == NumBrushes);
+            }
+        }
+
+        TEST_CASE("BrushBenchmark.benchCopyBrushes", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            for (const auto mapFormat : { MapFormat::Standard, MapFormat::Valve }) {
+                const BrushBuilder builder(mapFormat, worldBounds);
+                const Brush cylinder = builder.createBrush(makeCylinderPoints(16, 128.0, 64.0), "some_texture").value();
+
+                std::vector<Brush> copies;
+                copies.reserve(NumBrushes);
+                timeLambda([&]() {
+                    for (size_t i = 0; i < NumBrushes; ++i) {
+                        copies.push_back(cylinder);
+                    }
+                }, "copy " + std::to_string(NumBrushes) + " 16 sided cylinders in " + formatName(mapFormat) + " format");
+
+                CHECK(copies.size() == NumBrushes);
+            }
+        }
+
+        TEST_CASE("BrushBenchmark.benchTransformBrushes", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+            const Brush cylinder = builder.createBrush(makeCylinderPoints(16, 128.0, 64.0), "some_texture").value();
+
+            const auto transformations = std::vector<std::pair<std::string, vm::mat4x4>>{
+                { "translate", vm::translation_matrix(vm::vec3(16.0, 32.0, -8.0)) },
+                { "rotate",    vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(15.0)) },
+                // mirroring inverts the face winding and takes the slow path
+                { "mirror",    vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0)) },
+            };
+
+            for (const auto& [name, transformation] : transformations) {
+                std::vector<Brush> brushes(NumBrushes, cylinder);
+
+                size_t brushCount = 0;
+                timeLambda([&]() {
+                    for (auto& brush : brushes) {
+                        if (brush.transform(worldBounds, transformation, false).is_success()) {
+                            ++brushCount;
+                        }
+                    }
+                }, name + " " + std::to_string(NumBrushes) + " 16 sided cylinders");
+
+                CHECK(brushCount == NumBrushes);
+            }
+        }
+
+        TEST_CASE("BrushBenchmark.benchDragVertex", "[BrushBenchmark]") {
+            static constexpr size_t NumDraggedBrushes = 500;
+            static constexpr size_t NumDragSteps = 20;
+
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+            const Brush cylinder = builder.createBrush(makeCylinderPoints(16, 128.0, 64.0), "some_texture").value();
+
+            std::vector<Brush> brushes(NumDraggedBrushes, cylinder);
+            const auto step = vm::vec3(-1.0, 0.0, 1.0);
+
+            size_t moveCount = 0;
+            timeLambda([&]() {
+                for (auto& brush : brushes) {
+                    // the hulls are shared between the steps of one drag
+                    BrushHullCache hullCache;
+                    auto vertexPositions = std::vector<vm::vec3>({vm::vec3(128.0, 0.0, 64.0)});
+                    for (size_t i = 0; i < NumDragSteps; ++i) {
+                        // every step of a vertex drag checks and moves a copy of the brush
+                        auto copy = brush;
+                        if (copy.canMoveVertices(worldBounds, vertexPositions, step, &hullCache) && copy.moveVertices(worldBounds, vertexPositions, step, true, &hullCache).is_success()) {
+                            vertexPositions = copy.findClosestVertexPositions(vertexPositions + step);
+                            brush = std::move(copy);
+                            ++moveCount;
+                        }
+                    }
+                }
+            }, "drag a vertex of " + std::to_string(NumDraggedBrushes) + " 16 sided cylinders in " + std::to_string(NumDragSteps) + " steps");
+
+            CHECK(moveCount == NumDraggedBrushes * NumDragSteps);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/interned_string.h>
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumEntities = 50000;
+
+        // keys that are too long for the small string optimization, as they are common in mods
+        static const std::vector<std::string> LongKeys = {
+            "_light_cone_angle",
+            "_sunlight_penumbra",
+            "_shadow_self_only",
+            "delay_before_trigger",
+        };
+
+        static std::string createMap() {
+            auto options = BenchmarkMapOptions{};
+            options.pointEntityCount = NumEntities;
+            options.pointEntityPropertyKeys = LongKeys;
+            return createBenchmarkMap(options);
+        }
+
+        /**
+         * Returns the number of bytes that the given key occupies when every property owns a copy of it. Only keys that
+         * are too long for the small string optimization use heap memory.
+         */
+        static size_t ownedKeyBytes(const std::string& key) {
+            static const auto smallStringCapacity = std::string().capacity();
+            return sizeof(std::string) + (key.capacity() > smallStringCapacity ? key.capacity() + 1u : 0u);
+        }
+
+        TEST_CASE("EntityPropertiesBenchmark.load50kEntities", "[EntityPropertiesBenchmark]") {
+            const auto map = createMap();
+            const auto worldBounds = vm::bbox3(8192.0);
+
+            std::unique_ptr<WorldNode> world;
+            timeLambda([&]() {
+                IO::TestParserStatus status;
+                IO::WorldReader reader(map, MapFormat::Standard);
+                world = reader.read(worldBounds, status);
+            }, "load map with " + std::to_string(NumEntities) + " entities");
+
+            auto* layer = world->defaultLayer();
+            auto entityNodes = std::vector<const EntityNode*>();
+            for (const auto* node : layer->children()) {
+                if (const auto* entityNode = dynamic_cast<const EntityNode*>(node)) {
+                    entityNodes.push_back(entityNode);
+                }
+            }
+            REQUIRE(entityNodes.size() == NumEntities);
+
+            // copy all properties with owned keys to compare with the interned keys that the entities share
+            auto ownedProperties = std::vector<std::vector<std::pair<std::string, std::string>>>();
+            ownedProperties.reserve(entityNodes.size());
+            size_t propertyCount = 0u;
+            size_t ownedKeysBytes = 0u;
+            for (const auto* entityNode : entityNodes) {
+                auto& properties = ownedProperties.emplace_back();
+                properties.reserve(entityNode->entity().properties().size());
+                for (const auto& property : entityNode->entity().properties()) {
+                    const auto& ownedProperty = properties.emplace_back(property.key(), property.value());
+                    ownedKeysBytes += ownedKeyBytes(ownedProperty.first);
+                    ++propertyCount;
+                }
+            }
+
+            auto internedProperties = std::vector<std::vector<EntityProperty>>();
+            internedProperties.reserve(entityNodes.size());
+            timeLambda([&]() {
+                for (const auto* entityNode : entityNodes) {
+                    internedProperties.push_back(entityNode->entity().properties());
+                }
+            }, "copy " + std::to_string(propertyCount) + " properties whose keys take " + std::to_string(propertyCount * sizeof(kdl::interned_string))
+               + " bytes when interned in a pool of " + std::to_string(kdl::interned_string::pool_size()) + " strings and "
+               + std::to_string(ownedKeysBytes) + " bytes when owned");
+
+            size_t found = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0u; i < 10u; ++i) {
+                    for (const auto* entityNode : entityNodes) {
+                        const auto& entity = entityNode->entity();
+                        found += entity.property(PropertyKeys::Targetname) != nullptr ? 1u : 0u;
+                        found += entity.property(LongKeys.back()) != nullptr ? 1u : 0u;
+                        found += entity.property("missing_property") != nullptr ? 1u : 0u;
+                    }
+                }
+            }, "find properties 10 times");
+            CHECK(found == 10u * 2u * NumEntities);
+
+            // detach and reattach all entities to measure indexing and link resolution
+            auto children = layer->replaceChildren({});
+            timeLambda([&]() {
+                layer->replaceChildren(std::move(children));
+            }, "index and link " + std::to_string(NumEntities) + " entities");
+            CHECK(entityNodes.front()->linkTargets().size() == 1u);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushError.h"
+#include "Model/BrushNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/MapFormat.h"
+#include "Model/UpdateLinkedGroupsError.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumLinkedGroups = 200;
+        static constexpr size_t NumBrushesPerGroup = 500;
+
+        static std::unique_ptr<GroupNode> createLinkedGroup(const BrushBuilder& builder, const vm::bbox3& worldBounds, const vm::vec3& offset) {
+            const auto transformation = vm::translation_matrix(offset);
+
+            auto group = Group{"group"};
+            group.setLinkedGroupId("linked_group");
+            group.transform(transformation);
+            auto groupNode = std::make_unique<GroupNode>(std::move(group));
+
+            for (size_t i = 0; i < NumBrushesPerGroup; ++i) {
+                const auto position = vm::vec3(static_cast<FloatType>(i % 25u) * 32.0, static_cast<FloatType>(i / 25u) * 32.0, 0.0);
+                auto brush = builder.createCube(16.0, "texture").value();
+                REQUIRE(brush.transform(worldBounds, vm::translation_matrix(position) * transformation, false).is_success());
+                groupNode->addChild(new BrushNode(std::move(brush)));
+            }
+
+            return groupNode;
+        }
+
+        TEST_CASE("GroupNodeBenchmark.updateLinkedGroupsAfterChangingOneBrush", "[GroupNodeBenchmark]") {
+            const vm::bbox3 worldBounds(32768.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            auto sourceGroupNode = createLinkedGroup(builder, worldBounds, vm::vec3::zero());
+            auto targetGroupNodes = std::vector<std::unique_ptr<GroupNode>>{};
+            for (size_t i = 0; i < NumLinkedGroups; ++i) {
+                const auto offset = vm::vec3(static_cast<FloatType>(i % 20u + 1u) * 1024.0, static_cast<FloatType>(i / 20u) * 1024.0, 0.0);
+                targetGroupNodes.push_back(createLinkedGroup(builder, worldBounds, offset));
+            }
+            const auto targetGroupNodePtrs = kdl::vec_transform(targetGroupNodes, [](const auto& groupNode) { return groupNode.get(); });
+
+            auto* changedBrushNode = static_cast<BrushNode*>(sourceGroupNode->children().front());
+            auto changedBrush = changedBrushNode->brush();
+            REQUIRE(changedBrush.transform(worldBounds, vm::translation_matrix(vm::vec3(0.0, 0.0, 16.0)), false).is_success());
+            changedBrushNode->setBrush(std::move(changedBrush));
+
+            const auto message = std::to_string(NumLinkedGroups) + " linked groups with " + std::to_string(NumBrushesPerGroup) + " brushes after changing one brush";
+
+            timeLambda([&]() {
+                CHECK(updateLinkedGroups(*sourceGroupNode, targetGroupNodePtrs, worldBounds).is_success());
+            }, "update " + message);
+
+            timeLambda([&]() {
+                CHECK(updateLinkedGroups(*sourceGroupNode, targetGroupNodePtrs, {changedBrushNode}, worldBounds).is_success());
+            }, "incrementally update " + message);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/Camera.h"
+#include "Renderer/LabelDeclutterer.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "Renderer/TextAnchor.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static constexpr size_t NumLabelsPerRow = 150;
+        static constexpr float LabelSpacing = 32.0f;
+        static constexpr float MaxLabelDistance = 2048.0f;
+
+        struct Label {
+            vm::vec2f position;
+            vm::vec2f size;
+            float distance;
+        };
+
+        /**
+         * Culls, sorts and declutters the given anchors the way the entity renderer prepares the classname labels
+         * every frame. The labels are assumed to be laid out already, so they all have the same size.
+         */
+        static size_t prepareLabels(const Camera& camera, const std::vector<SimpleTextAnchor>& anchors, const vm::vec2f& labelSize, LabelDeclutterer& declutterer) {
+            const auto& viewport = camera.viewport();
+
+            auto labels = std::vector<Label>();
+            for (const auto& anchor : anchors) {
+                const auto distance = camera.perpendicularDistanceTo(anchor.position(camera));
+                if (distance <= 0.0f || distance > MaxLabelDistance) {
+                    continue;
+                }
+
+                const auto position = vm::vec2f(anchor.offset(camera, labelSize));
+                if (viewport.contains(position.x(), position.y(), labelSize.x(), labelSize.y())) {
+                    labels.push_back({ position, labelSize, distance });
+                }
+            }
+
+            std::sort(std::begin(labels), std::end(labels), [](const auto& lhs, const auto& rhs) {
+                return lhs.distance < rhs.distance;
+            });
+
+            declutterer.clear();
+            for (const auto& label : labels) {
+                declutterer.add(label.position, label.size);
+            }
+            return declutterer.count();
+        }
+
+        TEST_CASE("LabelDecluttererBenchmark.benchPrepareClassnameLabels", "[LabelDecluttererBenchmark]") {
+            auto anchors = std::vector<SimpleTextAnchor>();
+            anchors.reserve(NumLabelsPerRow * NumLabelsPerRow);
+            for (size_t x = 0; x < NumLabelsPerRow; ++x) {
+                for (size_t y = 0; y < NumLabelsPerRow; ++y) {
+                    const auto position = vm::vec3f(static_cast<float>(x) * LabelSpacing, static_cast<float>(y) * LabelSpacing, 0.0f);
+                    anchors.emplace_back(position, TextAlignment::Bottom);
+                }
+            }
+
+            const auto center = static_cast<float>(NumLabelsPerRow) * LabelSpacing / 2.0f;
+            const auto camera = PerspectiveCamera(90.0f, 1.0f, 8192.0f, Camera::Viewport(0, 0, 1920, 1080),
+                vm::vec3f(center, -256.0f, 512.0f), vm::normalize(vm::vec3f(0.0f, 1.0f, -0.5f)), vm::vec3f::pos_z());
+            const auto labelSize = vm::vec2f(96.0f, 14.0f);
+
+            LabelDeclutterer declutterer;
+            size_t visibleLabels = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0; i < 100; ++i) {
+                    visibleLabels = prepareLabels(camera, anchors, labelSize, declutterer);
+                }
+            }, "prepare " + std::to_string(anchors.size()) + " classname labels for 100 frames");
+
+            CHECK(visibleLabels > 0u);
+            CHECK(visibleLabels < anchors.size());
+        }
+    }
+}
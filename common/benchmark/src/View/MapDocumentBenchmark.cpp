@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Node.h"
+#include "Model/TestGame.h"
+#include "Model/WorldNode.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentCommandFacade.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static constexpr size_t NumBrushes = 100'000;
+
+        TEST_CASE("MapDocumentBenchmark.transformBrushes", "[MapDocumentBenchmark]") {
+            const vm::bbox3 worldBounds(32768.0);
+
+            auto game = std::make_shared<Model::TestGame>();
+            auto document = MapDocumentCommandFacade::newMapDocument();
+            document->newDocument(Model::MapFormat::Standard, worldBounds, game);
+
+            const Model::BrushBuilder builder(Model::MapFormat::Standard, worldBounds);
+            auto brushNodes = std::vector<Model::Node*>{};
+            brushNodes.reserve(NumBrushes);
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto position = vm::vec3(static_cast<FloatType>(i % 400u) * 64.0 - 12800.0, static_cast<FloatType>(i / 400u) * 64.0 - 8000.0, 0.0);
+                auto brush = builder.createCuboid(vm::bbox3(position, position + vm::vec3(32.0, 32.0, 32.0)), "texture").value();
+                brushNodes.push_back(new Model::BrushNode(std::move(brush)));
+            }
+
+            document->addNodes({{document->parentForNodes(), brushNodes}});
+            document->selectAllNodes();
+
+            timeLambda([&]() {
+                CHECK(document->translateObjects(vm::vec3(16.0, 16.0, 0.0)));
+            }, "translate " + std::to_string(NumBrushes) + " brushes");
+
+            timeLambda([&]() {
+                CHECK(document->rotateObjects(vm::vec3::zero(), vm::vec3::pos_z(), vm::to_radians(15.0)));
+            }, "rotate " + std::to_string(NumBrushes) + " brushes");
+        }
+    }
+}
@@ -26,9 +26,13 @@
 #include <vecmath/bbox_io.h>
 #include <vecmath/ray.h>
 #include <vecmath/intersection.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
+#include <iterator>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -483,16 +487,41 @@ namespace TrenchBroom {
         }
 
         /**
-         * Clears this tree and rebuilds it by inserting given objects.
+         * Clears this tree and rebuilds it from the given objects.
+         *
+         * Instead of inserting the objects one by one, the tree is built top down by recursively splitting the objects
+         * at the median of their centers along the axis in which the centers are spread the most. This takes O(n log n)
+         * time and yields a balanced tree.
          *
          * @param objects the objects to insert, a list of DataType
          * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates, or any bounds contains NaN; the tree is
+         * empty in that case
          */
         template <typename DataList, typename GetBounds>
         void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
             clear();
-            for (const U& object : objects) {
-                insert(getBounds(object), object);
+
+            auto leafs = std::vector<std::unique_ptr<LeafNode>>{};
+            try {
+                for (const U& object : objects) {
+                    const auto bounds = getBounds(object);
+                    check(bounds);
+
+                    auto leaf = std::make_unique<LeafNode>(bounds, object);
+                    if (!m_leafForData.emplace(object, leaf.get()).second) {
+                        throw NodeTreeException("Data already in tree");
+                    }
+                    leafs.push_back(std::move(leaf));
+                }
+            } catch (...) {
+                m_leafForData.clear();
+                throw;
+            }
+
+            if (!leafs.empty()) {
+                m_root = build(std::begin(leafs), std::end(leafs));
             }
         }
 
@@ -563,6 +592,32 @@ namespace TrenchBroom {
             insert(newBounds, data);
         }
     private:
+        /**
+         * Builds a subtree from the given range of leafs and returns its root. The leafs are released from the range.
+         */
+        template <typename I>
+        static Node* build(I first, I last) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            assert(count > 0u);
+
+            if (count == 1u) {
+                return first->release();
+            }
+
+            typename Box::builder centers;
+            for (auto it = first; it != last; ++it) {
+                centers.add((*it)->bounds().center());
+            }
+            const auto axis = vm::find_abs_max_component(centers.bounds().size());
+
+            const auto mid = std::next(first, static_cast<std::ptrdiff_t>(count / 2u));
+            std::nth_element(first, mid, last, [&](const auto& lhs, const auto& rhs) {
+                return lhs->bounds().center()[axis] < rhs->bounds().center()[axis];
+            });
+
+            return new InnerNode(build(first, mid), build(mid, last));
+        }
+
         void check(const Box& bounds) const {
             if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max)) {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
@@ -577,6 +632,7 @@ namespace TrenchBroom {
                 delete m_root;
                 m_root = nullptr;
             }
+            m_leafForData.clear();
         }
 
         /**
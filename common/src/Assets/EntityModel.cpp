@@ -30,6 +30,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/intersection.h>
 
+#include <numeric>
 #include <string>
 
 namespace TrenchBroom {
@@ -52,7 +53,7 @@ namespace TrenchBroom {
         m_name(name),
         m_bounds(bounds),
         m_pitchType(pitchType),
-        m_spacialTree(std::make_unique<SpacialTree>()) {}
+        m_memoryCounter(MemorySubsystem::EntityModels) {}
 
         EntityModelLoadedFrame::~EntityModelLoadedFrame() = default;
 
@@ -75,7 +76,10 @@ namespace TrenchBroom {
         float EntityModelLoadedFrame::intersect(const vm::ray3f& ray) const {
             auto closestDistance = vm::nan<float>();
 
-            const auto candidates = m_spacialTree->findIntersectors(ray);
+            const auto candidates = [&]() {
+                const auto lock = std::lock_guard<std::mutex>{m_spacialTreeMutex};
+                return spacialTree().findIntersectors(ray);
+            }();
             for (const TriNum triNum : candidates) {
                 const vm::vec3f& p1 = m_tris[triNum * 3 + 0];
                 const vm::vec3f& p2 = m_tris[triNum * 3 + 1];
@@ -86,7 +90,21 @@ namespace TrenchBroom {
             return closestDistance;
         }
 
-        void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
+        void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) {
+            indices.forEachPrimitive([&](const Renderer::PrimType primType, const size_t index, const size_t count) {
+                addTriangles(vertices, primType, index, count);
+            });
+            invalidateSpacialTree();
+        }
+
+        void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices) {
+            indices.forEachPrimitive([&](const Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
+                addTriangles(vertices, primType, index, count);
+            });
+            invalidateSpacialTree();
+        }
+
+        void EntityModelLoadedFrame::addTriangles(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
             switch (primType) {
                 case Renderer::PrimType::Points:
                 case Renderer::PrimType::Lines:
@@ -97,19 +115,13 @@ namespace TrenchBroom {
                     assert(count % 3 == 0);
                     m_tris.reserve(m_tris.size() + count);
                     for (size_t i = 0; i < count; i += 3) {
-                        vm::bbox3f::builder bounds;
                         const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         m_tris.push_back(p1);
                         m_tris.push_back(p2);
                         m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -120,18 +132,12 @@ namespace TrenchBroom {
 
                     const auto& p1 = Renderer::getVertexComponent<0>(vertices[index]);
                     for (size_t i = 1; i < count - 1; ++i) {
-                        vm::bbox3f::builder bounds;
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         m_tris.push_back(p1);
                         m_tris.push_back(p2);
                         m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -141,15 +147,10 @@ namespace TrenchBroom {
                     assert(count > 2);
                     m_tris.reserve(m_tris.size() + (count - 2) * 3);
                     for (size_t i = 0; i < count-2; ++i) {
-                        vm::bbox3f::builder bounds;
                         const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         if (i % 2 == 0) {
                             m_tris.push_back(p1);
                             m_tris.push_back(p2);
@@ -159,7 +160,6 @@ namespace TrenchBroom {
                             m_tris.push_back(p3);
                             m_tris.push_back(p2);
                         }
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -167,6 +167,29 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelLoadedFrame::invalidateSpacialTree() {
+            const auto lock = std::lock_guard<std::mutex>{m_spacialTreeMutex};
+            m_spacialTree.reset();
+            m_memoryCounter.setBytes(m_tris.capacity() * sizeof(vm::vec3f));
+        }
+
+        const EntityModelLoadedFrame::SpacialTree& EntityModelLoadedFrame::spacialTree() const {
+            if (m_spacialTree == nullptr) {
+                auto triNums = std::vector<TriNum>(m_tris.size() / 3u);
+                std::iota(std::begin(triNums), std::end(triNums), TriNum(0));
+
+                m_spacialTree = std::make_unique<SpacialTree>();
+                m_spacialTree->clearAndBuild(triNums, [&](const TriNum triNum) {
+                    vm::bbox3f::builder bounds;
+                    bounds.add(m_tris[triNum * 3 + 0]);
+                    bounds.add(m_tris[triNum * 3 + 1]);
+                    bounds.add(m_tris[triNum * 3 + 2]);
+                    return bounds.bounds();
+                });
+            }
+            return *m_spacialTree;
+        }
+
         // EntityModel::UnloadedFrame
 
         /**
@@ -213,6 +236,7 @@ namespace TrenchBroom {
         class EntityModelMesh {
         private:
             std::vector<EntityModelVertex> m_vertices;
+            MemoryCounter m_memoryCounter;
         protected:
             /**
              * Creates a new frame mesh that uses the given vertices.
@@ -220,7 +244,8 @@ namespace TrenchBroom {
              * @param vertices the vertices
              */
             explicit EntityModelMesh(const std::vector<EntityModelVertex>& vertices) :
-            m_vertices(vertices) {}
+            m_vertices(vertices),
+            m_memoryCounter(MemorySubsystem::EntityModels, m_vertices.capacity() * sizeof(EntityModelVertex)) {}
         public:
             virtual ~EntityModelMesh() = default;
         public:
@@ -264,10 +289,8 @@ namespace TrenchBroom {
             EntityModelIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) :
             EntityModelMesh(vertices),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
-                });
-        }
+                frame.addToSpacialTree(vertices, m_indices);
+            }
         private:
             std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(const Texture* skin, const Renderer::VertexArray& vertices) override {
                 const Renderer::TexturedIndexRangeMap texturedIndices(skin, m_indices);
@@ -294,9 +317,7 @@ namespace TrenchBroom {
             EntityModelTexturedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices) :
             EntityModelMesh(vertices),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
-                });
+                frame.addToSpacialTree(vertices, m_indices);
             }
         private:
             std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(const Texture* /* skin */, const Renderer::VertexArray& vertices) override {
@@ -19,12 +19,14 @@
 
 #pragma once
 
+#include "MemoryUsage.h"
 #include "Assets/EntityModel_Forward.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -112,11 +114,14 @@ namespace TrenchBroom {
             vm::bbox3f m_bounds;
             PitchType m_pitchType;
 
-            // For hit testing
+            // For hit testing, the spacial tree is built on demand once all triangles have been added
             std::vector<vm::vec3f> m_tris;
             using TriNum = size_t;
             using SpacialTree = AABBTree<float, 3, TriNum>;
-            std::unique_ptr<SpacialTree> m_spacialTree;
+            mutable std::unique_ptr<SpacialTree> m_spacialTree;
+            mutable std::mutex m_spacialTreeMutex;
+
+            MemoryCounter m_memoryCounter;
         public:
             /**
              * Creates a new frame with the given index, name and bounds.
@@ -136,14 +141,40 @@ namespace TrenchBroom {
             float intersect(const vm::ray3f& ray) const override;
 
             /**
-             * Adds the given primitives to the spacial tree for this frame.
+             * Adds the given primitives to the spacial tree for this frame. The spacial tree is built from all primitives
+             * when this frame is intersected for the first time.
+             *
+             * @param vertices the vertices
+             * @param indices the primitives
+             */
+            void addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices);
+
+            /**
+             * Adds the given primitives to the spacial tree for this frame. The spacial tree is built from all primitives
+             * when this frame is intersected for the first time.
+             *
+             * @param vertices the vertices
+             * @param indices the per texture primitives
+             */
+            void addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices);
+        private:
+            /**
+             * Adds the triangles of the given primitives to this frame's triangles.
              *
              * @param vertices the vertices
              * @param primType the primitive type
              * @param index the index of the first primitive's first vertex in the given vertex array
              * @param count the number of vertices that make up the primitive(s)
              */
-            void addToSpacialTree(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count);
+            void addTriangles(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count);
+
+            void invalidateSpacialTree();
+
+            /**
+             * Returns the spacial tree for this frame's triangles, building it if necessary. Must be called with the
+             * spacial tree mutex held.
+             */
+            const SpacialTree& spacialTree() const;
         };
 
         class EntityModelUnloadedFrame;
@@ -26,6 +26,7 @@
 
 #include <vecmath/forward.h>
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <vector>
@@ -33,6 +34,7 @@
 namespace TrenchBroom {
     namespace Assets {
         class TextureCollection;
+        class TextureResidencyManager;
 
         enum class TextureType {
             Opaque,
@@ -84,7 +86,8 @@ namespace TrenchBroom {
             size_t m_height;
             Color m_averageColor;
 
-            size_t m_usageCount;
+            // brush faces are copied on worker threads, see MapDocument::applyToNodeContents
+            std::atomic<size_t> m_usageCount;
             bool m_overridden;
 
             GLenum m_format;
@@ -101,6 +104,8 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
+
+            TextureResidencyManager* m_residencyManager;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, BufferList&& buffers, GLenum format, TextureType type);
@@ -109,8 +114,8 @@ namespace TrenchBroom {
             Texture(const Texture&) = delete;
             Texture& operator=(const Texture&) = delete;
             
-            Texture(Texture&& other) = default;
-            Texture& operator=(Texture&& other) = default;
+            Texture(Texture&& other);
+            Texture& operator=(Texture&& other);
 
             ~Texture();
 
@@ -160,6 +165,26 @@ namespace TrenchBroom {
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
+            /**
+             * Uploads the texture data to the given texture ID, but unlike prepare(), retains the texture
+             * data so that the texture can be evicted and uploaded again later.
+             *
+             * Returns false if there is no texture data to upload.
+             */
+            bool upload(GLuint textureId, int minFilter, int magFilter) const;
+
+            /**
+             * Marks this texture as not uploaded and returns the texture ID it was uploaded to, or 0 if it
+             * was not uploaded. The caller is responsible for deleting the returned texture ID.
+             */
+            GLuint evict() const;
+
+            /**
+             * Sets the residency manager that will be notified whenever this texture is activated. If a
+             * residency manager is set, the texture is uploaded on demand rather than by prepare().
+             */
+            void setResidencyManager(TextureResidencyManager* residencyManager);
+
             void activate() const;
             void deactivate() const;
         public: // exposed for tests only
@@ -173,6 +198,8 @@ namespace TrenchBroom {
              */
             GLenum format() const;
             TextureType type() const;
+        private:
+            void uploadBuffers(GLuint textureId, int minFilter, int magFilter) const;
         };
     }
 }
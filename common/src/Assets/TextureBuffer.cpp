@@ -29,14 +29,18 @@
 
 namespace TrenchBroom {
     namespace Assets {
-        TextureBuffer::TextureBuffer() : m_buffer(), m_size(0) {}
+        TextureBuffer::TextureBuffer() :
+        m_buffer(),
+        m_size(0),
+        m_memoryCounter(MemorySubsystem::TextureBuffers) {}
 
         /**
          * Note, buffer is created defult-initialized (i.e., uninitialized) on purpose.
          */
         TextureBuffer::TextureBuffer(const size_t size) :
         m_buffer(new unsigned char[size]),
-        m_size(size) {}
+        m_size(size),
+        m_memoryCounter(MemorySubsystem::TextureBuffers, size) {}
 
         const unsigned char* TextureBuffer::data() const {
             return m_buffer.get();
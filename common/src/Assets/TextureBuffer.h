@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "MemoryUsage.h"
 #include "Renderer/GL.h"
 
 #include <vecmath/forward.h>
@@ -32,6 +33,7 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<unsigned char[]> m_buffer;
             size_t m_size;
+            MemoryCounter m_memoryCounter;
         public:
             explicit TextureBuffer();
             explicit TextureBuffer(size_t size);
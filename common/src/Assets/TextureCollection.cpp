@@ -20,6 +20,7 @@
 #include "TextureCollection.h"
 
 #include "Ensure.h"
+#include "Assets/TextureResidencyManager.h"
 
 #include <kdl/vector_utils.h>
 
@@ -29,22 +30,32 @@
 namespace TrenchBroom {
     namespace Assets {
         TextureCollection::TextureCollection() :
-        m_loaded(false) {}
+        m_loaded(false),
+        m_residencyManager(nullptr) {}
 
         TextureCollection::TextureCollection(std::vector<Texture> textures) :
         m_loaded(false),
-        m_textures(std::move(textures)) {}
+        m_textures(std::move(textures)),
+        m_residencyManager(nullptr) {}
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
-        m_path(path) {}
+        m_path(path),
+        m_residencyManager(nullptr) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, std::vector<Texture> textures) :
         m_loaded(true),
         m_path(path),
-        m_textures(std::move(textures)) {}
+        m_textures(std::move(textures)),
+        m_residencyManager(nullptr) {}
 
         TextureCollection::~TextureCollection() {
+            if (m_residencyManager != nullptr) {
+                for (const auto& texture : m_textures) {
+                    m_residencyManager->remove(texture);
+                }
+            }
+
             if (!m_textureIds.empty()) {
                 glAssert(glDeleteTextures(static_cast<GLsizei>(m_textureIds.size()),
                                           static_cast<GLuint*>(&m_textureIds.front())));
@@ -104,7 +115,7 @@ namespace TrenchBroom {
         }
 
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return !m_textureIds.empty() || m_residencyManager != nullptr;
         }
 
         void TextureCollection::prepare(const int minFilter, const int magFilter) {
@@ -122,6 +133,15 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureCollection::prepare(TextureResidencyManager& residencyManager) {
+            assert(!prepared());
+
+            m_residencyManager = &residencyManager;
+            for (auto& texture : m_textures) {
+                texture.setResidencyManager(m_residencyManager);
+            }
+        }
+
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
             for (auto& texture : m_textures) {
                 texture.setMode(minFilter, magFilter);
@@ -28,6 +28,8 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        class TextureResidencyManager;
+
         class TextureCollection {
         private:
             using TextureIdList = std::vector<GLuint>;
@@ -37,6 +39,7 @@ namespace TrenchBroom {
             std::vector<Texture> m_textures;
 
             TextureIdList m_textureIds;
+            TextureResidencyManager* m_residencyManager;
 
             friend class Texture;
         public:
@@ -69,6 +72,13 @@ namespace TrenchBroom {
 
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+
+            /**
+             * Prepares this collection for on demand uploading. Instead of uploading all textures at once,
+             * the given residency manager uploads each texture when it is used, and may evict it again later.
+             */
+            void prepare(TextureResidencyManager& residencyManager);
+
             void setTextureMode(int minFilter, int magFilter);
         };
     }
@@ -24,14 +24,14 @@
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/TextureLoader.h"
+#include "Renderer/GL.h"
 
-#include <kdl/map_utils.h>
-#include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
 #include <chrono>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -56,11 +56,40 @@ namespace TrenchBroom {
             }
         };
 
+        class GLTextureResidencyBackend : public TextureResidencyManager::Backend {
+        private:
+            const int& m_minFilter;
+            const int& m_magFilter;
+        public:
+            GLTextureResidencyBackend(const int& minFilter, const int& magFilter) :
+            m_minFilter(minFilter),
+            m_magFilter(magFilter) {}
+
+            bool upload(const Texture& texture) override {
+                GLuint textureId = 0;
+                glAssert(glGenTextures(1, &textureId));
+                if (!texture.upload(textureId, m_minFilter, m_magFilter)) {
+                    glAssert(glDeleteTextures(1, &textureId));
+                    return false;
+                }
+                return true;
+            }
+
+            void evict(const Texture& texture) override {
+                const GLuint textureId = texture.evict();
+                if (textureId != 0) {
+                    glAssert(glDeleteTextures(1, &textureId));
+                }
+            }
+        };
+
         TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger) :
         m_logger(logger),
+        m_residencyManager(std::make_unique<GLTextureResidencyBackend>(m_minFilter, m_magFilter), 0u),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_generation(0u) {}
 
         TextureManager::~TextureManager() = default;
 
@@ -121,6 +150,7 @@ namespace TrenchBroom {
             m_toPrepare.clear();
             m_texturesByName.clear();
             m_textures.clear();
+            ++m_generation;
 
             // Remove logging because it might fail when the document is already destroyed.
         }
@@ -131,14 +161,28 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
-        void TextureManager::commitChanges() {
+        void TextureManager::setTextureMemoryBudget(const size_t budget) {
+            m_residencyManager.setBudget(budget);
+        }
+
+        const TextureResidencyManager& TextureManager::residencyManager() const {
+            return m_residencyManager;
+        }
+
+        void TextureManager::commitChanges(const void* view) {
             resetTextureMode();
             prepare();
             m_toRemove.clear();
+
+            if (kdl::vec_contains(m_viewsInFrame, view)) {
+                m_residencyManager.nextFrame();
+                m_viewsInFrame.clear();
+            }
+            m_viewsInFrame.push_back(view);
         }
 
         const Texture* TextureManager::texture(const std::string& name) const {
-            auto it = m_texturesByName.find(kdl::str_to_lower(name));
+            auto it = m_texturesByName.find(name);
             if (it == std::end(m_texturesByName)) {
                 return nullptr;
             } else {
@@ -158,6 +202,10 @@ namespace TrenchBroom {
             return m_collections;
         }
 
+        size_t TextureManager::generation() const {
+            return m_generation;
+        }
+
         void TextureManager::resetTextureMode() {
             if (m_resetTextureMode) {
                 for (auto& collection : m_collections) {
@@ -170,7 +218,11 @@ namespace TrenchBroom {
         void TextureManager::prepare() {
             for (const size_t index : m_toPrepare) {
                 auto& collection = m_collections[index];
-                collection.prepare(m_minFilter, m_magFilter);
+                if (m_residencyManager.budget() > 0u) {
+                    collection.prepare(m_residencyManager);
+                } else {
+                    collection.prepare(m_minFilter, m_magFilter);
+                }
             }
             m_toPrepare.clear();
         }
@@ -178,23 +230,31 @@ namespace TrenchBroom {
         void TextureManager::updateTextures() {
             m_texturesByName.clear();
             m_textures.clear();
+            ++m_generation;
 
             for (auto& collection : m_collections) {
                 for (auto& texture : collection.textures()) {
-                    const auto key = kdl::str_to_lower(texture.name());
                     texture.setOverridden(false);
 
-                    auto mIt = m_texturesByName.find(key);
+                    auto mIt = m_texturesByName.find(texture.name());
                     if (mIt != std::end(m_texturesByName)) {
                         mIt->second->setOverridden(true);
                         mIt->second = &texture;
                     } else {
-                        m_texturesByName.insert(std::make_pair(key, &texture));
+                        m_texturesByName.insert(std::make_pair(texture.name(), &texture));
                     }
                 }
             }
 
-            m_textures = kdl::vec_transform(kdl::map_values(m_texturesByName), [](auto* t) { return const_cast<const Texture*>(t); });
+            m_textures.reserve(m_texturesByName.size());
+            for (const auto& [name, texture] : m_texturesByName) {
+                m_textures.push_back(texture);
+            }
+
+            // keep the textures ordered by name, as they were when they were stored in an ordered map
+            m_textures = kdl::vec_sort(std::move(m_textures), [](const Texture* lhs, const Texture* rhs) {
+                return kdl::ci::string_less()(lhs->name(), rhs->name());
+            });
         }
     }
 }
@@ -20,9 +20,12 @@
 #pragma once
 
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidencyManager.h"
+
+#include <kdl/string_compare.h>
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -39,10 +42,14 @@ namespace TrenchBroom {
 
         class TextureManager {
         private:
-            using TextureMap = std::map<std::string, Texture*>;
+            // texture names are case insensitive, so the map hashes and compares them without case sensitivity
+            using TextureMap = std::unordered_map<std::string, Texture*, kdl::ci::string_hash, kdl::ci::string_equal>;
 
             Logger& m_logger;
 
+            // must be declared before the collections so that it outlives them
+            TextureResidencyManager m_residencyManager;
+
             std::vector<TextureCollection> m_collections;
 
             std::vector<size_t> m_toPrepare;
@@ -54,6 +61,10 @@ namespace TrenchBroom {
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            size_t m_generation;
+
+            // the views that have rendered since the residency manager started its current frame
+            std::vector<const void*> m_viewsInFrame;
         public:
             TextureManager(int magFilter, int minFilter, Logger& logger);
             ~TextureManager();
@@ -66,13 +77,45 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
-            void commitChanges();
 
+            /**
+             * Sets the amount of GPU memory in bytes that textures should use. If the budget is 0, all textures
+             * of a collection are uploaded when the collection is added and remain resident until the
+             * collection is removed. Otherwise, textures are uploaded when they are first used and the least
+             * recently used textures are evicted when the budget is exceeded.
+             *
+             * Changing between a budget of 0 and a non-zero budget only affects collections that are added
+             * afterwards.
+             */
+            void setTextureMemoryBudget(size_t budget);
+            const TextureResidencyManager& residencyManager() const;
+
+            /**
+             * Prepares and removes pending textures before the given view renders. The pointer only identifies the
+             * view.
+             *
+             * All views render in turn when the application draws a frame, so the texture residency frame ends when a
+             * view renders again that has already rendered in the current frame. This ensures that the textures used
+             * by one view are not evicted while the other views render the same frame.
+             */
+            void commitChanges(const void* view);
+
+            /**
+             * Returns the texture with the given name, ignoring case, or null if there is no such texture.
+             *
+             * This function does not modify the texture manager and may be called from multiple threads at once.
+             */
             const Texture* texture(const std::string& name) const;
             Texture* texture(const std::string& name);
             
             const std::vector<const Texture*>& textures() const;
             const std::vector<TextureCollection>& collections() const;
+
+            /**
+             * Returns a number that changes whenever texture collections are added or removed. Can be used
+             * to invalidate data that is derived from the textures.
+             */
+            size_t generation() const;
         private:
             void resetTextureMode();
             void prepare();
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureResidencyManager.h"
+
+#include "Assets/Texture.h"
+
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureResidencyManager::Backend::~Backend() = default;
+
+        TextureResidencyManager::TextureResidencyManager(std::unique_ptr<Backend> backend, const size_t budget) :
+        m_backend(std::move(backend)),
+        m_budget(budget),
+        m_frame(0u),
+        m_residentSize(0u) {
+            assert(m_backend != nullptr);
+        }
+
+        TextureResidencyManager::~TextureResidencyManager() {
+            clear();
+        }
+
+        size_t TextureResidencyManager::estimatedSize(const Texture& texture) {
+            // textures are stored as RGBA, and a full mipmap chain adds another third
+            const auto baseSize = texture.width() * texture.height() * 4u;
+            return baseSize + baseSize / 3u;
+        }
+
+        size_t TextureResidencyManager::budget() const {
+            return m_budget;
+        }
+
+        void TextureResidencyManager::setBudget(const size_t budget) {
+            m_budget = budget;
+            evictStale(m_frame);
+        }
+
+        size_t TextureResidencyManager::frame() const {
+            return m_frame;
+        }
+
+        size_t TextureResidencyManager::residentSize() const {
+            return m_residentSize;
+        }
+
+        size_t TextureResidencyManager::residentCount() const {
+            return m_entries.size();
+        }
+
+        bool TextureResidencyManager::isResident(const Texture& texture) const {
+            return m_index.count(&texture) > 0u;
+        }
+
+        void TextureResidencyManager::use(const Texture& texture) {
+            const auto it = m_index.find(&texture);
+            if (it != std::end(m_index)) {
+                auto entryIt = it->second;
+                entryIt->lastUse = m_frame;
+                m_entries.splice(std::end(m_entries), m_entries, entryIt);
+            } else if (m_backend->upload(texture)) {
+                const auto size = estimatedSize(texture);
+                m_entries.push_back(Entry{&texture, size, m_frame});
+                m_index.emplace(&texture, std::prev(std::end(m_entries)));
+                m_residentSize += size;
+            }
+
+            evictStale(m_frame);
+        }
+
+        void TextureResidencyManager::nextFrame() {
+            ++m_frame;
+        }
+
+        void TextureResidencyManager::remove(const Texture& texture) {
+            const auto it = m_index.find(&texture);
+            if (it != std::end(m_index)) {
+                evict(it->second);
+            }
+        }
+
+        void TextureResidencyManager::clear() {
+            while (!m_entries.empty()) {
+                evict(std::begin(m_entries));
+            }
+        }
+
+        void TextureResidencyManager::evictStale(const size_t currentFrame) {
+            if (m_budget == 0u) {
+                return;
+            }
+
+            while (m_residentSize > m_budget && !m_entries.empty()) {
+                const auto it = std::begin(m_entries);
+                if (it->lastUse == currentFrame) {
+                    // all remaining entries were used in the current frame
+                    break;
+                }
+                evict(it);
+            }
+        }
+
+        void TextureResidencyManager::evict(const EntryList::iterator it) {
+            m_backend->evict(*it->texture);
+            m_residentSize -= it->size;
+            m_index.erase(it->texture);
+            m_entries.erase(it);
+        }
+    }
+}
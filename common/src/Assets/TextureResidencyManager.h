@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+
+        /**
+         * Keeps track of which textures are currently uploaded to the GPU and evicts the least recently used
+         * textures when their total estimated size exceeds a memory budget.
+         *
+         * Textures are uploaded on demand when they are used for the first time, or when they are used again
+         * after having been evicted. Textures that were used during the current frame are never evicted, so
+         * the budget is a soft limit: if a single frame uses more textures than fit into the budget, all of
+         * them remain resident until they become stale.
+         *
+         * The actual uploading and deleting of textures is delegated to a backend so that the bookkeeping can
+         * be used without an OpenGL context.
+         */
+        class TextureResidencyManager {
+        public:
+            class Backend {
+            public:
+                virtual ~Backend();
+
+                /**
+                 * Uploads the given texture. Returns false if the texture could not be uploaded.
+                 */
+                virtual bool upload(const Texture& texture) = 0;
+
+                /**
+                 * Deletes the GPU resources of the given texture.
+                 */
+                virtual void evict(const Texture& texture) = 0;
+            };
+        private:
+            struct Entry {
+                const Texture* texture;
+                size_t size;
+                size_t lastUse;
+            };
+
+            using EntryList = std::list<Entry>;
+
+            std::unique_ptr<Backend> m_backend;
+            size_t m_budget;
+            size_t m_frame;
+            size_t m_residentSize;
+
+            // least recently used entries first
+            EntryList m_entries;
+            std::unordered_map<const Texture*, EntryList::iterator> m_index;
+        public:
+            /**
+             * Creates a new residency manager with the given backend and budget in bytes. A budget of 0 means
+             * that textures are never evicted.
+             */
+            TextureResidencyManager(std::unique_ptr<Backend> backend, size_t budget);
+            ~TextureResidencyManager();
+
+            deleteCopyAndMove(TextureResidencyManager)
+
+            /**
+             * Returns the estimated amount of GPU memory used by the given texture, including its mipmaps.
+             */
+            static size_t estimatedSize(const Texture& texture);
+
+            size_t budget() const;
+            void setBudget(size_t budget);
+
+            size_t frame() const;
+            size_t residentSize() const;
+            size_t residentCount() const;
+            bool isResident(const Texture& texture) const;
+
+            /**
+             * Marks the given texture as used in the current frame and uploads it if it isn't resident.
+             */
+            void use(const Texture& texture);
+
+            /**
+             * Ends the current frame. Textures used during the ended frame become candidates for eviction.
+             */
+            void nextFrame();
+
+            /**
+             * Evicts the given texture if it is resident and forgets about it.
+             */
+            void remove(const Texture& texture);
+
+            /**
+             * Evicts all resident textures.
+             */
+            void clear();
+        private:
+            void evictStale(size_t currentFrame);
+            void evict(EntryList::iterator it);
+        };
+    }
+}
@@ -32,14 +32,25 @@
 
 namespace TrenchBroom {
     FileLogger::FileLogger(const IO::Path& filePath) :
-    m_file(nullptr) {
+    m_file(nullptr),
+    m_writeRequested(false),
+    m_stopped(false) {
         const auto fixedPath = IO::Disk::fixPath(filePath);
         IO::Disk::ensureDirectoryExists(fixedPath.deleteLastComponent());
         m_file = openPathAsFILE(fixedPath, "w");
         ensure(m_file != nullptr, "log file could not be opened");
+
+        m_writerThread = std::thread([this]() { runWriter(); });
     }
 
     FileLogger::~FileLogger() {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stopped = true;
+        }
+        m_wakeCondition.notify_one();
+        m_writerThread.join();
+
         if (m_file != nullptr) {
             fclose(m_file);
             m_file = nullptr;
@@ -51,15 +62,68 @@ namespace TrenchBroom {
         return Instance;
     }
 
-    void FileLogger::doLog(const LogLevel /* level */, const std::string& message) {
-        assert(m_file != nullptr);
-        if (m_file != nullptr) {
-            std::fprintf(m_file, "%s\n", message.c_str());
-            std::fflush(m_file);
+    void FileLogger::flush() {
+        std::lock_guard<std::timed_mutex> lock(m_writeMutex);
+        writeMessages(m_messages.pop_all());
+    }
+
+    bool FileLogger::tryFlush() {
+        if (std::this_thread::get_id() == m_writerThread.get_id()) {
+            // the crash happened while writing, and the writer thread might already own the mutex
+            return false;
+        }
+
+        std::unique_lock<std::timed_mutex> lock(m_writeMutex, TryFlushTimeout);
+        if (!lock.owns_lock()) {
+            return false;
+        }
+
+        writeMessages(m_messages.pop_all());
+        return true;
+    }
+
+    void FileLogger::doLog(const LogLevel level, const std::string& message) {
+        m_messages.push(message);
+        if (level == LogLevel::Error) {
+            {
+                // must hold the mutex so that the writer cannot miss the notification between checking the flag and waiting
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_writeRequested = true;
+            }
+            m_wakeCondition.notify_one();
         }
     }
 
     void FileLogger::doLog(const LogLevel level, const QString& message) {
         log(level, message.toStdString());
     }
+
+    void FileLogger::runWriter() {
+        while (true) {
+            bool stopped;
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCondition.wait_for(lock, WriteInterval, [&]() { return m_stopped || m_writeRequested; });
+                m_writeRequested = false;
+
+                // must check this before writing to ensure that all messages logged before stopping are written
+                stopped = m_stopped;
+            }
+            flush();
+
+            if (stopped) {
+                break;
+            }
+        }
+    }
+
+    void FileLogger::writeMessages(const std::vector<std::string>& messages) {
+        assert(m_file != nullptr);
+        if (m_file != nullptr && !messages.empty()) {
+            for (const std::string& message : messages) {
+                std::fprintf(m_file, "%s\n", message.c_str());
+            }
+            std::fflush(m_file);
+        }
+    }
 }
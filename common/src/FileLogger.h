@@ -22,7 +22,15 @@
 #include "Macros.h"
 #include "Logger.h"
 
+#include <kdl/mpsc_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 class QString;
 
@@ -31,19 +39,54 @@ namespace TrenchBroom {
         class Path;
     }
 
+    /**
+     * Logs messages to a file asynchronously.
+     *
+     * Logging a message only adds it to a lock-free queue, so it can be done from any thread without blocking.
+     * A background thread periodically takes all queued messages and writes them to the file in a single batch.
+     * Errors wake the background thread immediately so that they reach the file as soon as possible.
+     */
     class FileLogger : public Logger {
     private:
+        static constexpr auto WriteInterval = std::chrono::milliseconds(100);
+        static constexpr auto TryFlushTimeout = std::chrono::milliseconds(500);
+
         FILE* m_file;
+
+        kdl::mpsc_queue<std::string> m_messages;
+
+        std::timed_mutex m_writeMutex;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic<bool> m_writeRequested;
+        std::atomic<bool> m_stopped;
+        std::thread m_writerThread;
     public:
         explicit FileLogger(const IO::Path& filePath);
         ~FileLogger() override;
 
         static FileLogger& instance();
+
+        /**
+         * Writes all messages that have been logged so far to the file and blocks until they have been written.
+         */
+        void flush();
+
+        /**
+         * Writes all messages that have been logged so far to the file unless the file is currently being written
+         * to and does not become available within a short time. Never blocks indefinitely, so it is safe to call
+         * when crashing, even if the crash happened while the background thread was writing.
+         *
+         * @return true if the messages were written and false otherwise
+         */
+        bool tryFlush();
     private:
         void doLog(LogLevel level, const std::string& message) override;
         void doLog(LogLevel level, const QString& message) override;
 
+        void runWriter();
+        void writeMessages(const std::vector<std::string>& messages);
+
         deleteCopyAndMove(FileLogger)
     };
 }
-
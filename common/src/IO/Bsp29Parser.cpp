@@ -27,10 +27,13 @@
 #include "IO/Reader.h"
 #include "IO/MipTextureReader.h"
 #include "IO/IdMipTextureReader.h"
+#include "Renderer/GLVertex.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/TexturedIndexRangeMapBuilder.h"
 
+#include <kdl/parallel.h>
+
 #include <string>
 #include <sstream>
 #include <vector>
@@ -69,6 +72,8 @@ namespace TrenchBroom {
             // static const size_t ModelOrigin           = 0x18;
             static const size_t ModelFaceIndex        = 0x38;
             // static const size_t ModelFaceCount        = 0x3c;
+
+            static const size_t MinParallelFaceCount  = 4096;
         }
 
         Bsp29Parser::Bsp29Parser(const std::string& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
@@ -200,18 +205,20 @@ namespace TrenchBroom {
         }
 
         std::vector<vm::vec3f> Bsp29Parser::parseVertices(Reader reader, const size_t vertexCount) {
+            static_assert(sizeof(vm::vec3f) == 3 * sizeof(float), "vertices must be tightly packed");
             std::vector<vm::vec3f> result(vertexCount);
-            for (size_t i = 0; i < vertexCount; ++i) {
-                result[i] = reader.readVec<float, 3>();
-            }
+            reader.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(vm::vec3f));
             return result;
         }
 
         Bsp29Parser::EdgeInfoList Bsp29Parser::parseEdgeInfos(Reader reader, const size_t edgeInfoCount) {
+            std::vector<uint16_t> vertexIndices(2 * edgeInfoCount);
+            reader.read(reinterpret_cast<char*>(vertexIndices.data()), vertexIndices.size() * sizeof(uint16_t));
+
             EdgeInfoList result(edgeInfoCount);
             for (size_t i = 0; i < edgeInfoCount; ++i) {
-                result[i].vertexIndex1 = reader.readSize<uint16_t>();
-                result[i].vertexIndex2 = reader.readSize<uint16_t>();
+                result[i].vertexIndex1 = static_cast<size_t>(vertexIndices[2 * i + 0]);
+                result[i].vertexIndex2 = static_cast<size_t>(vertexIndices[2 * i + 1]);
             }
             return result;
         }
@@ -229,10 +236,9 @@ namespace TrenchBroom {
         }
 
         Bsp29Parser::FaceEdgeIndexList Bsp29Parser::parseFaceEdges(Reader reader, const size_t faceEdgeCount) {
+            static_assert(sizeof(FaceEdgeIndexList::value_type) == sizeof(int32_t), "face edges must be 32 bit integers");
             FaceEdgeIndexList result(faceEdgeCount);
-            for (size_t i = 0; i < faceEdgeCount; ++i) {
-                result[i] = reader.readInt<int32_t>();
-            }
+            reader.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(int32_t));
             return result;
         }
 
@@ -259,18 +265,18 @@ namespace TrenchBroom {
                 }
             }
 
-            vm::bbox3f::builder bounds;
-
-            Renderer::TexturedIndexRangeMapBuilder<Vertex::Type> builder(totalVertexCount, size);
-            for (size_t i = 0; i < modelFaceCount; ++i) {
+            // The faces are decoded independently of each other, and in parallel for large models. Filling the index
+            // range map must happen in order afterwards.
+            auto faceVertices = std::vector<VertexList>(modelFaceCount);
+            const auto decodeFace = [&](const size_t i) {
                 const auto& faceInfo = faceInfos[modelFaceIndex + i];
                 const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
-                auto* skin = surface.skin(textureInfo.textureIndex);
+                const auto* skin = surface.skin(textureInfo.textureIndex);
                 if (skin != nullptr) {
                     const auto faceVertexCount = faceInfo.edgeCount;
 
-                    VertexList faceVertices;
-                    faceVertices.reserve(faceVertexCount);
+                    auto& currentFaceVertices = faceVertices[i];
+                    currentFaceVertices.reserve(faceVertexCount);
                     for (size_t k = 0; k < faceVertexCount; ++k) {
                         const int faceEdgeIndex = faceEdges[faceInfo.edgeIndex + k];
                         size_t vertexIndex;
@@ -283,12 +289,29 @@ namespace TrenchBroom {
                         const auto& position = vertices[vertexIndex];
                         const auto texCoords = textureCoords(position, textureInfo, skin);
 
-                        bounds.add(position);
-
-                        faceVertices.push_back(Vertex(position, texCoords));
+                        currentFaceVertices.push_back(Vertex(position, texCoords));
                     }
+                }
+            };
 
-                    builder.addPolygon(skin, faceVertices);
+            if (modelFaceCount >= BspLayout::MinParallelFaceCount) {
+                kdl::parallel_for(modelFaceCount, decodeFace);
+            } else {
+                for (size_t i = 0; i < modelFaceCount; ++i) {
+                    decodeFace(i);
+                }
+            }
+
+            vm::bbox3f::builder bounds;
+
+            Renderer::TexturedIndexRangeMapBuilder<Vertex::Type> builder(totalVertexCount, size);
+            for (size_t i = 0; i < modelFaceCount; ++i) {
+                const auto& faceInfo = faceInfos[modelFaceIndex + i];
+                const auto& textureInfo = textureInfos[faceInfo.textureInfoIndex];
+                auto* skin = surface.skin(textureInfo.textureIndex);
+                if (skin != nullptr) {
+                    bounds.add(std::begin(faceVertices[i]), std::end(faceVertices[i]), Renderer::GetVertexComponent<0>());
+                    builder.addPolygon(skin, faceVertices[i]);
                 }
             }
 
@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CollectingParserStatus.h"
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static NullLogger& nullLogger() {
+            static auto logger = NullLogger();
+            return logger;
+        }
+
+        CollectingParserStatus::CollectingParserStatus(const std::string& prefix) :
+        ParserStatus(nullLogger(), prefix),
+        m_next(nullptr) {}
+
+        CollectingParserStatus::CollectingParserStatus(ParserStatus& next) :
+        ParserStatus(nullLogger(), next.prefix()),
+        m_next(&next) {}
+
+        const std::vector<CollectingParserStatus::Message>& CollectingParserStatus::messages() const {
+            return m_messages;
+        }
+
+        void CollectingParserStatus::passOn(ParserStatus& status) const {
+            for (const auto& [level, str] : m_messages) {
+                status.logFormatted(level, str);
+            }
+        }
+
+        void CollectingParserStatus::doProgress(const double progress) {
+            if (m_next != nullptr) {
+                m_next->progress(progress);
+            }
+        }
+
+        void CollectingParserStatus::doLog(const LogLevel level, const std::string& str) {
+            m_messages.emplace_back(level, str);
+            if (m_next != nullptr) {
+                m_next->logFormatted(level, str);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Logger.h"
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Collects the messages logged to it so that a parser can run on a worker thread. The collected messages are
+         * passed on to another parser status on the calling thread afterwards.
+         *
+         * Alternatively, the messages can be forwarded to another parser status immediately, in which case they are
+         * recorded so that they can be replayed later.
+         */
+        class CollectingParserStatus : public ParserStatus {
+        public:
+            using Message = std::pair<LogLevel, std::string>;
+        private:
+            ParserStatus* m_next;
+            std::vector<Message> m_messages;
+        public:
+            explicit CollectingParserStatus(const std::string& prefix = "");
+
+            /**
+             * Creates a parser status that forwards all messages and progress to the given status and records the
+             * messages. The messages are formatted with the prefix of the given status.
+             */
+            explicit CollectingParserStatus(ParserStatus& next);
+
+            const std::vector<Message>& messages() const;
+            void passOn(ParserStatus& status) const;
+        private:
+            void doProgress(double progress) override;
+            void doLog(LogLevel level, const std::string& str) override;
+        };
+    }
+}
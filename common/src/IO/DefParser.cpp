@@ -137,6 +137,10 @@ namespace TrenchBroom {
         EntityDefinitionParser(defaultEntityColor),
         m_tokenizer(DefTokenizer(std::move(str))) {}
 
+        DefParser::DefParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache) :
+        EntityDefinitionParser(defaultEntityColor, str, path, std::move(cache)),
+        m_tokenizer(DefTokenizer(std::move(str))) {}
+
         DefParser::TokenNameMap DefParser::tokenNames() const {
             using namespace DefToken;
 
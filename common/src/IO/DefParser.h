@@ -72,6 +72,7 @@ namespace TrenchBroom {
             std::map<std::string, EntityDefinitionClassInfo> m_baseClasses;
         public:
             DefParser(std::string_view str, const Color& defaultEntityColor);
+            DefParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache);
         private:
             TokenNameMap tokenNames() const override;
             std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
@@ -47,6 +47,11 @@ namespace TrenchBroom {
         m_begin(str.data()),
         m_end(str.data() + str.size()) {}
 
+        EntParser::EntParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache) :
+        EntityDefinitionParser(defaultEntityColor, str, path, std::move(cache)),
+        m_begin(str.data()),
+        m_end(str.data() + str.size()) {}
+
         std::vector<EntityDefinitionClassInfo> EntParser::parseClassInfos(ParserStatus& status) {
             tinyxml2::XMLDocument doc;
             doc.Parse(m_begin, static_cast<size_t>(m_end - m_begin));
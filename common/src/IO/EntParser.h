@@ -54,6 +54,7 @@ namespace TrenchBroom {
             const char* m_end;
         public:
             EntParser(std::string_view str, const Color& defaultEntityColor);
+            EntParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache);
         private:
             std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
             
@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionClassInfoCache.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/PathQt.h"
+#include "IO/Reader.h"
+
+#include <functional>
+
+#include <QDateTime>
+#include <QFileInfo>
+
+namespace TrenchBroom {
+    namespace IO {
+        bool operator==(const EntityDefinitionFileStamp& lhs, const EntityDefinitionFileStamp& rhs) {
+            return lhs.path == rhs.path &&
+                lhs.modificationTime == rhs.modificationTime &&
+                lhs.contentHash == rhs.contentHash;
+        }
+
+        bool operator!=(const EntityDefinitionFileStamp& lhs, const EntityDefinitionFileStamp& rhs) {
+            return !(lhs == rhs);
+        }
+
+        static int64_t modificationTime(const Path& path) {
+            const auto fileInfo = QFileInfo(pathAsQString(path));
+            return fileInfo.exists() ? fileInfo.lastModified().toMSecsSinceEpoch() : -1;
+        }
+
+        static size_t hashContents(std::string_view contents) {
+            return std::hash<std::string_view>{}(contents);
+        }
+
+        EntityDefinitionFileStamp stampEntityDefinitionFile(const Path& path, std::string_view contents) {
+            return { path, modificationTime(path), hashContents(contents) };
+        }
+
+        bool isUnchanged(const EntityDefinitionFileStamp& stamp) {
+            const auto currentModificationTime = modificationTime(stamp.path);
+            if (currentModificationTime == -1) {
+                return false;
+            } else if (currentModificationTime == stamp.modificationTime) {
+                return true;
+            }
+
+            // the file was touched, but its contents may still be the same
+            try {
+                const auto file = Disk::openFile(stamp.path);
+                auto reader = file->reader().buffer();
+                return hashContents(reader.stringView()) == stamp.contentHash;
+            } catch (const Exception&) {
+                return false;
+            }
+        }
+
+        EntityDefinitionClassInfoCache::EntityDefinitionClassInfoCache() = default;
+
+        EntityDefinitionClassInfoCache::~EntityDefinitionClassInfoCache() = default;
+
+        std::optional<EntityDefinitionClassInfoCache::Entry> EntityDefinitionClassInfoCache::find(const Path& path) {
+            const auto key = path.asString();
+
+            auto entry = std::optional<Entry>();
+            {
+                const auto lock = std::lock_guard<std::mutex>(m_mutex);
+                const auto it = m_entries.find(key);
+                if (it == std::end(m_entries)) {
+                    return std::nullopt;
+                }
+                entry = it->second;
+            }
+
+            // check the files without holding the lock, this might read them from disk
+            for (const auto& file : entry->files) {
+                if (!isUnchanged(file)) {
+                    const auto lock = std::lock_guard<std::mutex>(m_mutex);
+                    const auto it = m_entries.find(key);
+                    if (it != std::end(m_entries) && it->second.files == entry->files) {
+                        m_entries.erase(it);
+                    }
+                    return std::nullopt;
+                }
+            }
+
+            return entry;
+        }
+
+        void EntityDefinitionClassInfoCache::insert(const Path& path, std::vector<EntityDefinitionFileStamp> files, std::vector<EntityDefinitionClassInfo> classInfos, std::vector<std::pair<LogLevel, std::string>> messages) {
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            m_entries[path.asString()] = Entry{ std::move(files), std::move(classInfos), std::move(messages) };
+        }
+
+        size_t EntityDefinitionClassInfoCache::size() const {
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            return m_entries.size();
+        }
+
+        void EntityDefinitionClassInfoCache::clear() {
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            m_entries.clear();
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Logger.h"
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Identifies the state of an entity definition file on disk by its modification time and a hash of its
+         * contents.
+         */
+        struct EntityDefinitionFileStamp {
+            Path path;
+            int64_t modificationTime;
+            size_t contentHash;
+        };
+
+        bool operator==(const EntityDefinitionFileStamp& lhs, const EntityDefinitionFileStamp& rhs);
+        bool operator!=(const EntityDefinitionFileStamp& lhs, const EntityDefinitionFileStamp& rhs);
+
+        /**
+         * Creates a stamp for the file at the given absolute path, which has the given contents.
+         */
+        EntityDefinitionFileStamp stampEntityDefinitionFile(const Path& path, std::string_view contents);
+
+        /**
+         * Checks whether the file identified by the given stamp is unchanged on disk. The contents are only read and
+         * hashed if the modification time differs from the one recorded in the stamp.
+         */
+        bool isUnchanged(const EntityDefinitionFileStamp& stamp);
+
+        /**
+         * Caches the class infos parsed from entity definition files so that reloading a file only reparses it if
+         * it or one of the files it includes has changed.
+         *
+         * This class is thread safe.
+         */
+        class EntityDefinitionClassInfoCache {
+        public:
+            struct Entry {
+                /**
+                 * The stamps of the cached file and of all files it includes, directly or indirectly.
+                 */
+                std::vector<EntityDefinitionFileStamp> files;
+                std::vector<EntityDefinitionClassInfo> classInfos;
+                /**
+                 * The messages that were logged while parsing the cached file, so that they can be replayed when the
+                 * cached class infos are used.
+                 */
+                std::vector<std::pair<LogLevel, std::string>> messages;
+            };
+        private:
+            mutable std::mutex m_mutex;
+            std::unordered_map<std::string, Entry> m_entries;
+        public:
+            EntityDefinitionClassInfoCache();
+            ~EntityDefinitionClassInfoCache();
+
+            /**
+             * Returns the cached entry for the file at the given path if none of the files it was parsed from have
+             * changed since. Stale entries are evicted.
+             */
+            std::optional<Entry> find(const Path& path);
+            void insert(const Path& path, std::vector<EntityDefinitionFileStamp> files, std::vector<EntityDefinitionClassInfo> classInfos, std::vector<std::pair<LogLevel, std::string>> messages);
+
+            size_t size() const;
+            void clear();
+        };
+    }
+}
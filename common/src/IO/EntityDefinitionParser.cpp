@@ -23,8 +23,10 @@
 #include "Assets/EntityDefinition.h"
 #include "Assets/ModelDefinition.h"
 #include "Assets/PropertyDefinition.h"
+#include "IO/CollectingParserStatus.h"
 #include "IO/EntityDefinitionClassInfo.h"
 #include "IO/ParserStatus.h"
+#include "IO/Path.h"
 #include "Model/EntityProperties.h"
 
 #include <kdl/vector_utils.h>
@@ -38,6 +40,14 @@ namespace TrenchBroom {
     
        EntityDefinitionParser::EntityDefinitionParser(const Color& defaultEntityColor) :
         m_defaultEntityColor(defaultEntityColor) {}
+
+        EntityDefinitionParser::EntityDefinitionParser(const Color& defaultEntityColor, std::string_view str, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache) :
+        m_defaultEntityColor(defaultEntityColor),
+        m_cache(std::move(cache)) {
+            if (m_cache != nullptr && !path.isEmpty() && path.isAbsolute()) {
+                m_fileStamp = stampEntityDefinitionFile(path, str);
+            }
+        }
         
         EntityDefinitionParser::~EntityDefinitionParser() {}
         
@@ -340,8 +350,34 @@ namespace TrenchBroom {
         }
 
         EntityDefinitionParser::EntityDefinitionList EntityDefinitionParser::parseDefinitions(ParserStatus& status) {
-            auto classInfos = parseClassInfos(status);
+            auto classInfos = parseOrFindClassInfos(status);
             return createDefinitions(status, std::move(classInfos));
         }
+
+        std::vector<EntityDefinitionClassInfo> EntityDefinitionParser::parseOrFindClassInfos(ParserStatus& status) {
+            if (m_cache == nullptr || !m_fileStamp) {
+                return parseClassInfos(status);
+            }
+
+            if (auto entry = m_cache->find(m_fileStamp->path); entry && entry->files.front().contentHash == m_fileStamp->contentHash) {
+                status.debug("Using cached entity definitions for '" + m_fileStamp->path.asString() + "'");
+                for (const auto& [level, message] : entry->messages) {
+                    status.logFormatted(level, message);
+                }
+                return std::move(entry->classInfos);
+            }
+
+            // record the messages so that they can be replayed when the cached class infos are used
+            auto recordingStatus = CollectingParserStatus(status);
+            auto classInfos = parseClassInfos(recordingStatus);
+            if (auto files = includedFiles()) {
+                m_cache->insert(m_fileStamp->path, kdl::vec_concat(std::vector<EntityDefinitionFileStamp>{*m_fileStamp}, std::move(*files)), classInfos, recordingStatus.messages());
+            }
+            return classInfos;
+        }
+
+        std::optional<std::vector<EntityDefinitionFileStamp>> EntityDefinitionParser::includedFiles() const {
+            return std::vector<EntityDefinitionFileStamp>();
+        }
     }
 }
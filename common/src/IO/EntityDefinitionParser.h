@@ -20,9 +20,12 @@
 #pragma once
 
 #include "Color.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -42,6 +45,8 @@ namespace TrenchBroom {
         class EntityDefinitionParser {
         private:
             Color m_defaultEntityColor;
+            std::shared_ptr<EntityDefinitionClassInfoCache> m_cache;
+            std::optional<EntityDefinitionFileStamp> m_fileStamp;
         protected:
             using EntityDefinitionList = std::vector<Assets::EntityDefinition*>;
             using PropertyDefinitionPtr = std::shared_ptr<Assets::PropertyDefinition>;
@@ -49,14 +54,29 @@ namespace TrenchBroom {
             using PropertyDefinitionMap = std::unordered_map<std::string, PropertyDefinitionPtr>;
         public:
             EntityDefinitionParser(const Color& defaultEntityColor);
+
+            /**
+             * Creates a parser for the file at the given path, which has the given contents. If a cache is given and
+             * the path is absolute, the parsed class infos are stored in the cache and reused on subsequent parses of
+             * the same file as long as it, and any file it includes, is unchanged.
+             */
+            EntityDefinitionParser(const Color& defaultEntityColor, std::string_view str, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache);
             virtual ~EntityDefinitionParser();
             
             EntityDefinitionList parseDefinitions(ParserStatus& status);
         private:
+            std::vector<EntityDefinitionClassInfo> parseOrFindClassInfos(ParserStatus& status);
+
             std::unique_ptr<Assets::EntityDefinition> createDefinition(const EntityDefinitionClassInfo& classInfo) const;
             std::vector<Assets::EntityDefinition*> createDefinitions(ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const;
  
             virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) = 0;
+
+            /**
+             * Returns the stamps of the files included by the parsed file, or an empty optional if the parsed class
+             * infos depend on the context in which the file was parsed and therefore must not be cached.
+             */
+            virtual std::optional<std::vector<EntityDefinitionFileStamp>> includedFiles() const;
         };
     }
 }
@@ -20,6 +20,7 @@
 #include "FgdParser.h"
 
 #include "Assets/PropertyDefinition.h"
+#include "IO/CollectingParserStatus.h"
 #include "IO/EntityDefinitionClassInfo.h"
 #include "IO/File.h"
 #include "IO/DiskFileSystem.h"
@@ -27,13 +28,16 @@
 #include "IO/LegacyModelDefinitionParser.h"
 #include "IO/ParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -127,8 +131,11 @@ namespace TrenchBroom {
             return Token(FgdToken::Eof, nullptr, nullptr, length(), line(), column());
         }
 
-        FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path) :
-        EntityDefinitionParser(defaultEntityColor),
+        FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache) :
+        EntityDefinitionParser(defaultEntityColor, str, path, cache),
+        m_includeScopes(1u),
+        m_includeCache(cache != nullptr ? std::move(cache) : std::make_shared<EntityDefinitionClassInfoCache>()),
+        m_str(str),
         m_tokenizer(FgdTokenizer(std::move(str))) {
             if (!path.isEmpty() && path.isAbsolute()) {
                 m_fs = std::make_shared<DiskFileSystem>(path.deleteLastComponent());
@@ -139,6 +146,15 @@ namespace TrenchBroom {
         FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor) :
         FgdParser(std::move(str), defaultEntityColor, Path()) {}
 
+        // Used to parse included files on worker threads. The class infos do not depend on the default entity color.
+        FgdParser::FgdParser(std::shared_ptr<const PreloadedFileMap> preloadedFiles, std::vector<Path> paths, std::shared_ptr<EntityDefinitionClassInfoCache> includeCache) :
+        EntityDefinitionParser(Color()),
+        m_paths(std::move(paths)),
+        m_includeScopes(1u),
+        m_preloadedFiles(std::move(preloadedFiles)),
+        m_includeCache(std::move(includeCache)),
+        m_tokenizer(FgdTokenizer(std::string_view())) {}
+
         FgdParser::TokenNameMap FgdParser::tokenNames() const {
             using namespace FgdToken;
 
@@ -201,7 +217,24 @@ namespace TrenchBroom {
             return false;
         }
 
+        void FgdParser::addIncludedFiles(const std::vector<EntityDefinitionFileStamp>& files) {
+            assert(!m_includeScopes.empty());
+            auto& includedFiles = m_includeScopes.back().files;
+            includedFiles.insert(std::end(includedFiles), std::begin(files), std::end(files));
+        }
+
+        void FgdParser::setNotCacheable() {
+            // the class infos of every file on the include stack depend on the context of the current file
+            for (auto& scope : m_includeScopes) {
+                scope.cacheable = false;
+            }
+        }
+
         std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfos(ParserStatus& status) {
+            if (m_paths.size() == 1u) {
+                parseIncludedFilesInParallel(status);
+            }
+
             std::vector<EntityDefinitionClassInfo> classInfos;
             auto token = m_tokenizer.peekToken();
             while (!token.hasType(FgdToken::Eof)) {
@@ -211,6 +244,16 @@ namespace TrenchBroom {
             return classInfos;
         }
 
+        std::optional<std::vector<EntityDefinitionFileStamp>> FgdParser::includedFiles() const {
+            assert(!m_includeScopes.empty());
+            const auto& scope = m_includeScopes.front();
+            if (scope.cacheable) {
+                return scope.files;
+            } else {
+                return std::nullopt;
+            }
+        }
+
         void FgdParser::parseClassInfoOrInclude(ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos) {
             auto token = expect(status, FgdToken::Eof | FgdToken::Word, m_tokenizer.peekToken());
             if (token.hasType(FgdToken::Eof)) {
@@ -710,8 +753,8 @@ namespace TrenchBroom {
         }
 
         std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(ParserStatus& status, const Path& path) {
-            if (m_fs == nullptr) {
-                status.error(m_tokenizer.line(), kdl::str_to_string("Cannot include file without host file path"));
+            if (m_fs == nullptr && m_preloadedFiles == nullptr) {
+                status.error(m_tokenizer.line(), kdl::str_to_string("Cannot include file without host file path"));
                 return {};
             }
         
@@ -719,24 +762,185 @@ namespace TrenchBroom {
             auto result = std::vector<EntityDefinitionClassInfo>();
             try {
                 status.debug(m_tokenizer.line(), "Parsing included file '" + path.asString() + "'");
-                const auto file = m_fs->openFile(currentRoot() + path);
-                const auto filePath = file->path();
-                status.debug(m_tokenizer.line(), "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
-
-                if (!isRecursiveInclude(filePath)) {
-                    const PushIncludePath pushIncludePath(this, filePath);
-                    auto reader = file->reader().buffer();
-                    m_tokenizer.replaceState(reader.stringView());
-                    result = parseClassInfos(status);
+                if (m_preloadedFiles != nullptr) {
+                    // parsing on a worker thread, which must not access the file system
+                    const auto it = m_preloadedFiles->find((currentRoot() + path).asString());
+                    if (it != std::end(*m_preloadedFiles)) {
+                        result = includeFile(status, path, it->second.path, it->second.contents);
+                    } else {
+                        // the class infos are discarded and the file is parsed again on the calling thread
+                        setNotCacheable();
+                    }
                 } else {
-                    status.error(m_tokenizer.line(), kdl::str_to_string("Skipping recursively included file: ", path.asString(), " (", filePath, ")"));
+                    const auto file = m_fs->openFile(currentRoot() + path);
+                    auto reader = file->reader().buffer();
+                    result = includeFile(status, path, file->path(), reader.stringView());
                 }
             } catch (const Exception &e) {
                 status.error(m_tokenizer.line(), kdl::str_to_string("Failed to parse included file: ", e.what()));
+                setNotCacheable();
             }
 
             m_tokenizer.restoreStateAndSource(snapshot);
             return result;
         }
+
+        std::vector<EntityDefinitionClassInfo> FgdParser::includeFile(ParserStatus& status, const Path& path, const Path& filePath, std::string_view str) {
+            status.debug(m_tokenizer.line(), "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
+
+            if (isRecursiveInclude(filePath)) {
+                status.error(m_tokenizer.line(), kdl::str_to_string("Skipping recursively included file: ", path.asString(), " (", filePath, ")"));
+                setNotCacheable();
+                return {};
+            }
+
+            if (auto entry = m_includeCache->find(filePath)) {
+                status.debug(m_tokenizer.line(), "Using cached class infos for '" + filePath.asString() + "'");
+                for (const auto& [level, message] : entry->messages) {
+                    status.logFormatted(level, message);
+                }
+                addIncludedFiles(entry->files);
+                return std::move(entry->classInfos);
+            }
+
+            return parseIncludedFile(status, filePath, str);
+        }
+
+        /**
+         * Parses the given contents of the included file at the given path and caches the resulting class infos
+         * unless they depend on the files that include it. The messages logged while parsing are cached, too.
+         */
+        std::vector<EntityDefinitionClassInfo> FgdParser::parseIncludedFile(ParserStatus& status, const Path& filePath, std::string_view str) {
+            const auto fileStamp = stampEntityDefinitionFile(filePath, str);
+
+            auto recordingStatus = CollectingParserStatus(status);
+            auto result = std::vector<EntityDefinitionClassInfo>();
+            m_includeScopes.emplace_back();
+            try {
+                const PushIncludePath pushIncludePath(this, filePath);
+                m_tokenizer.replaceState(str);
+                result = parseClassInfos(recordingStatus);
+            } catch (...) {
+                m_includeScopes.pop_back();
+                setNotCacheable();
+                throw;
+            }
+
+            auto scope = std::move(m_includeScopes.back());
+            m_includeScopes.pop_back();
+
+            if (scope.cacheable) {
+                auto files = kdl::vec_concat(std::vector<EntityDefinitionFileStamp>{fileStamp}, std::move(scope.files));
+                m_includeCache->insert(filePath, files, result, recordingStatus.messages());
+                addIncludedFiles(files);
+            }
+
+            return result;
+        }
+
+        /**
+         * Finds the paths of the files included by the given FGD source without parsing it. Only include directives
+         * at the start of a line are found, but that is where they are placed in practice. Any other include is
+         * still parsed when it is encountered.
+         */
+        static std::vector<Path> findIncludes(std::string_view str) {
+            static const auto Directive = std::string_view("@include");
+
+            auto result = std::vector<Path>();
+            auto lineStart = size_t(0);
+            while (lineStart < str.size()) {
+                auto lineEnd = str.find('\n', lineStart);
+                if (lineEnd == std::string_view::npos) {
+                    lineEnd = str.size();
+                }
+
+                auto line = str.substr(lineStart, lineEnd - lineStart);
+                const auto first = line.find_first_not_of(" \t");
+                if (first != std::string_view::npos) {
+                    line = line.substr(first);
+                    if (kdl::ci::str_is_prefix(line, Directive)) {
+                        const auto open = line.find('"', Directive.size());
+                        const auto close = open != std::string_view::npos ? line.find('"', open + 1u) : std::string_view::npos;
+                        if (close != std::string_view::npos) {
+                            result.emplace_back(std::string(line.substr(open + 1u, close - open - 1u)));
+                        }
+                    }
+                }
+
+                lineStart = lineEnd + 1u;
+            }
+
+            return result;
+        }
+
+        /**
+         * Reads the files included by the given FGD source, and recursively the files they include, into the given
+         * map.
+         */
+        void FgdParser::preloadIncludedFiles(const Path& root, std::string_view str, PreloadedFileMap& files) const {
+            for (const auto& path : findIncludes(str)) {
+                const auto includePath = root + path;
+                const auto key = includePath.asString();
+                if (files.count(key) == 0u) {
+                    try {
+                        const auto file = m_fs->openFile(includePath);
+                        auto reader = file->reader().buffer();
+                        const auto& preloadedFile = files[key] = PreloadedFile{ file->path(), std::string(reader.stringView()) };
+                        preloadIncludedFiles(preloadedFile.path.deleteLastComponent(), preloadedFile.contents, files);
+                    } catch (const Exception&) {
+                        // reported when the include directive is parsed
+                    }
+                }
+            }
+        }
+
+        /**
+         * Parses the files included by the top level file on worker threads and stores their class infos in the
+         * include cache, where they are picked up when the include directives are parsed. The messages logged by
+         * the workers are replayed from the cache then, too.
+         *
+         * The file system is not safe to access concurrently, so all included files are read beforehand, including
+         * the files they include in turn. A worker that encounters an include which was not read beforehand does not
+         * cache its result, and the file is parsed again when its include directive is parsed.
+         */
+        void FgdParser::parseIncludedFilesInParallel(ParserStatus& status) {
+            if (m_fs == nullptr) {
+                return;
+            }
+
+            auto preloadedFiles = std::make_shared<PreloadedFileMap>();
+            preloadIncludedFiles(currentRoot(), m_str, *preloadedFiles);
+
+            auto includes = std::vector<const PreloadedFile*>();
+            for (const auto& path : findIncludes(m_str)) {
+                const auto it = preloadedFiles->find((currentRoot() + path).asString());
+                if (it != std::end(*preloadedFiles)) {
+                    const auto& preloadedFile = it->second;
+                    const auto isDuplicate = std::any_of(std::begin(includes), std::end(includes), [&](const auto* include) {
+                        return include->path == preloadedFile.path;
+                    });
+                    if (!isDuplicate && !isRecursiveInclude(preloadedFile.path) && !m_includeCache->find(preloadedFile.path)) {
+                        includes.push_back(&preloadedFile);
+                    }
+                }
+            }
+
+            if (includes.size() < 2u) {
+                return;
+            }
+
+            const auto prefix = status.prefix();
+            kdl::parallel_for(includes.size(), [&](const size_t i) {
+                const auto& include = *includes[i];
+
+                auto includeStatus = CollectingParserStatus(prefix);
+                FgdParser parser(preloadedFiles, m_paths, m_includeCache);
+                try {
+                    parser.parseIncludedFile(includeStatus, include.path, include.contents);
+                } catch (const Exception&) {
+                    // reported when the include directive is parsed
+                }
+            });
+        }
     }
 }
@@ -28,6 +28,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -71,24 +73,56 @@ namespace TrenchBroom {
         private:
             using Token = FgdTokenizer::Token;
 
+            /**
+             * The files included by a file that is currently being parsed.
+             */
+            struct IncludeScope {
+                std::vector<EntityDefinitionFileStamp> files;
+                bool cacheable = true;
+            };
+
+            /**
+             * An included file that was read before parsing.
+             */
+            struct PreloadedFile {
+                Path path;
+                std::string contents;
+            };
+
+            /**
+             * Maps the path of an include directive, prefixed with the directory of the including file, to the file
+             * it refers to.
+             */
+            using PreloadedFileMap = std::unordered_map<std::string, PreloadedFile>;
+
             std::vector<Path> m_paths;
+            std::vector<IncludeScope> m_includeScopes;
             std::shared_ptr<FileSystem> m_fs;
+            std::shared_ptr<const PreloadedFileMap> m_preloadedFiles;
+            std::shared_ptr<EntityDefinitionClassInfoCache> m_includeCache;
 
+            std::string_view m_str;
             FgdTokenizer m_tokenizer;
         public:
-            FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path);
+            FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path, std::shared_ptr<EntityDefinitionClassInfoCache> cache = nullptr);
             FgdParser(std::string_view str, const Color& defaultEntityColor);
         private:
+            FgdParser(std::shared_ptr<const PreloadedFileMap> preloadedFiles, std::vector<Path> paths, std::shared_ptr<EntityDefinitionClassInfoCache> includeCache);
+
             class PushIncludePath;
             void pushIncludePath(const Path& path);
             void popIncludePath();
 
             Path currentRoot() const;
             bool isRecursiveInclude(const Path& path) const;
+
+            void addIncludedFiles(const std::vector<EntityDefinitionFileStamp>& files);
+            void setNotCacheable();
         private:
             TokenNameMap tokenNames() const override;
 
             std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+            std::optional<std::vector<EntityDefinitionFileStamp>> includedFiles() const override;
 
             void parseClassInfoOrInclude(ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos);
 
@@ -128,6 +162,10 @@ namespace TrenchBroom {
 
             std::vector<EntityDefinitionClassInfo> parseInclude(ParserStatus& status);
             std::vector<EntityDefinitionClassInfo> handleInclude(ParserStatus& status, const Path& path);
+            std::vector<EntityDefinitionClassInfo> includeFile(ParserStatus& status, const Path& path, const Path& filePath, std::string_view str);
+            std::vector<EntityDefinitionClassInfo> parseIncludedFile(ParserStatus& status, const Path& filePath, std::string_view str);
+            void preloadIncludedFiles(const Path& root, std::string_view str, PreloadedFileMap& files) const;
+            void parseIncludedFilesInParallel(ParserStatus& status);
         };
     }
 }
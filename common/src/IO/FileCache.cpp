@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileCache.h"
+
+#include "IO/File.h"
+
+#include <kdl/string_compare.h>
+
+namespace TrenchBroom {
+    namespace IO {
+        FileCache::FileCache(const size_t maxBytes) :
+        m_maxBytes(maxBytes),
+        m_bytes(0u),
+        m_hits(0u),
+        m_misses(0u) {}
+
+        std::shared_ptr<File> FileCache::get(const std::string& key) {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+
+            const auto it = m_index.find(key);
+            if (it == std::end(m_index)) {
+                ++m_misses;
+                return nullptr;
+            }
+
+            ++m_hits;
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            return it->second->second;
+        }
+
+        void FileCache::put(const std::string& key, std::shared_ptr<File> file) {
+            const auto fileSize = file->size();
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+
+            // the previous file is stale even if the new one cannot be cached
+            const auto it = m_index.find(key);
+            if (it != std::end(m_index)) {
+                m_bytes -= it->second->second->size();
+                m_entries.erase(it->second);
+                m_index.erase(it);
+            }
+
+            if (fileSize > m_maxBytes) {
+                return;
+            }
+
+            m_entries.emplace_front(key, std::move(file));
+            m_index.emplace(key, std::begin(m_entries));
+            m_bytes += fileSize;
+
+            evict();
+        }
+
+        void FileCache::removeWithPrefix(const std::string& prefix) {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+
+            auto it = std::begin(m_entries);
+            while (it != std::end(m_entries)) {
+                if (kdl::cs::str_is_prefix(it->first, prefix)) {
+                    m_bytes -= it->second->size();
+                    m_index.erase(it->first);
+                    it = m_entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void FileCache::clear() {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+
+            m_entries.clear();
+            m_index.clear();
+            m_bytes = 0u;
+        }
+
+        size_t FileCache::maxBytes() const {
+            return m_maxBytes;
+        }
+
+        size_t FileCache::bytes() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_bytes;
+        }
+
+        size_t FileCache::count() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_entries.size();
+        }
+
+        size_t FileCache::hits() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_hits;
+        }
+
+        size_t FileCache::misses() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_misses;
+        }
+
+        void FileCache::evict() {
+            while (m_bytes > m_maxBytes && !m_entries.empty()) {
+                const auto& [key, file] = m_entries.back();
+                m_bytes -= file->size();
+                m_index.erase(key);
+                m_entries.pop_back();
+            }
+        }
+    }
+}
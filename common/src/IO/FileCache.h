@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace IO {
+        class File;
+
+        /**
+         * A thread safe cache of opened files, such as entries decompressed from an archive. Once the total size of
+         * the cached files exceeds the given budget, the least recently used files are evicted.
+         *
+         * Cached files are shared with their users, so they must not be modified.
+         */
+        class FileCache {
+        private:
+            using Entry = std::pair<std::string, std::shared_ptr<File>>;
+            using EntryList = std::list<Entry>;
+
+            const size_t m_maxBytes;
+            mutable std::mutex m_mutex;
+            // the most recently used entry comes first
+            EntryList m_entries;
+            std::unordered_map<std::string, EntryList::iterator> m_index;
+            size_t m_bytes;
+            size_t m_hits;
+            size_t m_misses;
+        public:
+            explicit FileCache(size_t maxBytes);
+
+            /**
+             * Returns the file cached under the given key and marks it as most recently used, or returns nullptr if
+             * no such file is cached.
+             */
+            std::shared_ptr<File> get(const std::string& key);
+
+            /**
+             * Caches the given file under the given key, replacing any file already cached under that key, and evicts
+             * the least recently used files until the cache fits its budget again. Files that are larger than the
+             * budget are not cached, but they still remove any file already cached under the given key.
+             */
+            void put(const std::string& key, std::shared_ptr<File> file);
+
+            /**
+             * Removes every file whose key starts with the given prefix.
+             */
+            void removeWithPrefix(const std::string& prefix);
+            void clear();
+
+            size_t maxBytes() const;
+            size_t bytes() const;
+            size_t count() const;
+            size_t hits() const;
+            size_t misses() const;
+        private:
+            void evict();
+        };
+    }
+}
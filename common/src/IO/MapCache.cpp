@@ -0,0 +1,635 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "Ensure.h"
+#include "Exceptions.h"
+#include "Macros.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/IOUtils.h"
+#include "IO/NodeSerializer.h"
+#include "IO/NodeWriter.h"
+#include "IO/ParserStatus.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushError.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/parallel.h>
+#include <kdl/result.h>
+#include <kdl/string_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace MapCache {
+            /*
+             * Layout of a cache file, all values are stored in native byte order:
+             *
+             * - header: magic, version, size and hash of the map file, map format, world bounds, object count, size
+             *   and hash of the object data
+             * - object data: one record per entity and brush in the order in which they appear in the map file
+             *
+             * Brush records are prefixed with their size so that they can be skipped when reading the object data, and
+             * decoded in parallel afterwards.
+             */
+            static constexpr char Magic[] = { 'T', 'B', 'M', 'C' };
+            static constexpr uint32_t Version = 1u;
+            static constexpr uint32_t NoParent = std::numeric_limits<uint32_t>::max();
+
+            enum class RecordType : uint8_t {
+                Entity = 0,
+                Brush = 1
+            };
+
+            static uint64_t hashContents(const std::string_view contents) {
+                // FNV-1a
+                uint64_t result = 14695981039346656037ull;
+                for (const char c : contents) {
+                    result ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+                    result *= 1099511628211ull;
+                }
+                return result;
+            }
+
+            /**
+             * Returns the number of lines that precede the comment of the first entity in the given map file, e.g. the
+             * game and format comments.
+             */
+            static size_t countHeaderLines(const std::string_view mapContents) {
+                const auto header = mapContents.substr(0u, mapContents.find('{'));
+                const auto newlines = static_cast<size_t>(std::count(std::begin(header), std::end(header), '\n'));
+                return newlines > 0u ? newlines - 1u : 0u;
+            }
+
+            static size_t countLines(const std::string_view str) {
+                return static_cast<size_t>(std::count(std::begin(str), std::end(str), '\n'));
+            }
+
+            template <typename T>
+            static void append(std::string& buffer, const T value) {
+                static_assert(std::is_trivially_copyable_v<T>, "value must be trivially copyable");
+                buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            template <typename T>
+            static void overwrite(std::string& buffer, const size_t offset, const T value) {
+                static_assert(std::is_trivially_copyable_v<T>, "value must be trivially copyable");
+                assert(offset + sizeof(T) <= buffer.size());
+                std::memcpy(buffer.data() + offset, &value, sizeof(T));
+            }
+
+            static void appendIndex(std::string& buffer, const size_t value) {
+                append(buffer, static_cast<uint32_t>(value));
+            }
+
+            static void appendString(std::string& buffer, const std::string& str) {
+                appendIndex(buffer, str.size());
+                buffer.append(str);
+            }
+
+            static void appendVec(std::string& buffer, const vm::vec3& vec) {
+                append(buffer, static_cast<double>(vec.x()));
+                append(buffer, static_cast<double>(vec.y()));
+                append(buffer, static_cast<double>(vec.z()));
+            }
+
+            static size_t readIndex(Reader& reader) {
+                return reader.readSize<uint32_t>();
+            }
+
+            static size_t readIndex(Reader& reader, const size_t count) {
+                const auto index = readIndex(reader);
+                if (index >= count) {
+                    throw ReaderException("Index out of range: " + std::to_string(index));
+                }
+                return index;
+            }
+
+            static std::string readString(Reader& reader) {
+                const auto size = readIndex(reader);
+                return reader.readString(size);
+            }
+
+            static vm::vec3 readVec(Reader& reader) {
+                return reader.readVec<double, 3>();
+            }
+
+            static bool hasSurfaceAttributes(const Model::MapFormat format) {
+                switch (format) {
+                    case Model::MapFormat::Quake2:
+                    case Model::MapFormat::Quake2_Valve:
+                    case Model::MapFormat::Quake3:
+                    case Model::MapFormat::Quake3_Legacy:
+                    case Model::MapFormat::Quake3_Valve:
+                    case Model::MapFormat::Daikatana:
+                        return true;
+                    case Model::MapFormat::Standard:
+                    case Model::MapFormat::Valve:
+                    case Model::MapFormat::Hexen2:
+                    case Model::MapFormat::Unknown:
+                        return false;
+                    switchDefault()
+                }
+            }
+
+            /**
+             * Writes the given face such that reading it yields the same face as parsing it from the map file, that
+             * is, only the attributes that the map file stores for the given format are written.
+             */
+            static void appendFace(std::string& buffer, const Model::BrushFace& face, const Model::MapFormat format) {
+                const auto& points = face.points();
+                appendVec(buffer, points[0]);
+                appendVec(buffer, points[1]);
+                appendVec(buffer, points[2]);
+
+                const auto& attributes = face.attributes();
+                appendString(buffer, attributes.textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : attributes.textureName());
+                append(buffer, attributes.xOffset());
+                append(buffer, attributes.yOffset());
+                append(buffer, attributes.rotation());
+                append(buffer, attributes.xScale());
+                append(buffer, attributes.yScale());
+
+                if (hasSurfaceAttributes(format)) {
+                    append(buffer, static_cast<int32_t>(attributes.surfaceContents()));
+                    append(buffer, static_cast<int32_t>(attributes.surfaceFlags()));
+                    append(buffer, attributes.surfaceValue());
+                }
+
+                if (format == Model::MapFormat::Daikatana) {
+                    append(buffer, static_cast<uint8_t>(attributes.hasColor()));
+                    if (attributes.hasColor()) {
+                        append(buffer, static_cast<int32_t>(attributes.color().r()));
+                        append(buffer, static_cast<int32_t>(attributes.color().g()));
+                        append(buffer, static_cast<int32_t>(attributes.color().b()));
+                    }
+                }
+
+                if (Model::isParallelTexCoordSystem(format)) {
+                    appendVec(buffer, face.textureXAxis());
+                    appendVec(buffer, face.textureYAxis());
+                }
+            }
+
+            static Model::BrushFace readFace(Reader& reader, const Model::MapFormat format, const size_t line) {
+                const auto point1 = readVec(reader);
+                const auto point2 = readVec(reader);
+                const auto point3 = readVec(reader);
+
+                auto attributes = Model::BrushFaceAttributes(readString(reader));
+                attributes.setXOffset(reader.readFloat<float>());
+                attributes.setYOffset(reader.readFloat<float>());
+                attributes.setRotation(reader.readFloat<float>());
+                attributes.setXScale(reader.readFloat<float>());
+                attributes.setYScale(reader.readFloat<float>());
+
+                if (hasSurfaceAttributes(format)) {
+                    attributes.setSurfaceContents(reader.readInt<int32_t>());
+                    attributes.setSurfaceFlags(reader.readInt<int32_t>());
+                    attributes.setSurfaceValue(reader.readFloat<float>());
+                }
+
+                if (format == Model::MapFormat::Daikatana && reader.readBool<uint8_t>()) {
+                    const auto r = reader.readInt<int32_t>();
+                    const auto g = reader.readInt<int32_t>();
+                    const auto b = reader.readInt<int32_t>();
+                    attributes.setColor(Color(r, g, b));
+                }
+
+                auto result = [&]() {
+                    if (Model::isParallelTexCoordSystem(format)) {
+                        const auto textureXAxis = readVec(reader);
+                        const auto textureYAxis = readVec(reader);
+                        return Model::BrushFace::createFromValve(point1, point2, point3, attributes, textureXAxis, textureYAxis, format);
+                    } else {
+                        return Model::BrushFace::createFromStandard(point1, point2, point3, attributes, format);
+                    }
+                }();
+
+                return std::move(result).visit(kdl::overload(
+                    [&](Model::BrushFace&& face) {
+                        face.setFilePosition(line, 1u);
+                        return std::move(face);
+                    },
+                    [&](const Model::BrushError e) -> Model::BrushFace {
+                        throw ReaderException("Cannot restore brush face: " + kdl::str_to_string(e));
+                    }
+                ));
+            }
+
+            /**
+             * Encodes the faces and the geometry of the given brush. The faces are written in the order in which they
+             * appear in the map file, and the geometry's faces are written in the same order. Half edges are numbered
+             * in the order in which they appear in the face boundaries.
+             */
+            static std::string encodeBrush(const Model::Brush& brush, const Model::MapFormat format) {
+                std::string buffer;
+
+                std::unordered_map<const Model::BrushVertex*, size_t> vertexIndices;
+                appendIndex(buffer, brush.vertexCount());
+                for (const auto* vertex : brush.vertices()) {
+                    vertexIndices.emplace(vertex, vertexIndices.size());
+                    appendVec(buffer, vertex->position());
+                }
+
+                std::unordered_map<const Model::BrushHalfEdge*, size_t> halfEdgeIndices;
+                appendIndex(buffer, brush.faceCount());
+                for (const auto& face : brush.faces()) {
+                    appendFace(buffer, face, format);
+
+                    const auto* faceGeometry = face.geometry();
+                    ensure(faceGeometry != nullptr, "face geometry is null");
+
+                    const auto& plane = faceGeometry->plane();
+                    appendVec(buffer, plane.normal);
+                    append(buffer, static_cast<double>(plane.distance));
+
+                    appendIndex(buffer, faceGeometry->boundary().size());
+                    for (const auto* halfEdge : faceGeometry->boundary()) {
+                        halfEdgeIndices.emplace(halfEdge, halfEdgeIndices.size());
+                        appendIndex(buffer, vertexIndices.at(halfEdge->origin()));
+                    }
+                }
+
+                appendIndex(buffer, brush.edgeCount());
+                for (const auto* edge : brush.edges()) {
+                    appendIndex(buffer, halfEdgeIndices.at(edge->firstEdge()));
+                    appendIndex(buffer, halfEdgeIndices.at(edge->secondEdge()));
+                }
+
+                return buffer;
+            }
+
+            static MapReader::BrushInfo decodeBrush(Reader reader, const Model::MapFormat format, const size_t startLine, const std::optional<size_t> parentIndex) {
+                const auto vertexCount = readIndex(reader);
+                std::vector<vm::vec3> positions;
+                positions.reserve(vertexCount);
+                for (size_t i = 0u; i < vertexCount; ++i) {
+                    positions.push_back(readVec(reader));
+                }
+
+                const auto faceCount = readIndex(reader);
+                std::vector<Model::BrushFace> faces;
+                std::vector<vm::plane3> facePlanes;
+                std::vector<std::vector<size_t>> faceVertexIndices;
+                faces.reserve(faceCount);
+                facePlanes.reserve(faceCount);
+                faceVertexIndices.reserve(faceCount);
+
+                size_t halfEdgeCount = 0u;
+                for (size_t i = 0u; i < faceCount; ++i) {
+                    // faces are stored one per line, directly after the opening brace of the brush
+                    faces.push_back(readFace(reader, format, startLine + 1u + i));
+
+                    const auto normal = readVec(reader);
+                    const auto distance = static_cast<FloatType>(reader.readDouble<double>());
+                    facePlanes.emplace_back(distance, normal);
+
+                    const auto boundarySize = readIndex(reader);
+                    auto& vertexIndices = faceVertexIndices.emplace_back();
+                    vertexIndices.reserve(boundarySize);
+                    for (size_t j = 0u; j < boundarySize; ++j) {
+                        vertexIndices.push_back(readIndex(reader, vertexCount));
+                    }
+                    halfEdgeCount += boundarySize;
+                }
+
+                const auto edgeCount = readIndex(reader);
+                if (2u * edgeCount != halfEdgeCount) {
+                    throw ReaderException("Invalid brush geometry");
+                }
+
+                std::vector<std::tuple<size_t, size_t>> edgeHalfEdgeIndices;
+                edgeHalfEdgeIndices.reserve(edgeCount);
+                for (size_t i = 0u; i < edgeCount; ++i) {
+                    const auto first = readIndex(reader, halfEdgeCount);
+                    const auto second = readIndex(reader, halfEdgeCount);
+                    edgeHalfEdgeIndices.emplace_back(first, second);
+                }
+
+                auto geometry = std::make_unique<Model::BrushGeometry>(positions, faceVertexIndices, facePlanes, edgeHalfEdgeIndices);
+                return MapReader::BrushInfo{std::move(faces), startLine, 0u, parentIndex, std::move(geometry)};
+            }
+
+            /**
+             * Writes the objects of a map in the same order as the map file serializer and tracks the lines at which
+             * they appear in the map file, following the conventions of the map parser.
+             */
+            class CacheSerializer : public NodeSerializer {
+            private:
+                Model::MapFormat m_format;
+                std::string& m_buffer;
+                size_t m_line;
+                size_t m_objectCount;
+
+                size_t m_entityIndex;
+                size_t m_entityStartLine;
+                size_t m_entityRecordOffset;
+                size_t m_propertyCount;
+                std::unordered_set<std::string> m_propertyKeys;
+
+                std::unordered_map<const Model::Node*, std::string> m_nodeToEncodedBrush;
+            public:
+                CacheSerializer(const Model::MapFormat format, const size_t headerLines, std::string& buffer) :
+                m_format(format),
+                m_buffer(buffer),
+                m_line(headerLines + 1u),
+                m_objectCount(0u),
+                m_entityIndex(0u),
+                m_entityStartLine(0u),
+                m_entityRecordOffset(0u),
+                m_propertyCount(0u) {}
+
+                size_t objectCount() const {
+                    return m_objectCount;
+                }
+            private:
+                void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override {
+                    std::vector<const Model::BrushNode*> brushNodes;
+                    Model::Node::visitAll(rootNodes, kdl::overload(
+                        [](auto&& thisLambda, const Model::WorldNode* world) { world->visitChildren(thisLambda); },
+                        [](auto&& thisLambda, const Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+                        [](auto&& thisLambda, const Model::GroupNode* group) { group->visitChildren(thisLambda); },
+                        [](auto&& thisLambda, const Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
+                        [&](const Model::BrushNode* brush) {
+                            brushNodes.push_back(brush);
+                        }
+                    ));
+
+                    auto encodedBrushes = kdl::vec_parallel_transform(std::move(brushNodes), [&](const Model::BrushNode* brushNode) {
+                        return std::make_pair(brushNode, encodeBrush(brushNode->brush(), m_format));
+                    });
+
+                    for (auto& [brushNode, encodedBrush] : encodedBrushes) {
+                        m_nodeToEncodedBrush[brushNode] = std::move(encodedBrush);
+                    }
+                }
+
+                void doEndFile() override {}
+
+                void doBeginEntity(const Model::Node* /* node */) override {
+                    ++m_line; // entity comment
+                    m_entityStartLine = m_line++;
+                    m_entityIndex = m_objectCount++;
+
+                    append(m_buffer, RecordType::Entity);
+                    m_entityRecordOffset = m_buffer.size();
+                    appendIndex(m_buffer, m_entityStartLine);
+                    appendIndex(m_buffer, 0u); // line count
+                    appendIndex(m_buffer, 0u); // property count
+
+                    m_propertyCount = 0u;
+                    m_propertyKeys.clear();
+                }
+
+                void doEndEntity(const Model::Node* /* node */) override {
+                    const auto lineCount = m_line++ - m_entityStartLine;
+                    overwrite(m_buffer, m_entityRecordOffset + sizeof(uint32_t), static_cast<uint32_t>(lineCount));
+                    overwrite(m_buffer, m_entityRecordOffset + 2u * sizeof(uint32_t), static_cast<uint32_t>(m_propertyCount));
+                }
+
+                void doEntityProperty(const Model::EntityProperty& property) override {
+                    auto key = escapeEntityProperties(property.key());
+                    auto value = escapeEntityProperties(property.value());
+                    m_line += 1u + countLines(key) + countLines(value);
+
+                    // the parser ignores duplicate keys
+                    if (m_propertyKeys.insert(key).second) {
+                        appendString(m_buffer, key);
+                        appendString(m_buffer, value);
+                        ++m_propertyCount;
+                    }
+                }
+
+                void doBrush(const Model::BrushNode* brushNode) override {
+                    auto it = m_nodeToEncodedBrush.find(brushNode);
+                    ensure(it != std::end(m_nodeToEncodedBrush), "attempted to serialize a brush which was not passed to doBeginFile");
+                    const auto& encodedBrush = it->second;
+
+                    ++m_line; // brush comment
+                    const auto startLine = m_line++;
+                    m_line += brushNode->brush().faceCount();
+                    const auto lineCount = m_line++ - startLine;
+
+                    append(m_buffer, RecordType::Brush);
+                    appendIndex(m_buffer, startLine);
+                    appendIndex(m_buffer, lineCount);
+                    appendIndex(m_buffer, m_entityIndex);
+                    appendIndex(m_buffer, encodedBrush.size());
+                    m_buffer.append(encodedBrush);
+
+                    ++m_objectCount;
+                }
+
+                void doBrushFace(const Model::BrushFace& /* face */) override {}
+            };
+
+            Path cachePath(const Path& mapPath) {
+                return mapPath.addExtension("tbcache");
+            }
+
+            void write(const Model::WorldNode& world, const vm::bbox3& worldBounds, const Path& mapPath) {
+                const auto fixedMapPath = Disk::fixPath(mapPath);
+                const auto file = Disk::openFile(fixedMapPath);
+                const auto mapReader = file->reader().buffer();
+                const auto mapContents = mapReader.stringView();
+
+                std::string objects;
+                auto serializer = std::make_unique<CacheSerializer>(world.mapFormat(), countHeaderLines(mapContents), objects);
+                auto& cacheSerializer = *serializer;
+
+                NodeWriter writer(world, std::move(serializer));
+                writer.writeMap();
+
+                std::string header;
+                header.append(Magic, sizeof(Magic));
+                append(header, Version);
+                append(header, static_cast<uint64_t>(mapContents.size()));
+                append(header, hashContents(mapContents));
+                append(header, static_cast<int32_t>(world.mapFormat()));
+                appendVec(header, worldBounds.min);
+                appendVec(header, worldBounds.max);
+                appendIndex(header, cacheSerializer.objectCount());
+                append(header, static_cast<uint64_t>(objects.size()));
+                append(header, hashContents(objects));
+
+                const auto path = cachePath(fixedMapPath);
+                auto stream = openPathAsOutputStream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!stream) {
+                    throw FileSystemException("Cannot open file: " + path.asString());
+                }
+                stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+                stream.write(objects.data(), static_cast<std::streamsize>(objects.size()));
+                if (!stream) {
+                    throw FileSystemException("Cannot write file: " + path.asString());
+                }
+            }
+
+            static std::vector<MapReader::ObjectInfo> readObjects(Reader& reader, const size_t objectCount, const Model::MapFormat format) {
+                std::vector<MapReader::ObjectInfo> objectInfos;
+                objectInfos.reserve(objectCount);
+
+                // entities are decoded right away, brushes are only located and decoded in parallel afterwards
+                std::vector<size_t> brushIndices;
+                std::vector<std::tuple<size_t, Reader>> brushReaders;
+
+                for (size_t i = 0u; i < objectCount; ++i) {
+                    const auto recordType = static_cast<RecordType>(reader.readUnsignedChar<uint8_t>());
+                    const auto startLine = readIndex(reader);
+                    const auto lineCount = readIndex(reader);
+
+                    if (recordType == RecordType::Entity) {
+                        const auto propertyCount = readIndex(reader);
+                        std::vector<Model::EntityProperty> properties;
+                        properties.reserve(propertyCount);
+                        for (size_t j = 0u; j < propertyCount; ++j) {
+                            auto key = readString(reader);
+                            auto value = readString(reader);
+                            properties.emplace_back(key, value);
+                        }
+                        objectInfos.push_back(MapReader::EntityInfo{std::move(properties), startLine, lineCount});
+                    } else if (recordType == RecordType::Brush) {
+                        const auto parentIndex = readIndex(reader);
+                        if (parentIndex != NoParent && parentIndex >= i) {
+                            throw ReaderException("Invalid brush parent index: " + std::to_string(parentIndex));
+                        }
+
+                        const auto size = readIndex(reader);
+                        brushIndices.push_back(i);
+                        brushReaders.emplace_back(startLine, reader.subReaderFromCurrent(size));
+                        reader.seekForward(size);
+
+                        auto brushInfo = MapReader::BrushInfo{{}, startLine, lineCount, std::nullopt, nullptr};
+                        if (parentIndex != NoParent) {
+                            brushInfo.parentIndex = parentIndex;
+                        }
+                        objectInfos.push_back(std::move(brushInfo));
+                    } else {
+                        throw ReaderException("Unknown record type");
+                    }
+                }
+
+                // exceptions must not escape the worker threads, so failures are recorded as empty results
+                auto decodedBrushes = kdl::vec_parallel_transform(std::move(brushReaders), [&](std::tuple<size_t, Reader>&& brushReader) -> std::optional<MapReader::BrushInfo> {
+                    auto& [startLine, subReader] = brushReader;
+                    try {
+                        return decodeBrush(std::move(subReader), format, startLine, std::nullopt);
+                    } catch (const ReaderException&) {
+                        return std::nullopt;
+                    }
+                });
+
+                for (size_t i = 0u; i < brushIndices.size(); ++i) {
+                    auto& decodedBrush = decodedBrushes[i];
+                    if (!decodedBrush) {
+                        throw ReaderException("Cannot decode brush");
+                    }
+
+                    auto& brushInfo = std::get<MapReader::BrushInfo>(objectInfos[brushIndices[i]]);
+                    brushInfo.faces = std::move(decodedBrush->faces);
+                    brushInfo.geometry = std::move(decodedBrush->geometry);
+                }
+
+                return objectInfos;
+            }
+
+            std::unique_ptr<Model::WorldNode> read(const Path& mapPath, const std::string_view mapContents, const Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
+                const auto path = cachePath(Disk::fixPath(mapPath));
+                if (format == Model::MapFormat::Unknown || !Disk::fileExists(path)) {
+                    return nullptr;
+                }
+
+                try {
+                    const auto file = Disk::openFile(path);
+                    auto reader = file->reader().buffer();
+
+                    char magic[sizeof(Magic)];
+                    reader.read(magic, sizeof(Magic));
+                    if (std::memcmp(magic, Magic, sizeof(Magic)) != 0 || reader.readUnsignedInt<uint32_t>() != Version) {
+                        return nullptr;
+                    }
+
+                    // a cache that was written for a different version of the map file is silently ignored
+                    if (reader.read<uint64_t, uint64_t>() != static_cast<uint64_t>(mapContents.size()) ||
+                        reader.read<uint64_t, uint64_t>() != hashContents(mapContents) ||
+                        reader.readInt<int32_t>() != static_cast<int>(format)) {
+                        return nullptr;
+                    }
+
+                    const auto cachedMin = readVec(reader);
+                    const auto cachedMax = readVec(reader);
+                    if (vm::bbox3(cachedMin, cachedMax) != worldBounds) {
+                        return nullptr;
+                    }
+
+                    const auto objectCount = readIndex(reader);
+                    const auto objectsSize = reader.readSize<uint64_t>();
+                    const auto objectsHash = reader.read<uint64_t, uint64_t>();
+
+                    auto objectReader = reader.subReaderFromCurrent(objectsSize).buffer();
+                    if (hashContents(objectReader.stringView()) != objectsHash) {
+                        throw ReaderException("Checksum mismatch");
+                    }
+
+                    auto objectInfos = readObjects(objectReader, objectCount, format);
+                    WorldReader worldReader("", format);
+                    return worldReader.read(std::move(objectInfos), worldBounds, status);
+                } catch (const Exception& e) {
+                    status.warn("Ignoring map cache '" + path.asString() + "': " + e.what());
+                    return nullptr;
+                }
+            }
+        }
+    }
+}
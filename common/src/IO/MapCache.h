@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include <vecmath/forward.h>
+
+#include <memory>
+#include <string_view>
+
+namespace TrenchBroom {
+    namespace Model {
+        enum class MapFormat;
+        class WorldNode;
+    }
+
+    namespace IO {
+        class ParserStatus;
+        class Path;
+
+        /**
+         * A binary companion file that is stored next to a map file and allows to reopen the map without parsing it
+         * and without recomputing the geometry of its brushes.
+         *
+         * The cache stores the objects of the map in the order in which they appear in the map file, together with
+         * the geometry of every brush. It is tied to the exact contents of the map file by a hash, so a cache that was
+         * written for a different version of the map file is ignored and the map file is parsed instead.
+         */
+        namespace MapCache {
+            /**
+             * Returns the path of the cache file that belongs to the map file at the given path.
+             */
+            Path cachePath(const Path& mapPath);
+
+            /**
+             * Writes the cache file for the given world, which must just have been saved to the given map file.
+             *
+             * @param world the world to write
+             * @param worldBounds the world bounds that were used to compute the brush geometry
+             * @param mapPath the path of the map file that the world was saved to
+             *
+             * @throws FileSystemException if the map file cannot be read or the cache file cannot be written
+             */
+            void write(const Model::WorldNode& world, const vm::bbox3& worldBounds, const Path& mapPath);
+
+            /**
+             * Restores the world from the cache file that belongs to the map file at the given path.
+             *
+             * Returns null if there is no cache file, if it was written for different map file contents, a
+             * different map format or different world bounds, or if it cannot be read. The caller should then parse
+             * the map file.
+             *
+             * @param mapPath the path of the map file
+             * @param mapContents the current contents of the map file
+             * @param format the format of the map file
+             * @param worldBounds the world bounds
+             * @param status the parser status
+             * @return the world node or null
+             */
+            std::unique_ptr<Model::WorldNode> read(const Path& mapPath, std::string_view mapContents, Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #include "Ensure.h"
 #include "Exceptions.h"
 #include "Macros.h"
+#include "IO/NumberCodec.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityNode.h"
@@ -37,38 +38,67 @@
 
 #include <fmt/format.h>
 
-#include <iterator> // for std::ostreambuf_iterator
+#include <iterator> // for std::ostreambuf_iterator, std::back_inserter
 #include <memory>
+#include <string>
 #include <utility> // for std::pair
 #include <vector>
-#include <sstream>
 
 namespace TrenchBroom {
     namespace IO {
+        // enough for a face with three points with fractional coordinates and a long texture name
+        static constexpr size_t BrushFaceBufferSize = 256;
+
+        static void appendPoint(std::string& buffer, const vm::vec3& point) {
+            buffer += "( ";
+            appendNumber(buffer, point.x());
+            buffer += ' ';
+            appendNumber(buffer, point.y());
+            buffer += ' ';
+            appendNumber(buffer, point.z());
+            buffer += " )";
+        }
+
+        static void appendTextureAxis(std::string& buffer, const vm::vec3& axis, const float offset) {
+            buffer += "[ ";
+            appendNumber(buffer, axis.x());
+            buffer += ' ';
+            appendNumber(buffer, axis.y());
+            buffer += ' ';
+            appendNumber(buffer, axis.z());
+            buffer += ' ';
+            appendNumber(buffer, offset);
+            buffer += " ]";
+        }
+
+        static void appendRotationAndScale(std::string& buffer, const Model::BrushFaceAttributes& attributes) {
+            buffer += ' ';
+            appendNumber(buffer, attributes.rotation());
+            buffer += ' ';
+            appendNumber(buffer, attributes.xScale());
+            buffer += ' ';
+            appendNumber(buffer, attributes.yScale());
+        }
+
         class QuakeFileSerializer : public MapFileSerializer {
         public:
             explicit QuakeFileSerializer(std::ostream& stream) :
             MapFileSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                buffer += '\n';
             }
         protected:
-            void writeFacePoints(std::ostream& stream, const Model::BrushFace& face) const {
+            void writeFacePoints(std::string& buffer, const Model::BrushFace& face) const {
                 const Model::BrushFace::Points& points = face.points();
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "( {} {} {} ) ( {} {} {} ) ( {} {} {} )",
-                               points[0].x(),
-                               points[0].y(),
-                               points[0].z(),
-                               points[1].x(),
-                               points[1].y(),
-                               points[1].z(),
-                               points[2].x(),
-                               points[2].y(),
-                               points[2].z());
+                appendPoint(buffer, points[0]);
+                buffer += ' ';
+                appendPoint(buffer, points[1]);
+                buffer += ' ';
+                appendPoint(buffer, points[2]);
             }
 
             static bool shouldQuoteTextureName(const std::string& textureName) {
@@ -79,39 +109,30 @@ namespace TrenchBroom {
                 return "\"" + kdl::str_escape(textureName, "\"") + "\"";
             }
 
-            void writeTextureInfo(std::ostream& stream, const Model::BrushFace& face) const {
+            void writeTextureInfo(std::string& buffer, const Model::BrushFace& face) const {
                 const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), " {} {} {} {} {} {}",
-                               shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName,
-                               face.attributes().xOffset(),
-                               face.attributes().yOffset(),
-                               face.attributes().rotation(),
-                               face.attributes().xScale(),
-                               face.attributes().yScale());
+                buffer += ' ';
+                buffer += shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName;
+                buffer += ' ';
+                appendNumber(buffer, face.attributes().xOffset());
+                buffer += ' ';
+                appendNumber(buffer, face.attributes().yOffset());
+                appendRotationAndScale(buffer, face.attributes());
             }
 
-            void writeValveTextureInfo(std::ostream& stream, const Model::BrushFace& face) const {
+            void writeValveTextureInfo(std::string& buffer, const Model::BrushFace& face) const {
                 const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
                 const vm::vec3 xAxis = face.textureXAxis();
                 const vm::vec3 yAxis = face.textureYAxis();
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), " {} [ {} {} {} {} ] [ {} {} {} {} ] {} {} {}",
-                               textureName,
-
-                               xAxis.x(),
-                               xAxis.y(),
-                               xAxis.z(),
-                               face.attributes().xOffset(),
-
-                               yAxis.x(),
-                               yAxis.y(),
-                               yAxis.z(),
-                               face.attributes().yOffset(),
-
-                               face.attributes().rotation(),
-                               face.attributes().xScale(),
-                               face.attributes().yScale());
+                buffer += ' ';
+                buffer += textureName;
+                buffer += ' ';
+                appendTextureAxis(buffer, xAxis, face.attributes().xOffset());
+                buffer += ' ';
+                appendTextureAxis(buffer, yAxis, face.attributes().yOffset());
+                appendRotationAndScale(buffer, face.attributes());
             }
         };
 
@@ -120,19 +141,19 @@ namespace TrenchBroom {
             explicit Quake2FileSerializer(std::ostream& stream) :
             QuakeFileSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 // Neverball's "mapc" doesn't like it if surface attributes aren't present.
                 // This suggests the Radiants always output these, so it's probably a compatibility danger.
-                writeSurfaceAttributes(stream, face);
+                writeSurfaceAttributes(buffer, face);
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+                buffer += '\n';
             }
         protected:
-            void writeSurfaceAttributes(std::ostream& stream, const Model::BrushFace& face) const {
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), " {} {} {}",
+            void writeSurfaceAttributes(std::string& buffer, const Model::BrushFace& face) const {
+                fmt::format_to(std::back_inserter(buffer), " {} {} {}",
                                face.attributes().surfaceContents(),
                                face.attributes().surfaceFlags(),
                                face.attributes().surfaceValue());
@@ -144,12 +165,12 @@ namespace TrenchBroom {
             explicit Quake2ValveFileSerializer(std::ostream& stream) :
             Quake2FileSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                writeSurfaceAttributes(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                writeSurfaceAttributes(buffer, face);
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+                buffer += '\n';
             }
         };
 
@@ -161,22 +182,22 @@ namespace TrenchBroom {
             Quake2FileSerializer(stream),
             SurfaceColorFormat(" %d %d %d") {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor()) {
-                    writeSurfaceAttributes(stream, face);
+                    writeSurfaceAttributes(buffer, face);
                 }
                 if (face.attributes().hasColor()) {
-                    writeSurfaceColor(stream, face);
+                    writeSurfaceColor(buffer, face);
                 }
 
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+                buffer += '\n';
             }
         protected:
-            void writeSurfaceColor(std::ostream& stream, const Model::BrushFace& face) const {
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), " {} {} {}",
+            void writeSurfaceColor(std::string& buffer, const Model::BrushFace& face) const {
+                fmt::format_to(std::back_inserter(buffer), " {} {} {}",
                                static_cast<int>(face.attributes().color().r()),
                                static_cast<int>(face.attributes().color().g()),
                                static_cast<int>(face.attributes().color().b()));
@@ -188,10 +209,10 @@ namespace TrenchBroom {
             explicit Hexen2FileSerializer(std::ostream& stream):
             QuakeFileSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), " 0\n"); // extra value written here
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                buffer += " 0\n"; // extra value written here
             }
         };
 
@@ -200,10 +221,10 @@ namespace TrenchBroom {
             explicit ValveFileSerializer(std::ostream& stream) :
             QuakeFileSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                buffer += '\n';
             }
         };
 
@@ -308,7 +329,10 @@ namespace TrenchBroom {
 
         void MapFileSerializer::doBrushFace(const Model::BrushFace& face) {
             const size_t lines = 1u;
-            doWriteBrushFace(m_stream, face);
+            std::string buffer;
+            buffer.reserve(BrushFaceBufferSize);
+            doWriteBrushFace(buffer, face);
+            m_stream << buffer;
             face.setFilePosition(m_line, lines);
             m_line += lines;
         }
@@ -329,11 +353,12 @@ namespace TrenchBroom {
          * Threadsafe
          */
         std::string MapFileSerializer::writeBrushFaces(const Model::Brush& brush) const {
-            std::stringstream stream;
+            std::string buffer;
+            buffer.reserve(brush.faceCount() * BrushFaceBufferSize);
             for (const Model::BrushFace& face : brush.faces()) {
-                doWriteBrushFace(stream, face);
+                doWriteBrushFace(buffer, face);
             }
-            return stream.str();
+            return buffer;
         }
     }
 }
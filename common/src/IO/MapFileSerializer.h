@@ -24,6 +24,7 @@
 
 #include <iosfwd>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -60,7 +61,7 @@ namespace TrenchBroom {
             void setFilePosition(const Model::Node* node);
             size_t startLine();
         private: // threadsafe
-            virtual void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const = 0;
+            virtual void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const = 0;
             std::string writeBrushFaces(const Model::Brush& brush) const;
         };
     }
@@ -72,6 +72,12 @@ namespace TrenchBroom {
             parseBrushFaces(status);
         }
 
+        void MapReader::readObjects(std::vector<ObjectInfo> objectInfos, const vm::bbox3& worldBounds, ParserStatus& status) {
+            m_worldBounds = worldBounds;
+            m_objectInfos = std::move(objectInfos);
+            createNodes(status);
+        }
+
         // implement MapParser interface
 
         void MapReader::onBeginEntity(const size_t /* line */, std::vector<Model::EntityProperty> properties, ParserStatus& /* status */) {
@@ -91,7 +97,7 @@ namespace TrenchBroom {
         }
 
         void MapReader::onBeginBrush(const size_t /* line */, ParserStatus& /* status */) {
-            m_objectInfos.push_back(BrushInfo{{}, 0, 0, m_currentEntityInfo});
+            m_objectInfos.push_back(BrushInfo{{}, 0, 0, m_currentEntityInfo, nullptr});
         }
 
         void MapReader::onEndBrush(const size_t startLine, const size_t lineCount, ParserStatus& /* status */) {
@@ -184,7 +190,7 @@ namespace TrenchBroom {
          * added to the given vector of node issues and an empty optional is returned.
          */
         static std::optional<ContainerInfo> extractContainerInfo(const std::vector<Model::EntityProperty>& properties, std::vector<NodeIssue>& nodeIssues) {
-            const std::string& parentLayerIdStr = findProperty(properties, Model::PropertyKeys::Layer);
+            const std::string& parentLayerIdStr = findProperty(properties, Model::InternedPropertyKeys::Layer);
             if (!kdl::str_is_blank(parentLayerIdStr)) {
                 const auto rawParentLayerId = kdl::str_to_long(parentLayerIdStr);
                 if (rawParentLayerId && *rawParentLayerId >= 0) {
@@ -196,7 +202,7 @@ namespace TrenchBroom {
                 return std::nullopt;
             }
 
-            const std::string& parentGroupIdStr = findProperty(properties, Model::PropertyKeys::Group);
+            const std::string& parentGroupIdStr = findProperty(properties, Model::InternedPropertyKeys::Group);
             if (!kdl::str_is_blank(parentGroupIdStr)) {
                 const auto rawParentGroupId = kdl::str_to_long(parentGroupIdStr);
                 if (rawParentGroupId && *rawParentGroupId >= 0) {
@@ -264,12 +270,12 @@ namespace TrenchBroom {
         static CreateNodeResult createLayerNode(const MapReader::EntityInfo& entityInfo) {
             const auto& properties = entityInfo.properties;
 
-            const std::string& name = findProperty(properties, Model::PropertyKeys::LayerName);
+            const std::string& name = findProperty(properties, Model::InternedPropertyKeys::LayerName);
             if (kdl::str_is_blank(name)) {
                 return NodeError{entityInfo.startLine, "Skipping layer entity: missing name"};
             }
 
-            const std::string& idStr = findProperty(properties, Model::PropertyKeys::LayerId);
+            const std::string& idStr = findProperty(properties, Model::InternedPropertyKeys::LayerId);
             if (kdl::str_is_blank(idStr)) {
                 return NodeError{entityInfo.startLine, "Skipping layer entity: missing id"};
             }
@@ -282,11 +288,11 @@ namespace TrenchBroom {
 
             Model::Layer layer = Model::Layer(name);
             // This is optional (not present on maps saved in TB 2020.1 and earlier)
-            if (const auto layerSortIndex = kdl::str_to_int(findProperty(properties, Model::PropertyKeys::LayerSortIndex))) {
+            if (const auto layerSortIndex = kdl::str_to_int(findProperty(properties, Model::InternedPropertyKeys::LayerSortIndex))) {
                 layer.setSortIndex(*layerSortIndex);
             }
 
-            if (findProperty(properties, Model::PropertyKeys::LayerOmitFromExport) == Model::PropertyValues::LayerOmitFromExportValue) {
+            if (findProperty(properties, Model::InternedPropertyKeys::LayerOmitFromExport) == Model::PropertyValues::LayerOmitFromExportValue) {
                 layer.setOmitFromExport(true);
             }
 
@@ -296,10 +302,10 @@ namespace TrenchBroom {
             const Model::IdType layerId = static_cast<Model::IdType>(*rawId);
             layerNode->setPersistentId(layerId);
 
-            if (findProperty(properties, Model::PropertyKeys::LayerLocked) == Model::PropertyValues::LayerLockedValue) {
+            if (findProperty(properties, Model::InternedPropertyKeys::LayerLocked) == Model::PropertyValues::LayerLockedValue) {
                 layerNode->setLockState(Model::LockState::Lock_Locked);
             }
-            if (findProperty(properties, Model::PropertyKeys::LayerHidden) == Model::PropertyValues::LayerHiddenValue) {
+            if (findProperty(properties, Model::InternedPropertyKeys::LayerHidden) == Model::PropertyValues::LayerHiddenValue) {
                 layerNode->setVisibilityState(Model::VisibilityState::Visibility_Hidden);
             }
 
@@ -314,12 +320,12 @@ namespace TrenchBroom {
          * Creates a group node for the given entity info. Returns an error if the entity attributes contain missing or invalid information.
          */
         static CreateNodeResult createGroupNode(const MapReader::EntityInfo& entityInfo) {
-            const std::string& name = findProperty(entityInfo.properties, Model::PropertyKeys::GroupName);
+            const std::string& name = findProperty(entityInfo.properties, Model::InternedPropertyKeys::GroupName);
             if (kdl::str_is_blank(name)) {
                 return NodeError{entityInfo.startLine, "Skipping group entity: missing name"};
             }
 
-            const std::string& idStr = findProperty(entityInfo.properties, Model::PropertyKeys::GroupId);
+            const std::string& idStr = findProperty(entityInfo.properties, Model::InternedPropertyKeys::GroupId);
             if (kdl::str_is_blank(idStr)) {
                 return NodeError{entityInfo.startLine, "Skipping group entity: missing id"};
             }
@@ -332,9 +338,9 @@ namespace TrenchBroom {
             auto group = Model::Group{name};
             auto nodeIssues = std::vector<NodeIssue>{};
 
-            const std::string& linkedGroupId = findProperty(entityInfo.properties, Model::PropertyKeys::LinkedGroupId);
+            const std::string& linkedGroupId = findProperty(entityInfo.properties, Model::InternedPropertyKeys::LinkedGroupId);
             if (!linkedGroupId.empty()) {
-                const std::string& transformationStr = findProperty(entityInfo.properties, Model::PropertyKeys::GroupTransformation);
+                const std::string& transformationStr = findProperty(entityInfo.properties, Model::InternedPropertyKeys::GroupTransformation);
                 if (const auto transformation = vm::parse<FloatType, 4u, 4u>(transformationStr)) {
                     group.setLinkedGroupId(linkedGroupId);
                     group.setTransformation(*transformation);
@@ -392,7 +398,7 @@ namespace TrenchBroom {
          * Returns an error if the node could not be created.
          */
         static CreateNodeResult createNodeFromEntityInfo(MapReader::EntityInfo entityInfo, const Model::MapFormat mapFormat) {
-            const auto& classname = findProperty(entityInfo.properties, Model::PropertyKeys::Classname);
+            const auto& classname = findProperty(entityInfo.properties, Model::InternedPropertyKeys::Classname);
             if (isWorldspawn(classname, entityInfo.properties)) {
                 return createWorldNode(std::move(entityInfo), mapFormat);
             } else if (isLayer(classname, entityInfo.properties)) {
@@ -408,7 +414,10 @@ namespace TrenchBroom {
          * Creates a brush node from the given brush info. Returns an error if the brush could not be created.
          */
         static CreateNodeResult createBrushNode(MapReader::BrushInfo brushInfo, const vm::bbox3& worldBounds) {
-            return Model::Brush::create(worldBounds, std::move(brushInfo.faces))
+            auto brushResult = brushInfo.geometry != nullptr
+                ? Model::Brush::create(std::move(brushInfo.faces), std::move(brushInfo.geometry))
+                : Model::Brush::create(worldBounds, std::move(brushInfo.faces));
+            return std::move(brushResult)
                 .and_then([&](Model::Brush&& brush) {
                     auto brushNode = std::make_unique<Model::BrushNode>(std::move(brush));
                     brushNode->setFilePosition(brushInfo.startLine, brushInfo.lineCount);
@@ -23,6 +23,7 @@
 #include "IO/StandardMapParser.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
 #include "Model/IdType.h"
 
 #include <kdl/result.h>
@@ -30,6 +31,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
 
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <variant>
@@ -80,6 +82,12 @@ namespace TrenchBroom {
                 size_t startLine;
                 size_t lineCount;
                 std::optional<size_t> parentIndex;
+                /**
+                 * The geometry of the brush if it is already known, e.g. because it was restored from a cache. If
+                 * given, the faces are expected in the order of the geometry's faces and the geometry is not
+                 * recomputed.
+                 */
+                std::unique_ptr<Model::BrushGeometry> geometry;
             };
 
             using ObjectInfo = std::variant<EntityInfo, BrushInfo>;
@@ -117,6 +125,11 @@ namespace TrenchBroom {
              * @throws ParserException if parsing fails
              */
             void readBrushFaces(const vm::bbox3& worldBounds, ParserStatus& status);
+            /**
+             * Creates nodes from the given object infos instead of parsing them, e.g. because they were restored from
+             * a cache.
+             */
+            void readObjects(std::vector<ObjectInfo> objectInfos, const vm::bbox3& worldBounds, ParserStatus& status);
         protected: // implement MapParser interface
             void onBeginEntity(size_t line, std::vector<Model::EntityProperty> properties, ParserStatus& status) override;
             void onEndEntity(size_t startLine, size_t lineCount, ParserStatus& status) override;
@@ -203,14 +203,11 @@ namespace TrenchBroom {
 
         Md2Parser::Md2Frame::Md2Frame(const size_t vertexCount) :
         name(""),
-        vertices(vertexCount) {}
+        vertices(vertexCount),
+        positions(vertexCount) {}
 
-        vm::vec3f Md2Parser::Md2Frame::vertex(const size_t index) const {
-            const Md2Vertex& vertex = vertices[index];
-            const vm::vec3f position(static_cast<float>(vertex.x),
-                                 static_cast<float>(vertex.y),
-                                 static_cast<float>(vertex.z));
-            return position * scale + offset;
+        const vm::vec3f& Md2Parser::Md2Frame::vertex(const size_t index) const {
+            return positions[index];
         }
 
         const vm::vec3f& Md2Parser::Md2Frame::normal(const size_t index) const {
@@ -319,11 +316,13 @@ namespace TrenchBroom {
             frame.offset = reader.readVec<float,3>();
             frame.name = reader.readString(Md2Layout::FrameNameLength);
 
+            static_assert(sizeof(Md2Vertex) == 4, "MD2 vertices must be tightly packed");
+            reader.read(reinterpret_cast<char*>(frame.vertices.data()), vertexCount * sizeof(Md2Vertex));
+
+            // unpack all positions in a single branch free loop, which the compiler can vectorize
             for (size_t i = 0; i < vertexCount; ++i) {
-                frame.vertices[i].x = reader.readUnsignedChar<char>();
-                frame.vertices[i].y = reader.readUnsignedChar<char>();
-                frame.vertices[i].z = reader.readUnsignedChar<char>();
-                frame.vertices[i].normalIndex = reader.readUnsignedChar<char>();
+                const auto& vertex = frame.vertices[i];
+                frame.positions[i] = vm::vec3f(static_cast<float>(vertex.x), static_cast<float>(vertex.y), static_cast<float>(vertex.z)) * frame.scale + frame.offset;
             }
 
             return frame;
@@ -395,7 +394,7 @@ namespace TrenchBroom {
             result.reserve(meshVertices.size());
 
             for (const Md2MeshVertex& md2MeshVertex : meshVertices) {
-                const auto position = frame.vertex(md2MeshVertex.vertexIndex);
+                const auto& position = frame.vertex(md2MeshVertex.vertexIndex);
                 const auto& texCoords = md2MeshVertex.texCoords;
 
                 result.emplace_back(position, texCoords);
@@ -62,9 +62,10 @@ namespace TrenchBroom {
                 vm::vec3f offset;
                 std::string name;
                 Md2VertexList vertices;
+                std::vector<vm::vec3f> positions;
 
                 explicit Md2Frame(size_t vertexCount);
-                vm::vec3f vertex(size_t index) const;
+                const vm::vec3f& vertex(size_t index) const;
                 const vm::vec3f& normal(size_t index) const;
             };
 
@@ -19,6 +19,7 @@
 
 #include "Md3Parser.h"
 
+#include "Exceptions.h"
 #include "Logger.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Texture.h"
@@ -26,9 +27,12 @@
 #include "IO/Reader.h"
 #include "IO/ResourceUtils.h"
 #include "IO/SkinLoader.h"
-#include "Renderer/IndexRangeMapBuilder.h"
+#include "Renderer/IndexRangeMap.h"
 #include "Renderer/PrimType.h"
 
+#include <kdl/parallel.h>
+
+#include <optional>
 #include <string>
 
 namespace TrenchBroom {
@@ -48,6 +52,7 @@ namespace TrenchBroom {
             static const size_t TexCoordLength = 2 * sizeof(float);
             static const size_t VertexLength = 4 * sizeof(int16_t);
             static const float VertexScale = 1.0f / 64.0f;
+            static const size_t MinParallelVertexCount = 4096;
         }
 
         Md3Parser::Md3Parser(const std::string& name, const char* begin, const char* end, const FileSystem& fs) :
@@ -161,6 +166,19 @@ namespace TrenchBroom {
         }
 
         void Md3Parser::parseFrameSurfaces(Reader reader, Assets::EntityModelLoadedFrame& frame, Assets::EntityModel& model) {
+            struct FrameSurface {
+                size_t vertexCount;
+                size_t triangleCount;
+                Reader vertexReader;
+                Reader texCoordReader;
+                Reader triangleReader;
+            };
+
+            // Read the surface headers first so that the surfaces can be decoded independently of each other.
+            auto surfaceIndices = std::vector<size_t>{};
+            auto frameSurfaces = std::vector<FrameSurface>{};
+            size_t totalVertexCount = 0;
+
             for (size_t i = 0; i < model.surfaceCount(); ++i) {
                 const auto ident = reader.readInt<int32_t>();
 
@@ -185,27 +203,66 @@ namespace TrenchBroom {
                     const auto frameVertexLength = vertexCount * Md3Layout::VertexLength;
                     const auto frameVertexOffset = vertexOffset + frame.index() * frameVertexLength;
 
-                    const auto vertexPositions = parseVertexPositions(reader.subReaderFromBegin(frameVertexOffset, frameVertexLength), vertexCount);
-                    const auto texCoords = parseTexCoords(reader.subReaderFromBegin(texCoordOffset, vertexCount * Md3Layout::TexCoordLength), vertexCount);
+                    surfaceIndices.push_back(i);
+                    frameSurfaces.push_back(FrameSurface{
+                        vertexCount,
+                        triangleCount,
+                        reader.subReaderFromBegin(frameVertexOffset, frameVertexLength),
+                        reader.subReaderFromBegin(texCoordOffset, vertexCount * Md3Layout::TexCoordLength),
+                        reader.subReaderFromBegin(triangleOffset, triangleCount * Md3Layout::TriangleLength)
+                    });
+                    totalVertexCount += vertexCount;
+                }
+
+                reader = reader.subReaderFromBegin(endOffset);
+            }
+
+            // exceptions must not escape the worker threads, so failures are recorded as empty results
+            const auto decodeSurface = [&](FrameSurface&& frameSurface) -> std::optional<std::vector<Assets::EntityModelVertex>> {
+                try {
+                    const auto vertexPositions = parseVertexPositions(std::move(frameSurface.vertexReader), frameSurface.vertexCount);
+                    const auto texCoords = parseTexCoords(std::move(frameSurface.texCoordReader), frameSurface.vertexCount);
                     const auto vertices = buildVertices(vertexPositions, texCoords);
 
-                    const auto triangles = parseTriangles(reader.subReaderFromBegin(triangleOffset, triangleCount * Md3Layout::TriangleLength), triangleCount);
+                    const auto triangles = parseTriangles(std::move(frameSurface.triangleReader), frameSurface.triangleCount);
+                    return buildFrameSurfaceVertices(triangles, vertices);
+                } catch (const ReaderException&) {
+                    return std::nullopt;
+                }
+            };
+
+            // spawning the worker threads only pays off for models with several large surfaces
+            auto surfaceVertices = std::vector<std::optional<std::vector<Assets::EntityModelVertex>>>{};
+            if (frameSurfaces.size() > 1u && totalVertexCount >= Md3Layout::MinParallelVertexCount) {
+                surfaceVertices = kdl::vec_parallel_transform(std::move(frameSurfaces), decodeSurface);
+            } else {
+                for (auto& frameSurface : frameSurfaces) {
+                    surfaceVertices.push_back(decodeSurface(std::move(frameSurface)));
+                }
+            }
 
-                    auto& surface = model.surface(i);
-                    buildFrameSurface(frame, surface, triangles, vertices);
+            for (size_t i = 0; i < surfaceIndices.size(); ++i) {
+                auto& surface = model.surface(surfaceIndices[i]);
+                const auto& vertices = surfaceVertices[i];
+                if (!vertices) {
+                    throw AssetException("Could not decode MD3 surface '" + surface.name() + "'");
                 }
 
-                reader = reader.subReaderFromBegin(endOffset);
+                const auto rangeMap = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, vertices->size());
+                surface.addIndexedMesh(frame, *vertices, rangeMap);
             }
         }
 
         std::vector<Md3Parser::Md3Triangle> Md3Parser::parseTriangles(Reader reader, const size_t triangleCount) {
+            auto indices = std::vector<int32_t>(3 * triangleCount);
+            reader.read(reinterpret_cast<char*>(indices.data()), indices.size() * sizeof(int32_t));
+
             std::vector<Md3Triangle> result;
             result.reserve(triangleCount);
             for (size_t i = 0; i < triangleCount; ++i) {
-                const auto i1 = reader.readSize<int32_t>();
-                const auto i2 = reader.readSize<int32_t>();
-                const auto i3 = reader.readSize<int32_t>();
+                const auto i1 = static_cast<size_t>(indices[3 * i + 0]);
+                const auto i2 = static_cast<size_t>(indices[3 * i + 1]);
+                const auto i3 = static_cast<size_t>(indices[3 * i + 2]);
                 result.push_back(Md3Triangle {i1, i2, i3});
             }
             return result;
@@ -223,26 +280,26 @@ namespace TrenchBroom {
         }
 
         std::vector<vm::vec3f> Md3Parser::parseVertexPositions(Reader reader, const size_t vertexCount) {
-            std::vector<vm::vec3f> result;
-            result.reserve(vertexCount);
+            static_assert(Md3Layout::VertexLength == 4 * sizeof(int16_t), "MD3 vertices must consist of four 16 bit values");
+            auto packedVertices = std::vector<int16_t>(4 * vertexCount);
+            reader.read(reinterpret_cast<char*>(packedVertices.data()), packedVertices.size() * sizeof(int16_t));
+
+            // unpack all positions in a single branch free loop, which the compiler can vectorize; the packed normals
+            // are not needed because entity models are rendered without lighting
+            auto result = std::vector<vm::vec3f>(vertexCount);
             for (size_t i = 0; i < vertexCount; ++i) {
-                const auto x = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-                const auto y = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-                const auto z = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-                /* const auto n = */ reader.readInt<int16_t>();
-                result.emplace_back(x, y, z);
+                result[i] = vm::vec3f(
+                    static_cast<float>(packedVertices[4 * i + 0]),
+                    static_cast<float>(packedVertices[4 * i + 1]),
+                    static_cast<float>(packedVertices[4 * i + 2])) * Md3Layout::VertexScale;
             }
             return result;
         }
 
         std::vector<vm::vec2f> Md3Parser::parseTexCoords(Reader reader, const size_t vertexCount) {
-            std::vector<vm::vec2f> result;
-            result.reserve(vertexCount);
-            for (size_t i = 0; i < vertexCount; ++i) {
-                const auto s = reader.readFloat<float>();
-                const auto t = reader.readFloat<float>();
-                result.emplace_back(s, t);
-            }
+            static_assert(sizeof(vm::vec2f) == Md3Layout::TexCoordLength, "texture coordinates must be tightly packed");
+            auto result = std::vector<vm::vec2f>(vertexCount);
+            reader.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(vm::vec2f));
             return result;
         }
 
@@ -277,10 +334,9 @@ namespace TrenchBroom {
             return IO::loadShader(shaderPath, m_fs, logger);
         }
 
-        void Md3Parser::buildFrameSurface(Assets::EntityModelLoadedFrame& frame, Assets::EntityModelSurface& surface, const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModelVertex>& vertices) {
+        std::vector<Assets::EntityModelVertex> Md3Parser::buildFrameSurfaceVertices(const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModelVertex>& vertices) {
             using Vertex = Assets::EntityModelVertex;
 
-            const auto rangeMap = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, 3 * triangles.size());
             std::vector<Vertex> frameVertices;
             frameVertices.reserve(3 * triangles.size());
 
@@ -300,7 +356,7 @@ namespace TrenchBroom {
                 frameVertices.push_back(v3);
             }
 
-            surface.addIndexedMesh(frame, frameVertices, rangeMap);
+            return frameVertices;
         }
     }
 }
@@ -67,7 +67,7 @@ namespace TrenchBroom {
             void loadSurfaceSkins(Assets::EntityModelSurface& surface, const std::vector<Path>& shaders, Logger& logger);
             Assets::Texture loadShader(Logger& logger, const Path& path) const;
             
-            void buildFrameSurface(Assets::EntityModelLoadedFrame& frame, Assets::EntityModelSurface& surface, const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModelVertex>& vertices);
+            std::vector<Assets::EntityModelVertex> buildFrameSurfaceVertices(const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModelVertex>& vertices);
         };
     }
 }
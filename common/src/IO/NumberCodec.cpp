@@ -0,0 +1,303 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberCodec.h"
+
+#include "Macros.h"
+
+#include <kdl/string_utils.h>
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+
+#if !defined(__cpp_lib_to_chars)
+#include <locale>
+#include <sstream>
+#endif
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr double PowersOfTen[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        // the largest integer such that it and all smaller integers are exactly representable as a double
+        static constexpr std::uint64_t MaxExactMantissa = std::uint64_t(1) << 53;
+
+        enum class DecimalScan {
+            // the string is not a plain decimal number
+            Invalid,
+            // the string is a plain decimal number that cannot be converted exactly using the fast path
+            Slow,
+            // the string is a plain decimal number, and the value has been computed
+            Exact
+        };
+
+        /**
+         * Converts strings of the form [+-]digits[.digits][(e|E)[+-]digits]. If the mantissa fits into 53 bits and the
+         * decimal exponent is small enough, both are exactly representable as doubles, and a single multiplication or
+         * division yields the correctly rounded value (Clinger's fast path).
+         */
+        static DecimalScan scanDecimal(const char* cur, const char* end, double& result) {
+            bool negative = false;
+            if (cur < end && (*cur == '-' || *cur == '+')) {
+                negative = *cur == '-';
+                ++cur;
+            }
+
+            std::uint64_t mantissa = 0;
+            int digits = 0;
+            int significantDigits = 0;
+            int exponent = 0;
+            // the whole string must be scanned before deciding that it needs the slow path
+            bool slow = false;
+
+            for (; cur < end && *cur >= '0' && *cur <= '9'; ++cur, ++digits) {
+                if (mantissa != 0 || *cur != '0') {
+                    if (++significantDigits > 19) {
+                        slow = true;
+                    } else {
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*cur - '0');
+                    }
+                }
+            }
+            if (cur < end && *cur == '.') {
+                for (++cur; cur < end && *cur >= '0' && *cur <= '9'; ++cur, ++digits) {
+                    if (mantissa != 0 || *cur != '0') {
+                        if (++significantDigits > 19) {
+                            slow = true;
+                        } else {
+                            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*cur - '0');
+                        }
+                    }
+                    --exponent;
+                }
+            }
+            if (digits == 0) {
+                return DecimalScan::Invalid;
+            }
+
+            if (cur < end && (*cur == 'e' || *cur == 'E')) {
+                ++cur;
+                bool negativeExponent = false;
+                if (cur < end && (*cur == '-' || *cur == '+')) {
+                    negativeExponent = *cur == '-';
+                    ++cur;
+                }
+                if (cur == end || *cur < '0' || *cur > '9') {
+                    return DecimalScan::Invalid;
+                }
+
+                int explicitExponent = 0;
+                for (; cur < end && *cur >= '0' && *cur <= '9'; ++cur) {
+                    if (explicitExponent > 9999) {
+                        slow = true;
+                    } else {
+                        explicitExponent = explicitExponent * 10 + (*cur - '0');
+                    }
+                }
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            }
+            if (cur != end) {
+                return DecimalScan::Invalid;
+            }
+
+            if (slow || mantissa > MaxExactMantissa || exponent < -22 || exponent > 22) {
+                return DecimalScan::Slow;
+            }
+
+            const auto value = static_cast<double>(mantissa);
+            result = exponent < 0 ? value / PowersOfTen[-exponent] : value * PowersOfTen[exponent];
+            if (negative) {
+                result = -result;
+            }
+            return DecimalScan::Exact;
+        }
+
+        static bool isDigit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        /**
+         * Returns whether the mantissa of the given plain decimal number has a non-zero digit.
+         */
+        static bool hasNonZeroMantissa(const char* cur, const char* end) {
+            for (; cur < end && *cur != 'e' && *cur != 'E'; ++cur) {
+                if (*cur >= '1' && *cur <= '9') {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Converts a plain decimal number that is not handled by the fast path. Neither std::from_chars nor a stream
+         * imbued with the classic locale depend on the current locale. Like std::stod, this rejects results that
+         * overflow or underflow.
+         */
+        static std::optional<double> convertDecimal(const char* begin, const char* end) {
+            // std::from_chars does not accept a leading plus sign
+            if (*begin == '+') {
+                ++begin;
+            }
+
+            double result;
+#if defined(__cpp_lib_to_chars)
+            const auto [ptr, ec] = std::from_chars(begin, end, result);
+            if (ec != std::errc() || ptr != end) {
+                return std::nullopt;
+            }
+#else
+            auto stream = std::istringstream(std::string(begin, end));
+            stream.imbue(std::locale::classic());
+            if (!(stream >> result)) {
+                return std::nullopt;
+            }
+#endif
+
+            if (std::fpclassify(result) == FP_SUBNORMAL || (result == 0.0 && hasNonZeroMantissa(begin, end))) {
+                return std::nullopt;
+            }
+            return result;
+        }
+
+        static bool startsWithIgnoringCase(const char* cur, const char* end, const std::string_view prefix) {
+            if (static_cast<size_t>(end - cur) < prefix.size()) {
+                return false;
+            }
+            for (const auto c : prefix) {
+                if ((*cur++ | 0x20) != c) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Interprets the longest plain decimal number at the start of the given string like std::stod does, but
+         * independently of the current locale.
+         */
+        static std::optional<double> parseDecimalPrefix(const char* cur, const char* end) {
+            while (cur < end && (*cur == ' ' || (*cur >= '\t' && *cur <= '\r'))) {
+                ++cur;
+            }
+
+            const auto* begin = cur;
+            if (cur < end && (*cur == '-' || *cur == '+')) {
+                ++cur;
+            }
+
+            if (startsWithIgnoringCase(cur, end, "inf")) {
+                return *begin == '-' ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            } else if (startsWithIgnoringCase(cur, end, "nan")) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+
+            int digits = 0;
+            for (; cur < end && isDigit(*cur); ++cur, ++digits);
+            if (cur < end && *cur == '.') {
+                for (++cur; cur < end && isDigit(*cur); ++cur, ++digits);
+            }
+            if (digits == 0) {
+                return std::nullopt;
+            }
+
+            // an exponent is only part of the number if it has digits
+            if (cur < end && (*cur == 'e' || *cur == 'E')) {
+                auto* exponent = cur + 1;
+                if (exponent < end && (*exponent == '-' || *exponent == '+')) {
+                    ++exponent;
+                }
+                if (exponent < end && isDigit(*exponent)) {
+                    for (cur = exponent; cur < end && isDigit(*cur); ++cur);
+                }
+            }
+
+            double result;
+            if (scanDecimal(begin, cur, result) == DecimalScan::Exact) {
+                return result;
+            }
+            return convertDecimal(begin, cur);
+        }
+
+        std::optional<double> parseDouble(const std::string_view str) {
+            const auto* begin = str.data();
+            const auto* end = str.data() + str.size();
+
+            double result;
+            switch (scanDecimal(begin, end, result)) {
+                case DecimalScan::Exact:
+                    return result;
+                case DecimalScan::Slow:
+                    return convertDecimal(begin, end);
+                case DecimalScan::Invalid:
+                    return parseDecimalPrefix(begin, end);
+                switchDefault();
+            }
+        }
+
+        std::optional<long> parseLong(const std::string_view str) {
+            const auto* begin = str.data();
+            const auto* end = str.data() + str.size();
+
+            // std::from_chars does not accept a leading plus sign
+            if (end - begin > 1 && *begin == '+' && *(begin + 1) >= '0' && *(begin + 1) <= '9') {
+                ++begin;
+            }
+
+            long result;
+            const auto [ptr, ec] = std::from_chars(begin, end, result);
+            if (ec == std::errc() && ptr == end) {
+                return result;
+            }
+
+            return kdl::str_to_long(std::string(str));
+        }
+
+        /**
+         * Integral values whose magnitude is below the given limit have no shorter representation than their integer
+         * digits, and they are formatted much faster as integers than as floating point numbers. Negative zero must
+         * still be written as "-0".
+         */
+        template <typename T>
+        static void appendFloatingPoint(std::string& buffer, const T value, const T exactIntegerLimit) {
+            if (std::abs(value) < exactIntegerLimit && value == std::trunc(value) && !(value == T(0) && std::signbit(value))) {
+                const auto formatted = fmt::format_int(static_cast<long long>(value));
+                buffer.append(formatted.data(), formatted.size());
+            } else {
+                fmt::format_to(std::back_inserter(buffer), "{}", value);
+            }
+        }
+
+        void appendNumber(std::string& buffer, const double value) {
+            appendFloatingPoint(buffer, value, static_cast<double>(MaxExactMantissa));
+        }
+
+        void appendNumber(std::string& buffer, const float value) {
+            appendFloatingPoint(buffer, value, static_cast<float>(1 << 24));
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Parses the given string as a decimal floating point number. The result is correctly rounded and does not
+         * depend on the current locale.
+         *
+         * Strings of the form [+-]digits[.digits][(e|E)[+-]digits] are converted without allocating. Any other string
+         * is interpreted like std::stod would interpret it in the classic locale: leading whitespace is skipped, the
+         * longest such number at the start of the string is converted, and results that overflow or underflow are
+         * rejected. Hexadecimal floating point numbers are not supported.
+         *
+         * @param str the string to parse
+         * @return the value or an empty optional if the given string cannot be interpreted as a floating point number
+         */
+        std::optional<double> parseDouble(std::string_view str);
+
+        /**
+         * Parses the given string as a decimal signed integer. Strings of the form [+-]digits are converted without
+         * allocating. Any other string is interpreted like std::stol would interpret it.
+         *
+         * @param str the string to parse
+         * @return the value or an empty optional if the given string cannot be interpreted as an integer
+         */
+        std::optional<long> parseLong(std::string_view str);
+
+        /**
+         * Appends the shortest decimal representation of the given value that reads back as the same value. The output
+         * is identical to formatting the value with fmt's "{}" format specification.
+         *
+         * @param buffer the buffer to append to
+         * @param value the value to append
+         */
+        void appendNumber(std::string& buffer, double value);
+
+        /**
+         * Appends the shortest decimal representation of the given value that reads back as the same float. The output
+         * is identical to formatting the value with fmt's "{}" format specification.
+         *
+         * @param buffer the buffer to append to
+         * @param value the value to append
+         */
+        void appendNumber(std::string& buffer, float value);
+    }
+}
@@ -27,7 +27,11 @@
 #include "Model/BrushGeometry.h"
 #include "Model/Polyhedron.h"
 
-#include <map>
+#include <kdl/parallel.h>
+
+#include <fmt/format.h>
+
+#include <iterator> // for std::back_inserter
 
 namespace TrenchBroom {
     namespace IO {
@@ -48,36 +52,23 @@ namespace TrenchBroom {
         m_mtlFile(m_mtlPath, true),
         m_stream(m_objFile.file),
         m_mtlStream(m_mtlFile.file),
-        m_currentObject({ 0, 0, {} }) {
+        m_vertexCount(0u) {
             ensure(m_stream != nullptr, "stream is null");
             ensure(m_mtlStream != nullptr, "mtl stream is null");
         }
 
-        void ObjFileSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {}
+        void ObjFileSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {
+            std::fprintf(m_stream, "mtllib %s\n", m_mtlPath.filename().c_str());
+            m_pendingBrushes.reserve(ChunkSize);
+        }
 
         void ObjFileSerializer::doEndFile() {
+            flushPendingBrushes();
             writeMtlFile();
-
-            std::fprintf(m_stream, "mtllib %s\n", m_mtlPath.filename().c_str());
-            writeVertices();
-            std::fprintf(m_stream, "\n");
-            writeTexCoords();
-            std::fprintf(m_stream, "\n");
-            writeNormals();
-            std::fprintf(m_stream, "\n");
-            writeObjects();
         }
 
         void ObjFileSerializer::writeMtlFile() {
-            std::map<std::string, const Assets::Texture*> usedTextures;
-
-            for (const Object& object : m_objects) {
-                for (const Face& face : object.faces) {
-                    usedTextures[face.textureName] = face.texture;
-                }
-            }
-
-            for (const auto& [textureName, texture] : usedTextures) {
+            for (const auto& [textureName, texture] : m_usedTextures) {
                 std::fprintf(m_mtlStream, "newmtl %s\n", textureName.c_str());
                 if (texture != nullptr && !texture->relativePath().isEmpty()) {
                     std::fprintf(m_mtlStream, "map_Kd %s\n\n", texture->relativePath().asString().c_str());
@@ -85,52 +76,159 @@ namespace TrenchBroom {
             }
         }
 
-        void ObjFileSerializer::writeVertices() {
-            std::fprintf(m_stream, "# vertices\n");
-            for (const vm::vec3& elem : m_vertices.list())
-                std::fprintf(m_stream, "v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+        /**
+         * Computes the face data of all pending brushes in parallel, resolves their indices and writes
+         * them to the file.
+         */
+        void ObjFileSerializer::flushPendingBrushes() {
+            if (m_pendingBrushes.empty()) {
+                return;
+            }
+
+            std::vector<Object> objects = kdl::vec_parallel_transform(std::move(m_pendingBrushes), [](const PendingBrush& pending) {
+                std::vector<const Model::BrushFace*> faces;
+                faces.reserve(pending.brush->brush().faceCount());
+                for (const Model::BrushFace& face : pending.brush->brush().faces()) {
+                    faces.push_back(&face);
+                }
+                return buildObject(pending.entityNo, pending.brushNo, faces);
+            });
+
+            m_pendingBrushes.clear();
+            writeObjects(objects);
         }
 
-        void ObjFileSerializer::writeTexCoords() {
-            std::fprintf(m_stream, "# texture coordinates\n");
-            for (const vm::vec2f& elem : m_texCoords.list()) {
-                // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
-                // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-                std::fprintf(m_stream, "vt %.17g %.17g\n", static_cast<double>(elem.x()), static_cast<double>(-elem.y()));
+        /**
+         * Rewrites the indices of the given object's faces so that they refer to the vertices, texture
+         * coordinates and normals of the entire file. Afterwards, the object's lists only contain the
+         * values that have not been written to the file yet.
+         *
+         * Vertex positions are never shared between objects, but texture coordinates and normals are.
+         */
+        void ObjFileSerializer::resolveIndices(Object& object) {
+            std::vector<size_t> texCoordIndices;
+            std::vector<vm::vec2f> newTexCoords;
+            texCoordIndices.reserve(object.texCoords.size());
+            for (const vm::vec2f& texCoords : object.texCoords) {
+                const auto [index, inserted] = m_texCoords.index(texCoords);
+                texCoordIndices.push_back(index);
+                if (inserted) {
+                    newTexCoords.push_back(texCoords);
+                }
+            }
+
+            std::vector<size_t> normalIndices;
+            std::vector<vm::vec3> newNormals;
+            normalIndices.reserve(object.normals.size());
+            for (const vm::vec3& normal : object.normals) {
+                const auto [index, inserted] = m_normals.index(normal);
+                normalIndices.push_back(index);
+                if (inserted) {
+                    newNormals.push_back(normal);
+                }
+            }
+
+            for (Face& face : object.faces) {
+                for (IndexedVertex& vertex : face.verts) {
+                    vertex.vertex += m_vertexCount;
+                    vertex.texCoords = texCoordIndices[vertex.texCoords];
+                    vertex.normal = normalIndices[vertex.normal];
+                }
+                m_usedTextures.emplace(face.textureName, face.texture);
             }
+
+            m_vertexCount += object.vertices.size();
+            object.texCoords = std::move(newTexCoords);
+            object.normals = std::move(newNormals);
         }
 
-        void ObjFileSerializer::writeNormals() {
-            std::fprintf(m_stream, "# face normals\n");
-            for (const vm::vec3& elem : m_normals.list()) {
-                std::fprintf(m_stream, "vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+        void ObjFileSerializer::writeObjects(std::vector<Object>& objects) {
+            // indices must be resolved in file order, but formatting can happen in parallel afterwards
+            for (Object& object : objects) {
+                resolveIndices(object);
+            }
+
+            const std::vector<std::string> formattedObjects = kdl::vec_parallel_transform(std::move(objects), [](const Object& object) {
+                return formatObject(object);
+            });
+
+            for (const std::string& formattedObject : formattedObjects) {
+                std::fwrite(formattedObject.data(), 1u, formattedObject.size(), m_stream);
             }
         }
 
-        void ObjFileSerializer::writeObjects() {
-            std::fprintf(m_stream, "# objects\n");
-            for (const Object& object : m_objects) {
-                std::fprintf(m_stream, "o entity%lu_brush%lu\n",
-                             static_cast<unsigned long>(object.entityNo),
-                             static_cast<unsigned long>(object.brushNo));
+        /**
+         * Threadsafe
+         */
+        ObjFileSerializer::Object ObjFileSerializer::buildObject(const size_t entityNo, const size_t brushNo, const std::vector<const Model::BrushFace*>& faces) {
+            Object object{ entityNo, brushNo, {}, {}, {}, {} };
+            object.faces.reserve(faces.size());
+
+            IndexMap<vm::vec3> vertices;
+            IndexMap<vm::vec2f> texCoords;
+            IndexMap<vm::vec3> normals;
+
+            const auto addValue = [](auto& indexMap, auto& list, const auto& value) {
+                const auto [index, inserted] = indexMap.index(value);
+                if (inserted) {
+                    list.push_back(value);
+                }
+                return index;
+            };
+
+            for (const Model::BrushFace* face : faces) {
+                const vm::vec3& normal = face->boundary().normal;
+                const size_t normalIndex = addValue(normals, object.normals, normal);
+
+                IndexedVertexList indexedVertices;
+                indexedVertices.reserve(face->vertexCount());
+
+                for (const Model::BrushVertex* vertex : face->vertices()) {
+                    const vm::vec3& position = vertex->position();
+                    const vm::vec2f faceTexCoords = face->textureCoords(position);
+
+                    const size_t vertexIndex = addValue(vertices, object.vertices, position);
+                    const size_t texCoordsIndex = addValue(texCoords, object.texCoords, faceTexCoords);
 
-                writeFaces(object.faces);
-                std::fprintf(m_stream, "\n");
+                    indexedVertices.emplace_back(vertexIndex, texCoordsIndex, normalIndex);
+                }
+
+                object.faces.emplace_back(std::move(indexedVertices), face->attributes().textureName(), face->texture());
             }
+
+            return object;
         }
 
-        void ObjFileSerializer::writeFaces(const FaceList& faces) {
-            for (const Face& face : faces) {
-                std::fprintf(m_stream, "usemtl %s\n", face.textureName.c_str());
-                std::fprintf(m_stream, "f");
+        /**
+         * Threadsafe
+         */
+        std::string ObjFileSerializer::formatObject(const Object& object) {
+            std::string result;
+            auto out = std::back_inserter(result);
+
+            fmt::format_to(out, "o entity{}_brush{}\n", object.entityNo, object.brushNo);
+            for (const vm::vec3& elem : object.vertices) {
+                fmt::format_to(out, "v {:.17g} {:.17g} {:.17g}\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+            }
+            for (const vm::vec2f& elem : object.texCoords) {
+                // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
+                // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
+                fmt::format_to(out, "vt {:.17g} {:.17g}\n", static_cast<double>(elem.x()), static_cast<double>(-elem.y()));
+            }
+            for (const vm::vec3& elem : object.normals) {
+                fmt::format_to(out, "vn {:.17g} {:.17g} {:.17g}\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+            }
+            for (const Face& face : object.faces) {
+                fmt::format_to(out, "usemtl {}\n", face.textureName);
+                fmt::format_to(out, "f");
                 for (const IndexedVertex& vertex : face.verts) {
-                    std::fprintf(m_stream, " %lu/%lu/%lu",
-                                 static_cast<unsigned long>(vertex.vertex) + 1,
-                                 static_cast<unsigned long>(vertex.texCoords) + 1,
-                                 static_cast<unsigned long>(vertex.normal) + 1);
+                    fmt::format_to(out, " {}/{}/{}", vertex.vertex + 1u, vertex.texCoords + 1u, vertex.normal + 1u);
                 }
-                std::fprintf(m_stream, "\n");
+                fmt::format_to(out, "\n");
             }
+            fmt::format_to(out, "\n");
+
+            return result;
         }
 
         void ObjFileSerializer::doBeginEntity(const Model::Node* /* node */) {}
@@ -138,38 +236,21 @@ namespace TrenchBroom {
         void ObjFileSerializer::doEntityProperty(const Model::EntityProperty& /* property */) {}
 
         void ObjFileSerializer::doBrush(const Model::BrushNode* brush) {
-            m_currentObject.entityNo = entityNo();
-            m_currentObject.brushNo = brushNo();
-            // Vertex positions inserted from now on should get new indices
-            m_vertices.clearIndices();
-
-            for (const Model::BrushFace& face : brush->brush().faces()) {
-                doBrushFace(face);
+            m_pendingBrushes.push_back({ entityNo(), brushNo(), brush });
+            if (m_pendingBrushes.size() >= ChunkSize) {
+                flushPendingBrushes();
             }
-
-            m_objects.push_back(m_currentObject);
-            m_currentObject.faces.clear();
         }
 
+        /**
+         * Faces that are serialized on their own are written as an object containing only that face.
+         */
         void ObjFileSerializer::doBrushFace(const Model::BrushFace& face) {
-            const vm::vec3& normal = face.boundary().normal;
-            const size_t normalIndex = m_normals.index(normal);
+            flushPendingBrushes();
 
-            IndexedVertexList indexedVertices;
-            indexedVertices.reserve(face.vertexCount());
-
-            for (const Model::BrushVertex* vertex : face.vertices()) {
-                const vm::vec3& position = vertex->position();
-                const vm::vec2f texCoords = face.textureCoords(position);
-
-                const size_t vertexIndex = m_vertices.index(position);
-                const size_t texCoordsIndex = m_texCoords.index(texCoords);
-
-                indexedVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
-            }
-
-            m_currentObject.faces.push_back(Face(indexedVertices, face.attributes().textureName(), face.texture()));
+            std::vector<Object> objects;
+            objects.push_back(buildObject(entityNo(), brushNo(), { &face }));
+            writeObjects(objects);
         }
     }
 }
-
@@ -25,10 +25,14 @@
 #include "IO/Path.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/vec.h>
 
 #include <cstdio>
+#include <functional>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -44,36 +48,46 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        /**
+         * Exports brushes to a Wavefront OBJ file and an accompanying MTL file.
+         *
+         * Brushes are not buffered for the entire file. Instead, they are collected into chunks of
+         * bounded size. The face data of each chunk is computed in parallel, then vertex, texture
+         * coordinate and normal indices are resolved and the chunk is written before the next one is
+         * collected. Each object is written with the vertices, texture coordinates and normals that
+         * it introduces, followed by its faces.
+         */
         class ObjFileSerializer : public NodeSerializer {
         private:
+            /**
+             * The maximum number of brushes that are buffered before they are written to the file.
+             */
+            static constexpr size_t ChunkSize = 1024u;
+
+            struct VecHash {
+                template <typename T, std::size_t S>
+                size_t operator()(const vm::vec<T,S>& v) const {
+                    size_t seed = 0u;
+                    for (std::size_t i = 0u; i < S; ++i) {
+                        seed ^= std::hash<T>{}(v[i]) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+                    }
+                    return seed;
+                }
+            };
+
             template <typename V>
             class IndexMap {
-            public:
-                using List = std::vector<V>;
             private:
-                using Map = std::map<V, size_t>;
+                using Map = std::unordered_map<V, size_t, VecHash>;
                 Map m_map;
-                List m_list;
             public:
-                const List& list() const {
-                    return m_list;
-                }
-
-                size_t index(const V& v) {
-                    const auto it = m_map.insert({ v, m_list.size() }).first;
-                    const size_t index = it->second;
-                    if (index == m_list.size()) {
-                        m_list.push_back(v);
-                    }
-                    return index;
-                }
-
                 /**
-                 * Values inserted after this is called will not reuse indices from before this
-                 * is called.
+                 * Returns the index of the given value and whether the value was newly added. New
+                 * values receive consecutive indices starting at 0.
                  */
-                void clearIndices() {
-                    m_map.clear();
+                std::pair<size_t, bool> index(const V& v) {
+                    const auto [it, inserted] = m_map.emplace(v, m_map.size());
+                    return { it->second, inserted };
                 }
             };
 
@@ -97,13 +111,25 @@ namespace TrenchBroom {
 
             using FaceList = std::vector<Face>;
 
+            /**
+             * The data of a single exported object. The indices of its faces refer to the object's
+             * own vertex, texture coordinate and normal lists until they are resolved against the
+             * indices of the entire file.
+             */
             struct Object {
                 size_t entityNo;
                 size_t brushNo;
+                std::vector<vm::vec3> vertices;
+                std::vector<vm::vec2f> texCoords;
+                std::vector<vm::vec3> normals;
                 FaceList faces;
             };
 
-            using ObjectList = std::vector<Object>;
+            struct PendingBrush {
+                size_t entityNo;
+                size_t brushNo;
+                const Model::BrushNode* brush;
+            };
 
             Path m_objPath;
             Path m_mtlPath;
@@ -114,12 +140,12 @@ namespace TrenchBroom {
             FILE* m_stream;
             FILE* m_mtlStream;
 
-            IndexMap<vm::vec3> m_vertices;
+            size_t m_vertexCount;
             IndexMap<vm::vec2f> m_texCoords;
             IndexMap<vm::vec3> m_normals;
 
-            Object m_currentObject;
-            ObjectList m_objects;
+            std::vector<PendingBrush> m_pendingBrushes;
+            std::map<std::string, const Assets::Texture*> m_usedTextures;
         public:
             explicit ObjFileSerializer(const Path& path);
         private:
@@ -128,11 +154,12 @@ namespace TrenchBroom {
 
             void writeMtlFile();
 
-            void writeVertices();
-            void writeTexCoords();
-            void writeNormals();
-            void writeObjects();
-            void writeFaces(const FaceList& faces);
+            void flushPendingBrushes();
+            void resolveIndices(Object& object);
+            void writeObjects(std::vector<Object>& objects);
+
+            static Object buildObject(size_t entityNo, size_t brushNo, const std::vector<const Model::BrushFace*>& faces);
+            static std::string formatObject(const Object& object);
 
             void doBeginEntity(const Model::Node* node) override;
             void doEndEntity(const Model::Node* node) override;
@@ -143,4 +170,3 @@ namespace TrenchBroom {
         };
     }
 }
-
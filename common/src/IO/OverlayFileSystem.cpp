@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OverlayFileSystem.h"
+
+#include "Exceptions.h"
+#include "IO/PackageIndex.h"
+#include "IO/Path.h"
+
+#include <kdl/vector_utils.h>
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        OverlayFileSystem::OverlayFileSystem() :
+        FileSystem() {}
+
+        void OverlayFileSystem::addFileSystem(std::shared_ptr<FileSystem> fileSystem) {
+            m_layers.push_back(Layer{std::move(fileSystem), nullptr});
+        }
+
+        void OverlayFileSystem::addPackages(std::shared_ptr<const PackageIndex> packages) {
+            m_layers.push_back(Layer{nullptr, std::move(packages)});
+        }
+
+        Path OverlayFileSystem::doMakeAbsolute(const Path& path) const {
+            for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+                const auto& fileSystem = it->fileSystem;
+                if (fileSystem && (fileSystem->fileExists(path) || fileSystem->directoryExists(path))) {
+                    return fileSystem->makeAbsolute(path);
+                }
+                if (it->packages && (it->packages->fileExists(path) || it->packages->directoryExists(path))) {
+                    // files in packages have no absolute path
+                    break;
+                }
+            }
+            throw FileSystemException("Cannot make absolute path of '" + path.asString() + "'");
+        }
+
+        bool OverlayFileSystem::doDirectoryExists(const Path& path) const {
+            for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+                if (it->fileSystem ? it->fileSystem->directoryExists(path) : it->packages->directoryExists(path)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool OverlayFileSystem::doFileExists(const Path& path) const {
+            for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+                if (it->fileSystem ? it->fileSystem->fileExists(path) : it->packages->fileExists(path)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<Path> OverlayFileSystem::doGetDirectoryContents(const Path& path) const {
+            auto result = std::vector<Path>{};
+            for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+                if (it->fileSystem) {
+                    if (it->fileSystem->directoryExists(path)) {
+                        result = kdl::vec_concat(std::move(result), it->fileSystem->getDirectoryContents(path));
+                    }
+                } else {
+                    result = kdl::vec_concat(std::move(result), it->packages->directoryContents(path));
+                }
+            }
+            return kdl::vec_sort_and_remove_duplicates(std::move(result));
+        }
+
+        std::shared_ptr<File> OverlayFileSystem::doOpenFile(const Path& path) const {
+            for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+                if (it->fileSystem) {
+                    if (it->fileSystem->fileExists(path)) {
+                        return it->fileSystem->openFile(path);
+                    }
+                } else if (const auto* package = it->packages->findPackage(path)) {
+                    return package->openFile(path);
+                }
+            }
+            throw FileSystemException("File not found: '" + path.asString() + "'");
+        }
+    }
+}
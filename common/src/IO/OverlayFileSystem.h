@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/FileSystem.h"
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class PackageIndex;
+        class Path;
+
+        /**
+         * Overlays several file systems and package indices so that the layer that was added last and contains a
+         * path provides it.
+         *
+         * Packages are looked up in their index, so the cost of a query depends on the number of layers and not on
+         * the number of packages. Other file systems, such as disk file systems, are queried directly so that
+         * changes to their contents are visible immediately. The layers must not have a next file system.
+         */
+        class OverlayFileSystem : public FileSystem {
+        private:
+            struct Layer {
+                std::shared_ptr<FileSystem> fileSystem;
+                std::shared_ptr<const PackageIndex> packages;
+            };
+
+            // the layer that was added last comes last
+            std::vector<Layer> m_layers;
+        public:
+            OverlayFileSystem();
+
+            /**
+             * Adds the given file system on top of the existing layers.
+             */
+            void addFileSystem(std::shared_ptr<FileSystem> fileSystem);
+
+            /**
+             * Adds the given packages on top of the existing layers.
+             */
+            void addPackages(std::shared_ptr<const PackageIndex> packages);
+        private:
+            Path doMakeAbsolute(const Path& path) const override;
+
+            bool doDirectoryExists(const Path& path) const override;
+            bool doFileExists(const Path& path) const override;
+
+            std::vector<Path> doGetDirectoryContents(const Path& path) const override;
+            std::shared_ptr<File> doOpenFile(const Path& path) const override;
+        };
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PackageIndex.h"
+
+#include "IO/FileMatcher.h"
+#include "IO/FileSystem.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::string indexKey(const Path& path) {
+            return path.makeLowerCase().makeCanonical().asString("/");
+        }
+
+        PackageIndex::PackageIndex(std::vector<std::shared_ptr<FileSystem>> packages) :
+        m_packages(std::move(packages)) {
+            auto items = std::unordered_set<std::string>{};
+            for (const auto& package : m_packages) {
+                addPackage(*package, items);
+            }
+        }
+
+        const std::vector<std::shared_ptr<FileSystem>>& PackageIndex::packages() const {
+            return m_packages;
+        }
+
+        bool PackageIndex::directoryExists(const Path& path) const {
+            return m_directories.count(indexKey(path)) > 0u;
+        }
+
+        bool PackageIndex::fileExists(const Path& path) const {
+            return m_files.count(indexKey(path)) > 0u;
+        }
+
+        const std::vector<Path>& PackageIndex::directoryContents(const Path& path) const {
+            static const auto NoContents = std::vector<Path>{};
+
+            const auto it = m_directories.find(indexKey(path));
+            return it != std::end(m_directories) ? it->second : NoContents;
+        }
+
+        const FileSystem* PackageIndex::findPackage(const Path& path) const {
+            const auto it = m_files.find(indexKey(path));
+            return it != std::end(m_files) ? it->second : nullptr;
+        }
+
+        void PackageIndex::addPackage(const FileSystem& package, std::unordered_set<std::string>& items) {
+            m_directories.try_emplace(indexKey(Path()));
+
+            for (const auto& path : package.findItemsRecursively(Path(""), FileTypeMatcher(false, true))) {
+                m_directories.try_emplace(indexKey(path));
+                addItem(path, items);
+            }
+
+            for (const auto& path : package.findItemsRecursively(Path(""), FileTypeMatcher(true, false))) {
+                // packages that come first win, so existing entries are never replaced
+                if (m_files.try_emplace(indexKey(path), &package).second) {
+                    addItem(path, items);
+                }
+            }
+        }
+
+        /**
+         * Adds the name of the given item to the contents of its directory, unless an item with the same name was
+         * added already. The given set contains the keys of the items added so far.
+         */
+        void PackageIndex::addItem(const Path& path, std::unordered_set<std::string>& items) {
+            if (items.insert(indexKey(path)).second) {
+                m_directories[indexKey(path.deleteLastComponent())].push_back(path.lastComponent());
+            }
+        }
+    }
+}
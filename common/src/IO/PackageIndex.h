@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/Path.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class FileSystem;
+
+        /**
+         * A merged, case insensitive index of the contents of several packages, such as the pak or pk3 files in a
+         * search path.
+         *
+         * Packages do not change after they were read, so the index maps every file to the package that provides it
+         * once when it is created. If several packages contain a file, the package that comes first wins. The
+         * packages must not have a next file system.
+         *
+         * The index is immutable and can be queried from several threads.
+         */
+        class PackageIndex {
+        private:
+            std::vector<std::shared_ptr<FileSystem>> m_packages;
+            std::unordered_map<std::string, const FileSystem*> m_files;
+            std::unordered_map<std::string, std::vector<Path>> m_directories;
+        public:
+            /**
+             * Creates an index of the given packages, which are ordered by decreasing priority.
+             */
+            explicit PackageIndex(std::vector<std::shared_ptr<FileSystem>> packages);
+
+            const std::vector<std::shared_ptr<FileSystem>>& packages() const;
+
+            bool directoryExists(const Path& path) const;
+            bool fileExists(const Path& path) const;
+
+            /**
+             * Returns the names of the items in the given directory, or an empty vector if no package contains the
+             * given directory.
+             */
+            const std::vector<Path>& directoryContents(const Path& path) const;
+
+            /**
+             * Returns the package that provides the file at the given path, or nullptr if no package contains it.
+             */
+            const FileSystem* findPackage(const Path& path) const;
+        private:
+            void addPackage(const FileSystem& package, std::unordered_set<std::string>& items);
+            void addItem(const Path& path, std::unordered_set<std::string>& items);
+        };
+    }
+}
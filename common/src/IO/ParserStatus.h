@@ -35,6 +35,8 @@ namespace TrenchBroom {
         public:
             virtual ~ParserStatus();
         public:
+            const std::string& prefix() const;
+
             void progress(double progress);
 
             void debug(size_t line, size_t column, const std::string& str);
@@ -54,6 +56,12 @@ namespace TrenchBroom {
             void warn(const std::string& str);
             void error(const std::string& str);
             [[noreturn]] void errorAndThrow(const std::string& str);
+
+            /**
+             * Logs the given message as is, without adding a prefix or position. This is used to pass on messages
+             * that were already formatted by another parser status.
+             */
+            void logFormatted(LogLevel level, const std::string& str);
         private:
             void log(LogLevel level, size_t line, size_t column, const std::string& str);
             std::string buildMessage(size_t line, size_t column, const std::string& str) const;
@@ -21,19 +21,38 @@
 
 #include "Logger.h"
 #include "Assets/Quake3Shader.h"
+#include "IO/CollectingParserStatus.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/Quake3ShaderParser.h"
+#include "IO/Reader.h"
 #include "IO/SimpleParserStatus.h"
 
+#include <kdl/parallel.h>
+#include <kdl/string_format.h>
+#include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        static const auto ImageExtensions = std::vector<std::string> { "tga", "png", "jpg", "jpeg" };
+
+        struct ShaderFileResult {
+            std::vector<Assets::Quake3Shader> shaders;
+            CollectingParserStatus status;
+            std::optional<std::string> error;
+
+            explicit ShaderFileResult(const Path& path) :
+            status(path.asString()) {}
+        };
+
         Quake3ShaderFileSystem::Quake3ShaderFileSystem(std::shared_ptr<FileSystem> fs, Path shaderSearchPath, std::vector<Path> textureSearchPaths, Logger& logger) :
         ImageFileSystemBase(std::move(fs), Path()),
         m_shaderSearchPath(std::move(shaderSearchPath)),
@@ -54,17 +73,42 @@ namespace TrenchBroom {
 
             if (next().directoryExists(m_shaderSearchPath)) {
                 const auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
+
+                // The file systems are not safe to access concurrently, so read the files here.
+                auto contents = std::vector<std::pair<Path, std::string>>();
+                contents.reserve(paths.size());
                 for (const auto& path : paths) {
                     const auto file = next().openFile(path);
                     auto bufferedReader = file->reader().buffer();
+                    contents.emplace_back(file->path(), std::string(bufferedReader.stringView()));
+                }
+
+                auto fileResults = kdl::vec_parallel_transform(std::move(contents), [](auto&& pathAndContents) {
+                    const auto& [path, str] = pathAndContents;
 
+                    auto fileResult = std::make_unique<ShaderFileResult>(path);
                     try {
-                        Quake3ShaderParser parser(bufferedReader.stringView());
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        result = kdl::vec_concat(std::move(result), parser.parse(status));
+                        Quake3ShaderParser parser(str);
+                        fileResult->shaders = parser.parse(fileResult->status);
                     } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        fileResult->error = kdl::str_to_string("Skipping malformed shader file ", path, ": ", e.what());
                     }
+                    return fileResult;
+                });
+
+                auto shaderCount = size_t(0);
+                for (const auto& fileResult : fileResults) {
+                    shaderCount += fileResult->shaders.size();
+                }
+                result.reserve(shaderCount);
+
+                SimpleParserStatus status(m_logger);
+                for (auto& fileResult : fileResults) {
+                    fileResult->status.passOn(status);
+                    if (fileResult->error) {
+                        m_logger.warn(*fileResult->error);
+                    }
+                    result.insert(std::end(result), std::make_move_iterator(std::begin(fileResult->shaders)), std::make_move_iterator(std::end(fileResult->shaders)));
                 }
             }
 
@@ -73,40 +117,117 @@ namespace TrenchBroom {
         }
 
         void Quake3ShaderFileSystem::linkShaders(std::vector<Assets::Quake3Shader>& shaders) {
-            const auto extensions = std::vector<std::string> { "tga", "png", "jpg", "jpeg" };
-
             auto allImages = std::vector<Path>();
             for (const auto& path : m_textureSearchPaths) {
                 if (next().directoryExists(path)) {
-                    allImages = kdl::vec_concat(std::move(allImages), next().findItemsRecursively(path, FileExtensionMatcher(extensions)));
+                    allImages = kdl::vec_concat(std::move(allImages), next().findItemsRecursively(path, FileExtensionMatcher(ImageExtensions)));
                 }
             }
 
             m_logger.info() << "Linking shaders...";
-            linkTextures(allImages, shaders);
-            linkStandaloneShaders(shaders);
+            resolveShaderImages(buildImageIndex(allImages), shaders);
+
+            auto linked = std::vector<bool>(shaders.size(), false);
+            linkTextures(allImages, shaders, linked);
+            linkStandaloneShaders(shaders, linked);
         }
 
-        void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders) {
+        /**
+         * The images for each path are ordered by the preference of their extensions.
+         */
+        Quake3ShaderFileSystem::ImageIndex Quake3ShaderFileSystem::buildImageIndex(const std::vector<Path>& images) const {
+            const auto extensionRank = [](const Path& path) {
+                return kdl::vec_index_of(ImageExtensions, kdl::str_to_lower(path.extension())).value_or(ImageExtensions.size());
+            };
+
+            auto result = ImageIndex();
+            result.reserve(images.size());
+
+            for (const auto& image : images) {
+                result[image.deleteExtension().asString()].push_back(image);
+            }
+
+            for (auto& [key, candidates] : result) {
+                std::stable_sort(std::begin(candidates), std::end(candidates), [&](const Path& lhs, const Path& rhs) {
+                    return extensionRank(lhs) < extensionRank(rhs);
+                });
+            }
+
+            return result;
+        }
+
+        /**
+         * Determines the image of each shader in the same order of precedence as the texture reader does, but looks
+         * the images up in the image index instead of searching the file system. The image found is stored as the
+         * shader's editor image, so that the texture reader finds it without listing any directories. If no image is
+         * found in the index, the shader is left unchanged and the texture reader searches the file system.
+         */
+        void Quake3ShaderFileSystem::resolveShaderImages(const ImageIndex& imageIndex, std::vector<Assets::Quake3Shader>& shaders) const {
+            const auto findImage = [&](const Path& path) -> std::optional<Path> {
+                if (path.isEmpty()) {
+                    return std::nullopt;
+                }
+                if (!path.extension().empty() && next().fileExists(path)) {
+                    return path;
+                }
+
+                const auto it = imageIndex.find(path.deleteExtension().asString());
+                if (it != std::end(imageIndex)) {
+                    return it->second.front();
+                }
+                return std::nullopt;
+            };
+
+            const auto findShaderImage = [&](const Assets::Quake3Shader& shader) -> std::optional<Path> {
+                if (auto image = findImage(shader.editorImage)) {
+                    return image;
+                }
+                if (auto image = findImage(shader.shaderPath)) {
+                    return image;
+                }
+                if (auto image = findImage(shader.lightImage)) {
+                    return image;
+                }
+                for (const auto& stage : shader.stages) {
+                    if (auto image = findImage(stage.map)) {
+                        return image;
+                    }
+                }
+                return std::nullopt;
+            };
+
+            for (auto& shader : shaders) {
+                if (auto image = findShaderImage(shader)) {
+                    shader.editorImage = std::move(*image);
+                }
+            }
+        }
+
+        void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders, std::vector<bool>& linked) {
             m_logger.debug() << "Linking textures...";
+
+            // If there are several shaders with the same path, the first one wins.
+            auto shaderIndex = std::unordered_map<std::string, size_t>();
+            shaderIndex.reserve(shaders.size());
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                shaderIndex.emplace(shaders[i].shaderPath.asString(), i);
+            }
+
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
                 if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
-
-                    if (shaderIt != std::end(shaders)) {
+                    const auto shaderIt = shaderIndex.find(shaderPath.asString());
+                    if (shaderIt != std::end(shaderIndex) && !linked[shaderIt->second]) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        auto& shader = shaders[shaderIt->second];
 
                         auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
                         m_root.addFile(shaderPath, shaderFile);
 
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
+                        // Mark the shader so that we don't revisit it when linking standalone shaders.
+                        linked[shaderIt->second] = true;
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -120,12 +241,15 @@ namespace TrenchBroom {
             }
         }
 
-        void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
+        void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders, const std::vector<bool>& linked) {
             m_logger.debug() << "Linking standalone shaders...";
-            for (auto& shader : shaders) {
-                const auto& shaderPath = shader.shaderPath;
-                auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
-                m_root.addFile(shaderPath, std::move(shaderFile));
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                if (!linked[i]) {
+                    auto& shader = shaders[i];
+                    const auto& shaderPath = shader.shaderPath;
+                    auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
+                    m_root.addFile(shaderPath, std::move(shaderFile));
+                }
             }
         }
     }
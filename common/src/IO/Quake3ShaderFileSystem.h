@@ -21,6 +21,8 @@
 
 #include "IO/ImageFileSystem.h"
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -37,9 +39,17 @@ namespace TrenchBroom {
          *
          * Also scans for textures available at a list of search paths and generates shaders for such textures which
          * do not already have a shader by the same name.
+         *
+         * The shader scripts are parsed in parallel. The texture images are indexed once by their path without
+         * extension, and the index is used to link shaders and to resolve their images.
          */
         class Quake3ShaderFileSystem : public ImageFileSystemBase {
         private:
+            /**
+             * Maps the path of a texture image without its extension to the paths of all images with that path.
+             */
+            using ImageIndex = std::unordered_map<std::string, std::vector<Path>>;
+
             Path m_shaderSearchPath;
             std::vector<Path> m_textureSearchPaths;
             Logger& m_logger;
@@ -61,8 +71,10 @@ namespace TrenchBroom {
 
             std::vector<Assets::Quake3Shader> loadShaders() const;
             void linkShaders(std::vector<Assets::Quake3Shader>& shaders);
-            void linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders);
-            void linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders);
+            ImageIndex buildImageIndex(const std::vector<Path>& images) const;
+            void resolveShaderImages(const ImageIndex& imageIndex, std::vector<Assets::Quake3Shader>& shaders) const;
+            void linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders, std::vector<bool>& linked);
+            void linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders, const std::vector<bool>& linked);
         };
     }
 }
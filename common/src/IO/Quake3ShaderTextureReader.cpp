@@ -108,6 +108,10 @@ namespace TrenchBroom {
             return texturePath;
         }
 
+        /**
+         * Quake3ShaderFileSystem already stores the image it finds in its image index as the shader's editor image,
+         * so the directory search here is only a fallback for images outside of the texture search paths.
+         */
         Path Quake3ShaderTextureReader::findTexture(const Path& texturePath) const {
             if (!texturePath.isEmpty() && (texturePath.extension().empty() || !m_fs.fileExists(texturePath))) {
                 const auto candidates = m_fs.findItemsWithBaseName(texturePath, std::vector<std::string> { "tga", "png", "jpg", "jpeg"});
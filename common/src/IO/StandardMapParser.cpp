@@ -29,16 +29,14 @@
 #include <vecmath/plane.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
-        const std::string& QuakeMapTokenizer::NumberDelim() {
-            static const std::string numberDelim(Whitespace() + ")");
-            return numberDelim;
-        }
-
         QuakeMapTokenizer::QuakeMapTokenizer(std::string_view str) :
         Tokenizer(std::move(str), "\"", '\\'),
         m_skipEol(true) {}
@@ -61,14 +59,14 @@ namespace TrenchBroom {
                                 advance();
                                 return Token(QuakeMapToken::Comment, c, c+3, offset(c), startLine, startColumn);
                             }
-                            discardUntil("\n\r");
+                            discardLineComment();
                         }
                         break;
                     case ';':
                         // Heretic2 allows semicolon to start a line comment.
                         // QuArK writes comments in this format when saving a Heretic2 .map.
                         advance();
-                        discardUntil("\n\r");
+                        discardLineComment();
                         break;
                     case '{':
                         advance();
@@ -91,7 +89,10 @@ namespace TrenchBroom {
                     case '"': { // quoted string
                         advance();
                         c = curPos();
-                        const auto* e = readQuotedString('"', "\n}");
+                        const auto* e = readSimpleQuotedString();
+                        if (e == nullptr) {
+                            e = readQuotedString('"', "\n}");
+                        }
                         return Token(QuakeMapToken::String, c, e, offset(c), startLine, startColumn);
                     }
                     case '\r':
@@ -109,20 +110,16 @@ namespace TrenchBroom {
                         switchFallthrough();
                     case ' ':
                     case '\t':
-                        discardWhile(Whitespace());
+                        discardWhitespace();
                         break;
                     default: { // whitespace, integer, decimal or word
-                        const auto* e = readInteger(NumberDelim());
-                        if (e != nullptr) {
-                            return Token(QuakeMapToken::Integer, c, e, offset(c), startLine, startColumn);
-                        }
-
-                        e = readDecimal(NumberDelim());
-                        if (e != nullptr) {
-                            return Token(QuakeMapToken::Decimal, c, e, offset(c), startLine, startColumn);
+                        const auto [type, numberEnd] = scanNumber(c);
+                        if (numberEnd != nullptr) {
+                            advanceTo(numberEnd);
+                            return Token(type, c, numberEnd, offset(c), startLine, startColumn);
                         }
 
-                        e = readUntil(Whitespace());
+                        const auto* e = readUntil(Whitespace());
                         if (e == nullptr) {
                             throw ParserException(startLine, startColumn, "Unexpected character: " + std::string(c, 1));
                         }
@@ -134,6 +131,97 @@ namespace TrenchBroom {
             return Token(QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column());
         }
 
+        static bool isNumberDelim(const char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ')';
+        }
+
+        static const char* skipDigits(const char* cur, const char* end) {
+            while (cur < end && *cur >= '0' && *cur <= '9') {
+                ++cur;
+            }
+            return cur;
+        }
+
+        /**
+         * Scans the number starting at the given position without advancing. Accepts the same integers and decimals
+         * as readInteger and readDecimal, but classifies the number in a single pass.
+         *
+         * Returns the type and the end of the number, or a null end if there is no number at the given position.
+         */
+        std::tuple<QuakeMapToken::Type, const char*> QuakeMapTokenizer::scanNumber(const char* begin) const {
+            const auto first = *begin;
+            if (first != '+' && first != '-' && first != '.' && !isDigit(first)) {
+                return {0u, nullptr};
+            }
+
+            // an optional sign followed by digits is an integer
+            auto* cur = begin;
+            if (first == '+' || first == '-') {
+                ++cur;
+            }
+            cur = skipDigits(cur, m_end);
+            if (first != '.' && (cur == m_end || isNumberDelim(*cur))) {
+                return {QuakeMapToken::Integer, cur};
+            }
+
+            // otherwise, check for a decimal, which starts with the same sign and digits
+            if (cur < m_end && *cur == '.') {
+                cur = skipDigits(cur + 1, m_end);
+            }
+            if (cur < m_end && *cur == 'e') {
+                ++cur;
+                if (cur < m_end && (*cur == '+' || *cur == '-' || isDigit(*cur))) {
+                    cur = skipDigits(cur + 1, m_end);
+                }
+            }
+            if (cur == m_end || isNumberDelim(*cur)) {
+                return {QuakeMapToken::Decimal, cur};
+            }
+
+            return {0u, nullptr};
+        }
+
+        /**
+         * Reads a quoted string that does not span several lines or contain any escape characters, which is the
+         * common case. The opening quotation mark must already have been consumed.
+         *
+         * Returns the end of the string, or nullptr without advancing if the string is not such a simple string.
+         */
+        const char* QuakeMapTokenizer::readSimpleQuotedString() {
+            const auto* begin = curPos();
+            const auto* end = static_cast<const char*>(std::memchr(begin, '"', static_cast<size_t>(m_end - begin)));
+            if (end == nullptr || std::any_of(begin, end, [](const char c) { return c == '\\' || c == '\n' || c == '\r'; })) {
+                return nullptr;
+            }
+
+            advanceTo(end);
+            advance();
+            return end;
+        }
+
+        void QuakeMapTokenizer::discardWhitespace() {
+            while (!eof()) {
+                const auto* cur = curPos();
+                while (cur < m_end && (*cur == ' ' || *cur == '\t')) {
+                    ++cur;
+                }
+                advanceTo(cur);
+
+                if (eof() || (curChar() != '\n' && curChar() != '\r')) {
+                    break;
+                }
+                advance();
+            }
+        }
+
+        void QuakeMapTokenizer::discardLineComment() {
+            const auto* cur = curPos();
+            while (cur < m_end && *cur != '\n' && *cur != '\r') {
+                ++cur;
+            }
+            advanceTo(cur);
+        }
+
         const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
         const std::string StandardMapParser::PatchId = "patchDef2";
 
@@ -238,7 +326,7 @@ namespace TrenchBroom {
             const auto value = token.data();
 
             if (keys.count(name) == 0) {
-                properties.push_back(Model::EntityProperty(name, value));
+                properties.push_back(Model::EntityProperty(m_propertyKeys.intern(name), value));
                 keys.insert(name);
             } else {
                 status.warn(line, column, "Ignoring duplicate entity property '" + name + "'");
@@ -25,6 +25,7 @@
 #include "IO/Tokenizer.h"
 #include "Model/MapFormat.h"
 
+#include <kdl/interned_string.h>
 #include <kdl/vector_set_forward.h>
 
 #include <vecmath/forward.h>
@@ -56,7 +57,6 @@ namespace TrenchBroom {
 
         class QuakeMapTokenizer : public Tokenizer<QuakeMapToken::Type> {
         private:
-            static const std::string& NumberDelim();
             bool m_skipEol;
         public:
             explicit QuakeMapTokenizer(std::string_view str);
@@ -64,6 +64,11 @@ namespace TrenchBroom {
             void setSkipEol(bool skipEol);
         private:
             Token emitToken() override;
+
+            std::tuple<QuakeMapToken::Type, const char*> scanNumber(const char* begin) const;
+            const char* readSimpleQuotedString();
+            void discardWhitespace();
+            void discardLineComment();
         };
 
         class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type> {
@@ -75,6 +80,8 @@ namespace TrenchBroom {
             static const std::string PatchId;
 
             QuakeMapTokenizer m_tokenizer;
+            // entities repeat the same few property keys, so they are interned without accessing the global pool
+            kdl::interned_string_cache m_propertyKeys;
         protected:
             Model::MapFormat m_sourceMapFormat;
             Model::MapFormat m_targetMapFormat;
@@ -19,10 +19,11 @@
 
 #pragma once
 
+#include "IO/NumberCodec.h"
+
 #include <cassert>
 #include <string>
-
-#include <kdl/string_utils.h>
+#include <string_view>
 
 namespace TrenchBroom {
     namespace IO {
@@ -92,12 +93,12 @@ namespace TrenchBroom {
 
             template <typename T>
             T toFloat() const {
-                return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
+                return static_cast<T>(parseDouble(std::string_view(m_begin, length())).value_or(0.0));
             }
 
             template <typename T>
             T toInteger() const {
-                return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
+                return static_cast<T>(parseLong(std::string_view(m_begin, length())).value_or(0l));
             }
         };
     }
@@ -26,6 +26,7 @@
 
 #include <kdl/string_format.h>
 
+#include <algorithm>
 #include <cassert>
 #include <tuple>
 #include <string>
@@ -148,6 +149,25 @@ namespace TrenchBroom {
                 ++m_state.cur;
             }
 
+            /**
+             * Advances to the given position, which must not be before the current position. This is faster than
+             * advancing one character at a time, but the characters up to the given position must not contain any
+             * line breaks.
+             */
+            void advanceTo(const char* pos) {
+                assert(pos >= m_state.cur && pos <= m_end);
+                if (std::find(m_state.cur, pos, m_escapeChar) != pos) {
+                    // the escaped state depends on the sequence of escape characters
+                    while (m_state.cur < pos) {
+                        advance();
+                    }
+                } else if (pos > m_state.cur) {
+                    m_state.column += static_cast<size_t>(pos - m_state.cur);
+                    m_state.cur = pos;
+                    m_state.escaped = false;
+                }
+            }
+
             void errorIfEof() const {
                 if (eof()) {
                     throw ParserException("Unexpected end of file");
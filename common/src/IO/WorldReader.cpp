@@ -87,6 +87,15 @@ namespace TrenchBroom {
 
         std::unique_ptr<Model::WorldNode> WorldReader::read(const vm::bbox3& worldBounds, ParserStatus& status) {
             readEntities(worldBounds, status);
+            return finishWorld(status);
+        }
+
+        std::unique_ptr<Model::WorldNode> WorldReader::read(std::vector<ObjectInfo> objectInfos, const vm::bbox3& worldBounds, ParserStatus& status) {
+            readObjects(std::move(objectInfos), worldBounds, status);
+            return finishWorld(status);
+        }
+
+        std::unique_ptr<Model::WorldNode> WorldReader::finishWorld(ParserStatus& status) {
             sanitizeLayerSortIndicies(status);
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
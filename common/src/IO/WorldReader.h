@@ -51,6 +51,16 @@ namespace TrenchBroom {
 
             std::unique_ptr<Model::WorldNode> read(const vm::bbox3& worldBounds, ParserStatus& status);
 
+            /**
+             * Creates the world from the given object infos instead of parsing the string passed to the constructor.
+             *
+             * @param objectInfos the object infos, in the order in which they would appear in the map file
+             * @param worldBounds world bounds
+             * @param status status
+             * @return the world node
+             */
+            std::unique_ptr<Model::WorldNode> read(std::vector<ObjectInfo> objectInfos, const vm::bbox3& worldBounds, ParserStatus& status);
+
             /**
              * Try to parse the given string as the given map formats, in order.
              * Returns the world if parsing is successful, otherwise throws an exception.
@@ -64,6 +74,7 @@ namespace TrenchBroom {
              */
             static std::unique_ptr<Model::WorldNode> tryRead(std::string_view str, const std::vector<Model::MapFormat>& mapFormatsToTry, const vm::bbox3& worldBounds, ParserStatus& status);
         private:            
+            std::unique_ptr<Model::WorldNode> finishWorld(ParserStatus& status);
             void sanitizeLayerSortIndicies(ParserStatus& status);            
         private: // implement MapReader interface
             Model::Node* onWorldNode(std::unique_ptr<Model::WorldNode> worldNode, ParserStatus& status) override;
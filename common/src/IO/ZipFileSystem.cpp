@@ -20,11 +20,18 @@
 #include "ZipFileSystem.h"
 
 #include "IO/File.h"
+#include "IO/FileCache.h"
 #include "IO/DiskFileSystem.h"
 
+#include <cstdio>
+#include <limits>
 #include <memory>
 #include <string>
 
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/types.h>
+#endif
+
 namespace TrenchBroom {
     namespace IO {
         // ZipFileSystem::ZipCompressedFile
@@ -34,6 +41,22 @@ namespace TrenchBroom {
         m_fileIndex(fileIndex) {}
 
         std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::doOpen() const {
+            auto& cache = m_owner->m_cache;
+            if (!cache) {
+                return extract();
+            }
+
+            const auto key = m_owner->cacheKey(m_fileIndex);
+            if (auto file = cache->get(key)) {
+                return file;
+            }
+
+            auto file = extract();
+            cache->put(key, file);
+            return file;
+        }
+
+        std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::extract() const {
             const auto path = Path(m_owner->filename(m_fileIndex));
 
             mz_zip_archive_file_stat stat;
@@ -45,6 +68,7 @@ namespace TrenchBroom {
             auto data = std::make_unique<char[]>(uncompressedSize);
             auto* begin = data.get();
 
+            // only reads from the archive are serialized, so entries are inflated concurrently
             if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, begin, uncompressedSize, 0)) {
                 throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + path.asString());
             }
@@ -54,23 +78,34 @@ namespace TrenchBroom {
 
         // ZipFileSystem
 
-        ZipFileSystem::ZipFileSystem(const Path& path) :
-        ZipFileSystem(nullptr, path) {}
+        ZipFileSystem::ZipFileSystem(const Path& path, std::shared_ptr<FileCache> cache) :
+        ZipFileSystem(nullptr, path, std::move(cache)) {}
 
-        ZipFileSystem::ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
-        ImageFileSystem(std::move(next), path) {
+        ZipFileSystem::ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path, std::shared_ptr<FileCache> cache) :
+        ImageFileSystem(std::move(next), path),
+        m_cache(std::move(cache)) {
             initialize();
         }
 
         ZipFileSystem::~ZipFileSystem() {
+            if (m_cache) {
+                m_cache->removeWithPrefix(cachePrefix());
+            }
             mz_zip_reader_end(&m_archive);
         }
 
         void ZipFileSystem::doReadDirectory() {
+            if (m_cache) {
+                // the archive may have changed since its entries were cached
+                m_cache->removeWithPrefix(cachePrefix());
+            }
+
             mz_zip_zero_struct(&m_archive);
+            m_archive.m_pRead = readArchiveData;
+            m_archive.m_pIO_opaque = this;
 
-            if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE) {
-                throw FileSystemException("Error calling mz_zip_reader_init_cfile");
+            if (mz_zip_reader_init(&m_archive, m_file->size(), 0) != MZ_TRUE) {
+                throw FileSystemException("Error calling mz_zip_reader_init");
             }
 
             const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -87,6 +122,36 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Seeks to the given offset using the same 64 bit capable function as miniz, so that archives larger than 2 GiB
+         * can be read where long is 32 bits wide.
+         */
+        static bool seekArchive(std::FILE* file, const mz_uint64 offset) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+            return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+            if (offset > static_cast<mz_uint64>(std::numeric_limits<off_t>::max())) {
+                return false;
+            }
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        /**
+         * Reads the given number of bytes at the given offset of the archive. miniz calls this concurrently when
+         * entries are extracted on several threads, and the seek and the read must not be interleaved.
+         */
+        size_t ZipFileSystem::readArchiveData(void* opaque, const mz_uint64 offset, void* buffer, const size_t size) {
+            auto* fs = static_cast<ZipFileSystem*>(opaque);
+            auto* file = fs->m_file->file();
+
+            const auto lock = std::lock_guard<std::mutex>{fs->m_readMutex};
+            if (!seekArchive(file, offset)) {
+                return 0;
+            }
+            return std::fread(buffer, 1, size, file);
+        }
+
         /**
          * Helper to get the filename of a file in the zip archive
          */
@@ -105,5 +170,13 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        std::string ZipFileSystem::cachePrefix() const {
+            return m_path.asString() + "|";
+        }
+
+        std::string ZipFileSystem::cacheKey(const mz_uint fileIndex) const {
+            return cachePrefix() + std::to_string(fileIndex);
+        }
     }
 }
@@ -22,16 +22,28 @@
 #include "IO/ImageFileSystem.h"
 
 #include <memory>
+#include <mutex>
 
 #include <miniz/miniz.h>
 
 namespace TrenchBroom {
     namespace IO {
+        class FileCache;
         class Path;
 
+        /**
+         * A file system backed by a zip archive.
+         *
+         * Entries can be opened concurrently. The archive is read through positional reads that are serialized by a
+         * mutex, but the entries are decompressed in parallel. If a file cache is given, decompressed entries are
+         * cached so that opening them again does not decompress them again. The cached entries are removed when the
+         * file system is destroyed.
+         */
         class ZipFileSystem : public ImageFileSystem {
         private:
             mz_zip_archive m_archive;
+            std::mutex m_readMutex;
+            std::shared_ptr<FileCache> m_cache;
         private:
             class ZipCompressedFile : public FileEntry {
             private:
@@ -41,16 +53,20 @@ namespace TrenchBroom {
                 ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
             private:
                 std::shared_ptr<File> doOpen() const override;
+                std::shared_ptr<File> extract() const;
             };
             friend class ZipCompressedFile;
         public:
-            explicit ZipFileSystem(const Path& path);
-            ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
+            explicit ZipFileSystem(const Path& path, std::shared_ptr<FileCache> cache = nullptr);
+            ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path, std::shared_ptr<FileCache> cache = nullptr);
             ~ZipFileSystem() override;
         private:
             void doReadDirectory() override;
         private:
+            static size_t readArchiveData(void* opaque, mz_uint64 offset, void* buffer, size_t size);
             std::string filename(mz_uint fileIndex);
+            std::string cachePrefix() const;
+            std::string cacheKey(mz_uint fileIndex) const;
         };
     }
 }
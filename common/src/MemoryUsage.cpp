@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryUsage.h"
+
+#include <array>
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+
+namespace TrenchBroom {
+    struct MemorySubsystemCounter {
+        std::atomic<size_t> bytes = 0u;
+        std::atomic<size_t> peakBytes = 0u;
+    };
+
+    static std::array<MemorySubsystemCounter, MemorySubsystemCount>& memorySubsystemCounters() {
+        static auto counters = std::array<MemorySubsystemCounter, MemorySubsystemCount>();
+        return counters;
+    }
+
+    static MemorySubsystemCounter& memorySubsystemCounter(const MemorySubsystem subsystem) {
+        return memorySubsystemCounters()[static_cast<size_t>(subsystem)];
+    }
+
+    static void addMemoryUsage(const MemorySubsystem subsystem, const size_t bytes) {
+        if (bytes == 0u) {
+            return;
+        }
+
+        auto& counter = memorySubsystemCounter(subsystem);
+        const auto newBytes = counter.bytes.fetch_add(bytes) + bytes;
+
+        auto peakBytes = counter.peakBytes.load();
+        while (peakBytes < newBytes && !counter.peakBytes.compare_exchange_weak(peakBytes, newBytes)) {}
+    }
+
+    static void removeMemoryUsage(const MemorySubsystem subsystem, const size_t bytes) {
+        if (bytes == 0u) {
+            return;
+        }
+
+        auto& counter = memorySubsystemCounter(subsystem);
+        counter.bytes.fetch_sub(bytes);
+    }
+
+    const std::string& memorySubsystemName(const MemorySubsystem subsystem) {
+        static const auto names = std::array<std::string, MemorySubsystemCount>{
+            "Brushes",
+            "Texture buffers",
+            "Entity models",
+            "Brush renderer arrays",
+            "Undo stack",
+        };
+        return names[static_cast<size_t>(subsystem)];
+    }
+
+    MemoryUsage memoryUsage(const MemorySubsystem subsystem) {
+        const auto& counter = memorySubsystemCounter(subsystem);
+        return MemoryUsage{counter.bytes.load(), counter.peakBytes.load()};
+    }
+
+    void resetPeakMemoryUsage() {
+        for (auto& counter : memorySubsystemCounters()) {
+            counter.peakBytes = counter.bytes.load();
+        }
+    }
+
+    static double toMiB(const size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    void writeMemoryReport(std::ostream& str) {
+        const auto flags = str.flags();
+        str << std::fixed << std::setprecision(2);
+
+        for (size_t i = 0u; i < MemorySubsystemCount; ++i) {
+            const auto subsystem = static_cast<MemorySubsystem>(i);
+            const auto usage = memoryUsage(subsystem);
+            str << memorySubsystemName(subsystem) << ": " << toMiB(usage.bytes) << " MiB (peak " << toMiB(usage.peakBytes) << " MiB)\n";
+        }
+
+        str.flags(flags);
+    }
+
+    MemoryCounter::MemoryCounter(const MemorySubsystem subsystem, const size_t bytes) :
+    m_subsystem(subsystem),
+    m_bytes(bytes) {
+        addMemoryUsage(m_subsystem, m_bytes);
+    }
+
+    MemoryCounter::MemoryCounter(const MemoryCounter& other) :
+    MemoryCounter(other.m_subsystem, other.m_bytes) {}
+
+    MemoryCounter::MemoryCounter(MemoryCounter&& other) noexcept :
+    m_subsystem(other.m_subsystem),
+    m_bytes(std::exchange(other.m_bytes, 0u)) {}
+
+    MemoryCounter& MemoryCounter::operator=(MemoryCounter other) noexcept {
+        using std::swap;
+        swap(*this, other);
+        return *this;
+    }
+
+    void swap(MemoryCounter& lhs, MemoryCounter& rhs) noexcept {
+        using std::swap;
+        swap(lhs.m_subsystem, rhs.m_subsystem);
+        swap(lhs.m_bytes, rhs.m_bytes);
+    }
+
+    MemoryCounter::~MemoryCounter() {
+        removeMemoryUsage(m_subsystem, m_bytes);
+    }
+
+    size_t MemoryCounter::bytes() const {
+        return m_bytes;
+    }
+
+    void MemoryCounter::setBytes(const size_t bytes) {
+        if (bytes > m_bytes) {
+            addMemoryUsage(m_subsystem, bytes - m_bytes);
+        } else {
+            removeMemoryUsage(m_subsystem, m_bytes - bytes);
+        }
+        m_bytes = bytes;
+    }
+}
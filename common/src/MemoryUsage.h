@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace TrenchBroom {
+    /**
+     * The subsystems to which memory usage is attributed.
+     */
+    enum class MemorySubsystem {
+        /**
+         * Brushes including their faces and geometry, wherever they are stored (nodes, undo stack, clipboard).
+         */
+        Brushes,
+        /**
+         * Texture image data held in main memory.
+         */
+        TextureBuffers,
+        /**
+         * Vertices and collision data of entity model frames.
+         */
+        EntityModels,
+        /**
+         * The main memory copies of the brush renderer's vertex and index arrays, whose space is managed by
+         * AllocationTracker.
+         */
+        BrushRendererArrays,
+        /**
+         * The commands on the undo and redo stacks of the command processor and in pending transactions. The faces
+         * and geometry of brushes held by these commands are only counted as brushes.
+         */
+        UndoStack,
+    };
+
+    constexpr size_t MemorySubsystemCount = 5u;
+
+    const std::string& memorySubsystemName(MemorySubsystem subsystem);
+
+    struct MemoryUsage {
+        size_t bytes;
+        size_t peakBytes;
+    };
+
+    /**
+     * Returns the number of bytes that are currently attributed to the given subsystem, and the highest number of bytes
+     * that were attributed to it at any time since the program was started or since resetPeakMemoryUsage was called.
+     *
+     * Memory usage is estimated by the owners of the memory, so the values do not include allocator overhead and may
+     * not include all memory that a subsystem uses.
+     */
+    MemoryUsage memoryUsage(MemorySubsystem subsystem);
+
+    /**
+     * Resets the peak memory usage of all subsystems to their current memory usage.
+     */
+    void resetPeakMemoryUsage();
+
+    /**
+     * Writes the memory usage of all subsystems to the given stream, one line per subsystem.
+     */
+    void writeMemoryReport(std::ostream& str);
+
+    /**
+     * Attributes a number of bytes to a subsystem for as long as it exists.
+     *
+     * Objects whose memory usage should be accounted for hold a counter and update it whenever their memory usage
+     * changes. Copying a counter attributes its bytes to its subsystem again, as the copy of the owning object uses the
+     * same amount of memory. Moving a counter transfers its bytes to the new counter.
+     *
+     * Counters can be created, updated and destroyed on any thread.
+     */
+    class MemoryCounter {
+    private:
+        MemorySubsystem m_subsystem;
+        size_t m_bytes;
+    public:
+        explicit MemoryCounter(MemorySubsystem subsystem, size_t bytes = 0u);
+
+        MemoryCounter(const MemoryCounter& other);
+        MemoryCounter(MemoryCounter&& other) noexcept;
+        MemoryCounter& operator=(MemoryCounter other) noexcept;
+
+        friend void swap(MemoryCounter& lhs, MemoryCounter& rhs) noexcept;
+
+        ~MemoryCounter();
+
+        size_t bytes() const;
+        void setBytes(size_t bytes);
+    };
+}
@@ -26,6 +26,7 @@
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
+#include "Model/BrushHullCache.h"
 #include "Model/MapFormat.h"
 #include "Model/TexCoordSystem.h"
 
@@ -43,7 +44,9 @@
 #include <vecmath/polygon.h>
 #include <vecmath/util.h>
 
+#include <algorithm>
 #include <iterator>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -58,11 +61,13 @@ namespace TrenchBroom {
             }
         };
 
-        Brush::Brush() {}
+        Brush::Brush() :
+        m_memoryCounter(MemorySubsystem::Brushes) {}
 
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr),
+        m_memoryCounter(other.m_memoryCounter) {
             if (m_geometry) {
                 for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
@@ -75,7 +80,8 @@ namespace TrenchBroom {
 
         Brush::Brush(Brush&& other) noexcept :
         m_faces(std::move(other.m_faces)),
-        m_geometry(std::move(other.m_geometry)) {}
+        m_geometry(std::move(other.m_geometry)),
+        m_memoryCounter(std::move(other.m_memoryCounter)) {}
 
         Brush& Brush::operator=(Brush other) noexcept {
             using std::swap;
@@ -87,12 +93,16 @@ namespace TrenchBroom {
             using std::swap;
             swap(lhs.m_faces, rhs.m_faces);
             swap(lhs.m_geometry, rhs.m_geometry);
+            swap(lhs.m_memoryCounter, rhs.m_memoryCounter);
         }
         
         Brush::~Brush() = default;
 
         Brush::Brush(std::vector<BrushFace> faces) :
-        m_faces(std::move(faces)) {}
+        m_faces(std::move(faces)),
+        m_memoryCounter(MemorySubsystem::Brushes) {
+            updateMemoryUsage();
+        }
 
         kdl::result<Brush, BrushError> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace> faces) {
             Brush brush(std::move(faces));
@@ -100,6 +110,28 @@ namespace TrenchBroom {
                 .and_then([&]() { return std::move(brush); });
         }
 
+        kdl::result<Brush, BrushError> Brush::create(std::vector<BrushFace> faces, std::unique_ptr<BrushGeometry> geometry) {
+            if (geometry == nullptr || geometry->faceCount() != faces.size() || !geometry->closed()) {
+                return BrushError::InvalidBrush;
+            }
+
+            Brush brush(std::move(faces));
+            
+            size_t faceIndex = 0u;
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                brush.m_faces[faceIndex].setGeometry(faceGeometry);
+                faceGeometry->setPayload(faceIndex);
+                ++faceIndex;
+            }
+
+            brush.m_geometry = std::move(geometry);
+            brush.updateMemoryUsage();
+
+            assert(brush.checkFaceLinks());
+
+            return std::move(brush);
+        }
+
         kdl::result<void, BrushError> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds) {
             // First, add all faces to the brush geometry
             BrushFace::sortFaces(m_faces);
@@ -124,32 +156,52 @@ namespace TrenchBroom {
                 return BrushError::InvalidBrush;
             }
             
+            // Check this before moving any faces so that no faces are destroyed if the brush is incomplete
+            for (const BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                if (!faceGeometry->payload()) {
+                    return BrushError::IncompleteBrush;
+                }
+            }
+
             // Now collect all faces which still remain
             std::vector<BrushFace> remainingFaces;
             remainingFaces.reserve(m_faces.size());
             
             for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
-                if (const auto faceIndex = faceGeometry->payload()) {
-                    remainingFaces.push_back(std::move(m_faces[*faceIndex]));
-                    faceGeometry->setPayload(remainingFaces.size() - 1u);
-                } else {
-                    return BrushError::IncompleteBrush;
-                }
+                const auto faceIndex = *faceGeometry->payload();
+                remainingFaces.push_back(std::move(m_faces[faceIndex]));
+                faceGeometry->setPayload(remainingFaces.size() - 1u);
             }
 
             m_faces = std::move(remainingFaces);
             m_geometry = std::move(geometry);
+            updateMemoryUsage();
             
             assert(checkFaceLinks());
 
             return kdl::void_success;
         }
+
+        void Brush::updateMemoryUsage() {
+            auto bytes = m_faces.capacity() * sizeof(BrushFace);
+            if (m_geometry) {
+                bytes += sizeof(BrushGeometry)
+                    + m_geometry->vertexCount() * sizeof(BrushVertex)
+                    + m_geometry->edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge))
+                    + m_geometry->faceCount() * sizeof(BrushFaceGeometry);
+            }
+            m_memoryCounter.setBytes(bytes);
+        }
         
         const vm::bbox3& Brush::bounds() const {
             ensure(m_geometry != nullptr, "geometry is null");
             return m_geometry->bounds();
         }
 
+        size_t Brush::memoryUsage() const {
+            return m_memoryCounter.bytes();
+        }
+
         std::optional<size_t> Brush::findFace(const std::string& textureName) const {
             return kdl::vec_index_of(m_faces, [&](const BrushFace& face) { return face.attributes().textureName() == textureName; });
         }
@@ -454,12 +506,12 @@ namespace TrenchBroom {
             return result;
         }
 
-        bool Brush::canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const {
-            return doCanMoveVertices(worldBounds, vertices, delta, true).success;
+        bool Brush::canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta, BrushHullCache* hullCache) const {
+            return doCanMoveVertices(worldBounds, vertices, delta, true, hullCache).success;
         }
 
-        kdl::result<void, BrushError> Brush::moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool uvLock) {
-            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
+        kdl::result<void, BrushError> Brush::moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool uvLock, BrushHullCache* hullCache) {
+            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock, hullCache);
         }
 
         bool Brush::canAddVertex(const vm::bbox3& worldBounds, const vm::vec3& position) const {
@@ -545,7 +597,7 @@ namespace TrenchBroom {
             return updateFacesFromGeometry(worldBounds, matcher, newGeometry, uvLock);
         }
 
-        bool Brush::canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const {
+        bool Brush::canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, BrushHullCache* hullCache) const {
             ensure(m_geometry != nullptr, "geometry is null");
             ensure(!edgePositions.empty(), "no edge positions");
 
@@ -553,7 +605,7 @@ namespace TrenchBroom {
             vm::segment3::get_vertices(
                 std::begin(edgePositions), std::end(edgePositions),
                 std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false, hullCache);
 
             if (!result.success) {
                 return false;
@@ -568,22 +620,22 @@ namespace TrenchBroom {
             return true;
         }
 
-        kdl::result<void, BrushError> Brush::moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, const bool uvLock) {
+        kdl::result<void, BrushError> Brush::moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, const bool uvLock, BrushHullCache* hullCache) {
             assert(canMoveEdges(worldBounds, edgePositions, delta));
 
             std::vector<vm::vec3> vertexPositions;
             vm::segment3::get_vertices(std::begin(edgePositions), std::end(edgePositions),
                                        std::back_inserter(vertexPositions));
-            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
+            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock, hullCache);
         }
 
-        bool Brush::canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const {
+        bool Brush::canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, BrushHullCache* hullCache) const {
             ensure(m_geometry != nullptr, "geometry is null");
             ensure(!facePositions.empty(), "no face positions");
 
             std::vector<vm::vec3> vertexPositions;
             vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false, hullCache);
 
             if (!result.success) {
                 return false;
@@ -598,26 +650,33 @@ namespace TrenchBroom {
             return true;
         }
 
-        kdl::result<void, BrushError> Brush::moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, const bool uvLock) {
+        kdl::result<void, BrushError> Brush::moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, const bool uvLock, BrushHullCache* hullCache) {
             assert(canMoveFaces(worldBounds, facePositions, delta));
 
             std::vector<vm::vec3> vertexPositions;
             vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
-            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
+            return doMoveVertices(worldBounds, vertexPositions, delta, uvLock, hullCache);
         }
 
-        Brush::CanMoveVerticesResult::CanMoveVerticesResult(const bool s, BrushGeometry&& g) :
+        Brush::CanMoveVerticesResult::CanMoveVerticesResult(const bool s, std::shared_ptr<const BrushGeometry> g) :
         success(s),
-        geometry(std::make_unique<BrushGeometry>(std::move(g))) {}
+        geometry(std::move(g)) {}
 
         Brush::CanMoveVerticesResult Brush::CanMoveVerticesResult::rejectVertexMove() {
-            return CanMoveVerticesResult(false, BrushGeometry());
+            return CanMoveVerticesResult(false, nullptr);
         }
 
-        Brush::CanMoveVerticesResult Brush::CanMoveVerticesResult::acceptVertexMove(BrushGeometry&& result) {
+        Brush::CanMoveVerticesResult Brush::CanMoveVerticesResult::acceptVertexMove(std::shared_ptr<const BrushGeometry> result) {
             return CanMoveVerticesResult(true, std::move(result));
         }
 
+        static std::shared_ptr<const BrushGeometry> findOrBuildHull(BrushHullCache* hullCache, std::vector<vm::vec3> points) {
+            if (hullCache) {
+                return hullCache->findOrBuild(std::move(points));
+            }
+            return std::make_shared<const BrushGeometry>(points);
+        }
+
         /*
          We determine whether a move is valid by considering the vertices being moved and the vertices
          remaining at their positions as polyhedra. Depending on whether or not they really are polyhedra,
@@ -646,7 +705,7 @@ namespace TrenchBroom {
          If `allowVertexRemoval` is true, vertices can be moved inside a remaining polyhedron.
 
          */
-        Brush::CanMoveVerticesResult Brush::doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, const bool allowVertexRemoval) const {
+        Brush::CanMoveVerticesResult Brush::doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, const bool allowVertexRemoval, BrushHullCache* hullCache) const {
             // Should never occur, takes care of the first row.
             if (vertexPositions.empty() || vm::is_zero(delta, vm::C::almost_zero())) {
                 return CanMoveVerticesResult::rejectVertexMove();
@@ -676,9 +735,14 @@ namespace TrenchBroom {
                 }
             }
 
-            BrushGeometry remaining(remainingPoints);
-            BrushGeometry moving(movingPoints);
-            BrushGeometry result(resultPoints);
+            // the remaining vertices do not change while vertices are dragged, so their hull is usually cached
+            const auto remainingHull = findOrBuildHull(hullCache, std::move(remainingPoints));
+            const auto resultHull = findOrBuildHull(hullCache, std::move(resultPoints));
+            const BrushGeometry moving(movingPoints);
+
+            const BrushGeometry* remainingGeometry = remainingHull.get();
+            const BrushGeometry* movingGeometry = &moving;
+            const BrushGeometry& result = *resultHull;
 
             // Will the result go out of world bounds?
             if (!worldBounds.contains(result.bounds())) {
@@ -687,7 +751,7 @@ namespace TrenchBroom {
 
             // Special case, takes care of the first column.
             if (moving.vertexCount() == vertexCount()) {
-                return CanMoveVerticesResult::acceptVertexMove(std::move(result));
+                return CanMoveVerticesResult::acceptVertexMove(resultHull);
             }
 
             // Will vertices be removed?
@@ -706,24 +770,23 @@ namespace TrenchBroom {
             }
 
             // One of the remaining two ok cases?
-            if ((moving.point() && remaining.polygon()) ||
-                (moving.edge() && remaining.edge())) {
-                return CanMoveVerticesResult::acceptVertexMove(std::move(result));
+            if ((movingGeometry->point() && remainingGeometry->polygon()) ||
+                (movingGeometry->edge() && remainingGeometry->edge())) {
+                return CanMoveVerticesResult::acceptVertexMove(resultHull);
             }
 
             // Invert if necessary.
-            if (remaining.point() || remaining.edge() || (remaining.polygon() && moving.polyhedron())) {
-                using std::swap;
-                swap(remaining, moving);
+            if (remainingGeometry->point() || remainingGeometry->edge() || (remainingGeometry->polygon() && movingGeometry->polyhedron())) {
+                std::swap(remainingGeometry, movingGeometry);
                 delta = -delta;
             }
 
             // Now check if any of the moving vertices would travel through the remaining fragment and out the other side.
-            for (const auto* vertex : moving.vertices()) {
+            for (const auto* vertex : movingGeometry->vertices()) {
                 const auto& oldPos = vertex->position();
                 const auto newPos = oldPos + delta;
 
-                for (const auto* face : remaining.faces()) {
+                for (const auto* face : remainingGeometry->faces()) {
                     if (face->pointStatus(oldPos, vm::constants<FloatType>::point_status_epsilon()) == vm::plane_status::below &&
                         face->pointStatus(newPos, vm::constants<FloatType>::point_status_epsilon()) == vm::plane_status::above) {
                         const auto ray = vm::ray3(oldPos, normalize(newPos - oldPos));
@@ -735,10 +798,10 @@ namespace TrenchBroom {
                 }
             }
 
-            return CanMoveVerticesResult::acceptVertexMove(std::move(result));
+            return CanMoveVerticesResult::acceptVertexMove(resultHull);
         }
 
-        kdl::result<void, BrushError> Brush::doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool uvLock) {
+        kdl::result<void, BrushError> Brush::doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool uvLock, BrushHullCache* hullCache) {
             ensure(m_geometry != nullptr, "geometry is null");
             ensure(!vertexPositions.empty(), "no vertex positions");
             assert(canMoveVertices(worldBounds, vertexPositions, delta));
@@ -755,7 +818,9 @@ namespace TrenchBroom {
                 }
             }
             
-            BrushGeometry newGeometry(newVertices);
+            // reuse the result hull if the move was checked beforehand, it will not be needed again
+            const auto newHull = hullCache ? hullCache->take(std::move(newVertices)) : std::make_shared<const BrushGeometry>(newVertices);
+            const BrushGeometry& newGeometry = *newHull;
 
             using VecMap = std::map<vm::vec3, vm::vec3>;
             VecMap vertexMapping;
@@ -914,10 +979,68 @@ namespace TrenchBroom {
                     return BrushError::InvalidFace;
                 }
             }
-            
+
+            if (transformGeometry(worldBounds, transformation)) {
+                return kdl::void_success;
+            }
             return updateGeometryFromFaces(worldBounds);
         }
 
+        /**
+         * Returns whether the given transformation is affine and its linear part has a positive determinant. Such a
+         * transformation maps a convex polyhedron to a convex polyhedron with the same topology and winding.
+         */
+        static bool isOrientationPreservingAffine(const vm::mat4x4& m) {
+            if (m[0][3] != 0.0 || m[1][3] != 0.0 || m[2][3] != 0.0 || m[3][3] != 1.0) {
+                return false;
+            }
+
+            const auto determinant =
+                  m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                - m[1][0] * (m[0][1] * m[2][2] - m[0][2] * m[2][1])
+                + m[2][0] * (m[0][1] * m[1][2] - m[0][2] * m[1][1]);
+            return determinant > vm::constants<FloatType>::almost_zero();
+        }
+
+        bool Brush::transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation) {
+            if (m_geometry == nullptr || !isOrientationPreservingAffine(transformation)) {
+                return false;
+            }
+
+            // the same corrections that updateGeometryFromFaces applies
+            const auto edgeCount = m_geometry->edgeCount();
+            m_geometry->transform(transformation);
+            m_geometry->correctVertexPositions();
+            if (!m_geometry->healEdges() || m_geometry->edgeCount() != edgeCount) {
+                return false;
+            }
+
+            // a rebuilt geometry would have been clipped by the world bounds
+            if (!worldBounds.contains(m_geometry->bounds())) {
+                return false;
+            }
+
+            // the face boundaries were computed from the transformed face points, check that they still contain the
+            // transformed vertices
+            for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
+                const auto faceIndex = faceGeometry->payload();
+                if (!faceIndex) {
+                    return false;
+                }
+
+                const auto& boundary = m_faces[*faceIndex].boundary();
+                for (const BrushHalfEdge* halfEdge : faceGeometry->boundary()) {
+                    if (boundary.point_status(halfEdge->origin()->position(), vm::constants<FloatType>::point_status_epsilon()) != vm::plane_status::inside) {
+                        return false;
+                    }
+                }
+                faceGeometry->setPlane(boundary);
+            }
+
+            assert(checkFaceLinks());
+            return true;
+        }
+
         bool Brush::contains(const vm::bbox3& bounds) const {
             if (!this->bounds().contains(bounds)) {
                 return false;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "FloatType.h"
+#include "MemoryUsage.h"
 #include "Macros.h"
 #include "Model/BrushGeometry.h"
 
@@ -36,6 +37,8 @@ namespace TrenchBroom {
     namespace Model {
         template <typename P> class PolyhedronMatcher;
 
+        class BrushHullCache;
+
         enum class BrushError;
         enum class MapFormat;
 
@@ -53,6 +56,7 @@ namespace TrenchBroom {
         private:
             std::vector<BrushFace> m_faces;
             std::unique_ptr<BrushGeometry> m_geometry;
+            MemoryCounter m_memoryCounter;
         public:
             Brush();
 
@@ -65,12 +69,25 @@ namespace TrenchBroom {
             ~Brush();
             
             static kdl::result<Brush, BrushError> create(const vm::bbox3& worldBounds, std::vector<BrushFace> faces);
+
+            /**
+             * Creates a brush from the given faces and a previously computed geometry, e.g. one that was restored from a
+             * cache, without clipping the geometry again. The faces must be given in the order of the geometry's faces,
+             * that is, the i-th face belongs to the i-th face of the given geometry.
+             */
+            static kdl::result<Brush, BrushError> create(std::vector<BrushFace> faces, std::unique_ptr<BrushGeometry> geometry);
         private:
             Brush(std::vector<BrushFace> faces);
 
             kdl::result<void, BrushError> updateGeometryFromFaces(const vm::bbox3& worldBounds);
+            void updateMemoryUsage();
         public:
             const vm::bbox3& bounds() const;
+
+            /**
+             * Returns an estimate of the memory in bytes that this brush uses for its faces and its geometry.
+             */
+            size_t memoryUsage() const;
         public: // face management:
             std::optional<size_t> findFace(const std::string& textureName) const;
             std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -140,9 +157,14 @@ namespace TrenchBroom {
 
             std::vector<const BrushFace*> incidentFaces(const BrushVertex* vertex) const;
 
+            /*
+             * The vertex, edge and face move operations accept an optional hull cache. If given, the convex hulls that
+             * are built to check and perform the move are shared via the cache, e.g. between the steps of a drag.
+             */
+
             // vertex operations
-            bool canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const;
-            kdl::result<void, BrushError> moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool uvLock = false);
+            bool canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta, BrushHullCache* hullCache = nullptr) const;
+            kdl::result<void, BrushError> moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool uvLock = false, BrushHullCache* hullCache = nullptr);
 
             bool canAddVertex(const vm::bbox3& worldBounds, const vm::vec3& position) const;
             kdl::result<void, BrushError> addVertex(const vm::bbox3& worldBounds, const vm::vec3& position);
@@ -154,26 +176,26 @@ namespace TrenchBroom {
             kdl::result<void, BrushError> snapVertices(const vm::bbox3& worldBounds, FloatType snapTo, bool uvLock = false);
 
             // edge operations
-            bool canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const;
-            kdl::result<void, BrushError> moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, bool uvLock = false);
+            bool canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, BrushHullCache* hullCache = nullptr) const;
+            kdl::result<void, BrushError> moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, bool uvLock = false, BrushHullCache* hullCache = nullptr);
 
             // face operations
-            bool canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const;
-            kdl::result<void, BrushError> moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, bool uvLock = false);
+            bool canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, BrushHullCache* hullCache = nullptr) const;
+            kdl::result<void, BrushError> moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, bool uvLock = false, BrushHullCache* hullCache = nullptr);
         private:
             struct CanMoveVerticesResult {
             public:
                 bool success;
-                std::unique_ptr<BrushGeometry> geometry;
+                std::shared_ptr<const BrushGeometry> geometry;
             private:
-                CanMoveVerticesResult(bool s, BrushGeometry&& g);
+                CanMoveVerticesResult(bool s, std::shared_ptr<const BrushGeometry> g);
             public:
                 static CanMoveVerticesResult rejectVertexMove();
-                static CanMoveVerticesResult acceptVertexMove(BrushGeometry&& result);
+                static CanMoveVerticesResult acceptVertexMove(std::shared_ptr<const BrushGeometry> result);
             };
 
-            CanMoveVerticesResult doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, bool allowVertexRemoval) const;
-            kdl::result<void, BrushError> doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool lockTexture);
+            CanMoveVerticesResult doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, bool allowVertexRemoval, BrushHullCache* hullCache) const;
+            kdl::result<void, BrushError> doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool lockTexture, BrushHullCache* hullCache);
             /**
              * Tries to find 3 vertices in `left` and `right` that are related according to the PolyhedronMatcher, and
              * generates an affine transform for them which can then be used to implement UV lock.
@@ -231,6 +253,10 @@ namespace TrenchBroom {
             /**
              * Applies the given transformation to this brush.
              *
+             * If the transformation is affine and preserves orientation, it cannot change the topology of the brush,
+             * so the existing geometry is transformed in place and the order of the faces is retained. Otherwise, or if
+             * the transformed geometry does not match the transformed faces, the geometry is rebuilt from the faces.
+             *
              * If the brush becomes invalid, an error is returned.
              *
              * @param worldBounds the world bounds
@@ -239,6 +265,12 @@ namespace TrenchBroom {
              * @return a void result or an error if the operation fails
              */
             kdl::result<void, BrushError> transform(const vm::bbox3& worldBounds, const vm::mat4x4& transformation, bool lockTextures);
+        private:
+            /**
+             * Transforms the geometry of this brush in place after its faces have been transformed. Returns false if
+             * the transformation cannot be applied this way, in which case the geometry must be rebuilt from the faces.
+             */
+            bool transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation);
         public:
             bool contains(const vm::bbox3& bounds) const;
             bool contains(const Brush& brush) const;
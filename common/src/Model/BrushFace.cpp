@@ -48,6 +48,7 @@
 
 #include <sstream>
 #include <string>
+#include <variant>
 
 namespace TrenchBroom {
     namespace Model {
@@ -63,10 +64,10 @@ namespace TrenchBroom {
         Taggable(other),
         m_points(other.m_points),
         m_boundary(other.m_boundary),
-        m_attributes(other.m_attributes),
         m_textureReference(other.m_textureReference),
-        m_texCoordSystem(other.m_texCoordSystem ? other.m_texCoordSystem->clone() : nullptr),
         m_geometry(nullptr),
+        m_attributes(other.m_attributes),
+        m_texCoordSystem(other.m_texCoordSystem),
         m_lineNumber(other.m_lineNumber),
         m_lineCount(other.m_lineCount),
         m_selected(other.m_selected),
@@ -76,10 +77,10 @@ namespace TrenchBroom {
         Taggable(other),
         m_points(std::move(other.m_points)),
         m_boundary(std::move(other.m_boundary)),
-        m_attributes(std::move(other.m_attributes)),
         m_textureReference(std::move(other.m_textureReference)),
-        m_texCoordSystem(std::move(other.m_texCoordSystem)),
         m_geometry(other.m_geometry),
+        m_attributes(std::move(other.m_attributes)),
+        m_texCoordSystem(std::move(other.m_texCoordSystem)),
         m_lineNumber(other.m_lineNumber),
         m_lineCount(other.m_lineCount),
         m_selected(other.m_selected),
@@ -96,10 +97,10 @@ namespace TrenchBroom {
             swap(static_cast<Taggable&>(lhs), static_cast<Taggable&>(rhs));
             swap(lhs.m_points, rhs.m_points);
             swap(lhs.m_boundary, rhs.m_boundary);
-            swap(lhs.m_attributes, rhs.m_attributes);
             swap(lhs.m_textureReference, rhs.m_textureReference);
-            swap(lhs.m_texCoordSystem, rhs.m_texCoordSystem);
             swap(lhs.m_geometry, rhs.m_geometry);
+            swap(lhs.m_attributes, rhs.m_attributes);
+            swap(lhs.m_texCoordSystem, rhs.m_texCoordSystem);
             swap(lhs.m_lineNumber, rhs.m_lineNumber);
             swap(lhs.m_lineCount, rhs.m_lineCount);
             swap(lhs.m_selected, rhs.m_selected);
@@ -110,8 +111,8 @@ namespace TrenchBroom {
 
         kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, const MapFormat mapFormat) {
             return Model::isParallelTexCoordSystem(mapFormat)
-                   ? BrushFace::create(point0, point1, point2, attributes, std::make_unique<ParallelTexCoordSystem>(point0, point1, point2, attributes))
-                   : BrushFace::create(point0, point1, point2, attributes, std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, attributes));
+                   ? BrushFace::create(point0, point1, point2, attributes, TexCoordSystemStorage(std::in_place_type<ParallelTexCoordSystem>, point0, point1, point2, attributes))
+                   : BrushFace::create(point0, point1, point2, attributes, TexCoordSystemStorage(std::in_place_type<ParaxialTexCoordSystem>, point0, point1, point2, attributes));
         }
 
         kdl::result<BrushFace, BrushError> BrushFace::createFromStandard(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& inputAttribs, const MapFormat mapFormat) {
@@ -150,7 +151,25 @@ namespace TrenchBroom {
             return BrushFace::create(point1, point2, point3, attribs, std::move(texCoordSystem));
         }
 
+        /**
+         * Copies the given texture coordinate system into inline storage.
+         */
+        static BrushFace::TexCoordSystemStorage toTexCoordSystemStorage(std::unique_ptr<TexCoordSystem> texCoordSystem) {
+            ensure(texCoordSystem != nullptr, "texCoordSystem is null");
+            if (const auto* parallel = dynamic_cast<const ParallelTexCoordSystem*>(texCoordSystem.get())) {
+                return *parallel;
+            }
+
+            const auto* paraxial = dynamic_cast<const ParaxialTexCoordSystem*>(texCoordSystem.get());
+            ensure(paraxial != nullptr, "texCoordSystem is either parallel or paraxial");
+            return *paraxial;
+        }
+
         kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem) {
+            return BrushFace::create(point0, point1, point2, attributes, toTexCoordSystemStorage(std::move(texCoordSystem)));
+        }
+
+        kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, TexCoordSystemStorage texCoordSystem) {
             Points points = {{ vm::correct(point0), vm::correct(point1), vm::correct(point2) }};
             const auto [result, plane] = vm::from_points(points[0], points[1], points[2]);
             if (result) {
@@ -161,23 +180,24 @@ namespace TrenchBroom {
         }
 
         BrushFace::BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem) :
+        BrushFace(points, boundary, attributes, toTexCoordSystemStorage(std::move(texCoordSystem))) {}
+
+        BrushFace::BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, TexCoordSystemStorage texCoordSystem) :
         m_points(points),
         m_boundary(boundary),
+        m_geometry(nullptr),
         m_attributes(attributes),
         m_texCoordSystem(std::move(texCoordSystem)),
-        m_geometry(nullptr),
         m_lineNumber(0),
         m_lineCount(0),
         m_selected(false),
-        m_markedToRenderFace(false) {
-            ensure(m_texCoordSystem != nullptr, "texCoordSystem is null");
-        }
+        m_markedToRenderFace(false) {}
 
         bool operator==(const BrushFace& lhs, const BrushFace& rhs) {
             return lhs.m_points == rhs.m_points &&
             lhs.m_boundary == rhs.m_boundary &&
             lhs.m_attributes == rhs.m_attributes &&
-            *lhs.m_texCoordSystem == *rhs.m_texCoordSystem &&
+            lhs.texCoordSystem() == rhs.texCoordSystem() &&
             lhs.m_lineNumber == rhs.m_lineNumber &&
             lhs.m_lineCount == rhs.m_lineCount &&
             lhs.m_selected == rhs.m_selected;
@@ -215,11 +235,11 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<TexCoordSystemSnapshot> BrushFace::takeTexCoordSystemSnapshot() const {
-            return m_texCoordSystem->takeSnapshot();
+            return texCoordSystem().takeSnapshot();
         }
 
         void BrushFace::restoreTexCoordSystemSnapshot(const TexCoordSystemSnapshot& coordSystemSnapshot) {
-            coordSystemSnapshot.restore(*m_texCoordSystem);
+            coordSystemSnapshot.restore(mutableTexCoordSystem());
         }
 
         void BrushFace::copyTexCoordSystemFromFace(const TexCoordSystemSnapshot& coordSystemSnapshot, const BrushFaceAttributes& attributes, const vm::plane3& sourceFacePlane, const WrapStyle wrapStyle) {
@@ -227,16 +247,16 @@ namespace TrenchBroom {
             const auto seam = vm::intersect_plane_plane(sourceFacePlane, m_boundary);
             const auto refPoint = vm::project_point(seam, center());
 
-            coordSystemSnapshot.restore(*m_texCoordSystem);
+            coordSystemSnapshot.restore(mutableTexCoordSystem());
 
             // Get the texcoords at the refPoint using the source face's attributes and tex coord system
-            const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, attributes, vm::vec2f::one());
+            const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, attributes, vm::vec2f::one());
 
-            m_texCoordSystem->updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
+            mutableTexCoordSystem().updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
 
             // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
             if (!vm::is_zero(seam.direction, vm::C::almost_zero())) {
-                const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
                 const auto offsetChange = desriedCoords - currentCoords;
                 m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
             }
@@ -342,7 +362,7 @@ namespace TrenchBroom {
         void BrushFace::setAttributes(const BrushFaceAttributes& attributes) {
             const float oldRotation = m_attributes.rotation();
             m_attributes = attributes;
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+            mutableTexCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
         }
 
         bool BrushFace::setAttributes(const BrushFace& other) {
@@ -360,13 +380,11 @@ namespace TrenchBroom {
         }
 
         void BrushFace::resetTexCoordSystemCache() {
-            if (m_texCoordSystem != nullptr) {
-                m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
-            }
+            mutableTexCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
         }
 
         const TexCoordSystem& BrushFace::texCoordSystem() const {
-            return *m_texCoordSystem;
+            return std::visit([](const auto& texCoordSystem) -> const TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
         }
 
         const Assets::Texture* BrushFace::texture() const {
@@ -396,52 +414,52 @@ namespace TrenchBroom {
         }
 
         vm::vec3 BrushFace::textureXAxis() const {
-            return m_texCoordSystem->xAxis();
+            return texCoordSystem().xAxis();
         }
 
         vm::vec3 BrushFace::textureYAxis() const {
-            return m_texCoordSystem->yAxis();
+            return texCoordSystem().yAxis();
         }
 
         void BrushFace::resetTextureAxes() {
-            m_texCoordSystem->resetTextureAxes(m_boundary.normal);
+            mutableTexCoordSystem().resetTextureAxes(m_boundary.normal);
         }
 
         void BrushFace::resetTextureAxesToParaxial() {
-            m_texCoordSystem->resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
+            mutableTexCoordSystem().resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
         }
 
         void BrushFace::convertToParaxial() {
-            auto [newTexCoordSystem, newAttributes] = m_texCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+            auto [newTexCoordSystem, newAttributes] = texCoordSystem().toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
 
             m_attributes = newAttributes;
-            m_texCoordSystem = std::move(newTexCoordSystem);
+            setTexCoordSystem(std::move(newTexCoordSystem));
         }
 
         void BrushFace::convertToParallel() {
-            auto [newTexCoordSystem, newAttributes] = m_texCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+            auto [newTexCoordSystem, newAttributes] = texCoordSystem().toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
 
             m_attributes = newAttributes;
-            m_texCoordSystem = std::move(newTexCoordSystem);
+            setTexCoordSystem(std::move(newTexCoordSystem));
         }
 
 
         void BrushFace::moveTexture(const vm::vec3& up, const vm::vec3& right, const vm::vec2f& offset) {
-            m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attributes);
+            mutableTexCoordSystem().moveTexture(m_boundary.normal, up, right, offset, m_attributes);
         }
 
         void BrushFace::rotateTexture(const float angle) {
             const float oldRotation = m_attributes.rotation();
-            m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attributes);
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+            mutableTexCoordSystem().rotateTexture(m_boundary.normal, angle, m_attributes);
+            mutableTexCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
         }
 
         void BrushFace::shearTexture(const vm::vec2f& factors) {
-            m_texCoordSystem->shearTexture(m_boundary.normal, factors);
+            mutableTexCoordSystem().shearTexture(m_boundary.normal, factors);
         }
 
         void BrushFace::flipTexture(const vm::vec3& /* cameraUp */, const vm::vec3& cameraRight, const vm::direction cameraRelativeFlipDirection) {
-            const vm::mat4x4 texToWorld = m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
+            const vm::mat4x4 texToWorld = texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
 
             const vm::vec3 texUAxisInWorld = vm::normalize((texToWorld * vm::vec4d(1, 0, 0, 0)).xyz());
             const vm::vec3 texVAxisInWorld = vm::normalize((texToWorld * vm::vec4d(0, 1, 0, 0)).xyz());
@@ -490,7 +508,7 @@ namespace TrenchBroom {
 
             return setPoints(m_points[0], m_points[1], m_points[2])
                 .and_then([&]() {
-                    m_texCoordSystem->transform(oldBoundary, m_boundary, transform, m_attributes, textureSize(), lockTexture, invariant);
+                    mutableTexCoordSystem().transform(oldBoundary, m_boundary, transform, m_attributes, textureSize(), lockTexture, invariant);
                 });
         }
 
@@ -518,12 +536,12 @@ namespace TrenchBroom {
                     const auto refPoint = project_point(seam, center());
 
                     // Get the texcoords at the refPoint using the old face's attribs and tex coord system
-                    const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                    const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
 
-                    m_texCoordSystem->updateNormal(oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
+                    mutableTexCoordSystem().updateNormal(oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
 
                     // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
-                    const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                    const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
                     const auto offsetChange = desriedCoords - currentCoords;
                     m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
                 }
@@ -531,7 +549,7 @@ namespace TrenchBroom {
         }
 
         vm::mat4x4 BrushFace::projectToBoundaryMatrix() const {
-            const auto texZAxis = m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
+            const auto texZAxis = texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
             const auto worldToPlaneMatrix = vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
             const auto [invertible, planeToWorldMatrix] = vm::invert(worldToPlaneMatrix); assert(invertible); unused(invertible);
             return planeToWorldMatrix * vm::mat4x4::zero_out<2>() * worldToPlaneMatrix;
@@ -539,22 +557,22 @@ namespace TrenchBroom {
 
         vm::mat4x4 BrushFace::toTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return vm::mat4x4::zero_out<2>() * m_texCoordSystem->toMatrix(offset, scale);
+                return vm::mat4x4::zero_out<2>() * texCoordSystem().toMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->toMatrix(offset, scale);
+                return texCoordSystem().toMatrix(offset, scale);
             }
         }
 
         vm::mat4x4 BrushFace::fromTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return projectToBoundaryMatrix() * m_texCoordSystem->fromMatrix(offset, scale);
+                return projectToBoundaryMatrix() * texCoordSystem().fromMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->fromMatrix(offset, scale);
+                return texCoordSystem().fromMatrix(offset, scale);
             }
         }
 
         float BrushFace::measureTextureAngle(const vm::vec2f& center, const vm::vec2f& point) const {
-            return m_texCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+            return texCoordSystem().measureAngle(m_attributes.rotation(), center, point);
         }
 
         size_t BrushFace::vertexCount() const {
@@ -619,7 +637,7 @@ namespace TrenchBroom {
         }
 
         vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const {
-            return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
+            return texCoordSystem().getTexCoords(point, m_attributes, textureSize());
         }
 
         FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const {
@@ -633,6 +651,14 @@ namespace TrenchBroom {
             }
         }
 
+        TexCoordSystem& BrushFace::mutableTexCoordSystem() {
+            return std::visit([](auto& texCoordSystem) -> TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
+        }
+
+        void BrushFace::setTexCoordSystem(std::unique_ptr<TexCoordSystem> texCoordSystem) {
+            m_texCoordSystem = toTexCoordSystemStorage(std::move(texCoordSystem));
+        }
+
         kdl::result<void, BrushError> BrushFace::setPoints(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2) {
             m_points[0] = point0;
             m_points[1] = point1;
@@ -24,6 +24,8 @@
 #include "Assets/AssetReference.h"
 #include "Model/BrushFaceAttributes.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
 #include "Model/Tag.h" // BrushFace inherits from Taggable
 
 #include <kdl/result_forward.h>
@@ -37,6 +39,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,9 +48,6 @@ namespace TrenchBroom {
     }
 
     namespace Model {
-        class TexCoordSystem;
-        class TexCoordSystemSnapshot;
-        enum class WrapStyle;
         enum class BrushError;
         enum class MapFormat;
 
@@ -81,15 +81,22 @@ namespace TrenchBroom {
         public:
             using VertexList = kdl::transform_adapter<BrushHalfEdgeList, TransformHalfEdgeToVertex>;
             using EdgeList = kdl::transform_adapter<BrushHalfEdgeList, TransformHalfEdgeToEdge>;
+
+            /**
+             * The texture coordinate system is stored inline so that copying a face does not require a heap
+             * allocation.
+             */
+            using TexCoordSystemStorage = std::variant<ParaxialTexCoordSystem, ParallelTexCoordSystem>;
         private:
+            // the fields used when building and rendering brush geometry are kept together
             BrushFace::Points m_points;
             vm::plane3 m_boundary;
-            BrushFaceAttributes m_attributes;
-
             Assets::AssetReference<Assets::Texture> m_textureReference;
-            std::unique_ptr<TexCoordSystem> m_texCoordSystem;
             BrushFaceGeometry* m_geometry;
 
+            BrushFaceAttributes m_attributes;
+            TexCoordSystemStorage m_texCoordSystem;
+
             mutable size_t m_lineNumber;
             mutable size_t m_lineCount;
             bool m_selected;
@@ -135,8 +142,10 @@ namespace TrenchBroom {
             static kdl::result<BrushFace, BrushError> createFromValve(const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const BrushFaceAttributes& attributes, const vm::vec3& texAxisX, const vm::vec3& texAxisY, MapFormat mapFormat);
 
             static kdl::result<BrushFace, BrushError> create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem);
+            static kdl::result<BrushFace, BrushError> create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, TexCoordSystemStorage texCoordSystem);
 
             BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem);
+            BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, TexCoordSystemStorage texCoordSystem);
 
             friend bool operator==(const BrushFace& lhs, const BrushFace& rhs);
             friend bool operator!=(const BrushFace& lhs, const BrushFace& rhs);
@@ -215,6 +224,9 @@ namespace TrenchBroom {
 
             FloatType intersectWithRay(const vm::ray3& ray) const;
         private:
+            TexCoordSystem& mutableTexCoordSystem();
+            void setTexCoordSystem(std::unique_ptr<TexCoordSystem> texCoordSystem);
+
             kdl::result<void, BrushError> setPoints(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
             void correctPoints();
         public: // brush renderer
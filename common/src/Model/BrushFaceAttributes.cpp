@@ -87,7 +87,7 @@ namespace TrenchBroom {
         }
 
         const std::string& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return m_textureName.str();
         }
 
         const vm::vec2f& BrushFaceAttributes::offset() const {
@@ -151,10 +151,10 @@ namespace TrenchBroom {
         }
         
         bool BrushFaceAttributes::setTextureName(const std::string& textureName) {
-            if (textureName == m_textureName) {
+            if (textureName == m_textureName.str()) {
                 return false;
             } else {
-                m_textureName = textureName;
+                m_textureName = kdl::interned_string(textureName);
                 return true;
             }
         }
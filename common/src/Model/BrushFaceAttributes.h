@@ -21,6 +21,8 @@
 
 #include "Color.h"
 
+#include <kdl/interned_string.h>
+
 #include <vecmath/forward.h>
 
 #include <string>
@@ -36,7 +38,8 @@ namespace TrenchBroom {
         public:
             static const std::string NoTextureName;
         private:
-            std::string m_textureName;
+            // interned because many faces share the same few texture names, which makes copying faces cheap
+            kdl::interned_string m_textureName;
 
             vm::vec2f m_offset;
             vm::vec2f m_scale;
@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushHullCache.h"
+
+#include "Polyhedron.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Model {
+        BrushHullCache::BrushHullCache() = default;
+        BrushHullCache::~BrushHullCache() = default;
+
+        std::shared_ptr<const BrushGeometry> BrushHullCache::findOrBuild(std::vector<vm::vec3> points) {
+            // the order of the vertices changes whenever the brush geometry is rebuilt
+            std::sort(std::begin(points), std::end(points));
+            {
+                const auto lock = std::lock_guard<std::mutex>{m_mutex};
+                const auto it = m_hulls.find(points);
+                if (it != std::end(m_hulls)) {
+                    return it->second;
+                }
+            }
+
+            // build the hull without holding the lock, another thread may have cached it in the meantime
+            auto hull = std::make_shared<const BrushGeometry>(points);
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_hulls.emplace(std::move(points), std::move(hull)).first->second;
+        }
+
+        std::shared_ptr<const BrushGeometry> BrushHullCache::take(std::vector<vm::vec3> points) {
+            std::sort(std::begin(points), std::end(points));
+            {
+                const auto lock = std::lock_guard<std::mutex>{m_mutex};
+                const auto it = m_hulls.find(points);
+                if (it != std::end(m_hulls)) {
+                    auto hull = std::move(it->second);
+                    m_hulls.erase(it);
+                    return hull;
+                }
+            }
+
+            return std::make_shared<const BrushGeometry>(points);
+        }
+
+        size_t BrushHullCache::size() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_hulls.size();
+        }
+
+        void BrushHullCache::clear() {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            m_hulls.clear();
+        }
+    }
+}
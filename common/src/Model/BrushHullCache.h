@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/forward.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Caches the convex hulls that are built when checking and performing vertex moves. While vertices are dragged,
+         * the vertices that remain at their positions do not change, so their hull can be reused for every step of the
+         * drag, and the result hull of a successful check can be reused by the move itself.
+         *
+         * Hulls are keyed by the points they were built from, so a cache can be shared by any number of brushes and a
+         * stale hull is never used. The cache is thread safe. It is owned by whoever performs the drag and should be
+         * cleared when the drag ends.
+         */
+        class BrushHullCache {
+        private:
+            mutable std::mutex m_mutex;
+            std::map<std::vector<vm::vec3>, std::shared_ptr<const BrushGeometry>> m_hulls;
+        public:
+            BrushHullCache();
+            ~BrushHullCache();
+
+            /**
+             * Returns the cached hull of the given points, or builds and caches it if it is not cached yet.
+             */
+            std::shared_ptr<const BrushGeometry> findOrBuild(std::vector<vm::vec3> points);
+
+            /**
+             * Removes the hull of the given points from this cache and returns it. If it is not cached, it is built.
+             */
+            std::shared_ptr<const BrushGeometry> take(std::vector<vm::vec3> points);
+
+            size_t size() const;
+            void clear();
+        };
+    }
+}
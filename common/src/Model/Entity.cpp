@@ -202,11 +202,20 @@ namespace TrenchBroom {
             return findProperty(key) != std::end(m_properties);
         }
 
+        bool Entity::hasProperty(const kdl::interned_string& key) const {
+            return findProperty(key) != std::end(m_properties);
+        }
+
         bool Entity::hasProperty(const std::string& key, const std::string& value) const {
             const auto it = findProperty(key);
             return it != std::end(m_properties) && it->hasValue(value);
         }
 
+        bool Entity::hasProperty(const kdl::interned_string& key, const std::string& value) const {
+            const auto it = findProperty(key);
+            return it != std::end(m_properties) && it->hasValue(value);
+        }
+
         bool Entity::hasPropertyWithPrefix(const std::string& prefix, const std::string& value) const {
             for (const auto& property : m_properties) {
                 if (property.hasPrefixAndValue(prefix, value)) {
@@ -230,6 +239,11 @@ namespace TrenchBroom {
             return it != std::end(m_properties) ? &it->value() : nullptr;
         }
 
+        const std::string* Entity::property(const kdl::interned_string& key) const {
+            const auto it = findProperty(key);
+            return it != std::end(m_properties) ? &it->value() : nullptr;
+        }
+
         std::vector<std::string> Entity::propertyKeys() const {
             return kdl::vec_transform(m_properties, [](const auto& property) { return property.key(); });
         }
@@ -262,6 +276,10 @@ namespace TrenchBroom {
             return kdl::vec_filter(m_properties, [&](const auto& property) { return property.hasKey(key); });
         }
 
+        std::vector<EntityProperty> Entity::propertiesWithKey(const kdl::interned_string& key) const {
+            return kdl::vec_filter(m_properties, [&](const auto& property) { return property.hasKey(key); });
+        }
+
         std::vector<EntityProperty> Entity::propertiesWithPrefix(const std::string& prefix) const {
             return kdl::vec_filter(m_properties, [&](const auto& property) { return property.hasPrefix(prefix); });
         }
@@ -300,8 +318,8 @@ namespace TrenchBroom {
         
         void Entity::validateCachedProperties() const {
             if (!m_cachedProperties.has_value()) {
-                const auto* classnameValue = property(PropertyKeys::Classname);
-                const auto* originValue = property(PropertyKeys::Origin);
+                const auto* classnameValue = property(InternedPropertyKeys::Classname);
+                const auto* originValue = property(InternedPropertyKeys::Origin);
 
                 // order is important here because EntityRotationPolicy::getRotation accesses classname
                 m_cachedProperties = CachedProperties{};
@@ -319,6 +337,14 @@ namespace TrenchBroom {
             return std::find_if(std::begin(m_properties), std::end(m_properties), [&](const auto& property) { return property.hasKey(key); });
         }
 
+        std::vector<EntityProperty>::const_iterator Entity::findProperty(const kdl::interned_string& key) const {
+            return std::find_if(std::begin(m_properties), std::end(m_properties), [&](const auto& property) { return property.hasKey(key); });
+        }
+
+        std::vector<EntityProperty>::iterator Entity::findProperty(const kdl::interned_string& key) {
+            return std::find_if(std::begin(m_properties), std::end(m_properties), [&](const auto& property) { return property.hasKey(key); });
+        }
+
         bool operator==(const Entity& lhs, const Entity& rhs) {
             return lhs.properties() == rhs.properties();
         }
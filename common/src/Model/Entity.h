@@ -132,12 +132,15 @@ namespace TrenchBroom {
             void removeNumberedProperty(const std::string& prefix);
 
             bool hasProperty(const std::string& key) const;
+            bool hasProperty(const kdl::interned_string& key) const;
             bool hasProperty(const std::string& key, const std::string& value) const;
+            bool hasProperty(const kdl::interned_string& key, const std::string& value) const;
 
             bool hasPropertyWithPrefix(const std::string& prefix, const std::string& value) const;
             bool hasNumberedProperty(const std::string& prefix, const std::string& value) const;
 
             const std::string* property(const std::string& key) const;
+            const std::string* property(const kdl::interned_string& key) const;
             std::vector<std::string> propertyKeys() const;
 
             const std::string& classname() const;
@@ -149,6 +152,7 @@ namespace TrenchBroom {
             const vm::mat4x4& rotation() const;
 
             std::vector<EntityProperty> propertiesWithKey(const std::string& property) const;
+            std::vector<EntityProperty> propertiesWithKey(const kdl::interned_string& property) const;
             std::vector<EntityProperty> propertiesWithPrefix(const std::string& property) const;
             std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
@@ -161,6 +165,8 @@ namespace TrenchBroom {
 
             std::vector<EntityProperty>::const_iterator findProperty(const std::string& property) const;
             std::vector<EntityProperty>::iterator findProperty(const std::string& property);
+            std::vector<EntityProperty>::const_iterator findProperty(const kdl::interned_string& property) const;
+            std::vector<EntityProperty>::iterator findProperty(const kdl::interned_string& property);
         };
 
         bool operator==(const Entity& lhs, const Entity& rhs);
@@ -275,7 +275,7 @@ namespace TrenchBroom {
         bool EntityNodeBase::hasMissingSources() const {
             return (m_linkSources.empty() &&
                     m_killSources.empty() &&
-                m_entity.hasProperty(PropertyKeys::Targetname));
+                m_entity.hasProperty(InternedPropertyKeys::Targetname));
         }
 
         std::vector<std::string> EntityNodeBase::findMissingLinkTargets() const {
@@ -356,7 +356,7 @@ namespace TrenchBroom {
                 std::vector<EntityNodeBase*>::iterator it = std::begin(m_linkTargets);
                 while (it != rem) {
                     EntityNodeBase* target = *it;
-                    const auto* targetTargetname = target->entity().property(PropertyKeys::Targetname);
+                    const auto* targetTargetname = target->entity().property(InternedPropertyKeys::Targetname);
                     if (targetTargetname && *targetTargetname == targetname) {
                         target->removeLinkSource(this);
                         --rem;
@@ -375,7 +375,7 @@ namespace TrenchBroom {
                 std::vector<EntityNodeBase*>::iterator it = std::begin(m_killTargets);
                 while (it != rem) {
                     EntityNodeBase* target = *it;
-                    const auto* targetTargetname = target->entity().property(PropertyKeys::Targetname);
+                    const auto* targetTargetname = target->entity().property(InternedPropertyKeys::Targetname);
                     if (targetTargetname && *targetTargetname == targetname) {
                         target->removeKillSource(this);
                         --rem;
@@ -501,7 +501,7 @@ namespace TrenchBroom {
             addAllLinkTargets();
             addAllKillTargets();
 
-            const std::string* targetname = m_entity.property(PropertyKeys::Targetname);
+            const std::string* targetname = m_entity.property(InternedPropertyKeys::Targetname);
             if (targetname != nullptr && !targetname->empty()) {
                 addAllLinkSources(*targetname);
                 addAllKillSources(*targetname);
@@ -72,7 +72,7 @@ namespace TrenchBroom {
         bool EntityNodeIndexQuery::execute(const EntityNodeBase* node, const std::string& value) const {
             switch (m_type) {
                 case Type_Exact:
-                    return node->entity().hasProperty(m_pattern, value);
+                    return node->entity().hasProperty(m_internedPattern, value);
                 case Type_Prefix:
                     return node->entity().hasPropertyWithPrefix(m_pattern, value);
                 case Type_Numbered:
@@ -87,7 +87,7 @@ namespace TrenchBroom {
             const auto& entity = node->entity();
             switch (m_type) {
                 case Type_Exact:
-                    return entity.propertiesWithKey(m_pattern);
+                    return entity.propertiesWithKey(m_internedPattern);
                 case Type_Prefix:
                     return entity.propertiesWithPrefix(m_pattern);
                 case Type_Numbered:
@@ -100,7 +100,8 @@ namespace TrenchBroom {
 
         EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& pattern) :
         m_type(type),
-        m_pattern(pattern) {}
+        m_pattern(pattern),
+        m_internedPattern(type == Type_Exact ? kdl::interned_string(pattern) : kdl::interned_string()) {}
 
         EntityNodeIndex::EntityNodeIndex() :
             m_keyIndex(std::make_unique<EntityNodeStringIndex>()),
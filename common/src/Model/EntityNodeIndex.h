@@ -20,6 +20,7 @@
 #pragma once
 
 #include <kdl/compact_trie_forward.h>
+#include <kdl/interned_string.h>
 
 #include <memory>
 #include <set>
@@ -44,6 +45,8 @@ namespace TrenchBroom {
         private:
             Type m_type;
             std::string m_pattern;
+            // exact queries compare property keys by identity
+            kdl::interned_string m_internedPattern;
         public:
             static EntityNodeIndexQuery exact(const std::string& pattern);
             static EntityNodeIndexQuery prefix(const std::string& pattern);
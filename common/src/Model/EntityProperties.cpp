@@ -64,6 +64,40 @@ namespace TrenchBroom {
             const std::string SoftMapBounds             = "_tb_soft_map_bounds";
         }
 
+        namespace InternedPropertyKeys {
+            const kdl::interned_string Classname                 = kdl::interned_string(PropertyKeys::Classname);
+            const kdl::interned_string Origin                    = kdl::interned_string(PropertyKeys::Origin);
+            const kdl::interned_string Wad                       = kdl::interned_string(PropertyKeys::Wad);
+            const kdl::interned_string Textures                  = kdl::interned_string(PropertyKeys::Textures);
+            const kdl::interned_string Mods                      = kdl::interned_string(PropertyKeys::Mods);
+            const kdl::interned_string Spawnflags                = kdl::interned_string(PropertyKeys::Spawnflags);
+            const kdl::interned_string EntityDefinitions         = kdl::interned_string(PropertyKeys::EntityDefinitions);
+            const kdl::interned_string Angle                     = kdl::interned_string(PropertyKeys::Angle);
+            const kdl::interned_string Angles                    = kdl::interned_string(PropertyKeys::Angles);
+            const kdl::interned_string Mangle                    = kdl::interned_string(PropertyKeys::Mangle);
+            const kdl::interned_string Target                    = kdl::interned_string(PropertyKeys::Target);
+            const kdl::interned_string Targetname                = kdl::interned_string(PropertyKeys::Targetname);
+            const kdl::interned_string Killtarget                = kdl::interned_string(PropertyKeys::Killtarget);
+            const kdl::interned_string ProtectedEntityProperties = kdl::interned_string(PropertyKeys::ProtectedEntityProperties);
+            const kdl::interned_string GroupType                 = kdl::interned_string(PropertyKeys::GroupType);
+            const kdl::interned_string LayerId                   = kdl::interned_string(PropertyKeys::LayerId);
+            const kdl::interned_string LayerName                 = kdl::interned_string(PropertyKeys::LayerName);
+            const kdl::interned_string LayerSortIndex            = kdl::interned_string(PropertyKeys::LayerSortIndex);
+            const kdl::interned_string LayerColor                = kdl::interned_string(PropertyKeys::LayerColor);
+            const kdl::interned_string LayerLocked               = kdl::interned_string(PropertyKeys::LayerLocked);
+            const kdl::interned_string LayerHidden               = kdl::interned_string(PropertyKeys::LayerHidden);
+            const kdl::interned_string LayerOmitFromExport       = kdl::interned_string(PropertyKeys::LayerOmitFromExport);
+            const kdl::interned_string Layer                     = kdl::interned_string(PropertyKeys::Layer);
+            const kdl::interned_string GroupId                   = kdl::interned_string(PropertyKeys::GroupId);
+            const kdl::interned_string GroupName                 = kdl::interned_string(PropertyKeys::GroupName);
+            const kdl::interned_string Group                     = kdl::interned_string(PropertyKeys::Group);
+            const kdl::interned_string GroupTransformation       = kdl::interned_string(PropertyKeys::GroupTransformation);
+            const kdl::interned_string LinkedGroupId             = kdl::interned_string(PropertyKeys::LinkedGroupId);
+            const kdl::interned_string Message                   = kdl::interned_string(PropertyKeys::Message);
+            const kdl::interned_string ValveVersion              = kdl::interned_string(PropertyKeys::ValveVersion);
+            const kdl::interned_string SoftMapBounds             = kdl::interned_string(PropertyKeys::SoftMapBounds);
+        }
+
         namespace PropertyValues {
             const std::string WorldspawnClassname = "worldspawn";
             const std::string NoClassname         = "undefined";
@@ -90,14 +124,24 @@ namespace TrenchBroom {
         m_key(key),
         m_value(value) {}
 
+        EntityProperty::EntityProperty(kdl::interned_string key, const std::string& value) :
+        m_key(std::move(key)),
+        m_value(value) {}
+
         int EntityProperty::compare(const EntityProperty& rhs) const {
-            const int keyCmp = m_key.compare(rhs.m_key);
-            if (keyCmp != 0)
-                return keyCmp;
+            if (m_key != rhs.m_key) {
+                const int keyCmp = m_key.str().compare(rhs.m_key.str());
+                if (keyCmp != 0)
+                    return keyCmp;
+            }
             return m_value.compare(rhs.m_value);
         }
 
         const std::string& EntityProperty::key() const {
+            return m_key.str();
+        }
+
+        const kdl::interned_string& EntityProperty::internedKey() const {
             return m_key;
         }
 
@@ -106,7 +150,11 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasKey(std::string_view key) const {
-            return kdl::cs::str_is_equal(m_key, key);
+            return kdl::cs::str_is_equal(m_key.str(), key);
+        }
+
+        bool EntityProperty::hasKey(const kdl::interned_string& key) const {
+            return m_key == key;
         }
 
         bool EntityProperty::hasValue(const std::string_view value) const {
@@ -118,7 +166,7 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasPrefix(const std::string_view prefix) const {
-            return kdl::cs::str_is_prefix(m_key, prefix);
+            return kdl::cs::str_is_prefix(m_key.str(), prefix);
         }
 
         bool EntityProperty::hasPrefixAndValue(const std::string_view prefix, const std::string_view value) const {
@@ -126,7 +174,7 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasNumberedPrefix(const std::string_view prefix) const {
-            return isNumberedProperty(prefix, m_key);
+            return isNumberedProperty(prefix, m_key.str());
         }
 
         bool EntityProperty::hasNumberedPrefixAndValue(const std::string_view prefix, const std::string_view value) const {
@@ -134,7 +182,7 @@ namespace TrenchBroom {
         }
 
         void EntityProperty::setKey(const std::string& key) {
-            m_key = key;
+            m_key = kdl::interned_string(key);
         }
 
         void EntityProperty::setValue(const std::string& value) {
@@ -174,7 +222,7 @@ namespace TrenchBroom {
             if (classname != PropertyValues::LayerClassname) {
                 return false;
             } else {
-                const std::string& groupType = findProperty(properties, PropertyKeys::GroupType);
+                const std::string& groupType = findProperty(properties, InternedPropertyKeys::GroupType);
                 return groupType == PropertyValues::GroupTypeLayer;
             }
         }
@@ -183,7 +231,7 @@ namespace TrenchBroom {
             if (classname != PropertyValues::GroupClassname) {
                 return false;
             } else {
-                const std::string& groupType = findProperty(properties, PropertyKeys::GroupType);
+                const std::string& groupType = findProperty(properties, InternedPropertyKeys::GroupType);
                 return groupType == PropertyValues::GroupTypeGroup;
             }
         }
@@ -194,7 +242,16 @@ namespace TrenchBroom {
 
         const std::string& findProperty(const std::vector<EntityProperty>& properties, const std::string& key, const std::string& defaultValue) {
             for (const EntityProperty& property : properties) {
-                if (key == property.key()) {
+                if (property.hasKey(key)) {
+                    return property.value();
+                }
+            }
+            return defaultValue;
+        }
+
+        const std::string& findProperty(const std::vector<EntityProperty>& properties, const kdl::interned_string& key, const std::string& defaultValue) {
+            for (const EntityProperty& property : properties) {
+                if (property.hasKey(key)) {
                     return property.value();
                 }
             }
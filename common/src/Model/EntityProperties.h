@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <kdl/interned_string.h>
+
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -59,6 +61,44 @@ namespace TrenchBroom {
             extern const std::string SoftMapBounds;
         }
 
+        /**
+         * The property keys above as interned strings. Looking up a property by an interned key only compares pointers
+         * and does not access the global interned string pool.
+         */
+        namespace InternedPropertyKeys {
+            extern const kdl::interned_string Classname;
+            extern const kdl::interned_string Origin;
+            extern const kdl::interned_string Wad;
+            extern const kdl::interned_string Textures;
+            extern const kdl::interned_string Mods;
+            extern const kdl::interned_string Spawnflags;
+            extern const kdl::interned_string EntityDefinitions;
+            extern const kdl::interned_string Angle;
+            extern const kdl::interned_string Angles;
+            extern const kdl::interned_string Mangle;
+            extern const kdl::interned_string Target;
+            extern const kdl::interned_string Targetname;
+            extern const kdl::interned_string Killtarget;
+            extern const kdl::interned_string ProtectedEntityProperties;
+            extern const kdl::interned_string GroupType;
+            extern const kdl::interned_string LayerId;
+            extern const kdl::interned_string LayerName;
+            extern const kdl::interned_string LayerSortIndex;
+            extern const kdl::interned_string LayerColor;
+            extern const kdl::interned_string LayerLocked;
+            extern const kdl::interned_string LayerHidden;
+            extern const kdl::interned_string LayerOmitFromExport;
+            extern const kdl::interned_string Layer;
+            extern const kdl::interned_string GroupId;
+            extern const kdl::interned_string GroupName;
+            extern const kdl::interned_string Group;
+            extern const kdl::interned_string GroupTransformation;
+            extern const kdl::interned_string LinkedGroupId;
+            extern const kdl::interned_string Message;
+            extern const kdl::interned_string ValveVersion;
+            extern const kdl::interned_string SoftMapBounds;
+        }
+
         namespace PropertyValues {
             extern const std::string WorldspawnClassname;
             extern const std::string NoClassname;
@@ -75,20 +115,27 @@ namespace TrenchBroom {
 
         bool isNumberedProperty(std::string_view prefix, std::string_view key);
 
+        /**
+         * Property keys are interned because the same few keys are repeated across all entities of a map. Values
+         * are mostly unique and are therefore stored as is.
+         */
         class EntityProperty {
         private:
-            std::string m_key;
+            kdl::interned_string m_key;
             std::string m_value;
         public:
             EntityProperty();
             EntityProperty(const std::string& key, const std::string& value);
-            
+            EntityProperty(kdl::interned_string key, const std::string& value);
+
             int compare(const EntityProperty& rhs) const;
 
             const std::string& key() const;
+            const kdl::interned_string& internedKey() const;
             const std::string& value() const;
 
             bool hasKey(std::string_view key) const;
+            bool hasKey(const kdl::interned_string& key) const;
             bool hasValue(std::string_view value) const;
             bool hasKeyAndValue(std::string_view key, std::string_view value) const;
             bool hasPrefix(std::string_view prefix) const;
@@ -112,6 +159,7 @@ namespace TrenchBroom {
         bool isGroup(const std::string& classname, const std::vector<EntityProperty>& properties);
         bool isWorldspawn(const std::string& classname, const std::vector<EntityProperty>& properties);
         const std::string& findProperty(const std::vector<EntityProperty>& properties, const std::string& key, const std::string& defaultValue = PropertyValues::DefaultValue);
+        const std::string& findProperty(const std::vector<EntityProperty>& properties, const kdl::interned_string& key, const std::string& defaultValue = PropertyValues::DefaultValue);
 
         class EntityProperties {
         private:
@@ -174,13 +174,13 @@ namespace TrenchBroom {
             const auto classname = entity.classname();
             if (classname != PropertyValues::NoClassname) {
                 if (kdl::cs::str_is_prefix(classname, "light")) {
-                    if (entity.hasProperty(PropertyKeys::Mangle)) {
+                    if (entity.hasProperty(InternedPropertyKeys::Mangle)) {
                         // spotlight without a target, update mangle
                         type = RotationType::Mangle;
                         propertyKey = PropertyKeys::Mangle;
-                    } else if (!entity.hasProperty(PropertyKeys::Target)) {
+                    } else if (!entity.hasProperty(InternedPropertyKeys::Target)) {
                         // not a spotlight, but might have a rotatable model, so change angle or angles
-                        if (entity.hasProperty(PropertyKeys::Angles)) {
+                        if (entity.hasProperty(InternedPropertyKeys::Angles)) {
                             type = eulerType;
                             propertyKey = PropertyKeys::Angles;
                         } else {
@@ -195,13 +195,13 @@ namespace TrenchBroom {
 
                     if (!entity.pointEntity()) {
                         // brush entity
-                        if (entity.hasProperty(PropertyKeys::Angles)) {
+                        if (entity.hasProperty(InternedPropertyKeys::Angles)) {
                             type = eulerType;
                             propertyKey = PropertyKeys::Angles;
-                        } else if (entity.hasProperty(PropertyKeys::Mangle)) {
+                        } else if (entity.hasProperty(InternedPropertyKeys::Mangle)) {
                             type = eulerType;
                             propertyKey = PropertyKeys::Mangle;
-                        } else if (entity.hasProperty(PropertyKeys::Angle)) {
+                        } else if (entity.hasProperty(InternedPropertyKeys::Angle)) {
                             type = RotationType::AngleUpDown;
                             propertyKey = PropertyKeys::Angle;
                         }
@@ -215,10 +215,10 @@ namespace TrenchBroom {
                             usage = RotationUsage::BlockRotation;
                         }
 
-                        if (entity.hasProperty(PropertyKeys::Angles)) {
+                        if (entity.hasProperty(InternedPropertyKeys::Angles)) {
                             type = eulerType;
                             propertyKey = PropertyKeys::Angles;
-                        } else if (entity.hasProperty(PropertyKeys::Mangle)) {
+                        } else if (entity.hasProperty(InternedPropertyKeys::Mangle)) {
                             type = eulerType;
                             propertyKey = PropertyKeys::Mangle;
                         } else {
@@ -25,7 +25,11 @@
 #include "IO/DiskIO.h"
 #include "IO/DkPakFileSystem.h"
 #include "IO/IdPakFileSystem.h"
+#include "IO/FileCache.h"
 #include "IO/FileMatcher.h"
+#include "IO/OverlayFileSystem.h"
+#include "IO/PackageIndex.h"
+#include "IO/PathQt.h"
 #include "IO/Quake3ShaderFileSystem.h"
 #include "IO/SystemPaths.h"
 #include "IO/ZipFileSystem.h"
@@ -34,23 +38,39 @@
 #include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include <QDateTime>
+#include <QFileInfo>
 
 namespace TrenchBroom {
     namespace Model {
+        // budget for the decompressed package entries that are kept in memory
+        static const size_t PackageFileCacheBytes = 64u * 1024u * 1024u;
+
         GameFileSystem::GameFileSystem() :
         FileSystem(),
-        m_shaderFS(nullptr) {}
+        m_overlayFS(nullptr),
+        m_shaderFS(nullptr),
+        m_fileCache(std::make_shared<IO::FileCache>(PackageFileCacheBytes)) {}
 
         void GameFileSystem::initialize(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, Logger& logger) {
-            // delete the existing file system
+            // delete the existing file system, but keep the packages so that unchanged search paths can reuse them
             releaseNext();
             m_shaderFS = nullptr;
+            const auto previousPackages = std::move(m_packages);
+            m_packages.clear();
+
+            m_overlayFS = std::make_shared<IO::OverlayFileSystem>();
+            m_next = m_overlayFS;
 
             addDefaultAssetPaths(config, logger);
 
             if (!gamePath.isEmpty() && IO::Disk::directoryExists(gamePath)) {
-                addGameFileSystems(config, gamePath, additionalSearchPaths, logger);
+                addGameFileSystems(config, gamePath, additionalSearchPaths, previousPackages, logger);
                 addShaderFileSystem(config, logger);
             }
         }
@@ -86,27 +106,35 @@ namespace TrenchBroom {
             }
         }
 
-        void GameFileSystem::addGameFileSystems(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, Logger& logger) {
+        void GameFileSystem::addGameFileSystems(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, const std::vector<SearchPathPackages>& previousPackages, Logger& logger) {
             const auto& fileSystemConfig = config.fileSystemConfig();
             addFileSystemPath(gamePath + fileSystemConfig.searchPath, logger);
-            addFileSystemPackages(config, gamePath + fileSystemConfig.searchPath, logger);
+            addFileSystemPackages(config, gamePath + fileSystemConfig.searchPath, previousPackages, logger);
 
             for (const auto& searchPath : additionalSearchPaths) {
                 addFileSystemPath(gamePath + searchPath, logger);
-                addFileSystemPackages(config, gamePath + searchPath, logger);
+                addFileSystemPackages(config, gamePath + searchPath, previousPackages, logger);
             }
         }
 
         void GameFileSystem::addFileSystemPath(const IO::Path& path, Logger& logger) {
             try {
                 logger.info() << "Adding file system path " << path;
-                m_next = std::make_shared<IO::DiskFileSystem>(m_next, path);
+                m_overlayFS->addFileSystem(std::make_shared<IO::DiskFileSystem>(path));
             } catch (const FileSystemException& e) {
                 logger.error() << "Could not add file system search path '" << path << "': " << e.what();
             }
         }
 
-        void GameFileSystem::addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, Logger& logger) {
+        GameFileSystem::PackageStamp GameFileSystem::stampPackage(const IO::Path& path) {
+            const auto fileInfo = QFileInfo(IO::pathAsQString(path));
+            if (!fileInfo.exists()) {
+                return PackageStamp{path, -1, -1};
+            }
+            return PackageStamp{path, fileInfo.lastModified().toMSecsSinceEpoch(), static_cast<int64_t>(fileInfo.size())};
+        }
+
+        void GameFileSystem::addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, const std::vector<SearchPathPackages>& previousPackages, Logger& logger) {
             const auto& fileSystemConfig = config.fileSystemConfig();
             const auto& packageFormatConfig = fileSystemConfig.packageFormat;
 
@@ -115,25 +143,49 @@ namespace TrenchBroom {
 
             if (IO::Disk::directoryExists(searchPath)) {
                 const IO::DiskFileSystem diskFS(searchPath);
-                auto packages = diskFS.findItems(IO::Path(""), IO::FileExtensionMatcher(packageExtensions));
-                packages = kdl::vec_sort(std::move(packages), IO::Path::Less<kdl::ci::string_less>());
-
-                for (const auto& packagePath : packages) {
-                    try {
-                        if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::IdPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::DkPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::ZipFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
+                auto packagePaths = diskFS.findItems(IO::Path(""), IO::FileExtensionMatcher(packageExtensions));
+                packagePaths = kdl::vec_sort(std::move(packagePaths), IO::Path::Less<kdl::ci::string_less>());
+
+                auto packageStamps = kdl::vec_transform(packagePaths, [&](const auto& packagePath) {
+                    return stampPackage(diskFS.makeAbsolute(packagePath));
+                });
+
+                // reuse the index if the search path still contains the same, unmodified packages, e.g. when only the
+                // mods changed
+                const auto previous = std::find_if(std::begin(previousPackages), std::end(previousPackages), [&](const auto& packages) {
+                    return packages.searchPath == searchPath && packages.format == packageFormat && packages.packageStamps == packageStamps;
+                });
+
+                auto index = std::shared_ptr<const IO::PackageIndex>{};
+                if (previous != std::end(previousPackages)) {
+                    logger.info() << "Reusing " << packagePaths.size() << " file system packages in " << searchPath;
+                    index = previous->index;
+                } else {
+                    auto packages = std::vector<std::shared_ptr<IO::FileSystem>>{};
+                    for (const auto& packagePath : packagePaths) {
+                        try {
+                            if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
+                                logger.info() << "Adding file system package " << packagePath;
+                                packages.push_back(std::make_shared<IO::IdPakFileSystem>(diskFS.makeAbsolute(packagePath)));
+                            } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
+                                logger.info() << "Adding file system package " << packagePath;
+                                packages.push_back(std::make_shared<IO::DkPakFileSystem>(diskFS.makeAbsolute(packagePath)));
+                            } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
+                                logger.info() << "Adding file system package " << packagePath;
+                                packages.push_back(std::make_shared<IO::ZipFileSystem>(diskFS.makeAbsolute(packagePath), m_fileCache));
+                            }
+                        } catch (const std::exception& e) {
+                            logger.error() << e.what();
                         }
-                    } catch (const std::exception& e) {
-                        logger.error() << e.what();
                     }
+
+                    // packages that come later take precedence
+                    std::reverse(std::begin(packages), std::end(packages));
+                    index = std::make_shared<const IO::PackageIndex>(std::move(packages));
                 }
+
+                m_overlayFS->addPackages(index);
+                m_packages.push_back(SearchPathPackages{searchPath, packageFormat, std::move(packageStamps), std::move(index)});
             }
         }
 
@@ -20,14 +20,20 @@
 #pragma once
 
 #include "IO/FileSystem.h"
+#include "IO/Path.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
 
     namespace IO {
+        class FileCache;
+        class OverlayFileSystem;
+        class PackageIndex;
         class Path;
         class Quake3ShaderFileSystem;
     }
@@ -37,17 +43,45 @@ namespace TrenchBroom {
 
         class GameFileSystem : public IO::FileSystem {
         private:
+            /**
+             * Identifies a version of a package file. A package that was replaced or modified on disk has a different
+             * stamp, even if its path stays the same.
+             */
+            struct PackageStamp {
+                IO::Path path;
+                int64_t modificationTime;
+                int64_t size;
+
+                friend bool operator==(const PackageStamp& lhs, const PackageStamp& rhs) {
+                    return lhs.path == rhs.path && lhs.modificationTime == rhs.modificationTime && lhs.size == rhs.size;
+                }
+            };
+
+            /**
+             * The packages that were found in a search path.
+             */
+            struct SearchPathPackages {
+                IO::Path searchPath;
+                std::string format;
+                std::vector<PackageStamp> packageStamps;
+                std::shared_ptr<const IO::PackageIndex> index;
+            };
+
+            std::shared_ptr<IO::OverlayFileSystem> m_overlayFS;
             IO::Quake3ShaderFileSystem* m_shaderFS;
+            std::shared_ptr<IO::FileCache> m_fileCache;
+            std::vector<SearchPathPackages> m_packages;
         public:
             GameFileSystem();
             void initialize(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, Logger& logger);
             void reloadShaders();
         private:
             void addDefaultAssetPaths(const GameConfig& config, Logger& logger);
-            void addGameFileSystems(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, Logger& logger);
+            void addGameFileSystems(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, const std::vector<SearchPathPackages>& previousPackages, Logger& logger);
             void addShaderFileSystem(const GameConfig& config, Logger& logger);
             void addFileSystemPath(const IO::Path& path, Logger& logger);
-            void addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, Logger& logger);
+            static PackageStamp stampPackage(const IO::Path& path);
+            void addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, const std::vector<SearchPathPackages>& previousPackages, Logger& logger);
         private:
             bool doDirectoryExists(const IO::Path& path) const override;
             bool doFileExists(const IO::Path& path) const override;
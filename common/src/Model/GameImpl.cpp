@@ -32,6 +32,7 @@
 #include "IO/DefParser.h"
 #include "IO/DiskIO.h"
 #include "IO/DkmParser.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/EntParser.h"
 #include "IO/FgdParser.h"
@@ -39,6 +40,7 @@
 #include "IO/FileMatcher.h"
 #include "IO/GameConfigParser.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
@@ -78,7 +80,8 @@ namespace TrenchBroom {
     namespace Model {
         GameImpl::GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger) :
         m_config(config),
-        m_gamePath(gamePath) {
+        m_gamePath(gamePath),
+        m_entityDefinitionCache(std::make_shared<IO::EntityDefinitionClassInfoCache>()) {
             initializeFileSystem(logger);
         }
 
@@ -186,6 +189,9 @@ namespace TrenchBroom {
                 });
                 return IO::WorldReader::tryRead(fileReader.stringView(), possibleFormats, worldBounds, parserStatus);
             } else {
+                if (auto worldNode = IO::MapCache::read(path, fileReader.stringView(), format, worldBounds, parserStatus)) {
+                    return worldNode;
+                }
                 IO::WorldReader worldReader(fileReader.stringView(), format);
                 return worldReader.read(worldBounds, parserStatus);
             }
@@ -356,17 +362,17 @@ namespace TrenchBroom {
             if (kdl::ci::str_is_equal("fgd", extension)) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
-                IO::FgdParser parser(reader.stringView(), defaultColor, file->path());
+                IO::FgdParser parser(reader.stringView(), defaultColor, file->path(), m_entityDefinitionCache);
                 return parser.parseDefinitions(status);
             } else if (kdl::ci::str_is_equal("def", extension)) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
-                IO::DefParser parser(reader.stringView(), defaultColor);
+                IO::DefParser parser(reader.stringView(), defaultColor, file->path(), m_entityDefinitionCache);
                 return parser.parseDefinitions(status);
             } else if (kdl::ci::str_is_equal("ent", extension)) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
-                IO::EntParser parser(reader.stringView(), defaultColor);
+                IO::EntParser parser(reader.stringView(), defaultColor, file->path(), m_entityDefinitionCache);
                 return parser.parseDefinitions(status);
             } else {
                 throw GameException("Unknown entity definition format: '" + path.asString() + "'");
@@ -36,6 +36,10 @@ namespace TrenchBroom {
         class Palette;
     }
 
+    namespace IO {
+        class EntityDefinitionClassInfoCache;
+    }
+
     namespace Model {
         class GameImpl : public Game {
         private:
@@ -43,6 +47,7 @@ namespace TrenchBroom {
             GameFileSystem m_fs;
             IO::Path m_gamePath;
             std::vector<IO::Path> m_additionalSearchPaths;
+            std::shared_ptr<IO::EntityDefinitionClassInfoCache> m_entityDefinitionCache;
         public:
             GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger);
         private:
@@ -34,6 +34,7 @@
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/result_for_each.h>
 #include <kdl/string_utils.h>
@@ -41,32 +42,128 @@
 
 #include <vecmath/ray.h>
 
+#include <iterator>
 #include <string>
+#include <typeinfo>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Model {
-        static kdl::result<std::vector<std::unique_ptr<Node>>, UpdateLinkedGroupsError> cloneAndTransformChildren(const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation) {
+        using ChangedNodes = std::unordered_set<const Node*>;
+
+        /**
+         * Transforming brushes in parallel only pays off if there are enough of them.
+         */
+        static constexpr size_t MinParallelBrushTransforms = 64u;
+
+        /**
+         * A copy of a brush in the source group that must be transformed into a target group.
+         */
+        struct PendingLinkedBrushTransform {
+            Brush brush;
+            vm::mat4x4 transformation;
+            kdl::result<void, BrushError> result;
+        };
+
+        /**
+         * Returns the child of the given corresponding node that corresponds to the child of the given node at the given
+         * index, or null if the structure of both nodes does not match.
+         */
+        static const Node* findCorrespondingChild(const Node& node, const Node* correspondingNode, const size_t index) {
+            if (correspondingNode == nullptr || correspondingNode->childCount() != node.childCount()) {
+                return nullptr;
+            }
+
+            const auto* child = node.children()[index];
+            const auto* correspondingChild = correspondingNode->children()[index];
+            return typeid(*child) == typeid(*correspondingChild) ? correspondingChild : nullptr;
+        }
+
+        /**
+         * A node is unchanged if neither it nor its corresponding node in the target group have changed. If no changed
+         * nodes are given, then every node is considered changed.
+         */
+        static bool isUnchanged(const Node& node, const Node* correspondingNode, const ChangedNodes* changedNodes) {
+            return changedNodes != nullptr && correspondingNode != nullptr &&
+                changedNodes->count(&node) == 0u && changedNodes->count(correspondingNode) == 0u;
+        }
+
+        /**
+         * Copies every changed brush in the given node's subtree so that it can be transformed. The brushes are collected
+         * in the order in which cloneAndTransformChildren visits them.
+         */
+        static void collectPendingBrushTransforms(const Node& node, const Node* correspondingNode, const vm::mat4x4& transformation, const ChangedNodes* changedNodes, std::vector<PendingLinkedBrushTransform>& pendingTransforms) {
+            const auto& children = node.children();
+            for (size_t i = 0u; i < children.size(); ++i) {
+                const auto* childNode = children[i];
+                const auto* correspondingChildNode = findCorrespondingChild(node, correspondingNode, i);
+                if (const auto* brushNode = dynamic_cast<const BrushNode*>(childNode)) {
+                    if (!isUnchanged(*brushNode, correspondingChildNode, changedNodes)) {
+                        pendingTransforms.push_back({brushNode->brush(), transformation, kdl::void_success});
+                    }
+                } else {
+                    collectPendingBrushTransforms(*childNode, correspondingChildNode, transformation, changedNodes, pendingTransforms);
+                }
+            }
+        }
+
+        /**
+         * Transforms the pending brushes, which is the expensive part of updating linked groups. The brushes are
+         * transformed in place and without copying any faces, so this can safely run in parallel.
+         */
+        static void transformPendingBrushes(std::vector<PendingLinkedBrushTransform>& pendingTransforms, const vm::bbox3& worldBounds) {
+            const auto transformBrush = [&](const size_t index) {
+                auto& pendingTransform = pendingTransforms[index];
+                pendingTransform.result = pendingTransform.brush.transform(worldBounds, pendingTransform.transformation, true);
+            };
+
+            if (pendingTransforms.size() < MinParallelBrushTransforms) {
+                for (size_t i = 0u; i < pendingTransforms.size(); ++i) {
+                    transformBrush(i);
+                }
+            } else {
+                kdl::parallel_for(pendingTransforms.size(), transformBrush);
+            }
+        }
+
+        /**
+         * Clones the children of the given node into a target group. Unchanged children are copied from their
+         * corresponding nodes in the target group, changed brushes are taken from the given pending transforms.
+         */
+        static kdl::result<std::vector<std::unique_ptr<Node>>, UpdateLinkedGroupsError> cloneAndTransformChildren(const Node& node, const Node* correspondingNode, const vm::bbox3& worldBounds, const vm::mat4x4& transformation, const ChangedNodes* changedNodes, std::vector<PendingLinkedBrushTransform>::iterator& nextPendingTransform) {
             using VisitResult = kdl::result<std::unique_ptr<Node>, UpdateLinkedGroupsError>;
+            auto index = size_t(0);
             return kdl::for_each_result(node.children(), [&](const auto* childNode) {
+                const auto* correspondingChildNode = findCorrespondingChild(node, correspondingNode, index++);
+                const auto unchanged = isUnchanged(*childNode, correspondingChildNode, changedNodes);
                 return childNode->accept(kdl::overload(
                     [] (const WorldNode*) -> VisitResult { ensure(false, "Linked group structure is valid"); },
                     [] (const LayerNode*) -> VisitResult { ensure(false, "Linked group structure is valid"); },
                     [&](const GroupNode* groupNode) -> VisitResult {
+                        if (unchanged) {
+                            return std::make_unique<GroupNode>(static_cast<const GroupNode*>(correspondingChildNode)->group());
+                        }
                         auto group = groupNode->group();
                         group.transform(transformation);
                         return std::make_unique<GroupNode>(std::move(group));
                     },
                     [&](const EntityNode* entityNode)-> VisitResult {
+                        if (unchanged) {
+                            return std::make_unique<EntityNode>(static_cast<const EntityNode*>(correspondingChildNode)->entity());
+                        }
                         auto entity = entityNode->entity();
                         entity.transform(transformation);
                         return std::make_unique<EntityNode>(std::move(entity));
                     },
-                    [&](const BrushNode* brushNode) -> VisitResult {
-                        auto brush = brushNode->brush();
-                        return brush.transform(worldBounds, transformation, true)
+                    [&](const BrushNode*) -> VisitResult {
+                        if (unchanged) {
+                            return std::make_unique<BrushNode>(static_cast<const BrushNode*>(correspondingChildNode)->brush());
+                        }
+                        auto& pendingTransform = *nextPendingTransform++;
+                        return std::move(pendingTransform.result)
                             .and_then([&]() -> kdl::result<std::unique_ptr<Node>, BrushError> {
-                                return std::make_unique<BrushNode>(std::move(brush));
+                                return std::make_unique<BrushNode>(std::move(pendingTransform.brush));
                             }).map_errors([](const BrushError&) -> VisitResult { 
                                 return UpdateLinkedGroupsError::TransformFailed;
                             });
@@ -75,7 +172,7 @@ namespace TrenchBroom {
                     if (!worldBounds.contains(newChildNode->logicalBounds())) {
                         return UpdateLinkedGroupsError::UpdateExceedsWorldBounds;
                     }
-                    return cloneAndTransformChildren(*childNode, worldBounds, transformation)
+                    return cloneAndTransformChildren(*childNode, correspondingChildNode, worldBounds, transformation, changedNodes, nextPendingTransform)
                         .and_then([&](std::vector<std::unique_ptr<Node>>&& newChildren) -> VisitResult {
                             newChildNode->addChildren(kdl::vec_transform(std::move(newChildren), [](std::unique_ptr<Node>&& child) { return child.release(); }));
                             return std::move(newChildNode);
@@ -169,7 +266,7 @@ namespace TrenchBroom {
             }
         }
 
-        kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const vm::bbox3& worldBounds) {
+        static kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const vm::bbox3& worldBounds, const ChangedNodes* changedNodes) {
             const auto& sourceGroup = sourceGroupNode.group();
             const auto [success, invertedSourceTransformation] = vm::invert(sourceGroup.transformation());
             if (!success) {
@@ -178,9 +275,31 @@ namespace TrenchBroom {
 
             const auto _invertedSourceTransformation = invertedSourceTransformation;
             const auto targetGroupNodesToUpdate = kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+
+            // if the source group itself or a target group has changed, then the transformation into that target group has
+            // changed, too, and all children must be transformed
+            const auto sourceGroupChanged = changedNodes == nullptr || changedNodes->count(&sourceGroupNode) > 0u;
+            const auto changedNodesForTarget = kdl::vec_transform(targetGroupNodesToUpdate, [&](const auto* targetGroupNode) {
+                return sourceGroupChanged || changedNodes->count(targetGroupNode) > 0u ? nullptr : changedNodes;
+            });
+            const auto transformations = kdl::vec_transform(targetGroupNodesToUpdate, [&](const auto* targetGroupNode) {
+                return targetGroupNode->group().transformation() * _invertedSourceTransformation;
+            });
+
+            auto pendingTransforms = std::vector<PendingLinkedBrushTransform>{};
+            auto firstPendingTransforms = std::vector<size_t>{};
+            for (size_t i = 0u; i < targetGroupNodesToUpdate.size(); ++i) {
+                firstPendingTransforms.push_back(pendingTransforms.size());
+                collectPendingBrushTransforms(sourceGroupNode, targetGroupNodesToUpdate[i], transformations[i], changedNodesForTarget[i], pendingTransforms);
+            }
+
+            transformPendingBrushes(pendingTransforms, worldBounds);
+
+            auto targetIndex = size_t(0);
             return kdl::for_each_result(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
-                const auto transformation = targetGroupNode->group().transformation() * _invertedSourceTransformation;
-                return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
+                const auto i = targetIndex++;
+                auto nextPendingTransform = std::next(std::begin(pendingTransforms), static_cast<std::ptrdiff_t>(firstPendingTransforms[i]));
+                return cloneAndTransformChildren(sourceGroupNode, targetGroupNode, worldBounds, transformations[i], changedNodesForTarget[i], nextPendingTransform)
                     .and_then([&](std::vector<std::unique_ptr<Node>>&& newChildren) -> kdl::result<std::pair<Node*, std::vector<std::unique_ptr<Node>>>, UpdateLinkedGroupsError> {
                         preserveGroupNames(newChildren, targetGroupNode->children());
                         preserveEntityProperties(newChildren, targetGroupNode->children());
@@ -190,6 +309,15 @@ namespace TrenchBroom {
             });
         }
 
+        kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const vm::bbox3& worldBounds) {
+            return updateLinkedGroups(sourceGroupNode, targetGroupNodes, worldBounds, nullptr);
+        }
+
+        kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const std::vector<const Node*>& changedNodes, const vm::bbox3& worldBounds) {
+            const auto changedNodeSet = ChangedNodes(std::begin(changedNodes), std::end(changedNodes));
+            return updateLinkedGroups(sourceGroupNode, targetGroupNodes, worldBounds, &changedNodeSet);
+        }
+
         GroupNode::GroupNode(Group group) :
         m_group(std::move(group)),
         m_editState(EditState::Closed),
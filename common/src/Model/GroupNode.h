@@ -67,6 +67,22 @@ namespace TrenchBroom {
          */
         kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const vm::bbox3& worldBounds);
 
+        /**
+         * Updates the given target group nodes from the given source group node, but only transforms those children of the
+         * source group node that have changed.
+         *
+         * The children of the source group node correspond to the children of the target group nodes by their position.
+         * A child is considered unchanged if neither it nor its corresponding node in a target group are contained in the
+         * given changed nodes. Unchanged children are copied from their corresponding nodes instead of being transformed
+         * again, which is much cheaper for brushes. If the source group node or a target group node is among the changed
+         * nodes, or if the structure of a target group node does not match that of the source group node, then the
+         * affected children are transformed as in the function above.
+         *
+         * The caller must guarantee that the given changed nodes include every node whose contents have changed since the
+         * link set was last updated.
+         */
+        kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroups(const GroupNode& sourceGroupNode, const std::vector<Model::GroupNode*>& targetGroupNodes, const std::vector<const Node*>& changedNodes, const vm::bbox3& worldBounds);
+
         /**
          * A group of nodes that can be edited as one.
          *
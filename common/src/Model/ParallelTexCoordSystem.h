@@ -89,7 +89,7 @@ namespace TrenchBroom {
             std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
             std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
 
-            deleteCopyAndMove(ParallelTexCoordSystem)
+            defineCopyAndMove(ParallelTexCoordSystem)
         };
     }
 }
@@ -78,8 +78,8 @@ namespace TrenchBroom {
             void rotateAxes(vm::vec3& xAxis, vm::vec3& yAxis, FloatType angleInRadians, size_t planeNormIndex) const;
         public:
             static std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> fromParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, const vm::vec3& xAxis, const vm::vec3& yAxis);
-        private:
-            deleteCopyAndMove(ParaxialTexCoordSystem)
+
+            defineCopyAndMove(ParaxialTexCoordSystem)
         };
     }
 }
@@ -33,6 +33,7 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 #include <unordered_set>
@@ -1097,6 +1098,21 @@ namespace TrenchBroom {
              */
             explicit Polyhedron(std::vector<vm::vec<T,3>> positions);
 
+            /**
+             * Constructs a polyhedron from a previously computed topology without recomputing the convex hull. The
+             * half edges are numbered consecutively in the order in which they appear in the face boundaries, and each
+             * edge is given by the indices of its two half edges.
+             *
+             * The caller is responsible for passing a valid topology, e.g. one that was obtained from another
+             * polyhedron.
+             *
+             * @param positions the vertex positions
+             * @param faceVertexIndices for each face, the indices of the vertices of its boundary
+             * @param facePlanes for each face, its boundary plane
+             * @param edgeHalfEdgeIndices for each edge, the indices of its first and second half edge
+             */
+            Polyhedron(const std::vector<vm::vec<T,3>>& positions, const std::vector<std::vector<size_t>>& faceVertexIndices, const std::vector<vm::plane<T,3>>& facePlanes, const std::vector<std::tuple<size_t, size_t>>& edgeHalfEdgeIndices);
+
             /**
              * Copy constructor.
              */
@@ -1428,6 +1444,19 @@ namespace TrenchBroom {
              * @return true if this polyhedron is a convex volume afterwards
              */
             bool healEdges(const T minLength = MinEdgeLength);
+        public: // Transformation
+            /**
+             * Applies the given transformation to the positions of the vertices and to the planes of the faces of this
+             * polyhedron without changing its topology.
+             *
+             * The transformation must be affine, and the determinant of its linear part must be positive. Otherwise,
+             * the transformed polyhedron might not be convex or its faces might be wound the wrong way.
+             *
+             * Updates the bounds of this polyhedron afterwards.
+             *
+             * @param transformation the transformation to apply
+             */
+            void transform(const vm::mat<T,4,4>& transformation);
         private:
             /**
              * Removes the given edge from this polyhedron. The incident faces are updated accordingly, and they are
@@ -1883,6 +1912,9 @@ namespace TrenchBroom {
             /**
              * Checks whether this polyhedron is intersected by the given plane.
              *
+             * The bounds of this polyhedron are checked first so that planes which miss it entirely are rejected
+             * without looking at its vertices. Otherwise, the vertices are classified in a single batch.
+             *
              * @param plane the plane to check
              * @return a failure reason if clipping with the given plane would likely fail, or an empty optional
              * otherwise
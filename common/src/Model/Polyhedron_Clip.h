@@ -29,6 +29,8 @@
 #include <vecmath/scalar.h>
 #include <vecmath/util.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         template <typename T, typename FP, typename VP>
@@ -135,31 +137,69 @@ namespace TrenchBroom {
 
         template <typename T, typename FP, typename VP>
         std::optional<typename Polyhedron<T,FP,VP>::ClipResult::FailureReason> Polyhedron<T,FP,VP>::checkIntersects(const vm::plane<T,3>& plane) const {
-            std::size_t above = 0u;
-            std::size_t below = 0u;
-            std::size_t inside = 0u;
+            const T epsilon = vm::constants<T>::point_status_epsilon();
+
+            // If the bounds of this polyhedron are entirely below or above the plane, then so are its vertices, and we
+            // can avoid looking at the vertices at all. The bounds corners nearest to and furthest from the plane give
+            // the smallest and largest distance any vertex can possibly have.
+            if (!m_vertices.empty()) {
+                vm::vec<T,3> nearCorner, farCorner;
+                for (std::size_t i = 0u; i < 3u; ++i) {
+                    if (plane.normal[i] >= static_cast<T>(0.0)) {
+                        nearCorner[i] = m_bounds.min[i];
+                        farCorner[i] = m_bounds.max[i];
+                    } else {
+                        nearCorner[i] = m_bounds.max[i];
+                        farCorner[i] = m_bounds.min[i];
+                    }
+                }
 
-            for (const Vertex* currentVertex : m_vertices) {
-                const vm::plane_status status = plane.point_status(currentVertex->position(), vm::constants<T>::point_status_epsilon());
-                switch (status) {
-                    case vm::plane_status::above:
-                        ++above;
-                        break;
-                    case vm::plane_status::below:
-                        ++below;
-                        break;
-                    case vm::plane_status::inside:
-                        ++inside;
-                        break;
-                        switchDefault()
+                if (plane.point_distance(farCorner) <= epsilon) {
+                    // every vertex is either below or inside the plane
+                    return ClipResult::FailureReason::Unchanged;
+                } else if (plane.point_distance(nearCorner) > epsilon) {
+                    // every vertex is above the plane
+                    return ClipResult::FailureReason::Empty;
                 }
             }
 
-            assert(above + below + inside == m_vertices.size());
+            // Copy the vertex positions into a contiguous buffer so that the distances can be computed in a tight loop
+            // without branches, which the compiler can vectorize.
+            static thread_local std::vector<T> positions;
+            const std::size_t vertexCount = m_vertices.size();
+            positions.resize(3u * vertexCount);
+
+            T* xs = positions.data();
+            T* ys = xs + vertexCount;
+            T* zs = ys + vertexCount;
+
+            std::size_t index = 0u;
+            for (const Vertex* currentVertex : m_vertices) {
+                const vm::vec<T,3>& position = currentVertex->position();
+                xs[index] = position.x();
+                ys[index] = position.y();
+                zs[index] = position.z();
+                ++index;
+            }
+
+            const T nx = plane.normal.x();
+            const T ny = plane.normal.y();
+            const T nz = plane.normal.z();
+            const T d = plane.distance;
+
+            std::size_t above = 0u;
+            std::size_t below = 0u;
+            for (std::size_t i = 0u; i < vertexCount; ++i) {
+                // same evaluation order as vm::plane::point_distance
+                const T distance = xs[i] * nx + ys[i] * ny + zs[i] * nz - d;
+                above += static_cast<std::size_t>(distance > epsilon);
+                below += static_cast<std::size_t>(distance < -epsilon);
+            }
 
-            if (below + inside == m_vertices.size()) {
+            const std::size_t inside = vertexCount - above - below;
+            if (below + inside == vertexCount) {
                 return ClipResult::FailureReason::Unchanged;
-            } else if (above + inside == m_vertices.size()) {
+            } else if (above + inside == vertexCount) {
                 return ClipResult::FailureReason::Empty;
             } else {
                 return std::nullopt;
@@ -23,6 +23,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <vecmath/mat.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 #include <vecmath/ray.h>
@@ -194,6 +195,40 @@ namespace TrenchBroom {
             addPoints(std::move(positions));
         }
 
+        template <typename T, typename FP, typename VP>
+        Polyhedron<T,FP,VP>::Polyhedron(const std::vector<vm::vec<T,3>>& positions, const std::vector<std::vector<size_t>>& faceVertexIndices, const std::vector<vm::plane<T,3>>& facePlanes, const std::vector<std::tuple<size_t, size_t>>& edgeHalfEdgeIndices) {
+            assert(faceVertexIndices.size() == facePlanes.size());
+
+            std::vector<Vertex*> vertices;
+            vertices.reserve(positions.size());
+            for (const auto& position : positions) {
+                Vertex* vertex = new Vertex(position);
+                vertices.push_back(vertex);
+                m_vertices.push_back(vertex);
+            }
+
+            std::vector<HalfEdge*> halfEdges;
+            halfEdges.reserve(2u * edgeHalfEdgeIndices.size());
+            for (size_t i = 0u; i < faceVertexIndices.size(); ++i) {
+                HalfEdgeList boundary;
+                for (const size_t vertexIndex : faceVertexIndices[i]) {
+                    assert(vertexIndex < vertices.size());
+                    HalfEdge* halfEdge = new HalfEdge(vertices[vertexIndex]);
+                    halfEdges.push_back(halfEdge);
+                    boundary.push_back(halfEdge);
+                }
+                m_faces.push_back(new Face(std::move(boundary), facePlanes[i]));
+            }
+
+            for (const auto& [first, second] : edgeHalfEdgeIndices) {
+                assert(first < halfEdges.size() && second < halfEdges.size());
+                m_edges.push_back(new Edge(halfEdges[first], halfEdges[second]));
+            }
+
+            updateBounds();
+            assert(checkInvariant());
+        }
+
         template <typename T, typename FP, typename VP>
         Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other) {
             Copy copy(other.faces(), other.edges(), other.vertices(), *this, CopyCallback());
@@ -681,6 +716,17 @@ namespace TrenchBroom {
             updateBounds();
         }
 
+        template <typename T, typename FP, typename VP>
+        void Polyhedron<T,FP,VP>::transform(const vm::mat<T,4,4>& transformation) {
+            for (auto* vertex : m_vertices) {
+                vertex->setPosition(transformation * vertex->position());
+            }
+            for (auto* face : m_faces) {
+                face->setPlane(face->plane().transform(transformation));
+            }
+            updateBounds();
+        }
+
         template <typename T, typename FP, typename VP>
         bool Polyhedron<T,FP,VP>::healEdges(const T minLength) {
             const T minLength2 = minLength * minLength;
@@ -131,7 +131,9 @@ namespace TrenchBroom {
                 return axis / safeScale(T1(factor));
             }
 
-            deleteCopyAndMove(TexCoordSystem)
+            // only subclasses may be copied so that brush faces can store them by value
+            TexCoordSystem(const TexCoordSystem& other) = default;
+            TexCoordSystem& operator=(const TexCoordSystem& other) = default;
         };
     }
 }
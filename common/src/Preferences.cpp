@@ -131,11 +131,14 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<int> TextureMemoryBudget(IO::Path("Renderer/Texture memory budget"), 0);
         Preference<bool> EnableMSAA(IO::Path("Renderer/Enable multisampling"), true);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
 
+        Preference<bool> WriteMapCache(IO::Path("Editor/Write map cache"), false);
+
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
             return fontPath;
@@ -296,8 +299,10 @@ namespace TrenchBroom {
                 &GridColor2D,
                 &TextureMinFilter,
                 &TextureMagFilter,
+                &TextureMemoryBudget,
                 &TextureLock,
                 &UVLock,
+                &WriteMapCache,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
@@ -124,11 +124,14 @@ namespace TrenchBroom {
 
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        extern Preference<int> TextureMemoryBudget;
         extern Preference<bool> EnableMSAA;
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
 
+        extern Preference<bool> WriteMapCache;
+
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
 
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Ensure.h"
+#include "MemoryUsage.h"
 #include "Renderer/AllocationTracker.h"
 #include "Renderer/GL.h"
 #include "Renderer/GLVertexType.h"
@@ -74,6 +75,7 @@ namespace TrenchBroom {
             DirtyRangeTracker m_dirtyRange;
             VboManager* m_vboManager;
             Vbo* m_vbo;
+            MemoryCounter m_memoryCounter;
         private:
             void freeBlock() {
                 if (m_vbo != nullptr) {
@@ -106,7 +108,8 @@ namespace TrenchBroom {
             m_snapshot(),
             m_dirtyRange(0),
             m_vboManager(nullptr),
-            m_vbo(nullptr) {}
+            m_vbo(nullptr),
+            m_memoryCounter(MemorySubsystem::BrushRendererArrays) {}
 
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
@@ -116,12 +119,14 @@ namespace TrenchBroom {
             m_snapshot(),
             m_dirtyRange(elements.size()),
             m_vboManager(nullptr),
-            m_vbo(nullptr) {
+            m_vbo(nullptr),
+            m_memoryCounter(MemorySubsystem::BrushRendererArrays) {
 
                 const size_t elementsCount = elements.size();
                 m_dirtyRange.markDirty(0, elementsCount);
 
                 elements.swap(m_snapshot);
+                m_memoryCounter.setBytes(m_snapshot.capacity() * sizeof(T));
 
                 // we allow zero elements.
                 if (!empty()) {
@@ -140,6 +145,7 @@ namespace TrenchBroom {
             void resize(const size_t newSize) {
                 m_snapshot.resize(newSize);
                 m_dirtyRange.expand(newSize);
+                m_memoryCounter.setBytes(m_snapshot.capacity() * sizeof(T));
             }
 
             T* getPointerToWriteElementsTo(const size_t offsetWithinBlock, const size_t elementCount) {
@@ -21,12 +21,12 @@
 
 #include "Preferences.h"
 #include "PreferenceManager.h"
-#include "Renderer/ActiveShader.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/RenderBatch.h"
 
@@ -58,6 +58,16 @@ namespace TrenchBroom {
         EdgeRenderer::RenderBase::~RenderBase() {}
 
         void EdgeRenderer::RenderBase::renderEdges(RenderContext& renderContext) {
+            setupEdgeState(renderContext);
+            renderEdgesInState(renderContext);
+            cleanupEdgeState(renderContext);
+        }
+
+        RenderSortKey EdgeRenderer::RenderBase::edgeSortKey() const {
+            return RenderSortKey{!m_params.onTop, false, &Shaders::EdgeShader, 0u, m_params.width, m_params.offset};
+        }
+
+        void EdgeRenderer::RenderBase::setupEdgeState(RenderContext& renderContext) {
             if (m_params.offset != 0.0)
                 glSetEdgeOffset(m_params.offset);
 
@@ -67,19 +77,27 @@ namespace TrenchBroom {
             if (m_params.onTop)
                 glAssert(glDisable(GL_DEPTH_TEST))
 
-            {
-                ActiveShader shader(renderContext.shaderManager(), Shaders::EdgeShader);
-                shader.set("ShowSoftMapBounds", !renderContext.softMapBounds().is_empty());
-                shader.set("SoftMapBoundsMin", renderContext.softMapBounds().min);
-                shader.set("SoftMapBoundsMax", renderContext.softMapBounds().max);
-                shader.set("SoftMapBoundsColor", vm::vec4f(pref(Preferences::SoftMapBoundsColor).r(),
-                                                           pref(Preferences::SoftMapBoundsColor).g(),
-                                                           pref(Preferences::SoftMapBoundsColor).b(),
-                                                           0.33f)); // NOTE: heavier tint than FaceRenderer, since these are lines
-                shader.set("UseUniformColor", m_params.useColor);
-                shader.set("Color", m_params.color);
-                doRenderVertices(renderContext);
-            }
+            auto& program = renderContext.shaderManager().program(Shaders::EdgeShader);
+            program.activate();
+            program.set("ShowSoftMapBounds", !renderContext.softMapBounds().is_empty());
+            program.set("SoftMapBoundsMin", renderContext.softMapBounds().min);
+            program.set("SoftMapBoundsMax", renderContext.softMapBounds().max);
+            program.set("SoftMapBoundsColor", vm::vec4f(pref(Preferences::SoftMapBoundsColor).r(),
+                                                        pref(Preferences::SoftMapBoundsColor).g(),
+                                                        pref(Preferences::SoftMapBoundsColor).b(),
+                                                        0.33f)); // NOTE: heavier tint than FaceRenderer, since these are lines
+        }
+
+        void EdgeRenderer::RenderBase::renderEdgesInState(RenderContext& renderContext) {
+            // the color is not part of the sort key, so it is set for every renderable
+            auto& program = renderContext.shaderManager().program(Shaders::EdgeShader);
+            program.set("UseUniformColor", m_params.useColor);
+            program.set("Color", m_params.color);
+            doRenderVertices(renderContext);
+        }
+
+        void EdgeRenderer::RenderBase::cleanupEdgeState(RenderContext& renderContext) {
+            renderContext.shaderManager().program(Shaders::EdgeShader).deactivate();
 
             if (m_params.onTop)
                 glAssert(glEnable(GL_DEPTH_TEST))
@@ -136,6 +154,24 @@ namespace TrenchBroom {
             renderEdges(renderContext);
         }
 
+        std::optional<RenderSortKey> DirectEdgeRenderer::Render::doGetSortKey() const {
+            return edgeSortKey();
+        }
+
+        void DirectEdgeRenderer::Render::doSetupState(RenderContext& renderContext) {
+            setupEdgeState(renderContext);
+        }
+
+        void DirectEdgeRenderer::Render::doRenderInState(RenderContext& renderContext) {
+            if (m_vertexArray.vertexCount() == 0)
+                return;
+            renderEdgesInState(renderContext);
+        }
+
+        void DirectEdgeRenderer::Render::doCleanupState(RenderContext& renderContext) {
+            cleanupEdgeState(renderContext);
+        }
+
         void DirectEdgeRenderer::Render::doRenderVertices(RenderContext&) {
             m_indexRanges.render(m_vertexArray);
         }
@@ -189,6 +225,25 @@ namespace TrenchBroom {
             renderEdges(renderContext);
         }
 
+        std::optional<RenderSortKey> IndexedEdgeRenderer::Render::doGetSortKey() const {
+            return edgeSortKey();
+        }
+
+        void IndexedEdgeRenderer::Render::doSetupState(RenderContext& renderContext) {
+            setupEdgeState(renderContext);
+        }
+
+        void IndexedEdgeRenderer::Render::doRenderInState(RenderContext& renderContext) {
+            if (!m_indexArray->hasValidIndices()) {
+                return;
+            }
+            renderEdgesInState(renderContext);
+        }
+
+        void IndexedEdgeRenderer::Render::doCleanupState(RenderContext& renderContext) {
+            cleanupEdgeState(renderContext);
+        }
+
         void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&) {
             m_vertexArray->setupVertices();
             m_indexArray->setupIndices();
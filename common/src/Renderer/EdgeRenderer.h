@@ -53,6 +53,11 @@ namespace TrenchBroom {
                 virtual ~RenderBase();
             protected:
                 void renderEdges(RenderContext& renderContext);
+
+                RenderSortKey edgeSortKey() const;
+                void setupEdgeState(RenderContext& renderContext);
+                void renderEdgesInState(RenderContext& renderContext);
+                void cleanupEdgeState(RenderContext& renderContext);
             private:
                 virtual void doRenderVertices(RenderContext& renderContext) = 0;
             };
@@ -81,6 +86,10 @@ namespace TrenchBroom {
             private:
                 void doPrepareVertices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
+                std::optional<RenderSortKey> doGetSortKey() const override;
+                void doSetupState(RenderContext& renderContext) override;
+                void doRenderInState(RenderContext& renderContext) override;
+                void doCleanupState(RenderContext& renderContext) override;
                 void doRenderVertices(RenderContext& renderContext) override;
             };
         private:
@@ -110,6 +119,10 @@ namespace TrenchBroom {
             private:
                 void prepareVerticesAndIndices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
+                std::optional<RenderSortKey> doGetSortKey() const override;
+                void doSetupState(RenderContext& renderContext) override;
+                void doRenderInState(RenderContext& renderContext) override;
+                void doCleanupState(RenderContext& renderContext) override;
                 void doRenderVertices(RenderContext& renderContext) override;
             };
         private:
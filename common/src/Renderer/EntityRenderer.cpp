@@ -42,6 +42,8 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/scalar.h>
 
+#include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -81,6 +83,7 @@ namespace TrenchBroom {
         void EntityRenderer::setEntities(const std::vector<Model::EntityNode*>& entities) {
             m_entities = entities;
             m_modelRenderer.setEntities(std::begin(m_entities), std::end(m_entities));
+            pruneClassnameLabels();
             invalidate();
         }
 
@@ -95,6 +98,7 @@ namespace TrenchBroom {
             m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer();
             m_solidBoundsRenderer = TriangleRenderer();
             m_modelRenderer.clear();
+            m_classnameLabels.clear();
         }
 
         void EntityRenderer::reloadModels() {
@@ -207,23 +211,70 @@ namespace TrenchBroom {
             }
         }
 
+        // classnames further away than this are not shown in the 3D view, even if occluded overlays are shown
+        static const auto MaxClassnameDistance = 2048.0f;
+        // the labels are slightly inflated when decluttering so that their backgrounds do not touch
+        static const auto ClassnameMargin = vm::vec2f(4.0f, 4.0f);
+
         void EntityRenderer::renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (m_showOverlays && renderContext.showEntityClassnames()) {
                 Renderer::RenderService renderService(renderContext, renderBatch);
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
+                if (m_showOccludedOverlays) {
+                    renderService.setShowOccludedObjects();
+                } else {
+                    renderService.setHideOccludedObjects();
+                }
+
+                if (!m_classnameFont || m_classnameFont->compare(renderService.fontDescriptor()) != 0) {
+                    m_classnameLabels.clear();
+                    m_classnameFont = renderService.fontDescriptor();
+                }
+
+                struct Candidate {
+                    const Model::EntityNode* entity;
+                    const TextLayout* layout;
+                    float distance;
+                    vm::vec2f position;
+                    vm::vec2f size;
+                };
+
+                const auto& camera = renderContext.camera();
+                const auto& viewport = camera.viewport();
 
+                // cull the labels before they are laid out or checked for overlaps
+                auto candidates = std::vector<Candidate>();
                 for (const Model::EntityNode* entity : m_entities) {
                     if (m_showHiddenEntities || m_editorContext.visible(entity)) {
                         if (entity->containingGroup() == nullptr || entity->containingGroup() == m_editorContext.currentGroup()) {
-                            if (m_showOccludedOverlays)
-                                renderService.setShowOccludedObjects();
-                            else
-                                renderService.setHideOccludedObjects();
-                            renderService.renderString(entityString(entity), EntityClassnameAnchor(entity));
+                            const auto anchor = EntityClassnameAnchor(entity);
+                            const auto distance = camera.perpendicularDistanceTo(anchor.position(camera));
+                            if (distance <= 0.0f || (renderContext.render3D() && distance > MaxClassnameDistance)) {
+                                continue;
+                            }
+
+                            const auto& layout = classnameLayout(entity, renderService);
+                            const auto position = vm::vec2f(anchor.offset(camera, layout.size)) - ClassnameMargin;
+                            const auto size = round(layout.size) + 2.0f * ClassnameMargin;
+                            if (viewport.contains(position.x(), position.y(), size.x(), size.y())) {
+                                candidates.push_back({ entity, &layout, distance, position, size });
+                            }
                         }
                     }
                 }
+
+                // drop labels that overlap a label closer to the camera
+                std::sort(std::begin(candidates), std::end(candidates), [](const auto& lhs, const auto& rhs) {
+                    return lhs.distance < rhs.distance;
+                });
+
+                m_classnameDeclutterer.clear();
+                for (const auto& candidate : candidates) {
+                    if (m_classnameDeclutterer.add(candidate.position, candidate.size)) {
+                        renderService.renderString(*candidate.layout, EntityClassnameAnchor(candidate.entity));
+                    }
+                }
             }
         }
 
@@ -401,6 +452,28 @@ namespace TrenchBroom {
             m_boundsValid = true;
         }
 
+        const TextLayout& EntityRenderer::classnameLayout(const Model::EntityNode* entityNode, const RenderService& renderService) {
+            const auto& classname = entityNode->entity().classname();
+
+            auto& label = m_classnameLabels[entityNode];
+            if (label.classname != classname || label.layout.vertices.empty()) {
+                label.classname = classname;
+                label.layout = renderService.layoutString(entityString(entityNode));
+            }
+            return label.layout;
+        }
+
+        void EntityRenderer::pruneClassnameLabels() {
+            const auto entities = std::unordered_set<const Model::EntityNode*>(std::begin(m_entities), std::end(m_entities));
+            for (auto it = std::begin(m_classnameLabels); it != std::end(m_classnameLabels);) {
+                if (entities.count(it->first) == 0u) {
+                    it = m_classnameLabels.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
         AttrString EntityRenderer::entityString(const Model::EntityNode* entityNode) const {
             const auto& classname = entityNode->entity().classname();
             // const Model::AttributeValue& targetname = entity->attribute(Model::AttributeNames::Targetname);
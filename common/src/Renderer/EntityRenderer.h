@@ -22,11 +22,17 @@
 #include "Color.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/EntityModelRenderer.h"
+#include "Renderer/FontDescriptor.h"
+#include "Renderer/LabelDeclutterer.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextRenderer.h"
 #include "Renderer/TriangleRenderer.h"
 
 #include <vecmath/forward.h>
 
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -43,11 +49,20 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class AttrString;
+        class RenderService;
 
         class EntityRenderer {
         private:
             class EntityClassnameAnchor;
 
+            /**
+             * The laid out classname of an entity. It is laid out again when the classname changes.
+             */
+            struct ClassnameLabel {
+                std::string classname;
+                TextLayout layout;
+            };
+
             Assets::EntityModelManager& m_entityModelManager;
             const Model::EditorContext& m_editorContext;
             std::vector<Model::EntityNode*> m_entities;
@@ -72,6 +87,10 @@ namespace TrenchBroom {
             bool m_showAngles;
             Color m_angleColor;
             bool m_showHiddenEntities;
+
+            std::unordered_map<const Model::EntityNode*, ClassnameLabel> m_classnameLabels;
+            std::optional<FontDescriptor> m_classnameFont;
+            LabelDeclutterer m_classnameDeclutterer;
         public:
             EntityRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
 
@@ -117,6 +136,9 @@ namespace TrenchBroom {
             void invalidateBounds();
             void validateBounds();
 
+            const TextLayout& classnameLayout(const Model::EntityNode* entityNode, const RenderService& renderService);
+            void pruneClassnameLabels();
+
             AttrString entityString(const Model::EntityNode* entityNode) const;
             const Color& boundsColor(const Model::EntityNode* entityNode) const;
         };
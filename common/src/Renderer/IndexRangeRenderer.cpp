@@ -27,8 +27,8 @@ namespace TrenchBroom {
         m_vertexArray(vertexArray),
         m_indexArray(indexArray) {}
 
-        void IndexRangeRenderer::prepare(VboManager& vboManager) {
-            m_vertexArray.prepare(vboManager);
+        void IndexRangeRenderer::prepare(VboManager& vboManager, const VboUsage usage) {
+            m_vertexArray.prepare(vboManager, usage);
         }
 
         void IndexRangeRenderer::render() {
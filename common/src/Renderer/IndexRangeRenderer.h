@@ -40,7 +40,7 @@ namespace TrenchBroom {
 
             IndexRangeRenderer(const VertexArray& vertexArray, const IndexRangeMap& indexArray);
 
-            void prepare(VboManager& vboManager);
+            void prepare(VboManager& vboManager, VboUsage usage = VboUsage::StaticDraw);
             void render();
         };
     }
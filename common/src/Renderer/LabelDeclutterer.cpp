@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LabelDeclutterer.h"
+
+#include <cmath>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        const float LabelDeclutterer::DefaultCellSize = 64.0f;
+
+        LabelDeclutterer::LabelDeclutterer(const float cellSize) :
+        m_cellSize(cellSize) {}
+
+        static bool overlaps(const vm::vec2f& min1, const vm::vec2f& max1, const vm::vec2f& min2, const vm::vec2f& max2) {
+            return min1.x() < max2.x() && min2.x() < max1.x() &&
+                   min1.y() < max2.y() && min2.y() < max1.y();
+        }
+
+        bool LabelDeclutterer::add(const vm::vec2f& position, const vm::vec2f& size) {
+            const auto min = position;
+            const auto max = position + size;
+
+            const auto minX = cellCoord(min.x());
+            const auto minY = cellCoord(min.y());
+            const auto maxX = cellCoord(max.x());
+            const auto maxY = cellCoord(max.y());
+
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y) {
+                    const auto it = m_cells.find(cellKey(x, y));
+                    if (it != std::end(m_cells)) {
+                        for (const auto index : it->second) {
+                            const auto& rect = m_rects[index];
+                            if (overlaps(min, max, rect.min, rect.max)) {
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+
+            const auto index = m_rects.size();
+            m_rects.push_back({ min, max });
+
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y) {
+                    m_cells[cellKey(x, y)].push_back(index);
+                }
+            }
+
+            return true;
+        }
+
+        size_t LabelDeclutterer::count() const {
+            return m_rects.size();
+        }
+
+        void LabelDeclutterer::clear() {
+            m_rects.clear();
+            for (auto& cell : m_cells) {
+                cell.second.clear();
+            }
+        }
+
+        int LabelDeclutterer::cellCoord(const float f) const {
+            return static_cast<int>(std::floor(f / m_cellSize));
+        }
+
+        uint64_t LabelDeclutterer::cellKey(const int x, const int y) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+        }
+    }
+}
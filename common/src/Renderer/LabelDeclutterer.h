@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Drops screen space labels that overlap a label that was accepted before. To avoid comparing every pair of
+         * labels, the accepted labels are binned into a grid of square cells, and a label is only compared to the
+         * labels in the cells it covers.
+         *
+         * Labels should be added in order of priority, e.g. by their distance to the camera.
+         */
+        class LabelDeclutterer {
+        private:
+            struct Rect {
+                vm::vec2f min;
+                vm::vec2f max;
+            };
+
+            static const float DefaultCellSize;
+
+            float m_cellSize;
+            std::vector<Rect> m_rects;
+            std::unordered_map<uint64_t, std::vector<size_t>> m_cells;
+        public:
+            explicit LabelDeclutterer(float cellSize = DefaultCellSize);
+
+            /**
+             * Adds a label with the given position (its lower left corner) and size if it does not overlap any of
+             * the labels added so far.
+             *
+             * @return true if the label was added and false if it was dropped
+             */
+            bool add(const vm::vec2f& position, const vm::vec2f& size);
+
+            size_t count() const;
+
+            /**
+             * Removes all labels. The memory allocated for the grid cells is kept for the next frame.
+             */
+            void clear();
+        private:
+            int cellCoord(float f) const;
+            static uint64_t cellKey(int x, int y);
+        };
+    }
+}
@@ -190,7 +190,7 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
-            commitPendingChanges();
+            commitPendingChanges(renderContext);
             setupGL(renderBatch);
             renderDefaultOpaque(renderContext, renderBatch);
             renderLockedOpaque(renderContext, renderBatch);
@@ -204,9 +204,10 @@ namespace TrenchBroom {
             renderGroupLinks(renderContext, renderBatch);
         }
 
-        void MapRenderer::commitPendingChanges() {
+        void MapRenderer::commitPendingChanges(const RenderContext& renderContext) {
+            // every map view has its own camera, so the camera identifies the view that renders
             auto document = kdl::mem_lock(m_document);
-            document->commitPendingAssets();
+            document->commitPendingAssets(&renderContext.camera());
         }
 
         class SetupGL : public Renderable {
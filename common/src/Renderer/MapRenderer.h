@@ -84,7 +84,7 @@ namespace TrenchBroom {
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
-            void commitPendingChanges();
+            void commitPendingChanges(const RenderContext& renderContext);
             void setupGL(RenderBatch& renderBatch);
             void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
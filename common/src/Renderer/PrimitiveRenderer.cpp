@@ -248,14 +248,14 @@ namespace TrenchBroom {
         void PrimitiveRenderer::prepareLines(VboManager& vboManager) {
             for (auto& [attributes, mesh] : m_lineMeshes) {
                 IndexRangeRenderer& renderer = m_lineMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh))).first->second;
-                renderer.prepare(vboManager);
+                renderer.prepare(vboManager, VboUsage::StreamDraw);
             }
         }
 
         void PrimitiveRenderer::prepareTriangles(VboManager& vboManager) {
             for (auto& [attributes, mesh] : m_triangleMeshes) {
                 IndexRangeRenderer& renderer = m_triangleMeshRenderers.insert(std::make_pair(attributes, IndexRangeRenderer(mesh))).first->second;
-                renderer.prepare(vboManager);
+                renderer.prepare(vboManager, VboUsage::StreamDraw);
             }
         }
 
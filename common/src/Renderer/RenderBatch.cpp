@@ -43,6 +43,22 @@ namespace TrenchBroom {
             void doRender(RenderContext& renderContext) override {
                 m_wrappee->render(renderContext);
             }
+
+            std::optional<RenderSortKey> doGetSortKey() const override {
+                return m_wrappee->sortKey();
+            }
+
+            void doSetupState(RenderContext& renderContext) override {
+                m_wrappee->setupState(renderContext);
+            }
+
+            void doRenderInState(RenderContext& renderContext) override {
+                m_wrappee->renderInState(renderContext);
+            }
+
+            void doCleanupState(RenderContext& renderContext) override {
+                m_wrappee->cleanupState(renderContext);
+            }
         };
 
         RenderBatch::RenderBatch(VboManager& vboManager) :
@@ -92,6 +108,10 @@ namespace TrenchBroom {
             renderRenderables(renderContext);
         }
 
+        const RenderStateChanges& RenderBatch::stateChanges() const {
+            return m_stateChanges;
+        }
+
         void RenderBatch::doAdd(Renderable* renderable) {
             ensure(renderable != nullptr, "renderable is null");
             m_batch.push_back(renderable);
@@ -107,8 +127,40 @@ namespace TrenchBroom {
         }
 
         void RenderBatch::renderRenderables(RenderContext& renderContext) {
-            for (Renderable* renderable : m_batch)
-                renderable->render(renderContext);
+            const auto keys = kdl::vec_transform(m_batch, [](const Renderable* renderable) { return renderable->sortKey(); });
+
+            m_stateChanges = RenderStateChanges();
+
+            // the renderable whose state is currently set up, if any
+            Renderable* stateOwner = nullptr;
+            std::optional<RenderSortKey> previousKey;
+
+            for (const size_t index : sortRenderOrder(keys)) {
+                auto* renderable = m_batch[index];
+                const auto& key = keys[index];
+
+                if (stateOwner != nullptr && key != previousKey) {
+                    stateOwner->cleanupState(renderContext);
+                    stateOwner = nullptr;
+                }
+
+                m_stateChanges.add(previousKey, key);
+                previousKey = key;
+
+                if (key) {
+                    if (stateOwner == nullptr) {
+                        renderable->setupState(renderContext);
+                        stateOwner = renderable;
+                    }
+                    renderable->renderInState(renderContext);
+                } else {
+                    renderable->render(renderContext);
+                }
+            }
+
+            if (stateOwner != nullptr) {
+                stateOwner->cleanupState(renderContext);
+            }
         }
     }
 }
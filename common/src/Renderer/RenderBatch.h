@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "Renderer/RenderSortKey.h"
+
 #include <vector>
 
 namespace TrenchBroom {
@@ -44,6 +46,8 @@ namespace TrenchBroom {
 
             RenderableList m_batch;
             RenderableList m_oneshots;
+
+            RenderStateChanges m_stateChanges;
         public:
             explicit RenderBatch(VboManager& vboManager);
             ~RenderBatch();
@@ -60,7 +64,16 @@ namespace TrenchBroom {
             void addOneShot(DirectRenderable* renderable);
             void addOneShot(IndexedRenderable* renderable);
 
+            /**
+             * Renders the renderables in this batch. Renderables that provide a sort key are reordered to reduce the
+             * number of state changes, see sortRenderOrder().
+             */
             void render(RenderContext& renderContext);
+
+            /**
+             * Returns the number of draws and state changes caused by the last call to render().
+             */
+            const RenderStateChanges& stateChanges() const;
         private:
             void doAdd(Renderable* renderable);
 
@@ -141,6 +141,22 @@ namespace TrenchBroom {
             renderHeadsUp(AttrString(string));
         }
 
+        const FontDescriptor& RenderService::fontDescriptor() const {
+            return m_textRenderer->fontDescriptor();
+        }
+
+        TextLayout RenderService::layoutString(const AttrString& string) const {
+            return m_textRenderer->layoutString(m_renderContext, string);
+        }
+
+        void RenderService::renderString(const TextLayout& layout, const TextAnchor& position) {
+            if (m_occlusionPolicy != PrimitiveRendererOcclusionPolicy::Hide) {
+                m_textRenderer->renderStringOnTop(m_renderContext, m_foregroundColor, m_backgroundColor, layout, position);
+            } else {
+                m_textRenderer->renderString(m_renderContext, m_foregroundColor, m_backgroundColor, layout, position);
+            }
+        }
+
         void RenderService::renderHandles(const std::vector<vm::vec3f>& positions) {
             for (const vm::vec3f& position : positions)
                 renderHandle(position);
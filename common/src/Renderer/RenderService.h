@@ -32,6 +32,7 @@
 namespace TrenchBroom {
     namespace Renderer {
         class AttrString;
+        class FontDescriptor;
         class PointHandleRenderer;
         class PrimitiveRenderer;
         enum class PrimitiveRendererCullingPolicy;
@@ -39,6 +40,7 @@ namespace TrenchBroom {
         class RenderBatch;
         class RenderContext;
         class TextAnchor;
+        struct TextLayout;
         class TextRenderer;
 
         class RenderService {
@@ -83,6 +85,10 @@ namespace TrenchBroom {
             void renderString(const std::string& string, const TextAnchor& position);
             void renderHeadsUp(const std::string& string);
 
+            const FontDescriptor& fontDescriptor() const;
+            TextLayout layoutString(const AttrString& string) const;
+            void renderString(const TextLayout& layout, const TextAnchor& position);
+
             void renderHandles(const std::vector<vm::vec3f>& positions);
             void renderHandle(const vm::vec3f& position);
             void renderHandleHighlight(const vm::vec3f& position);
@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderSortKey.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <tuple>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        bool operator==(const RenderSortKey& lhs, const RenderSortKey& rhs) {
+            return std::tie(lhs.depthTest, lhs.blend, lhs.shader, lhs.texture, lhs.lineWidth, lhs.depthOffset)
+                == std::tie(rhs.depthTest, rhs.blend, rhs.shader, rhs.texture, rhs.lineWidth, rhs.depthOffset);
+        }
+
+        bool operator!=(const RenderSortKey& lhs, const RenderSortKey& rhs) {
+            return !(lhs == rhs);
+        }
+
+        bool operator<(const RenderSortKey& lhs, const RenderSortKey& rhs) {
+            // renderables without depth testing go last, and blended ones go after opaque ones
+            const auto lhsPass = std::make_tuple(!lhs.depthTest, lhs.blend);
+            const auto rhsPass = std::make_tuple(!rhs.depthTest, rhs.blend);
+            if (lhsPass != rhsPass) {
+                return lhsPass < rhsPass;
+            }
+            if (lhs.shader != rhs.shader) {
+                return std::less<const ShaderConfig*>()(lhs.shader, rhs.shader);
+            }
+            return std::tie(lhs.texture, lhs.lineWidth, lhs.depthOffset) < std::tie(rhs.texture, rhs.lineWidth, rhs.depthOffset);
+        }
+
+        void RenderStateChanges::add(const std::optional<RenderSortKey>& previous, const std::optional<RenderSortKey>& current) {
+            ++draws;
+
+            if (!previous || !current) {
+                ++stateChanges;
+                ++shaderChanges;
+                if (!current || current->texture != 0u) {
+                    ++textureChanges;
+                }
+                return;
+            }
+
+            if (*previous == *current) {
+                return;
+            }
+
+            ++stateChanges;
+            if (previous->shader != current->shader) {
+                ++shaderChanges;
+            }
+            if (previous->texture != current->texture) {
+                ++textureChanges;
+            }
+            if (previous->blend != current->blend) {
+                ++blendChanges;
+            }
+            if (previous->depthTest != current->depthTest || previous->depthOffset != current->depthOffset) {
+                ++depthChanges;
+            }
+        }
+
+        RenderStateChanges countStateChanges(const std::vector<std::optional<RenderSortKey>>& keys) {
+            auto result = RenderStateChanges();
+            auto previous = std::optional<RenderSortKey>();
+            for (const auto& key : keys) {
+                result.add(previous, key);
+                previous = key;
+            }
+            return result;
+        }
+
+        std::vector<size_t> sortRenderOrder(const std::vector<std::optional<RenderSortKey>>& keys) {
+            auto result = std::vector<size_t>(keys.size());
+            std::iota(std::begin(result), std::end(result), 0u);
+
+            const auto compareKeys = [&](const size_t lhs, const size_t rhs) {
+                return *keys[lhs] < *keys[rhs];
+            };
+
+            auto first = std::begin(result);
+            while (first != std::end(result)) {
+                first = std::find_if(first, std::end(result), [&](const size_t i) { return keys[i].has_value(); });
+                const auto last = std::find_if(first, std::end(result), [&](const size_t i) { return !keys[i].has_value(); });
+                std::stable_sort(first, last, compareKeys);
+                first = last;
+            }
+
+            return result;
+        }
+    }
+}
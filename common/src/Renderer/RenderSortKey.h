@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class ShaderConfig;
+
+        /**
+         * Describes the OpenGL state that a renderable requires.
+         *
+         * Renderables that provide a sort key can be reordered by a render batch so that renderables requiring the
+         * same state are rendered one after another. Consecutive renderables with equal sort keys share the setup of
+         * their state.
+         *
+         * The sort order is chosen such that renderables with depth testing are rendered before renderables without
+         * depth testing, and opaque renderables are rendered before blended renderables.
+         */
+        struct RenderSortKey {
+            bool depthTest;
+            bool blend;
+            const ShaderConfig* shader;
+            unsigned int texture;
+            float lineWidth;
+            double depthOffset;
+        };
+
+        bool operator==(const RenderSortKey& lhs, const RenderSortKey& rhs);
+        bool operator!=(const RenderSortKey& lhs, const RenderSortKey& rhs);
+        bool operator<(const RenderSortKey& lhs, const RenderSortKey& rhs);
+
+        /**
+         * Counts the draws and state changes that a sequence of renderables causes.
+         */
+        struct RenderStateChanges {
+            size_t draws = 0u;
+            /**
+             * The number of times that any state had to be set up.
+             */
+            size_t stateChanges = 0u;
+            size_t shaderChanges = 0u;
+            size_t textureChanges = 0u;
+            size_t blendChanges = 0u;
+            size_t depthChanges = 0u;
+
+            /**
+             * Records a draw with the given state, given the state of the previous draw. A missing key stands for a
+             * renderable that sets up all of its state by itself.
+             */
+            void add(const std::optional<RenderSortKey>& previous, const std::optional<RenderSortKey>& current);
+        };
+
+        /**
+         * Counts the draws and state changes for rendering renderables with the given keys in the given order.
+         */
+        RenderStateChanges countStateChanges(const std::vector<std::optional<RenderSortKey>>& keys);
+
+        /**
+         * Returns the order in which renderables with the given keys should be rendered.
+         *
+         * Renderables without a key are barriers: they are rendered at their original position, and no renderable is
+         * moved across them. Between two barriers, renderables are stably sorted by their keys.
+         */
+        std::vector<size_t> sortRenderOrder(const std::vector<std::optional<RenderSortKey>>& keys);
+    }
+}
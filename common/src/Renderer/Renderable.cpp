@@ -25,6 +25,34 @@ namespace TrenchBroom {
             doRender(renderContext);
         }
 
+        std::optional<RenderSortKey> Renderable::sortKey() const {
+            return doGetSortKey();
+        }
+
+        void Renderable::setupState(RenderContext& renderContext) {
+            doSetupState(renderContext);
+        }
+
+        void Renderable::renderInState(RenderContext& renderContext) {
+            doRenderInState(renderContext);
+        }
+
+        void Renderable::cleanupState(RenderContext& renderContext) {
+            doCleanupState(renderContext);
+        }
+
+        std::optional<RenderSortKey> Renderable::doGetSortKey() const {
+            return std::nullopt;
+        }
+
+        void Renderable::doSetupState(RenderContext&) {}
+
+        void Renderable::doRenderInState(RenderContext& renderContext) {
+            doRender(renderContext);
+        }
+
+        void Renderable::doCleanupState(RenderContext&) {}
+
         void DirectRenderable::prepareVertices(VboManager& vboManager) {
             doPrepareVertices(vboManager);
         }
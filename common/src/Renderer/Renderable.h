@@ -20,6 +20,9 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/RenderSortKey.h"
+
+#include <optional>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -32,9 +35,28 @@ namespace TrenchBroom {
             virtual ~Renderable() = default;
 
             void render(RenderContext& renderContext);
+
+            /**
+             * Returns the state that this renderable requires, or an empty optional if this renderable must be
+             * rendered at the position at which it was added to a render batch.
+             *
+             * If a sort key is returned, the render batch may reorder this renderable with other renderables that
+             * have a sort key. Of a sequence of renderables with equal sort keys, the render batch calls setupState()
+             * on the first, renderInState() on every renderable and finally cleanupState() on the first one again, so
+             * that the renderable which set up the state also cleans it up.
+             */
+            std::optional<RenderSortKey> sortKey() const;
+            void setupState(RenderContext& renderContext);
+            void renderInState(RenderContext& renderContext);
+            void cleanupState(RenderContext& renderContext);
         private:
             virtual void doRender(RenderContext& renderContext) = 0;
 
+            virtual std::optional<RenderSortKey> doGetSortKey() const;
+            virtual void doSetupState(RenderContext& renderContext);
+            virtual void doRenderInState(RenderContext& renderContext);
+            virtual void doCleanupState(RenderContext& renderContext);
+
             defineCopyAndMove(Renderable)
         };
 
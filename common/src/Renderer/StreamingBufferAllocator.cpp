@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StreamingBufferAllocator.h"
+
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        StreamingBufferAllocator::StreamingBufferAllocator(const Index regionSize, const size_t regionCount) :
+        m_regionSize(regionSize),
+        m_regionCount(regionCount),
+        m_currentRegion(regionCount - 1u),
+        m_head(0u) {
+            assert(m_regionCount > 0u);
+        }
+
+        StreamingBufferAllocator::Index StreamingBufferAllocator::regionSize() const {
+            return m_regionSize;
+        }
+
+        size_t StreamingBufferAllocator::regionCount() const {
+            return m_regionCount;
+        }
+
+        StreamingBufferAllocator::Index StreamingBufferAllocator::capacity() const {
+            return m_regionSize * m_regionCount;
+        }
+
+        size_t StreamingBufferAllocator::beginFrame() {
+            m_currentRegion = (m_currentRegion + 1u) % m_regionCount;
+            m_head = 0u;
+            return m_currentRegion;
+        }
+
+        size_t StreamingBufferAllocator::currentRegion() const {
+            return m_currentRegion;
+        }
+
+        StreamingBufferAllocator::Index StreamingBufferAllocator::allocatedBytes() const {
+            return m_head;
+        }
+
+        std::optional<StreamingBufferAllocator::Index> StreamingBufferAllocator::allocate(const Index size, const Index alignment) {
+            assert(alignment > 0u);
+
+            const auto regionStart = m_currentRegion * m_regionSize;
+            const auto unaligned = regionStart + m_head;
+            const auto aligned = (unaligned + alignment - 1u) / alignment * alignment;
+            const auto end = aligned + size;
+
+            if (end > regionStart + m_regionSize) {
+                return std::nullopt;
+            }
+
+            m_head = end - regionStart;
+            return aligned;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Implements the bookkeeping for a streaming buffer that is divided into a number of equally sized regions.
+         *
+         * Each frame writes its data into one region, starting at the beginning of the region. When a new frame
+         * begins, the allocator moves on to the next region, wrapping around after the last one. With three regions,
+         * the CPU can write the data for one frame while the GPU is still reading the data of the two previous
+         * frames. It is up to the caller to ensure that the GPU is done reading a region before it is reused.
+         *
+         * This class does not depend on OpenGL.
+         */
+        class StreamingBufferAllocator {
+        public:
+            using Index = size_t;
+        private:
+            Index m_regionSize;
+            size_t m_regionCount;
+            size_t m_currentRegion;
+            Index m_head;
+        public:
+            /**
+             * Creates a new allocator for a buffer of regionSize * regionCount bytes.
+             *
+             * The allocator starts out in the last region, so that the first call to beginFrame() selects the first
+             * region.
+             */
+            StreamingBufferAllocator(Index regionSize, size_t regionCount);
+
+            Index regionSize() const;
+            size_t regionCount() const;
+            Index capacity() const;
+
+            /**
+             * Starts a new frame and returns the index of the region that the frame writes into.
+             */
+            size_t beginFrame();
+
+            /**
+             * Returns the index of the region that the current frame writes into.
+             */
+            size_t currentRegion() const;
+
+            /**
+             * Returns the number of bytes that have been allocated in the current region, including padding.
+             */
+            Index allocatedBytes() const;
+
+            /**
+             * Allocates the given number of bytes in the current region. The returned offset is relative to the start
+             * of the buffer and is a multiple of the given alignment.
+             *
+             * Returns an empty optional if the current region does not have enough space left.
+             */
+            std::optional<Index> allocate(Index size, Index alignment = 1u);
+        };
+    }
+}
@@ -62,6 +62,16 @@ namespace TrenchBroom {
         m_minZoomFactor(minZoomFactor),
         m_inset(inset) {}
 
+        const FontDescriptor& TextRenderer::fontDescriptor() const {
+            return m_fontDescriptor;
+        }
+
+        TextLayout TextRenderer::layoutString(RenderContext& renderContext, const AttrString& string) const {
+            FontManager& fontManager = renderContext.fontManager();
+            TextureFont& font = fontManager.font(m_fontDescriptor);
+            return TextLayout{ font.quads(string, true), font.measure(string) };
+        }
+
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position) {
             renderString(renderContext, textColor, backgroundColor, string, position, false);
         }
@@ -70,6 +80,14 @@ namespace TrenchBroom {
             renderString(renderContext, textColor, backgroundColor, string, position, true);
         }
 
+        void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position) {
+            renderString(renderContext, textColor, backgroundColor, layout, position, false);
+        }
+
+        void TextRenderer::renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position) {
+            renderString(renderContext, textColor, backgroundColor, layout, position, true);
+        }
+
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, const bool onTop) {
 
             const Camera& camera = renderContext.camera();
@@ -77,16 +95,28 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
 
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            if (!isVisible(renderContext, stringSize(renderContext, string), position, distance, onTop))
                 return;
 
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
+            TextLayout layout = layoutString(renderContext, string);
+            addString(renderContext, textColor, backgroundColor, std::move(layout.vertices), layout.size, position, distance, onTop);
+        }
+
+        void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position, const bool onTop) {
+            const Camera& camera = renderContext.camera();
+            const float distance = camera.perpendicularDistanceTo(position.position(camera));
+            if (distance <= 0.0f)
+                return;
+
+            if (!isVisible(renderContext, round(layout.size), position, distance, onTop))
+                return;
+
+            addString(renderContext, textColor, backgroundColor, layout.vertices, layout.size, position, distance, onTop);
+        }
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+        void TextRenderer::addString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, std::vector<vm::vec2f> vertices, const vm::vec2f& size, const TextAnchor& position, const float distance, const bool onTop) {
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
-            const vm::vec3f offset = position.offset(camera, size);
+            const vm::vec3f offset = position.offset(renderContext.camera(), size);
 
             if (onTop)
                 addEntry(m_entriesOnTop, Entry(vertices, size, offset,
@@ -98,7 +128,7 @@ namespace TrenchBroom {
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isVisible(RenderContext& renderContext, const vm::vec2f& size, const TextAnchor& position, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
@@ -109,7 +139,6 @@ namespace TrenchBroom {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.viewport();
 
-            const vm::vec2f size = stringSize(renderContext, string);
             const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
             const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -165,8 +194,8 @@ namespace TrenchBroom {
             collection.textArray = VertexArray::move(std::move(textVertices));
             collection.rectArray = VertexArray::move(std::move(rectVertices));
 
-            collection.textArray.prepare(vboManager);
-            collection.rectArray.prepare(vboManager);
+            collection.textArray.prepare(vboManager, VboUsage::StreamDraw);
+            collection.rectArray.prepare(vboManager, VboUsage::StreamDraw);
         }
 
         void TextRenderer::addEntry(const Entry& entry, const bool /* onTop */, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
@@ -36,6 +36,15 @@ namespace TrenchBroom {
         class RenderContext;
         class TextAnchor;
 
+        /**
+         * The glyph quads and the size of a string that was laid out with a particular font. A layout can be cached
+         * and rendered repeatedly at different positions.
+         */
+        struct TextLayout {
+            std::vector<vm::vec2f> vertices;
+            vm::vec2f size;
+        };
+
         class TextRenderer : public DirectRenderable {
         private:
             static const float DefaultMaxViewDistance;
@@ -80,12 +89,20 @@ namespace TrenchBroom {
         public:
             explicit TextRenderer(const FontDescriptor& fontDescriptor, float maxViewDistance = DefaultMaxViewDistance, float minZoomFactor = DefaultMinZoomFactor, const vm::vec2f& inset = DefaultInset);
 
+            const FontDescriptor& fontDescriptor() const;
+            TextLayout layoutString(RenderContext& renderContext, const AttrString& string) const;
+
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
             void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
+
+            void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position);
+            void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position);
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
+            void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position, bool onTop);
+            void addString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, std::vector<vm::vec2f> vertices, const vm::vec2f& size, const TextAnchor& position, float distance, bool onTop);
 
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const vm::vec2f& size, const TextAnchor& position, float distance, bool onTop) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
             void addEntry(EntryCollection& collection, const Entry& entry);
 
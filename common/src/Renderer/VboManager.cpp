@@ -22,8 +22,12 @@
 #include "Vbo.h"
 #include "GL.h"
 #include "Macros.h"
+#include "Renderer/StreamingBufferAllocator.h"
 
 #include <algorithm> // for std::max
+#include <cassert>
+#include <cstring>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -46,17 +50,122 @@ namespace TrenchBroom {
                     return GL_STATIC_DRAW;
                 case VboUsage::DynamicDraw:
                     return GL_DYNAMIC_DRAW;
+                case VboUsage::StreamDraw:
+                    return GL_STREAM_DRAW;
                 switchDefault()
             }
         }
 
+        // VboManager::StreamingBuffer
+
+        class VboManager::StreamingBuffer {
+        private:
+            static constexpr size_t RegionSize = 4u * 1024u * 1024u;
+            static constexpr size_t RegionCount = 3u;
+            static constexpr size_t Alignment = 16u;
+
+            StreamingBufferAllocator m_allocator;
+            GLuint m_bufferId;
+            unsigned char* m_memory;
+            std::vector<GLsync> m_fences;
+        public:
+            static bool supported() {
+                return GLEW_ARB_buffer_storage && GLEW_ARB_sync;
+            }
+
+            StreamingBuffer() :
+            m_allocator(RegionSize, RegionCount),
+            m_bufferId(0),
+            m_memory(nullptr),
+            m_fences(RegionCount, nullptr) {
+                const auto capacity = static_cast<GLsizeiptr>(m_allocator.capacity());
+                const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+                glAssert(glGenBuffers(1, &m_bufferId));
+                glAssert(glBindBuffer(GL_ARRAY_BUFFER, m_bufferId));
+                glAssert(glBufferStorage(GL_ARRAY_BUFFER, capacity, nullptr, flags));
+                glAssert(m_memory = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, capacity, flags)));
+                glAssert(glBindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+
+            ~StreamingBuffer() {
+                for (auto fence : m_fences) {
+                    if (fence != nullptr) {
+                        glAssert(glDeleteSync(fence));
+                    }
+                }
+                if (m_memory != nullptr) {
+                    glAssert(glBindBuffer(GL_ARRAY_BUFFER, m_bufferId));
+                    glAssert(glUnmapBuffer(GL_ARRAY_BUFFER));
+                    glAssert(glBindBuffer(GL_ARRAY_BUFFER, 0));
+                }
+                glAssert(glDeleteBuffers(1, &m_bufferId));
+            }
+
+            deleteCopyAndMove(StreamingBuffer)
+
+            bool valid() const {
+                return m_memory != nullptr;
+            }
+
+            /**
+             * Moves on to the next region and waits until the GPU has finished reading it. Returns true if waiting was
+             * necessary.
+             */
+            bool beginFrame() {
+                const auto region = m_allocator.beginFrame();
+                auto& fence = m_fences[region];
+                if (fence == nullptr) {
+                    return false;
+                }
+
+                GLenum result;
+                glAssert(result = glClientWaitSync(fence, 0, 0));
+                const auto stalled = result == GL_TIMEOUT_EXPIRED;
+                while (result == GL_TIMEOUT_EXPIRED) {
+                    glAssert(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000u));
+                }
+
+                glAssert(glDeleteSync(fence));
+                fence = nullptr;
+                return stalled;
+            }
+
+            void endFrame() {
+                auto& fence = m_fences[m_allocator.currentRegion()];
+                assert(fence == nullptr);
+                glAssert(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            }
+
+            std::optional<size_t> write(const void* data, const size_t size) {
+                const auto offset = m_allocator.allocate(size, Alignment);
+                if (offset) {
+                    std::memcpy(m_memory + *offset, data, size);
+                }
+                return offset;
+            }
+
+            void bind() {
+                glAssert(glBindBuffer(GL_ARRAY_BUFFER, m_bufferId));
+            }
+
+            void unbind() {
+                glAssert(glBindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+        };
+
         // VboManager
 
         VboManager::VboManager(ShaderManager* shaderManager) :
         m_peakVboCount(0u),
         m_currentVboCount(0u),
         m_currentVboSize(0u),
-        m_shaderManager(shaderManager) {}
+        m_shaderManager(shaderManager),
+        m_streamingInitialized(false),
+        m_inFrame(false),
+        m_frame(0u) {}
+
+        VboManager::~VboManager() = default;
 
         Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage) {
             auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
@@ -88,6 +197,71 @@ namespace TrenchBroom {
             return m_currentVboSize;
         }
 
+        void VboManager::beginFrame() {
+            assert(!m_inFrame);
+
+            if (!m_streamingInitialized) {
+                // GLEW is not initialized yet when the VBO manager is created
+                if (StreamingBuffer::supported()) {
+                    m_streamingBuffer = std::make_unique<StreamingBuffer>();
+                    if (!m_streamingBuffer->valid()) {
+                        m_streamingBuffer.reset();
+                    }
+                }
+                m_streamingInitialized = true;
+            }
+
+            ++m_frame;
+            m_inFrame = true;
+            m_currentFrameStats = StreamingStats();
+
+            if (m_streamingBuffer != nullptr && m_streamingBuffer->beginFrame()) {
+                ++m_currentFrameStats.stalls;
+            }
+        }
+
+        void VboManager::endFrame() {
+            assert(m_inFrame);
+
+            if (m_streamingBuffer != nullptr) {
+                m_streamingBuffer->endFrame();
+            }
+
+            m_inFrame = false;
+            m_lastFrameStats = m_currentFrameStats;
+        }
+
+        std::optional<StreamingBlock> VboManager::streamData(const void* data, const size_t size) {
+            if (m_inFrame && m_streamingBuffer != nullptr) {
+                if (const auto offset = m_streamingBuffer->write(data, size)) {
+                    m_currentFrameStats.uploadedBytes += size;
+                    return StreamingBlock{*offset, m_frame};
+                }
+            }
+
+            ++m_currentFrameStats.fallbacks;
+            m_currentFrameStats.uploadedBytes += size;
+            return std::nullopt;
+        }
+
+        bool VboManager::isCurrent(const StreamingBlock& block) const {
+            return m_inFrame && block.frame == m_frame;
+        }
+
+        void VboManager::bindStreamingBuffer() {
+            assert(m_streamingBuffer != nullptr);
+            m_streamingBuffer->bind();
+        }
+
+        void VboManager::unbindStreamingBuffer() {
+            assert(m_streamingBuffer != nullptr);
+            m_streamingBuffer->unbind();
+        }
+
+        const StreamingStats& VboManager::lastFrameStreamingStats() const {
+            return m_lastFrameStats;
+        }
+
         ShaderManager& VboManager::shaderManager() {
             return *m_shaderManager;
         }
@@ -22,6 +22,10 @@
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -35,17 +39,53 @@ namespace TrenchBroom {
 
         enum class VboUsage {
             StaticDraw,
-            DynamicDraw
+            DynamicDraw,
+            /**
+             * The data is only rendered during the current frame. If possible, such data is written to the streaming
+             * buffer instead of a VBO of its own, see VboManager::streamData.
+             */
+            StreamDraw
+        };
+
+        /**
+         * The location of data that was written to the streaming buffer.
+         */
+        struct StreamingBlock {
+            size_t offset;
+            size_t frame;
+        };
+
+        struct StreamingStats {
+            size_t uploadedBytes = 0u;
+            /**
+             * The number of frames that had to wait for the GPU to finish reading the streaming buffer region.
+             */
+            size_t stalls = 0u;
+            /**
+             * The number of uploads that could not be streamed and were written to VBOs of their own.
+             */
+            size_t fallbacks = 0u;
         };
 
         class VboManager {
         private:
+            class StreamingBuffer;
+
             size_t m_peakVboCount;
             size_t m_currentVboCount;
             size_t m_currentVboSize;
             ShaderManager* m_shaderManager;
+
+            std::unique_ptr<StreamingBuffer> m_streamingBuffer;
+            bool m_streamingInitialized;
+            bool m_inFrame;
+            size_t m_frame;
+            StreamingStats m_currentFrameStats;
+            StreamingStats m_lastFrameStats;
         public:
             explicit VboManager(ShaderManager* shaderManager);
+            ~VboManager();
+
             /**
             * Immediately creates and binds to an OpenGL buffer of the given type and capacity.
             * The contents are initially unspecified. See Vbo class.
@@ -57,6 +97,44 @@ namespace TrenchBroom {
             size_t currentVboCount() const;
             size_t currentVboSize() const;
 
+            /**
+             * Begins a new frame. Data written to the streaming buffer can only be rendered until the frame ends.
+             *
+             * The streaming buffer is a persistently mapped buffer that is divided into three regions, one for each
+             * of the last three frames. Fences ensure that the GPU has finished reading a region before it is
+             * overwritten. If persistent mapping is not supported, the streaming buffer is disabled and all data is
+             * written to VBOs of their own.
+             *
+             * Must be called with a current OpenGL context.
+             */
+            void beginFrame();
+            void endFrame();
+
+            /**
+             * Copies the given data to the streaming buffer.
+             *
+             * Returns an empty optional if the streaming buffer is disabled, if no frame was begun, or if the current
+             * frame's region of the streaming buffer is full. Callers must then fall back to allocating a VBO.
+             */
+            std::optional<StreamingBlock> streamData(const void* data, size_t size);
+
+            template <typename T>
+            std::optional<StreamingBlock> streamBuffer(const std::vector<T>& buffer) {
+                static_assert(std::is_trivially_copyable<T>::value);
+                static_assert(std::is_standard_layout<T>::value);
+                return streamData(buffer.data(), buffer.size() * sizeof(T));
+            }
+
+            /**
+             * Indicates whether the given block was written during the current frame and can still be rendered.
+             */
+            bool isCurrent(const StreamingBlock& block) const;
+
+            void bindStreamingBuffer();
+            void unbindStreamingBuffer();
+
+            const StreamingStats& lastFrameStreamingStats() const;
+
             ShaderManager& shaderManager();
         };
     }
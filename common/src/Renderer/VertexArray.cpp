@@ -47,9 +47,9 @@ namespace TrenchBroom {
             return m_prepared;
         }
 
-        void VertexArray::prepare(VboManager& vboManager) {
+        void VertexArray::prepare(VboManager& vboManager, const VboUsage usage) {
             if (!prepared() && !empty()) {
-                m_holder->prepare(vboManager);
+                m_holder->prepare(vboManager, usage);
             }
             m_prepared = true;
         }
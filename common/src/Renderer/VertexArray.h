@@ -30,6 +30,7 @@
 #include <kdl/vector_utils.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom {
@@ -52,7 +53,7 @@ namespace TrenchBroom {
                 virtual size_t vertexCount() const = 0;
                 virtual size_t sizeInBytes() const = 0;
 
-                virtual void prepare(VboManager& vboManager) = 0;
+                virtual void prepare(VboManager& vboManager, VboUsage usage) = 0;
                 virtual void setup() = 0;
                 virtual void cleanup() = 0;
             };
@@ -62,6 +63,7 @@ namespace TrenchBroom {
             private:
                 VboManager* m_vboManager;
                 Vbo* m_vbo;
+                std::optional<StreamingBlock> m_streamingBlock;
                 size_t m_vertexCount;
             public:
                 size_t vertexCount() const override {
@@ -72,23 +74,46 @@ namespace TrenchBroom {
                     return VertexSpec::Size * m_vertexCount;
                 }
 
-                void prepare(VboManager& vboManager) override {
-                    if (m_vertexCount > 0 && m_vbo == nullptr) {
+                void prepare(VboManager& vboManager, const VboUsage usage) override {
+                    if (m_vertexCount > 0 && m_vbo == nullptr && !m_streamingBlock) {
                         m_vboManager = &vboManager;
-                        m_vbo = vboManager.allocateVbo(VboType::ArrayBuffer, sizeInBytes());;
-                        m_vbo->writeBuffer(0, doGetVertices());
+                        if (usage == VboUsage::StreamDraw) {
+                            m_streamingBlock = vboManager.streamBuffer(doGetVertices());
+                        }
+                        if (!m_streamingBlock) {
+                            m_vbo = vboManager.allocateVbo(VboType::ArrayBuffer, sizeInBytes(), usage);
+                            m_vbo->writeBuffer(0, doGetVertices());
+                        }
                     }
                 }
 
                 void setup() override {
-                    ensure(m_vbo != nullptr, "block is null");
-                    m_vbo->bind();
-                    VertexSpec::setup(m_vboManager->shaderManager().currentProgram(), m_vbo->offset());
+                    if (m_streamingBlock && !m_vboManager->isCurrent(*m_streamingBlock)) {
+                        // streamed data is only valid during the frame in which it was written, so write it again
+                        m_streamingBlock = m_vboManager->streamBuffer(doGetVertices());
+                        if (!m_streamingBlock) {
+                            m_vbo = m_vboManager->allocateVbo(VboType::ArrayBuffer, sizeInBytes(), VboUsage::StreamDraw);
+                            m_vbo->writeBuffer(0, doGetVertices());
+                        }
+                    }
+
+                    if (m_streamingBlock) {
+                        m_vboManager->bindStreamingBuffer();
+                        VertexSpec::setup(m_vboManager->shaderManager().currentProgram(), m_streamingBlock->offset);
+                    } else {
+                        ensure(m_vbo != nullptr, "block is null");
+                        m_vbo->bind();
+                        VertexSpec::setup(m_vboManager->shaderManager().currentProgram(), m_vbo->offset());
+                    }
                 }
 
                 void cleanup() override {
                     VertexSpec::cleanup(m_vboManager->shaderManager().currentProgram());
-                    m_vbo->unbind();
+                    if (m_streamingBlock) {
+                        m_vboManager->unbindStreamingBuffer();
+                    } else {
+                        m_vbo->unbind();
+                    }
                 }
             protected:
                 Holder(const size_t vertexCount) :
@@ -96,6 +121,10 @@ namespace TrenchBroom {
                 m_vbo(nullptr),
                 m_vertexCount(vertexCount) {}
 
+                bool streamed() const {
+                    return m_streamingBlock.has_value();
+                }
+
                 ~Holder() override {
                     // TODO: Revisit this revisiting OpenGL resource management. We should not store the VboManager,
                     // since it represents a safe time to delete the OpenGL buffer object.
@@ -124,9 +153,12 @@ namespace TrenchBroom {
                 Holder<VertexSpec>(vertices.size()),
                 m_vertices(std::move(vertices)) {}
 
-                void prepare(VboManager& vboManager) override {
-                    Holder<VertexSpec>::prepare(vboManager);
-                    kdl::vec_clear_to_zero(m_vertices);
+                void prepare(VboManager& vboManager, const VboUsage usage) override {
+                    Holder<VertexSpec>::prepare(vboManager, usage);
+                    if (!this->streamed()) {
+                        // streamed vertices must be kept in case they have to be written again in a later frame
+                        kdl::vec_clear_to_zero(m_vertices);
+                    }
                 }
             private:
                 const VertexList& doGetVertices() const override {
@@ -232,9 +264,14 @@ namespace TrenchBroom {
             /**
              * Prepares this vertex array by uploading its contents into the given vertex buffer object.
              *
+             * If the given usage is VboUsage::StreamDraw, the contents are written to the streaming buffer of the
+             * given VBO manager if possible. This is intended for vertex arrays that are recreated for every frame.
+             * If such a vertex array is rendered again in a later frame, its contents are written again.
+             *
              * @param vboManager the vertex buffer object to upload the contents of this vertex array into
+             * @param usage the expected usage of the uploaded data
              */
-            void prepare(VboManager& vboManager);
+            void prepare(VboManager& vboManager, VboUsage usage = VboUsage::StaticDraw);
 
             /**
              * Sets this vertex array up for rendering. If this vertex array is only rendered once, then there is no
@@ -19,6 +19,8 @@
 
 #include "TrenchBroomApp.h"
 
+#include "FileLogger.h"
+#include "MemoryUsage.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "RecoverableExceptions.h"
@@ -61,6 +63,7 @@
 #include <string>
 #include <vector>
 
+#include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QDebug>
 #include <QDesktopServices>
@@ -164,7 +167,18 @@ namespace TrenchBroom {
 
         void TrenchBroomApp::parseCommandLineAndShowFrame() {
             QCommandLineParser parser;
+            const auto memoryReportOption = QCommandLineOption("memory-report", tr("Print the memory usage of each subsystem when exiting."));
+            parser.addOption(memoryReportOption);
             parser.process(*this);
+
+            if (parser.isSet(memoryReportOption)) {
+                connect(this, &QCoreApplication::aboutToQuit, this, []() {
+                    std::cout << "Memory usage:\n";
+                    writeMemoryReport(std::cout);
+                    std::cout.flush();
+                });
+            }
+
             openFilesOrWelcomeFrame(parser.positionalArguments());
         }
 
@@ -500,7 +514,9 @@ namespace TrenchBroom {
                 mapPath = IO::Path();
             }
 
-            // Copy the log file
+            // Copy the log file, ensuring that pending log messages have been written first if possible; the crash
+            // might have happened while the log file was being written, so we must not wait for it indefinitely
+            FileLogger::instance().tryFlush();
             if (!QFile::copy(IO::pathAsQString(IO::SystemPaths::logFilePath()), QString::fromStdString(logPath.asString()))) {
                 logPath = IO::Path();
             }
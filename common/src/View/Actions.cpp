@@ -1611,6 +1611,13 @@ namespace TrenchBroom {
                 [](ActionExecutionContext& context) {
                     return context.hasDocument();
                 }));
+            debugMenu.addItem(createMenuAction(IO::Path("Menu/Debug/Print Memory Usage"), QObject::tr("Print Memory Usage to Console"), 0,
+                [](ActionExecutionContext& context) {
+                    context.frame()->debugPrintMemoryUsage();
+                },
+                [](ActionExecutionContext& context) {
+                    return context.hasDocument();
+                }));
 #endif
         }
 
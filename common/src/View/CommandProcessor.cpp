@@ -108,6 +108,11 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemoryUsage() const override {
+                // the commands of this transaction account for their own memory
+                return m_commands.capacity() * sizeof(std::unique_ptr<UndoableCommand>);
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -257,10 +262,16 @@ namespace TrenchBroom {
         }
 
         bool CommandProcessor::storeCommand(std::unique_ptr<UndoableCommand> command, const bool collate) {
+            // the command is either stored or collated into the last stored command, whose memory usage is only computed
+            // here and not whenever commands are moved between the undo and redo stacks
             if (m_transactionStack.empty()) {
-                return pushToUndoStack(std::move(command), collate);
+                const auto stored = pushToUndoStack(std::move(command), collate);
+                m_undoStack.back()->updateMemoryUsage();
+                return stored;
             } else {
-                return pushTransactionCommand(std::move(command), collate);
+                const auto stored = pushTransactionCommand(std::move(command), collate);
+                m_transactionStack.back().commands.back()->updateMemoryUsage();
+                return stored;
             }
         }
 
@@ -288,6 +299,7 @@ namespace TrenchBroom {
                 }
                 auto command = createTransaction(transaction.name, std::move(transaction.commands));
 
+                command->updateMemoryUsage();
                 if (m_transactionStack.empty()) {
                     pushToUndoStack(std::move(command), false);
                 } else {
@@ -27,12 +27,17 @@
 #include <QDebug>
 #include <QScrollBar>
 #include <QTextEdit>
+#include <QTimer>
 #include <QVBoxLayout>
 
 namespace TrenchBroom {
     namespace View {
         Console::Console(QWidget* parent) :
-        TabBookPage(parent) {
+        TabBookPage(parent),
+        m_textView(nullptr),
+        m_flushTimer(nullptr),
+        m_rateLimitTimer(nullptr),
+        m_suppressedCount(0u) {
             m_textView = new QTextEdit();
             m_textView->setReadOnly(true);
             m_textView->setWordWrapMode(QTextOption::NoWrap);
@@ -41,6 +46,16 @@ namespace TrenchBroom {
             sizer->setContentsMargins(0, 0, 0, 0);
             sizer->addWidget(m_textView);
             setLayout(sizer);
+
+            m_flushTimer = new QTimer(this);
+            m_flushTimer->setSingleShot(true);
+            m_flushTimer->setInterval(0);
+            connect(m_flushTimer, &QTimer::timeout, this, &Console::flushPendingMessages);
+
+            m_rateLimitTimer = new QTimer(this);
+            m_rateLimitTimer->setSingleShot(true);
+            m_rateLimitTimer->setInterval(RateLimitInterval);
+            connect(m_rateLimitTimer, &QTimer::timeout, this, &Console::endRateLimitInterval);
         }
 
         void Console::doLog(const LogLevel level, const std::string& message) {
@@ -60,30 +75,72 @@ namespace TrenchBroom {
         }
 
         void Console::logToConsole(const LogLevel level, const QString& message) {
-            // NOTE: QPalette::Text is the correct color role for contrast against QPalette::Base
-            // which is the background of text entry widgets 
-            QTextCharFormat format;
-            switch (level) {
-                case LogLevel::Debug:
-                    format.setForeground(QBrush(m_textView->palette().color(QPalette::Disabled, QPalette::Text)));
-                    break;
-                case LogLevel::Info:
-                    break;
-                case LogLevel::Warn:
-                    format.setForeground(QBrush(m_textView->palette().color(QPalette::Active, QPalette::Text)));
-                    break;
-                case LogLevel::Error:
-                    format.setForeground(QBrush(QColor(250, 30, 60)));
-                    break;
+            if (!m_rateLimitTimer->isActive()) {
+                m_rateLimitTimer->start();
+            }
+
+            if (!m_pendingMessages.empty() && m_pendingMessages.back().level == level && m_pendingMessages.back().message == message) {
+                ++m_pendingMessages.back().repeatCount;
+            } else if (++m_repetitions[message] > MaxRepetitionsPerInterval) {
+                ++m_suppressedCount;
+                return;
+            } else {
+                m_pendingMessages.push_back({ level, message, 1u });
+            }
+
+            if (!m_flushTimer->isActive()) {
+                m_flushTimer->start();
+            }
+        }
+
+        void Console::flushPendingMessages() {
+            if (m_pendingMessages.empty()) {
+                return;
             }
-            format.setFont(Fonts::fixedWidthFont());
 
             QTextCursor cursor(m_textView->document());
             cursor.movePosition(QTextCursor::MoveOperation::End);
-            cursor.insertText(message, format);
-            cursor.insertText("\n");
+            cursor.beginEditBlock();
+
+            for (const PendingMessage& pendingMessage : m_pendingMessages) {
+                // NOTE: QPalette::Text is the correct color role for contrast against QPalette::Base
+                // which is the background of text entry widgets
+                QTextCharFormat format;
+                switch (pendingMessage.level) {
+                    case LogLevel::Debug:
+                        format.setForeground(QBrush(m_textView->palette().color(QPalette::Disabled, QPalette::Text)));
+                        break;
+                    case LogLevel::Info:
+                        break;
+                    case LogLevel::Warn:
+                        format.setForeground(QBrush(m_textView->palette().color(QPalette::Active, QPalette::Text)));
+                        break;
+                    case LogLevel::Error:
+                        format.setForeground(QBrush(QColor(250, 30, 60)));
+                        break;
+                }
+                format.setFont(Fonts::fixedWidthFont());
+
+                cursor.insertText(pendingMessage.message, format);
+                if (pendingMessage.repeatCount > 1u) {
+                    cursor.insertText(QString(" (repeated %1 times)").arg(pendingMessage.repeatCount), format);
+                }
+                cursor.insertText("\n");
+            }
+
+            cursor.endEditBlock();
+            m_pendingMessages.clear();
 
             m_textView->moveCursor(QTextCursor::MoveOperation::End);
         }
+
+        void Console::endRateLimitInterval() {
+            if (m_suppressedCount > 0u) {
+                m_pendingMessages.push_back({ LogLevel::Warn, QString("Suppressed %1 repeated messages, see the log file for all messages").arg(m_suppressedCount), 1u });
+                m_suppressedCount = 0u;
+                flushPendingMessages();
+            }
+            m_repetitions.clear();
+        }
     }
 }
@@ -23,16 +23,45 @@
 #include "View/TabBook.h"
 
 #include <string>
+#include <vector>
+
+#include <QHash>
+#include <QString>
 
 class QTextEdit;
-class QString;
+class QTimer;
 class QWidget;
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * Displays log messages in a text view.
+         *
+         * Messages are not added to the text view immediately. Instead, they are collected and added in a single
+         * batch when control returns to the event loop, so that logging many messages in a row does not update the
+         * text view every time. Consecutive repetitions of the same message are collapsed into a single line.
+         *
+         * Furthermore, the number of times the same message is shown is limited per rate limit interval. Any further
+         * repetitions within that interval are suppressed, and their number is reported once the interval ends. The
+         * log file still receives all messages.
+         */
         class Console : public TabBookPage, public Logger {
         private:
+            struct PendingMessage {
+                LogLevel level;
+                QString message;
+                size_t repeatCount;
+            };
+
+            static constexpr int RateLimitInterval = 1000; // in milliseconds
+            static constexpr size_t MaxRepetitionsPerInterval = 10u;
+
             QTextEdit* m_textView;
+            QTimer* m_flushTimer;
+            QTimer* m_rateLimitTimer;
+            std::vector<PendingMessage> m_pendingMessages;
+            QHash<QString, size_t> m_repetitions;
+            size_t m_suppressedCount;
         public:
             explicit Console(QWidget* parent = nullptr);
         private:
@@ -40,6 +69,8 @@ namespace TrenchBroom {
             void doLog(LogLevel level, const QString& message) override;
             void logToDebugOut(LogLevel level, const QString& message);
             void logToConsole(LogLevel level, const QString& message);
+            void flushPendingMessages();
+            void endRateLimitInterval();
         };
     }
 }
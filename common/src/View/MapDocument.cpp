@@ -36,6 +36,7 @@
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/GameConfigParser.h"
+#include "IO/MapCache.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
 #include "Model/Brush.h"
@@ -44,6 +45,7 @@
 #include "Model/BrushNode.h"
 #include "Model/BrushBuilder.h"
 #include "Model/BrushGeometry.h"
+#include "Model/BrushHullCache.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/EditorContext.h"
 #include "Model/EmptyBrushEntityIssueGenerator.h"
@@ -103,6 +105,7 @@
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/result.h>
 #include <kdl/result_for_each.h>
@@ -115,9 +118,12 @@
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdlib> // for std::abs
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -174,6 +180,48 @@ namespace TrenchBroom {
             return findLinkedGroupsToUpdate(worldNode, nodes, true);
         }
 
+        /**
+         * Processing brushes in parallel only pays off if there are enough of them.
+         */
+        static constexpr size_t MinParallelBrushes = 256u;
+
+        template <typename L>
+        static void forEachBrushIndex(const size_t brushCount, L&& lambda) {
+            if (brushCount < MinParallelBrushes) {
+                for (size_t i = 0u; i < brushCount; ++i) {
+                    lambda(i);
+                }
+            } else {
+                kdl::parallel_for(brushCount, lambda);
+            }
+        }
+
+        /**
+         * Like forEachBrushIndex, but the given lambda returns false to indicate a failure. Once the lambda has failed, it is
+         * not called for any index that has not been started yet.
+         *
+         * Returns true if the lambda succeeded for every index and false otherwise.
+         */
+        template <typename L>
+        static bool forEachBrushIndexUntilFailure(const size_t brushCount, L&& lambda) {
+            auto failed = std::atomic<bool>{false};
+            forEachBrushIndex(brushCount, [&](const size_t i) {
+                if (!failed.load(std::memory_order_relaxed) && !lambda(i)) {
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            });
+            return !failed.load();
+        }
+
+        /**
+         * Whether applyToNodeContents may apply its lambda to brushes on worker threads. Only lambdas which do not modify
+         * shared state, log, or read preferences may be applied in parallel.
+         */
+        enum class ApplyPolicy {
+            Sequential,
+            Parallel
+        };
+
         /**
          * Applies the given lambda to a copy of the contents of each of the given nodes and returns a vector of pairs of the original node and the modified contents.
          *
@@ -183,30 +231,60 @@ namespace TrenchBroom {
          *
          * The given node contents should be modified in place and the lambda should return true if it was applied successfully and false otherwise.
          *
+         * If the given policy is ApplyPolicy::Parallel, brushes are copied and modified on worker threads. The result is ordered
+         * like the given nodes regardless of the policy.
+         *
          * Returns a vector of pairs which map each node to its modified contents if the lambda succeeded for every given node, or an empty optional otherwise.
-         */        
+         */
         template <typename N, typename L>
-        static std::optional<std::vector<std::pair<Model::Node*, Model::NodeContents>>> applyToNodeContents(const std::vector<N*>& nodes, L lambda) {
+        static std::optional<std::vector<std::pair<Model::Node*, Model::NodeContents>>> applyToNodeContents(const std::vector<N*>& nodes, L lambda, const ApplyPolicy policy = ApplyPolicy::Sequential) {
             using NodeContentType = std::variant<Model::Layer, Model::Group, Model::Entity, Model::Brush>;
 
-            auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
-            newNodes.reserve(nodes.size());
+            auto nodeContents = std::vector<std::optional<NodeContentType>>(nodes.size());
+            auto deferredBrushes = std::vector<std::pair<size_t, const Model::BrushNode*>>{};
 
-            bool success = true;
-            std::transform(std::begin(nodes), std::end(nodes), std::back_inserter(newNodes), [&](auto* node) {
-                NodeContentType nodeContents = node->accept(kdl::overload(
-                    [](const Model::WorldNode* worldNode)   -> NodeContentType { return worldNode->entity(); },
-                    [](const Model::LayerNode* layerNode)   -> NodeContentType { return layerNode->layer(); },
-                    [](const Model::GroupNode* groupNode)   -> NodeContentType { return groupNode->group(); },
-                    [](const Model::EntityNode* entityNode) -> NodeContentType { return entityNode->entity(); },
-                    [](const Model::BrushNode* brushNode)   -> NodeContentType { return brushNode->brush(); }
+            const auto apply = [&](const size_t i, NodeContentType contents) {
+                nodeContents[i] = std::move(contents);
+                return std::visit(lambda, *nodeContents[i]);
+            };
+
+            // entities are always copied on this thread because changing entity definition usage counts notifies observers
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                const bool success = nodes[i]->accept(kdl::overload(
+                    [&](const Model::WorldNode* worldNode)   { return apply(i, worldNode->entity()); },
+                    [&](const Model::LayerNode* layerNode)   { return apply(i, layerNode->layer()); },
+                    [&](const Model::GroupNode* groupNode)   { return apply(i, groupNode->group()); },
+                    [&](const Model::EntityNode* entityNode) { return apply(i, entityNode->entity()); },
+                    [&](const Model::BrushNode* brushNode)   {
+                        if (policy == ApplyPolicy::Parallel) {
+                            deferredBrushes.emplace_back(i, brushNode);
+                            return true;
+                        }
+                        return apply(i, brushNode->brush());
+                    }
                 ));
 
-                success = success && std::visit(lambda, nodeContents);
-                return std::make_pair(node, Model::NodeContents(std::move(nodeContents)));
+                if (!success) {
+                    return std::nullopt;
+                }
+            }
+
+            const bool success = forEachBrushIndexUntilFailure(deferredBrushes.size(), [&](const size_t i) {
+                const auto& [nodeIndex, brushNode] = deferredBrushes[i];
+                return apply(nodeIndex, brushNode->brush());
             });
 
-            return success ? std::make_optional(newNodes) : std::nullopt;
+            if (!success) {
+                return std::nullopt;
+            }
+
+            auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+            newNodes.reserve(nodes.size());
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                newNodes.emplace_back(nodes[i], Model::NodeContents(std::move(*nodeContents[i])));
+            }
+
+            return newNodes;
         }
 
         /**
@@ -224,12 +302,12 @@ namespace TrenchBroom {
          * node contents will be swapped, and the original nodes remain unmodified.
          */
         template <typename N, typename L>
-        static bool applyAndSwap(MapDocument& document, const std::string& commandName, const std::vector<N*>& nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate, L lambda) {
+        static bool applyAndSwap(MapDocument& document, const std::string& commandName, const std::vector<N*>& nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate, L lambda, const ApplyPolicy policy = ApplyPolicy::Sequential) {
             if (nodes.empty()) {
                 return true;
             }
 
-            if (auto newNodes = applyToNodeContents(nodes, std::move(lambda))) {
+            if (auto newNodes = applyToNodeContents(nodes, std::move(lambda), policy)) {
                 return document.swapNodeContents(commandName, std::move(*newNodes), std::move(linkedGroupsToUpdate));
             }
 
@@ -240,7 +318,8 @@ namespace TrenchBroom {
          * Applies the given lambda to a copy of each of the given faces.
          *
          * Specifically, each brush node of the given faces has its contents copied and the lambda applied to the copied faces. If the lambda succeeds for each
-         * face, the node contents are subsequently swapped.
+         * face, the node contents are subsequently swapped. Brushes are copied and modified on worker threads, so the lambda must be safe to call
+         * concurrently for faces of different brushes.
          *
          * The lambda L needs to accept brush faces:
          * - bool operator()(Model::BrushFace&);
@@ -258,29 +337,37 @@ namespace TrenchBroom {
                 return true;
             }
 
-            auto brushes = std::unordered_map<Model::BrushNode*, Model::Brush>{};
-
-            bool success = true;
-            std::for_each(std::begin(faces), std::end(faces), [&](const auto& faceHandle) {
+            // group the faces by their brushes in the order in which the brushes first occur
+            auto brushNodes = std::vector<Model::BrushNode*>{};
+            auto faceIndices = std::vector<std::vector<size_t>>{};
+            auto brushIndices = std::unordered_map<Model::BrushNode*, size_t>{};
+            for (const auto& faceHandle : faces) {
                 auto* brushNode = faceHandle.node();
-                auto it = brushes.find(brushNode);
-                if (it == std::end(brushes)) {
-                    it = brushes.emplace(brushNode, brushNode->brush()).first;
+                const auto [it, inserted] = brushIndices.emplace(brushNode, brushNodes.size());
+                if (inserted) {
+                    brushNodes.push_back(brushNode);
+                    faceIndices.emplace_back();
                 }
+                faceIndices[it->second].push_back(faceHandle.faceIndex());
+            }
 
-                auto& brush = it->second;
-                success = success && lambda(brush.face(faceHandle.faceIndex()));
+            auto brushes = std::vector<std::optional<Model::Brush>>(brushNodes.size());
+            const bool success = forEachBrushIndexUntilFailure(brushNodes.size(), [&](const size_t i) {
+                auto& brush = brushes[i].emplace(brushNodes[i]->brush());
+                return std::all_of(std::begin(faceIndices[i]), std::end(faceIndices[i]), [&](const size_t faceIndex) {
+                    return lambda(brush.face(faceIndex));
+                });
             });
 
             if (success) {
                 auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
-                newNodes.reserve(brushes.size());
+                newNodes.reserve(brushNodes.size());
 
-                for (auto& [brushNode, brush] : brushes) {
-                    newNodes.emplace_back(brushNode, Model::NodeContents(std::move(brush)));
+                for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                    newNodes.emplace_back(brushNodes[i], Model::NodeContents(std::move(*brushes[i])));
                 }
 
-                auto linkedGroupsToUpdate = findContainingLinkedGroupsToUpdate(*document.world(), kdl::vec_transform(newNodes, [](const auto& p) { return p.first; }));
+                auto linkedGroupsToUpdate = findContainingLinkedGroupsToUpdate(*document.world(), brushNodes);
                 document.swapNodeContents(commandName, std::move(newNodes), std::move(linkedGroupsToUpdate));
             }
 
@@ -290,6 +377,11 @@ namespace TrenchBroom {
         const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
         const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
+        static size_t textureMemoryBudget() {
+            // the preference is given in megabytes
+            return static_cast<size_t>(std::max(0, pref(Preferences::TextureMemoryBudget))) * 1024u * 1024u;
+        }
+
         MapDocument::MapDocument() :
         m_worldBounds(DefaultWorldBounds),
         m_world(nullptr),
@@ -314,7 +406,10 @@ namespace TrenchBroom {
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr),
-        m_repeatStack(std::make_unique<RepeatStack>()) {
+        m_repeatStack(std::make_unique<RepeatStack>()),
+        m_brushHullCache(std::make_unique<Model::BrushHullCache>()),
+        m_transactionDepth(0u) {
+            m_textureManager->setTextureMemoryBudget(textureMemoryBudget());
             bindObservers();
         }
 
@@ -519,6 +614,16 @@ namespace TrenchBroom {
 
         void MapDocument::doSaveDocument(const IO::Path& path) {
             saveDocumentTo(path);
+
+            // backups and crash saves also go through saveDocumentTo, but only files saved by the user get a cache
+            if (pref(Preferences::WriteMapCache)) {
+                try {
+                    IO::MapCache::write(*m_world, m_worldBounds, path);
+                } catch (const Exception& e) {
+                    warn() << "Could not write map cache: " << e.what();
+                }
+            }
+
             setLastSaveModificationCount();
             setPath(path);
             documentWasSavedNotifier(this);
@@ -556,6 +661,39 @@ namespace TrenchBroom {
             return stream.str();
         }
 
+        static void unsetAssets(Model::Node& node);
+
+        std::unique_ptr<Model::WorldNode> MapDocument::copySelectedNodes() const {
+            auto world = std::make_unique<Model::WorldNode>(m_world->entity(), m_world->mapFormat());
+            auto* layer = world->defaultLayer();
+
+            auto entityCopies = std::map<const Model::EntityNode*, Model::Node*>{};
+            for (const auto* node : m_selectedNodes.nodes()) {
+                node->accept(kdl::overload(
+                    [] (const Model::WorldNode*) {},
+                    [] (const Model::LayerNode*) {},
+                    [&](const Model::GroupNode* groupNode)   { layer->addChild(groupNode->cloneRecursively(m_worldBounds)); },
+                    [&](const Model::EntityNode* entityNode) { layer->addChild(entityNode->cloneRecursively(m_worldBounds)); },
+                    [&](const Model::BrushNode* brushNode) {
+                        if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(brushNode->parent())) {
+                            auto*& entityCopy = entityCopies[entityNode];
+                            if (entityCopy == nullptr) {
+                                entityCopy = entityNode->clone(m_worldBounds);
+                                layer->addChild(entityCopy);
+                            }
+                            entityCopy->addChild(brushNode->clone(m_worldBounds));
+                        } else {
+                            layer->addChild(brushNode->clone(m_worldBounds));
+                        }
+                    }
+                ));
+            }
+
+            // the copy can outlive this document and its assets, they are resolved again when the copy is pasted
+            unsetAssets(*world);
+            return world;
+        }
+
         PasteType MapDocument::paste(const std::string& str) {
             // Try parsing as entities, then as brushes, in all compatible formats
             const std::vector<Model::Node*> nodes = m_game->parseNodes(str, m_world->mapFormat(), m_worldBounds, logger());
@@ -578,6 +716,17 @@ namespace TrenchBroom {
             return PasteType::Failed;
         }
 
+        PasteType MapDocument::paste(const Model::WorldNode& copiedNodes) {
+            assert(copiedNodes.mapFormat() == m_world->mapFormat());
+
+            // Cloning keeps the brush geometry, so nothing needs to be parsed or rebuilt here
+            const std::vector<Model::Node*> nodes = Model::Node::cloneRecursively(m_worldBounds, copiedNodes.defaultLayer()->children());
+            if (!nodes.empty() && pasteNodes(nodes)) {
+                return PasteType::Node;
+            }
+            return PasteType::Failed;
+        }
+
         std::vector<Model::IdType> allPersistentGroupIds(const Model::Node& root) {
             auto result = std::vector<Model::IdType>{};
             root.accept(kdl::overload(
@@ -1964,45 +2113,69 @@ namespace TrenchBroom {
                 ));
             }
 
-            auto nodesToUpdate = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
-            nodesToUpdate.reserve(nodesToTransform.size());
-            for (auto* node : nodesToTransform) {
-                bool success = true;
+            const bool textureLock = pref(Preferences::TextureLock);
 
-                node->accept(kdl::overload(
+            auto nodesToUpdate = std::vector<std::optional<std::pair<Model::Node*, Model::NodeContents>>>(nodesToTransform.size());
+            auto brushesToTransform = std::vector<std::pair<size_t, Model::BrushNode*>>{};
+            for (size_t i = 0u; i < nodesToTransform.size(); ++i) {
+                nodesToTransform[i]->accept(kdl::overload(
                     [&](Model::WorldNode*) {},
                     [&](Model::LayerNode*) {},
                     [&](Model::GroupNode* groupNode) {
                         auto group = groupNode->group();
                         group.transform(transformation);
-                        nodesToUpdate.emplace_back(groupNode, group);
+                        nodesToUpdate[i].emplace(groupNode, group);
                     },
                     [&](Model::EntityNode* entityNode) {
                         auto entity = entityNode->entity();
                         entity.transform(transformation);
-                        nodesToUpdate.emplace_back(entityNode, entity);
+                        nodesToUpdate[i].emplace(entityNode, entity);
                     },
                     [&](Model::BrushNode* brushNode) {
-                        const bool lockTextures = pref(Preferences::TextureLock)
-                            || (Model::findContainingLinkedGroup(*brushNode) != nullptr);
-
-                        auto brush = brushNode->brush();
-                        brush.transform(m_worldBounds, transformation, lockTextures)
-                            .and_then([&](){
-                                nodesToUpdate.emplace_back(brushNode, brush);
-                            }).handle_errors([&](const Model::BrushError e) {
-                                error() << "Could not transform brush: " << e;
-                                success = false;
-                            });
-                     }
+                        brushesToTransform.emplace_back(i, brushNode);
+                    }
                 ));
+            }
 
-                if (!success) {
-                    return false;
+            // brush geometry is rebuilt on worker threads, so errors are collected and logged afterwards
+            auto brushErrors = std::vector<std::optional<Model::BrushError>>(brushesToTransform.size());
+            const bool brushesTransformed = forEachBrushIndexUntilFailure(brushesToTransform.size(), [&](const size_t i) {
+                const auto nodeIndex = brushesToTransform[i].first;
+                auto* brushNode = brushesToTransform[i].second;
+                const bool lockTextures = textureLock || (Model::findContainingLinkedGroup(*brushNode) != nullptr);
+
+                auto brush = brushNode->brush();
+                return brush.transform(m_worldBounds, transformation, lockTextures)
+                    .visit(kdl::overload(
+                        [&]() {
+                            nodesToUpdate[nodeIndex].emplace(brushNode, std::move(brush));
+                            return true;
+                        },
+                        [&](const Model::BrushError e) {
+                            brushErrors[i] = e;
+                            return false;
+                        }
+                    ));
+            });
+
+            if (!brushesTransformed) {
+                for (const auto& e : brushErrors) {
+                    if (e) {
+                        error() << "Could not transform brush: " << *e;
+                    }
                 }
+                return false;
             }
 
-            const auto success = swapNodeContents(commandName, nodesToUpdate, findContainingLinkedGroupsToUpdate(*m_world, m_selectedNodes.nodes()));
+            auto updatedNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+            updatedNodes.reserve(nodesToUpdate.size());
+            for (auto& nodeToUpdate : nodesToUpdate) {
+                if (nodeToUpdate) {
+                    updatedNodes.push_back(std::move(*nodeToUpdate));
+                }
+            }
+
+            const auto success = swapNodeContents(commandName, std::move(updatedNodes), findContainingLinkedGroupsToUpdate(*m_world, m_selectedNodes.nodes()));
 
             if (success) {
                 m_repeatStack->push([=]() { this->transformObjects(commandName, transformation); });
@@ -2439,7 +2612,13 @@ namespace TrenchBroom {
 
         bool MapDocument::resizeBrushes(const std::vector<vm::polygon3>& faces, const vm::vec3& delta) {
             const auto nodes = m_selectedNodes.nodes();
-            return applyAndSwap(*this, "Resize Brushes", nodes, findContainingLinkedGroupsToUpdate(*m_world, nodes), kdl::overload(
+            const bool textureLock = pref(Preferences::TextureLock);
+
+            // the brushes are resized on worker threads, so errors are collected and logged afterwards
+            auto brushErrorsMutex = std::mutex{};
+            auto brushErrors = std::vector<Model::BrushError>{};
+
+            const bool success = applyAndSwap(*this, "Resize Brushes", nodes, findContainingLinkedGroupsToUpdate(*m_world, nodes), kdl::overload(
                 [] (Model::Layer&)       { return true; },
                 [] (Model::Group&)       { return true; },
                 [] (Model::Entity&)      { return true; },
@@ -2450,18 +2629,25 @@ namespace TrenchBroom {
                         return true;
                     }
 
-                    return brush.moveBoundary(m_worldBounds, *faceIndex, delta, pref(Preferences::TextureLock))
+                    return brush.moveBoundary(m_worldBounds, *faceIndex, delta, textureLock)
                         .visit(kdl::overload(
                             [&]() {
                                 return m_worldBounds.contains(brush.bounds());
                             },
                             [&](const Model::BrushError e) {
-                                error() << "Could not resize brush: " << e;
+                                const auto lock = std::lock_guard<std::mutex>{brushErrorsMutex};
+                                brushErrors.push_back(e);
                                 return false;
                             }
                         ));
                 }
-            ));
+            ), ApplyPolicy::Parallel);
+
+            for (const auto e : brushErrors) {
+                error() << "Could not resize brush: " << e;
+            }
+
+            return success;
         }
 
         bool MapDocument::setFaceAttributes(const Model::BrushFaceAttributes& attributes) {
@@ -2555,7 +2741,13 @@ namespace TrenchBroom {
         }
 
         MapDocument::MoveVerticesResult MapDocument::moveVertices(std::vector<vm::vec3> vertexPositions, const vm::vec3& delta) {
+            const bool uvLock = pref(Preferences::UVLock);
+
+            // the brushes are validated and modified on worker threads
+            auto mutex = std::mutex{};
             auto newVertexPositions = std::vector<vm::vec3>{};
+            auto brushErrors = std::vector<Model::BrushError>{};
+
             auto newNodes = applyToNodeContents(m_selectedNodes.nodes(), kdl::overload(
                 [] (Model::Layer&) { return true; },
                 [] (Model::Group&) { return true; },
@@ -2566,19 +2758,26 @@ namespace TrenchBroom {
                         return true;
                     }
 
-                    if (!brush.canMoveVertices(m_worldBounds, verticesToMove, delta)) {
+                    if (!brush.canMoveVertices(m_worldBounds, verticesToMove, delta, m_brushHullCache.get())) {
                         return false;
                     }
 
-                    return brush.moveVertices(m_worldBounds, verticesToMove, delta, pref(Preferences::UVLock))
+                    return brush.moveVertices(m_worldBounds, verticesToMove, delta, uvLock, m_brushHullCache.get())
                         .and_then([&]() {
                             auto newPositions = brush.findClosestVertexPositions(verticesToMove + delta);
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
                             newVertexPositions = kdl::vec_concat(std::move(newVertexPositions), std::move(newPositions));
                         }).handle_errors([&](const Model::BrushError e) {
-                            error() << "Could not move brush vertices: " << e;
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
+                            brushErrors.push_back(e);
                         });
                }
-            ));
+            ), ApplyPolicy::Parallel);
+            releaseBrushHullCache();
+
+            for (const auto e : brushErrors) {
+                error() << "Could not move brush vertices: " << e;
+            }
 
             if (newNodes) {
                 kdl::vec_sort_and_remove_duplicates(newVertexPositions);
@@ -2597,7 +2796,13 @@ namespace TrenchBroom {
         }
 
         bool MapDocument::moveEdges(std::vector<vm::segment3> edgePositions, const vm::vec3& delta) {
+            const bool uvLock = pref(Preferences::UVLock);
+
+            // the brushes are validated and modified on worker threads
+            auto mutex = std::mutex{};
             auto newEdgePositions = std::vector<vm::segment3>{};
+            auto brushErrors = std::vector<Model::BrushError>{};
+
             auto newNodes = applyToNodeContents(m_selectedNodes.nodes(), kdl::overload(
                 [] (Model::Layer&) { return true; },
                 [] (Model::Group&) { return true; },
@@ -2608,21 +2813,28 @@ namespace TrenchBroom {
                         return true;
                     }
 
-                    if (!brush.canMoveEdges(m_worldBounds, edgesToMove, delta)) {
+                    if (!brush.canMoveEdges(m_worldBounds, edgesToMove, delta, m_brushHullCache.get())) {
                         return false;
                     }
 
-                    return brush.moveEdges(m_worldBounds, edgesToMove, delta, pref(Preferences::UVLock))
+                    return brush.moveEdges(m_worldBounds, edgesToMove, delta, uvLock, m_brushHullCache.get())
                         .and_then([&]() {
                             auto newPositions = brush.findClosestEdgePositions(kdl::vec_transform(edgesToMove, [&](const auto& edge) {
                                 return edge.translate(delta);
                             }));
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
                             newEdgePositions = kdl::vec_concat(std::move(newEdgePositions), std::move(newPositions));
                         }).handle_errors([&](const Model::BrushError e) {
-                            error() << "Could not move brush edges: " << e;
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
+                            brushErrors.push_back(e);
                         });
                 }
-            ));
+            ), ApplyPolicy::Parallel);
+            releaseBrushHullCache();
+
+            for (const auto e : brushErrors) {
+                error() << "Could not move brush edges: " << e;
+            }
 
             if (newNodes) {
                 kdl::vec_sort_and_remove_duplicates(newEdgePositions);
@@ -2636,7 +2848,13 @@ namespace TrenchBroom {
         }
 
         bool MapDocument::moveFaces(std::vector<vm::polygon3> facePositions, const vm::vec3& delta) {
+            const bool uvLock = pref(Preferences::UVLock);
+
+            // the brushes are validated and modified on worker threads
+            auto mutex = std::mutex{};
             auto newFacePositions = std::vector<vm::polygon3>{};
+            auto brushErrors = std::vector<Model::BrushError>{};
+
             auto newNodes = applyToNodeContents(m_selectedNodes.nodes(), kdl::overload(
                 [] (Model::Layer&) { return true; },
                 [] (Model::Group&) { return true; },
@@ -2647,21 +2865,28 @@ namespace TrenchBroom {
                         return true;
                     }
 
-                    if (!brush.canMoveFaces(m_worldBounds, facesToMove, delta)) {
+                    if (!brush.canMoveFaces(m_worldBounds, facesToMove, delta, m_brushHullCache.get())) {
                         return false;
                     }
 
-                    return brush.moveFaces(m_worldBounds, facesToMove, delta, pref(Preferences::UVLock))
+                    return brush.moveFaces(m_worldBounds, facesToMove, delta, uvLock, m_brushHullCache.get())
                         .and_then([&]() {
                             auto newPositions = brush.findClosestFacePositions(kdl::vec_transform(facesToMove, [&](const auto& face) {
                                 return face.translate(delta);
                             }));
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
                             newFacePositions = kdl::vec_concat(std::move(newFacePositions), std::move(newPositions));
                         }).handle_errors([&](const Model::BrushError e) {
-                            error() << "Could not move brush faces: " << e;
+                            const auto lock = std::lock_guard<std::mutex>{mutex};
+                            brushErrors.push_back(e);
                         });
                 }
-            ));
+            ), ApplyPolicy::Parallel);
+            releaseBrushHullCache();
+
+            for (const auto e : brushErrors) {
+                error() << "Could not move brush faces: " << e;
+            }
 
             if (newNodes) {
                 kdl::vec_sort_and_remove_duplicates(newFacePositions);
@@ -2820,6 +3045,7 @@ namespace TrenchBroom {
         void MapDocument::startTransaction(const std::string& name) {
             debug("Starting transaction '" + name + "'");
             doStartTransaction(name);
+            ++m_transactionDepth;
         }
 
         void MapDocument::rollbackTransaction() {
@@ -2830,12 +3056,28 @@ namespace TrenchBroom {
         void MapDocument::commitTransaction() {
             debug("Committing transaction");
             doCommitTransaction();
+            endTransaction();
         }
 
         void MapDocument::cancelTransaction() {
             debug("Cancelling transaction");
             doRollbackTransaction();
             doCommitTransaction();
+            endTransaction();
+        }
+
+        void MapDocument::endTransaction() {
+            assert(m_transactionDepth > 0u);
+            if (--m_transactionDepth == 0u) {
+                // the hulls are only shared between the steps of a drag
+                m_brushHullCache->clear();
+            }
+        }
+
+        void MapDocument::releaseBrushHullCache() {
+            if (m_transactionDepth == 0u) {
+                m_brushHullCache->clear();
+            }
         }
 
         std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command) {
@@ -2846,8 +3088,8 @@ namespace TrenchBroom {
             return doExecuteAndStore(std::move(command));
         }
 
-        void MapDocument::commitPendingAssets() {
-            m_textureManager->commitChanges();
+        void MapDocument::commitPendingAssets(const void* view) {
+            m_textureManager->commitChanges(view);
         }
 
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
@@ -3014,21 +3256,48 @@ namespace TrenchBroom {
             m_textureManager->clear();
         }
 
-        static auto makeSetTexturesVisitor(Assets::TextureManager& manager) {
-            return kdl::overload(
+        static std::vector<Model::BrushNode*> collectBrushNodes(const std::vector<Model::Node*>& nodes) {
+            auto result = std::vector<Model::BrushNode*>();
+            Model::Node::visitAll(nodes, kdl::overload(
                 [] (auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
-                [&](Model::BrushNode* brushNode) { 
-                    const Model::Brush& brush = brushNode->brush();
-                    for (size_t i = 0u; i < brush.faceCount(); ++i) {
-                        const Model::BrushFace& face = brush.face(i);
-                        Assets::Texture* texture = manager.texture(face.attributes().textureName());
-                        brushNode->setFaceTexture(i, texture);
-                    }
+                [&](Model::BrushNode* brushNode) { result.push_back(brushNode); }
+            ));
+            return result;
+        }
+
+        /**
+         * Resolves the textures of the faces of the given brushes in parallel, and then sets them sequentially.
+         *
+         * Looking up the textures by name only reads from the texture manager, but setting a face texture updates the
+         * usage count of the texture, which is shared by many faces.
+         */
+        static void setFaceTextures(const std::vector<Model::BrushNode*>& brushNodes, Assets::TextureManager& manager) {
+            auto offsets = std::vector<size_t>();
+            offsets.reserve(brushNodes.size());
+
+            size_t faceCount = 0u;
+            for (const auto* brushNode : brushNodes) {
+                offsets.push_back(faceCount);
+                faceCount += brushNode->brush().faceCount();
+            }
+
+            auto textures = std::vector<Assets::Texture*>(faceCount, nullptr);
+            forEachBrushIndex(brushNodes.size(), [&](const size_t i) {
+                const Model::Brush& brush = brushNodes[i]->brush();
+                for (size_t j = 0u; j < brush.faceCount(); ++j) {
+                    textures[offsets[i] + j] = manager.texture(brush.face(j).attributes().textureName());
                 }
-            );
+            });
+
+            for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                auto* brushNode = brushNodes[i];
+                for (size_t j = 0u; j < brushNode->brush().faceCount(); ++j) {
+                    brushNode->setFaceTexture(j, textures[offsets[i] + j]);
+                }
+            }
         }
 
         static auto makeUnsetTexturesVisitor() {
@@ -3047,12 +3316,20 @@ namespace TrenchBroom {
         }
 
         void MapDocument::setTextures() {
-            m_world->accept(makeSetTexturesVisitor(*m_textureManager));
+            const auto startTime = std::chrono::high_resolution_clock::now();
+
+            const auto brushNodes = collectBrushNodes({m_world.get()});
+            setFaceTextures(brushNodes, *m_textureManager);
+
+            const auto endTime = std::chrono::high_resolution_clock::now();
+            debug() << "Set textures of " << brushNodes.size() << " brushes in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() << "ms";
+
             textureUsageCountsDidChangeNotifier();
         }
 
         void MapDocument::setTextures(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeSetTexturesVisitor(*m_textureManager));
+            setFaceTextures(collectBrushNodes(nodes), *m_textureManager);
             textureUsageCountsDidChangeNotifier();
         }
 
@@ -3173,6 +3450,16 @@ namespace TrenchBroom {
             Model::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
         }
 
+        /**
+         * Removes all references to textures, entity definitions and entity models from the given node and its
+         * descendants.
+         */
+        static void unsetAssets(Model::Node& node) {
+            node.accept(makeUnsetEntityModelsVisitor());
+            node.accept(makeUnsetEntityDefinitionsVisitor());
+            node.accept(makeUnsetTexturesVisitor());
+        }
+
         std::vector<IO::Path> MapDocument::externalSearchPaths() const {
             std::vector<IO::Path> searchPaths;
             if (!m_path.isEmpty() && m_path.isAbsolute()) {
@@ -3299,14 +3586,23 @@ namespace TrenchBroom {
             return m_tagManager->smartTag(index);
         }
 
-        static auto makeInitializeNodeTagsVisitor(Model::TagManager& tagManager) {
-            return kdl::overload(
+        /**
+         * Initializes the tags of the given nodes and their descendants. The tags of brushes and their faces only
+         * depend on the brushes themselves, so they are initialized in parallel after all other nodes.
+         */
+        static void initializeTags(const std::vector<Model::Node*>& nodes, Model::TagManager& tagManager) {
+            auto brushNodes = std::vector<Model::BrushNode*>();
+            Model::Node::visitAll(nodes, kdl::overload(
                 [&](auto&& thisLambda, Model::WorldNode* world) { world->initializeTags(tagManager); world->visitChildren(thisLambda); },
                 [&](auto&& thisLambda, Model::LayerNode* layer) { layer->initializeTags(tagManager); layer->visitChildren(thisLambda); },
                 [&](auto&& thisLambda, Model::GroupNode* group) { group->initializeTags(tagManager); group->visitChildren(thisLambda); },
                 [&](auto&& thisLambda, Model::EntityNode* entity) { entity->initializeTags(tagManager); entity->visitChildren(thisLambda); },
-                [&](Model::BrushNode* brush) { brush->initializeTags(tagManager); }
-            );
+                [&](Model::BrushNode* brush) { brushNodes.push_back(brush); }
+            ));
+
+            forEachBrushIndex(brushNodes.size(), [&](const size_t i) {
+                brushNodes[i]->initializeTags(tagManager);
+            });
         }
 
         static auto makeClearNodeTagsVisitor() {
@@ -3322,11 +3618,17 @@ namespace TrenchBroom {
         void MapDocument::initializeNodeTags(MapDocument* document) {
             assert(document == this);
             unused(document);
-            m_world->accept(makeInitializeNodeTagsVisitor(*m_tagManager));
+
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            initializeTags({m_world.get()}, *m_tagManager);
+            const auto endTime = std::chrono::high_resolution_clock::now();
+
+            debug() << "Initialized node tags in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() << "ms";
         }
 
         void MapDocument::initializeNodeTags(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeInitializeNodeTagsVisitor(*m_tagManager));
+            initializeTags(nodes, *m_tagManager);
         }
 
         void MapDocument::clearNodeTags(const std::vector<Model::Node*>& nodes) {
@@ -3498,6 +3800,8 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::TextureMemoryBudget.path()) {
+                m_textureManager->setTextureMemoryBudget(textureMemoryBudget());
             }
         }
 
@@ -56,6 +56,7 @@ namespace TrenchBroom {
         class BrushFace;
         class BrushFaceHandle;
         class BrushFaceAttributes;
+        class BrushHullCache;
         class EditorContext;
         class Entity;
         enum class ExportFormat;
@@ -133,6 +134,13 @@ namespace TrenchBroom {
              * was changed.
              */
             std::unique_ptr<RepeatStack> m_repeatStack;
+
+            /*
+             * Shares the convex hulls built by vertex, edge and face moves between the steps of a drag. The cache is
+             * cleared when the outermost transaction ends, or after a move that is not part of a transaction.
+             */
+            std::unique_ptr<Model::BrushHullCache> m_brushHullCache;
+            size_t m_transactionDepth;
         public: // notification
             Notifier<Command*> commandDoNotifier;
             Notifier<Command*> commandDoneNotifier;
@@ -271,7 +279,21 @@ namespace TrenchBroom {
             std::string serializeSelectedNodes();
             std::string serializeSelectedBrushFaces();
 
+            /**
+             * Returns a copy of the selected nodes that does not depend on this document. The copied nodes are the
+             * children of the returned world's default layer. Selected brushes that belong to an entity are copied
+             * into a copy of that entity which contains only the selected brushes, so that the copy has the same
+             * structure as the result of parsing serializeSelectedNodes().
+             */
+            std::unique_ptr<Model::WorldNode> copySelectedNodes() const;
+
             PasteType paste(const std::string& str);
+
+            /**
+             * Pastes clones of the nodes returned by a previous call to copySelectedNodes(). The given world is not
+             * modified and can be pasted again. The copy must have the same map format as this document.
+             */
+            PasteType paste(const Model::WorldNode& copiedNodes);
         private:
             bool pasteNodes(const std::vector<Model::Node*>& nodes);
             bool pasteBrushFaces(const std::vector<Model::BrushFace>& faces);
@@ -491,6 +513,9 @@ namespace TrenchBroom {
             void commitTransaction();
             void cancelTransaction();
         private:
+            void endTransaction();
+            void releaseBrushHullCache();
+
             std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
             std::unique_ptr<CommandResult> executeAndStore(std::unique_ptr<UndoableCommand>&& command);
         private: // subclassing interface for command processing
@@ -508,7 +533,10 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> doExecute(std::unique_ptr<Command>&& command) = 0;
             virtual std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) = 0;
         public: // asset state management
-            void commitPendingAssets();
+            /**
+             * Commits pending asset changes before the given view renders. The pointer only identifies the view.
+             */
+            void commitPendingAssets(const void* view);
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
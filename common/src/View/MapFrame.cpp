@@ -22,6 +22,7 @@
 #include "Console.h"
 #include "Exceptions.h"
 #include "FileLogger.h"
+#include "MemoryUsage.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "TrenchBroomApp.h"
@@ -60,6 +61,7 @@
 #include "View/LaunchGameEngineDialog.h"
 #include "View/MainMenuBuilder.h"
 #include "View/MapDocument.h"
+#include "View/NodeClipboardData.h"
 #include "View/PasteType.h"
 #include "View/RenderView.h"
 #include "View/ReplaceTextureDialog.h"
@@ -80,6 +82,7 @@
 #include <cassert>
 #include <chrono>
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -1072,14 +1075,12 @@ namespace TrenchBroom {
         void MapFrame::copyToClipboard() {
             QClipboard *clipboard = QApplication::clipboard();
 
-            std::string str;
             if (m_document->hasSelectedNodes()) {
-                str = m_document->serializeSelectedNodes();
+                // the text representation is only created if another application requests it
+                clipboard->setMimeData(new NodeClipboardData(m_document->game(), m_document->encoding(), m_document->copySelectedNodes()));
             } else if (m_document->hasSelectedBrushFaces()) {
-                str = m_document->serializeSelectedBrushFaces();
+                clipboard->setText(mapStringToUnicode(m_document->encoding(), m_document->serializeSelectedBrushFaces()));
             }
-
-            clipboard->setText(mapStringToUnicode(m_document->encoding(), str));
         }
 
         bool MapFrame::canCutSelection() const {
@@ -1117,6 +1118,13 @@ namespace TrenchBroom {
 
         PasteType MapFrame::paste() {
             auto *clipboard = QApplication::clipboard();
+
+            // nodes copied in this process can be cloned instead of parsing their text representation
+            const auto* nodeData = qobject_cast<const NodeClipboardData*>(clipboard->mimeData());
+            if (nodeData != nullptr && nodeData->copiedNodes().mapFormat() == m_document->world()->mapFormat()) {
+                return m_document->paste(nodeData->copiedNodes());
+            }
+
             const auto qtext = clipboard->text();
 
             if (qtext.isEmpty()) {
@@ -1775,6 +1783,12 @@ namespace TrenchBroom {
             showModelessDialog(window);
         }
 
+        void MapFrame::debugPrintMemoryUsage() {
+            std::stringstream str;
+            writeMemoryReport(str);
+            m_document->info() << "Memory usage:\n" << str.str();
+        }
+
         void MapFrame::focusChange(QWidget* /* oldFocus */, QWidget* newFocus) {
             auto newMapView = dynamic_cast<MapViewBase*>(newFocus);
             if (newMapView != nullptr) {
@@ -362,6 +362,7 @@ namespace TrenchBroom {
             void debugThrowExceptionDuringCommand();
             void debugSetWindowSize();
             void debugShowPalette();
+            void debugPrintMemoryUsage();
 
             void focusChange(QWidget* oldFocus, QWidget* newFocus);
 
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeClipboardData.h"
+
+#include "Model/Game.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+#include "View/MapTextEncoding.h"
+#include "View/QtUtils.h"
+
+#include <sstream>
+
+#include <QString>
+#include <QStringList>
+
+namespace TrenchBroom {
+    namespace View {
+        static const auto TextMimeType = QString("text/plain");
+
+        NodeClipboardData::NodeClipboardData(std::shared_ptr<Model::Game> game, const MapTextEncoding encoding, std::unique_ptr<Model::WorldNode> copiedNodes) :
+        m_game(std::move(game)),
+        m_encoding(encoding),
+        m_copiedNodes(std::move(copiedNodes)) {}
+
+        NodeClipboardData::~NodeClipboardData() = default;
+
+        const Model::WorldNode& NodeClipboardData::copiedNodes() const {
+            return *m_copiedNodes;
+        }
+
+        bool NodeClipboardData::hasFormat(const QString& mimeType) const {
+            return mimeType == TextMimeType;
+        }
+
+        QStringList NodeClipboardData::formats() const {
+            return { TextMimeType };
+        }
+
+        QVariant NodeClipboardData::retrieveData(const QString& mimeType, const QVariant::Type type) const {
+            if (mimeType != TextMimeType) {
+                return QMimeData::retrieveData(mimeType, type);
+            }
+
+            if (m_text.isNull()) {
+                std::stringstream stream;
+                m_game->writeNodesToStream(*m_copiedNodes, m_copiedNodes->defaultLayer()->children(), stream);
+                m_text = mapStringToUnicode(m_encoding, stream.str());
+            }
+            return m_text;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QMimeData>
+#include <QString>
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        class Game;
+        class WorldNode;
+    }
+
+    namespace View {
+        enum class MapTextEncoding;
+
+        /**
+         * Clipboard contents for nodes copied from a map document. The copied nodes are kept so that they can be
+         * cloned directly when they are pasted into a document of this process. Their text representation is only
+         * created when it is requested, i.e. when another application pastes them or when they cannot be pasted
+         * directly.
+         */
+        class NodeClipboardData : public QMimeData {
+            Q_OBJECT
+        private:
+            std::shared_ptr<Model::Game> m_game;
+            MapTextEncoding m_encoding;
+            std::unique_ptr<Model::WorldNode> m_copiedNodes;
+            mutable QString m_text;
+        public:
+            NodeClipboardData(std::shared_ptr<Model::Game> game, MapTextEncoding encoding, std::unique_ptr<Model::WorldNode> copiedNodes);
+            ~NodeClipboardData() override;
+
+            const Model::WorldNode& copiedNodes() const;
+
+            bool hasFormat(const QString& mimeType) const override;
+            QStringList formats() const override;
+        protected:
+            QVariant retrieveData(const QString& mimeType, QVariant::Type type) const override;
+        };
+    }
+}
@@ -107,7 +107,10 @@ namespace TrenchBroom {
                     std::to_string(maxFrameTime) + "ms. " +
                     std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs (" +
                     std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling " +
-                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB. Streamed " +
+                    std::to_string(m_glContext->vboManager().lastFrameStreamingStats().uploadedBytes / 1024u) + " KiB in last frame (" +
+                    std::to_string(m_glContext->vboManager().lastFrameStreamingStats().fallbacks) + " fallbacks, " +
+                    std::to_string(m_glContext->vboManager().lastFrameStreamingStats().stalls) + " stalls)";
 
 
             });
@@ -214,9 +217,12 @@ namespace TrenchBroom {
 
         void RenderView::render() {
             processInput();
+
+            vboManager().beginFrame();
             clearBackground();
             doRender();
             renderFocusIndicator();
+            vboManager().endFrame();
         }
 
         void RenderView::processInput() {
@@ -35,7 +35,7 @@ namespace TrenchBroom {
         SwapNodeContentsCommand::SwapNodeContentsCommand(const std::string& name, std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate) :
         UndoableCommand(Type, name, true),
         m_nodes(std::move(nodes)),
-        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)) {}
+        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate), kdl::vec_transform(m_nodes, [](const auto& pair) -> const Model::Node* { return pair.first; })) {}
 
         SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 
@@ -73,5 +73,11 @@ namespace TrenchBroom {
 
             return false;
         }
+
+        size_t SwapNodeContentsCommand::doGetMemoryUsage() const {
+            // the faces and geometry of the stored brushes are counted as brushes, so only the stored objects and the
+            // node list are counted here
+            return m_nodes.capacity() * sizeof(decltype(m_nodes)::value_type);
+        }
     }
 }
@@ -19,6 +19,7 @@
 
 #include "TextureBrowserView.h"
 
+#include "Logger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
@@ -44,6 +45,7 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -132,7 +134,11 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::usageCountDidChange() {
-            invalidate();
+            // Usage counts only affect the border colors of the cells unless they determine which textures are
+            // shown or in which order, so the layout can be kept.
+            if (m_hideUnused || m_sortOrder == TextureSortOrder::Usage) {
+                invalidate();
+            }
             update();
         }
 
@@ -149,57 +155,90 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::doReloadLayout(Layout& layout) {
+            const auto startTime = std::chrono::high_resolution_clock::now();
+
             const IO::Path& fontPath = pref(Preferences::RendererFontPath());
             int fontSize = pref(Preferences::BrowserFontSize);
             assert(fontSize > 0);
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
 
+            // Every title consists of two lines of text. Measuring the titles is deferred until the cells become
+            // visible, so that we don't have to measure the names of all textures here.
+            const auto lineHeight = fontManager().font(font).measure("").y();
+            const auto titleHeight = 2.0f * lineHeight + 4.0f;
+
+            updateTextureNames();
+
+            size_t count = 0u;
             if (m_group) {
                 for (const Assets::TextureCollection& collection : getCollections()) {
                     layout.addGroup(collection.name(), static_cast<float>(fontSize) + 2.0f);
-                    for (const Assets::Texture* texture : getTextures(collection))
-                        addTextureToLayout(layout, texture, collection.name(), font);
+                    for (const Assets::Texture* texture : getTextures(collection)) {
+                        addTextureToLayout(layout, texture, collection.name(), font, titleHeight);
+                        ++count;
+                    }
                 }
             } else {
-                for (const Assets::Texture* texture : getTextures())
-                    addTextureToLayout(layout, texture, "", font);
+                for (const Assets::Texture* texture : getTextures()) {
+                    addTextureToLayout(layout, texture, "", font, titleHeight);
+                    ++count;
+                }
             }
+
+            const auto endTime = std::chrono::high_resolution_clock::now();
+            auto doc = kdl::mem_lock(m_document);
+            doc->debug() << "Reloaded texture browser layout with " << count << " textures in "
+                         << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() << "ms";
         }
 
-        void TextureBrowserView::addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font) {
+        void TextureBrowserView::addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, const float titleHeight) {
             const float maxCellWidth = layout.maxCellWidth();
 
-            const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
-
-            const auto textureFont = fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-            const auto groupFont   = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
-
-            const auto defaultTextHeight = fontManager().font(font).measure(groupName + textureName).y();
-            const auto textureNameSize   = fontManager().font(textureFont).measure(textureName);
-            const auto groupNameSize     = fontManager().font(groupFont).measure(groupName);
-
-            const auto totalSize = vm::vec2f(vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
-
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
             const float scaledTextureWidth = vm::round(scaleFactor * static_cast<float>(texture->width()));
             const float scaledTextureHeight = vm::round(scaleFactor * static_cast<float>(texture->height()));
 
             auto cellData = std::shared_ptr<TextureCellData>(new TextureCellData{
                 texture,
-                textureName,
+                m_textureNames.displayName(texture),
                 groupName,
-                vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
-                vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
-                textureFont,
-                groupFont
+                false,
+                vm::vec2f::zero(),
+                vm::vec2f::zero(),
+                font,
+                font
             });
 
             layout.addItem(QVariant::fromValue(cellData),
             scaledTextureWidth,
             scaledTextureHeight,
             maxCellWidth,
-            totalSize.y());
+            titleHeight);
+        }
+
+        void TextureBrowserView::measureTitles(TextureCellData& cellData, const Renderer::FontDescriptor& font, const float maxCellWidth) {
+            const auto& textureName = cellData.mainTitle;
+            const auto& groupName = cellData.subTitle;
+
+            const auto textureFont = fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
+            const auto groupFont   = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
+
+            const auto defaultTextHeight = fontManager().font(font).measure(groupName + textureName).y();
+            const auto textureNameSize   = fontManager().font(textureFont).measure(textureName);
+            const auto groupNameSize     = fontManager().font(groupFont).measure(groupName);
+
+            cellData.mainTitleOffset = vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f);
+            cellData.subTitleOffset = vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f);
+            cellData.mainTitleFont = textureFont;
+            cellData.subTitleFont = groupFont;
+            cellData.titlesMeasured = true;
+        }
+
+        void TextureBrowserView::updateTextureNames() {
+            auto doc = kdl::mem_lock(m_document);
+            const auto& textureManager = doc->textureManager();
+            m_textureNames.update(textureManager.collections(), textureManager.generation());
         }
 
         struct TextureBrowserView::CompareByUsageCount {
@@ -232,16 +271,6 @@ namespace TrenchBroom {
             }
         };
 
-        struct TextureBrowserView::MatchName {
-            std::string pattern;
-
-            explicit MatchName(const std::string& i_pattern) : pattern(i_pattern) {}
-
-            bool operator()(const Assets::Texture* texture) const {
-                return !kdl::ci::str_contains(texture->name(), pattern);
-            }
-        };
-
         const std::vector<Assets::TextureCollection>& TextureBrowserView::getCollections() const {
             auto doc = kdl::mem_lock(m_document);
             return doc->textureManager().collections();
@@ -266,7 +295,7 @@ namespace TrenchBroom {
             if (m_hideUnused)
                 textures = kdl::vec_erase_if(std::move(textures), MatchUsageCount());
             if (!m_filterText.empty())
-                textures = kdl::vec_erase_if(std::move(textures), MatchName(m_filterText));
+                textures = m_textureNames.filter(std::move(textures), m_filterText);
         }
 
         void TextureBrowserView::sortTextures(std::vector<const Assets::Texture*>& textures) const {
@@ -284,7 +313,7 @@ namespace TrenchBroom {
 
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
-            doc->textureManager().commitChanges();
+            doc->commitPendingAssets(this);
 
             const float viewLeft      = static_cast<float>(0);
             const float viewTop       = static_cast<float>(size().height());
@@ -339,7 +368,7 @@ namespace TrenchBroom {
             Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::move(vertices));
             Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::TextureBrowserBorderShader);
 
-            vertexArray.prepare(vboManager());
+            vertexArray.prepare(vboManager(), Renderer::VboUsage::StreamDraw);
             vertexArray.render(Renderer::PrimType::Quads);
         }
 
@@ -382,7 +411,7 @@ namespace TrenchBroom {
                                 shader.set("GrayScale", texture->overridden());
                                 texture->activate();
 
-                                vertexArray.prepare(vboManager());
+                                vertexArray.prepare(vboManager(), Renderer::VboUsage::StreamDraw);
                                 vertexArray.render(Renderer::PrimType::Quads);
 
                                 texture->deactivate();
@@ -420,7 +449,7 @@ namespace TrenchBroom {
 
             Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::move(vertices));
 
-            vertexArray.prepare(vboManager());
+            vertexArray.prepare(vboManager(), Renderer::VboUsage::StreamDraw);
             vertexArray.render(Renderer::PrimType::Quads);
         }
 
@@ -430,7 +459,7 @@ namespace TrenchBroom {
 
             for (const auto& [descriptor, vertices] : collectStringVertices(layout, y, height)) {
                 stringRenderers[descriptor] = Renderer::VertexArray::ref(vertices);
-                stringRenderers[descriptor].prepare(vboManager());
+                stringRenderers[descriptor].prepare(vboManager(), Renderer::VboUsage::StreamDraw);
             }
 
             Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::ColoredTextShader);
@@ -476,18 +505,19 @@ namespace TrenchBroom {
                         if (row.intersectsY(y, height)) {
                             for (unsigned int k = 0; k < row.size(); k++) {
                                 const auto& cell = row[k];
+                                const auto& data = measuredCellData(cell, defaultDescriptor, layout.maxCellWidth());
                                 const auto titleBounds = cell.titleBounds();
-                                const auto& textureFont = fontManager().font(cellData(cell).mainTitleFont);
-                                const auto& groupFont   = fontManager().font(cellData(cell).subTitleFont);
+                                const auto& textureFont = fontManager().font(data.mainTitleFont);
+                                const auto& groupFont   = fontManager().font(data.subTitleFont);
 
                                 // y is relative to top, but OpenGL coords are relative to bottom, so invert
                                 const auto titleOffset = vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
 
-                                const auto textureNameOffset = titleOffset + cellData(cell).mainTitleOffset;
-                                const auto groupNameOffset   = titleOffset + cellData(cell).subTitleOffset;
+                                const auto textureNameOffset = titleOffset + data.mainTitleOffset;
+                                const auto groupNameOffset   = titleOffset + data.subTitleOffset;
 
-                                const auto& textureName = cellData(cell).mainTitle;
-                                const auto& groupName   = cellData(cell).subTitle;
+                                const auto& textureName = data.mainTitle;
+                                const auto& groupName   = data.subTitle;
 
                                 const auto textureNameQuads = textureFont.quads(textureName, false, textureNameOffset);
                                 const auto groupNameQuads   = groupFont.quads(groupName, false, groupNameOffset);
@@ -504,10 +534,10 @@ namespace TrenchBroom {
                                     kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2),
                                     kdl::skip_iterator(std::begin(subTextColor), std::end(subTextColor), 0, 0));
 
-                                auto& mainTitleVertices = stringVertices[cellData(cell).mainTitleFont];
+                                auto& mainTitleVertices = stringVertices[data.mainTitleFont];
                                 mainTitleVertices = kdl::vec_concat(std::move(mainTitleVertices), textureNameVertices);
 
-                                auto& subTitleVertices = stringVertices[cellData(cell).subTitleFont];
+                                auto& subTitleVertices = stringVertices[data.subTitleFont];
                                 subTitleVertices = kdl::vec_concat(std::move(subTitleVertices), groupNameVertices);
                             }
                         }
@@ -564,5 +594,14 @@ namespace TrenchBroom {
             auto ptr = any.value<std::shared_ptr<TextureCellData>>();
             return *ptr;
         }
+
+        const TextureCellData& TextureBrowserView::measuredCellData(const Cell& cell, const Renderer::FontDescriptor& font, const float maxCellWidth) {
+            QVariant any = cell.item();
+            auto ptr = any.value<std::shared_ptr<TextureCellData>>();
+            if (!ptr->titlesMeasured) {
+                measureTitles(*ptr, font, maxCellWidth);
+            }
+            return *ptr;
+        }
     }
 }
@@ -22,6 +22,7 @@
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
 #include "View/CellView.h"
+#include "View/TextureNameIndex.h"
 
 #include <map>
 #include <memory>
@@ -45,6 +46,9 @@ namespace TrenchBroom {
             const Assets::Texture* texture;
             std::string mainTitle;
             std::string subTitle;
+
+            // The following members are only computed when the cell becomes visible for the first time.
+            bool titlesMeasured;
             vm::vec2f mainTitleOffset;
             vm::vec2f subTitleOffset;
             Renderer::FontDescriptor mainTitleFont;
@@ -69,6 +73,8 @@ namespace TrenchBroom {
             std::string m_filterText;
 
             const Assets::Texture* m_selectedTexture;
+
+            TextureNameIndex m_textureNames;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
                                GLContextManager& contextManager,
@@ -89,12 +95,13 @@ namespace TrenchBroom {
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
-            void addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font);
+            void addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, float titleHeight);
+            void measureTitles(TextureCellData& cellData, const Renderer::FontDescriptor& font, float maxCellWidth);
+            void updateTextureNames();
 
             struct CompareByUsageCount;
             struct CompareByName;
             struct MatchUsageCount;
-            struct MatchName;
 
             const std::vector<Assets::TextureCollection>& getCollections() const;
             std::vector<const Assets::Texture*> getTextures(const Assets::TextureCollection& collection) const;
@@ -121,6 +128,7 @@ namespace TrenchBroom {
             void doContextMenu(Layout& layout, float x, float y, QContextMenuEvent* event) override;
 
             const TextureCellData& cellData(const Cell& cell) const;
+            const TextureCellData& measuredCellData(const Cell& cell, const Renderer::FontDescriptor& font, float maxCellWidth);
         signals:
             void textureSelected(const Assets::Texture* texture);
         };
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureNameIndex.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "IO/Path.h"
+
+#include <kdl/string_format.h>
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        static std::string getDisplayName(const Assets::Texture* texture) {
+            return IO::Path(texture->name()).lastComponent().asString();
+        }
+
+        TextureNameIndex::TextureNameIndex() :
+        m_generation(0u) {}
+
+        void TextureNameIndex::update(const std::vector<Assets::TextureCollection>& collections, const size_t generation) {
+            if (!m_names.empty() && m_generation == generation) {
+                return;
+            }
+
+            m_names.clear();
+            for (const auto& collection : collections) {
+                for (const auto& texture : collection.textures()) {
+                    m_names[&texture] = TextureNames{
+                        getDisplayName(&texture),
+                        kdl::str_to_lower(texture.name())
+                    };
+                }
+            }
+            m_generation = generation;
+        }
+
+        size_t TextureNameIndex::size() const {
+            return m_names.size();
+        }
+
+        std::string TextureNameIndex::displayName(const Assets::Texture* texture) const {
+            const auto it = m_names.find(texture);
+            return it != std::end(m_names) ? it->second.displayName : getDisplayName(texture);
+        }
+
+        std::vector<const Assets::Texture*> TextureNameIndex::filter(std::vector<const Assets::Texture*> textures, const std::string& pattern) const {
+            const auto lowercasePattern = kdl::str_to_lower(pattern);
+            return kdl::vec_erase_if(std::move(textures), [&](const Assets::Texture* texture) {
+                const auto it = m_names.find(texture);
+                if (it != std::end(m_names)) {
+                    return it->second.lowercaseName.find(lowercasePattern) == std::string::npos;
+                }
+                return kdl::str_to_lower(texture->name()).find(lowercasePattern) == std::string::npos;
+            });
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+        class TextureCollection;
+    }
+
+    namespace View {
+        /**
+         * Caches the display names and the lowercase names of all textures so that the texture browser does not
+         * have to compute them again whenever it filters the textures or reloads its layout.
+         *
+         * The index is rebuilt when the generation of the texture manager changes. Textures that are not in the
+         * index, e.g. because they were added after it was built, are still handled correctly, but their names are
+         * computed on demand.
+         */
+        class TextureNameIndex {
+        private:
+            struct TextureNames {
+                std::string displayName;
+                std::string lowercaseName;
+            };
+
+            std::unordered_map<const Assets::Texture*, TextureNames> m_names;
+            size_t m_generation;
+        public:
+            TextureNameIndex();
+
+            /**
+             * Rebuilds this index from the given collections unless it was already built for the given generation.
+             */
+            void update(const std::vector<Assets::TextureCollection>& collections, size_t generation);
+
+            size_t size() const;
+
+            /**
+             * Returns the name of the given texture without its path.
+             */
+            std::string displayName(const Assets::Texture* texture) const;
+
+            /**
+             * Returns the textures whose names contain the given pattern, ignoring case. The order of the textures
+             * is preserved.
+             */
+            std::vector<const Assets::Texture*> filter(std::vector<const Assets::Texture*> textures, const std::string& pattern) const;
+        };
+    }
+}
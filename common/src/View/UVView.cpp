@@ -168,7 +168,7 @@ namespace TrenchBroom {
         void UVView::doRender() {
             if (m_helper.valid()) {
                 auto document = kdl::mem_lock(m_document);
-                document->commitPendingAssets();
+                document->commitPendingAssets(this);
 
                 Renderer::RenderContext renderContext(Renderer::RenderMode::Render2D, m_camera, fontManager(), shaderManager());
                 Renderer::RenderBatch renderBatch(vboManager());
@@ -28,7 +28,8 @@ namespace TrenchBroom {
     namespace View {
         UndoableCommand::UndoableCommand(const CommandType type, const std::string& name, const bool updateModificationCount) :
         Command(type, name),
-        m_modificationCount(updateModificationCount ? 1u : 0u) {}
+        m_modificationCount(updateModificationCount ? 1u : 0u),
+        m_memoryCounter(MemorySubsystem::UndoStack) {}
 
         UndoableCommand::~UndoableCommand() {}
 
@@ -64,5 +65,17 @@ namespace TrenchBroom {
             }
             return false;
         }
+
+        size_t UndoableCommand::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+
+        void UndoableCommand::updateMemoryUsage() {
+            m_memoryCounter.setBytes(memoryUsage());
+        }
+
+        size_t UndoableCommand::doGetMemoryUsage() const {
+            return 0u;
+        }
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "MemoryUsage.h"
 #include "View/Command.h"
 
 #include <memory>
@@ -32,6 +33,7 @@ namespace TrenchBroom {
         class UndoableCommand : public Command {
         private:
             size_t m_modificationCount;
+            MemoryCounter m_memoryCounter;
         protected:
             UndoableCommand(CommandType type, const std::string& name, bool updateModificationCount);
         public:
@@ -41,11 +43,25 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> performUndo(MapDocumentCommandFacade* document);
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the memory in bytes that this command holds in order to be undone or redone. Memory
+             * that is accounted for by other subsystems, such as the brushes held by the command, is not included.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Attributes this command's current memory usage to the undo stack subsystem. Must be called when the
+             * command is stored and whenever another command was collated into it.
+             */
+            void updateMemoryUsage();
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
 
+            virtual size_t doGetMemoryUsage() const;
+
             deleteCopyAndMove(UndoableCommand)
         };
     }
@@ -58,8 +58,9 @@ namespace TrenchBroom {
             return rhs.first->isAncestorOf(lhs.first);
         };
 
-        UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(LinkedGroupsToUpdate linkedGroupsToUpdate) :
-        m_state{kdl::vec_sort(std::move(linkedGroupsToUpdate), compareByAncestry)} {}
+        UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(LinkedGroupsToUpdate linkedGroupsToUpdate, std::optional<std::vector<const Model::Node*>> changedNodes) :
+        m_state{kdl::vec_sort(std::move(linkedGroupsToUpdate), compareByAncestry)},
+        m_changedNodes{std::move(changedNodes)} {}
 
         UpdateLinkedGroupsHelper::~UpdateLinkedGroupsHelper() = default;
 
@@ -105,7 +106,7 @@ namespace TrenchBroom {
         kdl::result<void, Model::UpdateLinkedGroupsError> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(MapDocumentCommandFacade& document) {
             return std::visit(kdl::overload(
                 [&](const LinkedGroupsToUpdate& linkedGroups) {
-                    return computeLinkedGroupUpdates(linkedGroups, document.worldBounds())
+                    return computeLinkedGroupUpdates(linkedGroups, m_changedNodes, document.worldBounds())
                         .and_then([&](auto&& linkedGroupUpdates) {
                             m_state = std::move(linkedGroupUpdates);
                         });
@@ -116,13 +117,15 @@ namespace TrenchBroom {
             ), m_state);
         }
 
-        kdl::result<UpdateLinkedGroupsHelper::LinkedGroupUpdates, Model::UpdateLinkedGroupsError> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const vm::bbox3& worldBounds) {
+        kdl::result<UpdateLinkedGroupsHelper::LinkedGroupUpdates, Model::UpdateLinkedGroupsError> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const std::optional<std::vector<const Model::Node*>>& changedNodes, const vm::bbox3& worldBounds) {
             if (!checkLinkedGroupsToUpdate(kdl::vec_transform(linkedGroupsToUpdate, [](const auto& p) { return p.first; }))) {
                 return Model::UpdateLinkedGroupsError::UpdateIsInconsistent;
             }
 
             return kdl::for_each_result(linkedGroupsToUpdate, [&](const auto& pair) {
-                return Model::updateLinkedGroups(*pair.first, pair.second, worldBounds);
+                return changedNodes
+                    ? Model::updateLinkedGroups(*pair.first, pair.second, *changedNodes, worldBounds)
+                    : Model::updateLinkedGroups(*pair.first, pair.second, worldBounds);
             }).and_then([&](auto&& nestedUpdateLists) -> kdl::result<LinkedGroupUpdates, Model::UpdateLinkedGroupsError> {
                 return kdl::vec_flatten(std::move(nestedUpdateLists));
             });
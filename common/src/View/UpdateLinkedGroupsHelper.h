@@ -24,6 +24,7 @@
 #include <kdl/result_forward.h>
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -54,14 +55,19 @@ namespace TrenchBroom {
          * a replacement node is created for each linked group that needs to be updated, and these
          * linked groups are replaced with their replacements. Calling applyLinkedGroupUpdates replaces
          * the replacement nodes with their original corresponding groups again, effectively undoing the change.
+         *
+         * If the helper is also given the nodes whose contents were changed, then only those nodes are transformed
+         * into the linked groups, see Model::updateLinkedGroups. This is only valid if the structure of the linked
+         * groups did not change.
          */
         class UpdateLinkedGroupsHelper {
         private:
             using LinkedGroupsToUpdate = std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>>;
             using LinkedGroupUpdates = std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>;
             std::variant<LinkedGroupsToUpdate, LinkedGroupUpdates> m_state;
+            std::optional<std::vector<const Model::Node*>> m_changedNodes;
         public:
-            explicit UpdateLinkedGroupsHelper(LinkedGroupsToUpdate linkedGroupsToUpdate);
+            explicit UpdateLinkedGroupsHelper(LinkedGroupsToUpdate linkedGroupsToUpdate, std::optional<std::vector<const Model::Node*>> changedNodes = std::nullopt);
             ~UpdateLinkedGroupsHelper();
 
             kdl::result<void, Model::UpdateLinkedGroupsError> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
@@ -69,7 +75,7 @@ namespace TrenchBroom {
             void collateWith(UpdateLinkedGroupsHelper& other);
         private:
             kdl::result<void, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
-            static kdl::result<LinkedGroupUpdates, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const vm::bbox3& worldBounds);
+            static kdl::result<LinkedGroupUpdates, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const std::optional<std::vector<const Model::Node*>>& changedNodes, const vm::bbox3& worldBounds);
 
             void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
         };
@@ -153,6 +153,9 @@ namespace TrenchBroom {
             m_rendererFontSizeCombo->addItems({ "8", "9", "10", "11", "12", "13", "14", "15", "16", "17", "18", "19", "20", "22", "24", "26", "28", "32", "36", "40", "48", "56", "64", "72" });
             m_rendererFontSizeCombo->setValidator(new QIntValidator(1, 96));
 
+            m_writeMapCache = new QCheckBox();
+            m_writeMapCache->setToolTip("Write a cache file next to the map file when saving, which allows reopening the map faster.");
+
             auto* layout = new FormWithSectionsLayout();
             layout->setContentsMargins(0, LayoutConstants::MediumVMargin, 0, 0);
             layout->setVerticalSpacing(2);
@@ -177,6 +180,9 @@ namespace TrenchBroom {
             layout->addSection("Fonts");
             layout->addRow("Renderer Font Size", m_rendererFontSizeCombo);
 
+            layout->addSection("Map Files");
+            layout->addRow("Write map cache", m_writeMapCache);
+
             viewBox->setMinimumWidth(400);
             viewBox->setLayout(layout);
 
@@ -194,6 +200,7 @@ namespace TrenchBroom {
             connect(m_textureModeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ViewPreferencePane::textureModeChanged);
             connect(m_textureBrowserIconSizeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ViewPreferencePane::textureBrowserIconSizeChanged);
             connect(m_rendererFontSizeCombo, &QComboBox::currentTextChanged, this, &ViewPreferencePane::rendererFontSizeChanged);
+            connect(m_writeMapCache, &QCheckBox::stateChanged, this, &ViewPreferencePane::writeMapCacheChanged);
         }
 
         bool ViewPreferencePane::doCanResetToDefaults() {
@@ -213,6 +220,7 @@ namespace TrenchBroom {
             prefs.resetToDefault(Preferences::Theme);
             prefs.resetToDefault(Preferences::TextureBrowserIconSize);
             prefs.resetToDefault(Preferences::RendererFontSize);
+            prefs.resetToDefault(Preferences::WriteMapCache);
         }
 
         void ViewPreferencePane::doUpdateControls() {
@@ -246,6 +254,7 @@ namespace TrenchBroom {
             }
 
             m_rendererFontSizeCombo->setCurrentText(QString::asprintf("%i", pref(Preferences::RendererFontSize)));
+            m_writeMapCache->setChecked(pref(Preferences::WriteMapCache));
         }
 
         bool ViewPreferencePane::doValidate() {
@@ -358,5 +367,11 @@ namespace TrenchBroom {
                 prefs.set(Preferences::RendererFontSize, value);
             }
         }
+
+        void ViewPreferencePane::writeMapCacheChanged(const int state) {
+            const auto value = state == Qt::Checked;
+            auto& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::WriteMapCache, value);
+        }
     }
 }
@@ -0,0 +1,25 @@
+textures/test/wrong_extension
+{
+    // editor image exists, but with a different extension
+    qer_editorimage textures/test/image.tga
+}
+
+textures/test/correct_extension
+{
+    // editor image exists with the given extension
+    qer_editorimage textures/test/image.jpg
+}
+
+textures/test/missing
+{
+    // editor image does not exist
+    qer_editorimage textures/test/missing.tga
+}
+
+textures/test/stage_map
+{
+    // no editor image, but the first stage refers to an image with a different extension
+    {
+        map textures/test/image.png
+    }
+}
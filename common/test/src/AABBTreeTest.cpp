@@ -24,6 +24,7 @@
 
 #include <set>
 #include <sstream>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -528,4 +529,40 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
 
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
+
+    TEST_CASE("AABBTreeTest.clearAndBuild", "[AABBTreeTest]") {
+        const auto getBounds = [](const size_t i) { return makeBounds(i, i + 1u); };
+
+        auto objects = std::vector<size_t>{};
+        for (size_t i = 0u; i < 100u; ++i) {
+            objects.push_back(i);
+        }
+
+        AABB tree;
+        tree.insert(makeBounds(-2, -1), 1000u);
+        tree.clearAndBuild(objects, getBounds);
+
+        CHECK_FALSE(tree.contains(1000u));
+        CHECK(tree.bounds() == makeBounds(0, 100));
+        CHECK(tree.height() == 8u);
+
+        for (const auto i : objects) {
+            assertTreeContains(tree, getBounds(i), i);
+        }
+        assertIntersectors(tree, RAY(VEC(50.5, 0.0, 0.0), VEC::pos_z()), { 50u });
+
+        SECTION("Nodes can be removed and inserted after building") {
+            CHECK(tree.remove(50u));
+            assertTreeDoesNotContain(tree, getBounds(50u), 50u);
+
+            tree.insert(getBounds(50u), 50u);
+            assertTreeContains(tree, getBounds(50u), 50u);
+        }
+
+        SECTION("Building with duplicate data throws and leaves the tree empty") {
+            CHECK_THROWS_AS(tree.clearAndBuild(std::vector<size_t>{ 1u, 1u }, getBounds), NodeTreeException);
+            CHECK(tree.empty());
+            CHECK_FALSE(tree.contains(1u));
+        }
+    }
 }
@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Assets/TextureManager.h"
+#include "Assets/TextureResidencyManager.h"
+#include "Renderer/GL.h"
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST_CASE("TextureManagerTest.advanceResidencyFrameOncePerFrame", "[TextureManagerTest]") {
+            NullLogger logger;
+            TextureManager textureManager(GL_NEAREST, GL_NEAREST, logger);
+
+            const int view1 = 0, view2 = 0, view3 = 0;
+
+            // all views render the first frame
+            textureManager.commitChanges(&view1);
+            textureManager.commitChanges(&view2);
+            textureManager.commitChanges(&view3);
+            CHECK(textureManager.residencyManager().frame() == 0u);
+
+            // the first view to render again starts the next frame
+            textureManager.commitChanges(&view2);
+            CHECK(textureManager.residencyManager().frame() == 1u);
+            textureManager.commitChanges(&view1);
+            CHECK(textureManager.residencyManager().frame() == 1u);
+
+            // a single view that renders repeatedly advances the frame every time
+            textureManager.commitChanges(&view1);
+            CHECK(textureManager.residencyManager().frame() == 2u);
+            textureManager.commitChanges(&view1);
+            CHECK(textureManager.residencyManager().frame() == 3u);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureResidencyManager.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        class RecordingBackend : public TextureResidencyManager::Backend {
+        private:
+            std::vector<const Texture*>& m_uploaded;
+            std::vector<const Texture*>& m_evicted;
+        public:
+            RecordingBackend(std::vector<const Texture*>& uploaded, std::vector<const Texture*>& evicted) :
+            m_uploaded(uploaded),
+            m_evicted(evicted) {}
+
+            bool upload(const Texture& texture) override {
+                m_uploaded.push_back(&texture);
+                return true;
+            }
+
+            void evict(const Texture& texture) override {
+                m_evicted.push_back(&texture);
+            }
+        };
+
+        TEST_CASE("TextureResidencyManagerTest.uploadOnFirstUse", "[TextureResidencyManagerTest]") {
+            std::vector<const Texture*> uploaded, evicted;
+            auto manager = TextureResidencyManager(std::make_unique<RecordingBackend>(uploaded, evicted), 0u);
+
+            const auto t1 = Texture("t1", 64, 64);
+            const auto t2 = Texture("t2", 32, 32);
+
+            CHECK_FALSE(manager.isResident(t1));
+            CHECK(manager.residentCount() == 0u);
+
+            manager.use(t1);
+            manager.use(t1);
+            CHECK(uploaded == std::vector<const Texture*>{&t1});
+            CHECK(manager.isResident(t1));
+            CHECK(manager.residentSize() == TextureResidencyManager::estimatedSize(t1));
+
+            manager.use(t2);
+            CHECK(uploaded == std::vector<const Texture*>{&t1, &t2});
+            CHECK(manager.residentCount() == 2u);
+            CHECK(manager.residentSize() == TextureResidencyManager::estimatedSize(t1) + TextureResidencyManager::estimatedSize(t2));
+
+            // without a budget, nothing is ever evicted
+            for (size_t i = 0; i < 10; ++i) {
+                manager.nextFrame();
+            }
+            CHECK(evicted.empty());
+        }
+
+        TEST_CASE("TextureResidencyManagerTest.evictLeastRecentlyUsed", "[TextureResidencyManagerTest]") {
+            std::vector<const Texture*> uploaded, evicted;
+
+            const auto t1 = Texture("t1", 64, 64);
+            const auto t2 = Texture("t2", 64, 64);
+            const auto t3 = Texture("t3", 64, 64);
+
+            const auto size = TextureResidencyManager::estimatedSize(t1);
+            auto manager = TextureResidencyManager(std::make_unique<RecordingBackend>(uploaded, evicted), 2u * size);
+
+            manager.use(t1);
+            manager.nextFrame();
+            manager.use(t2);
+            manager.nextFrame();
+
+            // t1 was used again, so t2 is now the least recently used texture
+            manager.use(t1);
+            manager.nextFrame();
+
+            manager.use(t3);
+            CHECK(evicted == std::vector<const Texture*>{&t2});
+            CHECK(manager.isResident(t1));
+            CHECK_FALSE(manager.isResident(t2));
+            CHECK(manager.isResident(t3));
+            CHECK(manager.residentSize() == 2u * size);
+
+            // using an evicted texture uploads it again
+            manager.nextFrame();
+            manager.use(t2);
+            CHECK(uploaded == std::vector<const Texture*>{&t1, &t2, &t3, &t2});
+            CHECK(evicted == std::vector<const Texture*>{&t2, &t1});
+        }
+
+        TEST_CASE("TextureResidencyManagerTest.keepTexturesUsedInCurrentFrame", "[TextureResidencyManagerTest]") {
+            std::vector<const Texture*> uploaded, evicted;
+
+            const auto t1 = Texture("t1", 64, 64);
+            const auto t2 = Texture("t2", 64, 64);
+            const auto t3 = Texture("t3", 64, 64);
+
+            const auto size = TextureResidencyManager::estimatedSize(t1);
+            auto manager = TextureResidencyManager(std::make_unique<RecordingBackend>(uploaded, evicted), size);
+
+            // the budget is exceeded, but all textures are needed to render the current frame
+            manager.use(t1);
+            manager.use(t2);
+            manager.use(t3);
+            CHECK(evicted.empty());
+            CHECK(manager.residentSize() == 3u * size);
+
+            // in the next frame, stale textures are evicted as soon as another texture is used
+            manager.nextFrame();
+            manager.use(t3);
+            CHECK(evicted == std::vector<const Texture*>{&t1, &t2});
+            CHECK(manager.residentSize() == size);
+        }
+
+        TEST_CASE("TextureResidencyManagerTest.setBudget", "[TextureResidencyManagerTest]") {
+            std::vector<const Texture*> uploaded, evicted;
+
+            const auto t1 = Texture("t1", 64, 64);
+            const auto t2 = Texture("t2", 64, 64);
+
+            const auto size = TextureResidencyManager::estimatedSize(t1);
+            auto manager = TextureResidencyManager(std::make_unique<RecordingBackend>(uploaded, evicted), 0u);
+
+            manager.use(t1);
+            manager.use(t2);
+            manager.nextFrame();
+
+            manager.setBudget(size);
+            CHECK(evicted == std::vector<const Texture*>{&t1});
+            CHECK(manager.residentSize() == size);
+        }
+
+        TEST_CASE("TextureResidencyManagerTest.removeAndClear", "[TextureResidencyManagerTest]") {
+            std::vector<const Texture*> uploaded, evicted;
+
+            const auto t1 = Texture("t1", 64, 64);
+            const auto t2 = Texture("t2", 64, 64);
+
+            {
+                auto manager = TextureResidencyManager(std::make_unique<RecordingBackend>(uploaded, evicted), 0u);
+
+                manager.use(t1);
+                manager.use(t2);
+
+                manager.remove(t1);
+                CHECK(evicted == std::vector<const Texture*>{&t1});
+                CHECK_FALSE(manager.isResident(t1));
+                CHECK(manager.residentCount() == 1u);
+
+                // removing a texture that isn't resident does nothing
+                manager.remove(t1);
+                CHECK(evicted == std::vector<const Texture*>{&t1});
+            }
+
+            // the destructor evicts the remaining textures
+            CHECK(evicted == std::vector<const Texture*>{&t1, &t2});
+        }
+    }
+}
@@ -21,6 +21,7 @@
 #include "Assets/EntityDefinitionTestUtils.h"
 #include "Assets/PropertyDefinition.h"
 #include "IO/DiskIO.h"
+#include "IO/EntityDefinitionClassInfoCache.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
@@ -31,6 +32,7 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 
 #include "Catch2.h"
@@ -869,6 +871,93 @@ decor_goddess_statue : "Goddess Statue" [])";
             kdl::vec_clear_and_delete(defs);
         }
 
+        TEST_CASE("FgdParserTest.parseIncludeWithCache", "[FgdParserTest]") {
+            const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseNestedInclude/host.fgd");
+            auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            auto cache = std::make_shared<EntityDefinitionClassInfoCache>();
+
+            for (size_t i = 0u; i < 2u; ++i) {
+                FgdParser parser(reader.stringView(), defaultColor, file->path(), cache);
+
+                TestParserStatus status;
+                auto defs = parser.parseDefinitions(status);
+                CHECK(defs.size() == 3u);
+                CHECK(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "worldspawn"; }));
+                CHECK(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "info_player_start"; }));
+                CHECK(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "info_player_coop"; }));
+
+                // the host file and both included files
+                CHECK(cache->size() == 3u);
+
+                kdl::vec_clear_and_delete(defs);
+            }
+        }
+
+        TEST_CASE("FgdParserTest.parseIncludesInParallel", "[FgdParserTest]") {
+            const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseParallelIncludes/host.fgd");
+            auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            auto cache = std::make_shared<EntityDefinitionClassInfoCache>();
+
+            // the second pass finds all files in the cache
+            for (size_t i = 0u; i < 2u; ++i) {
+                FgdParser parser(reader.stringView(), defaultColor, file->path(), cache);
+
+                TestParserStatus status;
+                auto defs = parser.parseDefinitions(status);
+                CHECK(defs.size() == 3u);
+                CHECK(std::any_of(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "worldspawn"; }));
+
+                const auto lightIt = std::find_if(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "light"; });
+                REQUIRE(lightIt != std::end(defs));
+                const auto* light = *lightIt;
+                CHECK(light->color() == Color(1.0f, 1.0f, 40.0f / 255.0f, 1.0f));
+                CHECK(light->propertyDefinition("style") != nullptr);
+                CHECK(light->propertyDefinition("targetname") != nullptr);
+                REQUIRE(light->propertyDefinition("light") != nullptr);
+                CHECK(light->propertyDefinition("light")->type() == Assets::PropertyDefinitionType::IntegerProperty);
+
+                const auto itemIt = std::find_if(std::begin(defs), std::end(defs), [](const auto* def) { return def->name() == "item_health"; });
+                REQUIRE(itemIt != std::end(defs));
+                const auto* item = *itemIt;
+                CHECK(item->propertyDefinition("targetname") != nullptr);
+                REQUIRE(item->propertyDefinition("spawnflags") != nullptr);
+                const auto* spawnflags = static_cast<const Assets::FlagsPropertyDefinition*>(item->propertyDefinition("spawnflags"));
+                REQUIRE(spawnflags->options().size() == 1u);
+                CHECK(spawnflags->options()[0].shortDescription() == std::string("Rotten"));
+
+                // the duplicate spawnflags warning is replayed from the cache
+                CHECK(status.countStatus(LogLevel::Warn) == 1u);
+
+                // the host file and all included files
+                CHECK(cache->size() == 4u);
+
+                kdl::vec_clear_and_delete(defs);
+            }
+        }
+
+        TEST_CASE("FgdParserTest.parseRecursiveIncludeIsNotCached", "[FgdParserTest]") {
+            const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseRecursiveInclude/host.fgd");
+            auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            auto cache = std::make_shared<EntityDefinitionClassInfoCache>();
+            FgdParser parser(reader.stringView(), defaultColor, file->path(), cache);
+
+            TestParserStatus status;
+            auto defs = parser.parseDefinitions(status);
+            CHECK(defs.size() == 1u);
+            CHECK(cache->size() == 0u);
+
+            kdl::vec_clear_and_delete(defs);
+        }
+
         TEST_CASE("FgdParserTest.parseRecursiveInclude", "[FgdParserTest]") {
             const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseRecursiveInclude/host.fgd");
             auto file = Disk::openFile(path);
@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/File.h"
+#include "IO/FileCache.h"
+#include "IO/Path.h"
+
+#include <memory>
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::shared_ptr<File> makeFile(const std::string& name, const size_t size) {
+            return std::make_shared<OwningBufferFile>(Path(name), std::make_unique<char[]>(size), size);
+        }
+
+        TEST_CASE("FileCacheTest.getAndPut", "[FileCacheTest]") {
+            auto cache = FileCache(100u);
+            CHECK(cache.get("a") == nullptr);
+            CHECK(cache.misses() == 1u);
+
+            const auto a = makeFile("a", 10u);
+            cache.put("a", a);
+            CHECK(cache.get("a") == a);
+            CHECK(cache.hits() == 1u);
+            CHECK(cache.count() == 1u);
+            CHECK(cache.bytes() == 10u);
+
+            const auto b = makeFile("a", 20u);
+            cache.put("a", b);
+            CHECK(cache.get("a") == b);
+            CHECK(cache.count() == 1u);
+            CHECK(cache.bytes() == 20u);
+        }
+
+        TEST_CASE("FileCacheTest.evictLeastRecentlyUsed", "[FileCacheTest]") {
+            auto cache = FileCache(100u);
+            cache.put("a", makeFile("a", 40u));
+            cache.put("b", makeFile("b", 40u));
+
+            // mark a as most recently used
+            CHECK(cache.get("a") != nullptr);
+
+            cache.put("c", makeFile("c", 40u));
+            CHECK(cache.get("a") != nullptr);
+            CHECK(cache.get("b") == nullptr);
+            CHECK(cache.get("c") != nullptr);
+            CHECK(cache.bytes() == 80u);
+        }
+
+        TEST_CASE("FileCacheTest.skipOversizedFiles", "[FileCacheTest]") {
+            auto cache = FileCache(100u);
+            cache.put("a", makeFile("a", 40u));
+            cache.put("b", makeFile("b", 101u));
+
+            CHECK(cache.get("a") != nullptr);
+            CHECK(cache.get("b") == nullptr);
+            CHECK(cache.bytes() == 40u);
+        }
+
+        TEST_CASE("FileCacheTest.oversizedFileReplacesStaleFile", "[FileCacheTest]") {
+            auto cache = FileCache(100u);
+            cache.put("a", makeFile("a", 40u));
+            cache.put("a", makeFile("a", 101u));
+
+            CHECK(cache.get("a") == nullptr);
+            CHECK(cache.count() == 0u);
+            CHECK(cache.bytes() == 0u);
+        }
+
+        TEST_CASE("FileCacheTest.removeWithPrefix", "[FileCacheTest]") {
+            auto cache = FileCache(100u);
+            cache.put("pak0|1", makeFile("a", 10u));
+            cache.put("pak0|2", makeFile("b", 10u));
+            cache.put("pak1|1", makeFile("c", 10u));
+
+            cache.removeWithPrefix("pak0|");
+            CHECK(cache.get("pak0|1") == nullptr);
+            CHECK(cache.get("pak0|2") == nullptr);
+            CHECK(cache.get("pak1|1") != nullptr);
+            CHECK(cache.count() == 1u);
+            CHECK(cache.bytes() == 10u);
+
+            cache.clear();
+            CHECK(cache.count() == 0u);
+            CHECK(cache.bytes() == 0u);
+        }
+    }
+}
@@ -0,0 +1,250 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Node.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::string writeMap(const Model::WorldNode& world) {
+            std::stringstream str;
+            writeGameComment(str, "Test", Model::formatName(world.mapFormat()));
+            NodeWriter writer(world, str);
+            writer.writeMap();
+            return str.str();
+        }
+
+        static void collectNodes(const Model::Node* node, std::vector<const Model::Node*>& result) {
+            result.push_back(node);
+            for (const auto* child : node->children()) {
+                collectNodes(child, result);
+            }
+        }
+
+        static size_t countLines(const std::string& str) {
+            return static_cast<size_t>(std::count(std::begin(str), std::end(str), '\n')) + 1u;
+        }
+
+        static void checkSameNodes(const Model::WorldNode& expected, const Model::WorldNode& actual, const size_t lineCount) {
+            std::vector<const Model::Node*> expectedNodes, actualNodes;
+            collectNodes(&expected, expectedNodes);
+            collectNodes(&actual, actualNodes);
+            REQUIRE(actualNodes.size() == expectedNodes.size());
+
+            for (size_t i = 0u; i < expectedNodes.size(); ++i) {
+                const auto* expectedNode = expectedNodes[i];
+                const auto* actualNode = actualNodes[i];
+
+                CHECK(actualNode->lineNumber() == expectedNode->lineNumber());
+                for (size_t line = 1u; line <= lineCount; ++line) {
+                    CHECK(actualNode->containsLine(line) == expectedNode->containsLine(line));
+                }
+
+                const auto* expectedBrushNode = dynamic_cast<const Model::BrushNode*>(expectedNode);
+                const auto* actualBrushNode = dynamic_cast<const Model::BrushNode*>(actualNode);
+                REQUIRE((actualBrushNode != nullptr) == (expectedBrushNode != nullptr));
+                if (expectedBrushNode != nullptr) {
+                    const auto& expectedBrush = expectedBrushNode->brush();
+                    const auto& actualBrush = actualBrushNode->brush();
+                    CHECK(actualBrush.bounds() == expectedBrush.bounds());
+                    CHECK(actualBrush.vertexCount() == expectedBrush.vertexCount());
+                    CHECK(actualBrush.edgeCount() == expectedBrush.edgeCount());
+                    CHECK(actualBrush.fullySpecified());
+
+                    // the faces of a parsed brush are ordered by the geometry, so they are matched by their line numbers
+                    REQUIRE(actualBrush.faceCount() == expectedBrush.faceCount());
+                    for (const auto& expectedFace : expectedBrush.faces()) {
+                        const auto it = std::find_if(std::begin(actualBrush.faces()), std::end(actualBrush.faces()), [&](const auto& face) {
+                            return face.lineNumber() == expectedFace.lineNumber();
+                        });
+                        REQUIRE(it != std::end(actualBrush.faces()));
+
+                        const auto& actualFace = *it;
+                        CHECK(actualFace.points() == expectedFace.points());
+                        CHECK(actualFace.attributes() == expectedFace.attributes());
+                        CHECK(actualFace.textureXAxis() == expectedFace.textureXAxis());
+                        CHECK(actualFace.textureYAxis() == expectedFace.textureYAxis());
+                        CHECK_THAT(actualFace.vertexPositions(), Catch::UnorderedEquals(expectedFace.vertexPositions()));
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("MapCacheTest.writeAndRead", "[MapCacheTest]") {
+            using T = std::tuple<Model::MapFormat, std::string>;
+            const auto [mapFormat, data] = GENERATE(values<T>({
+                {Model::MapFormat::Valve, R"(
+{
+"classname" "worldspawn"
+"message" "a \"quoted\" message"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Layer"
+"_tb_id" "7"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "Group"
+"_tb_id" "3"
+"_tb_layer" "7"
+{
+( -80.5 28 102 ) ( -73 28 102 ) ( -73 22 102 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 15 0.5 0.5
+( -80.5 28 102 ) ( -80.5 22 102 ) ( -80.5 22 57 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -73 22 102 ) ( -73 28 102 ) ( -73 28 57 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -73 28 102 ) ( -80.5 28 102 ) ( -80.5 28 57 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -80.5 22 102 ) ( -73 22 102 ) ( -73 22 57 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -80.5 22 57 ) ( -73 22 57 ) ( -73 28 57 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+}
+}
+{
+"classname" "light"
+"origin" "0 0 0"
+"_tb_group" "3"
+}
+)"},
+                {Model::MapFormat::Quake2, R"(
+{
+"classname" "worldspawn"
+}
+{
+"classname" "func_door"
+{
+( -712 1280 -448 ) ( -904 1280 -448 ) ( -904 992 -448 ) rtz/c_mf_v3c 56 -32 0 1 1 8 16 2.5
+( -904 992 -416 ) ( -904 1280 -416 ) ( -712 1280 -416 ) rtz/b_rc_v16w 32 32 0 1 1
+( -832 968 -416 ) ( -832 1256 -416 ) ( -832 1256 -448 ) rtz/c_mf_v3c 16 96 0 1 1
+( -920 1088 -448 ) ( -920 1088 -416 ) ( -680 1088 -416 ) rtz/c_mf_v3c 56 96 0 1 1 0 0 0
+( -968 1152 -448 ) ( -920 1152 -448 ) ( -944 1152 -416 ) rtz/c_mf_v3c 56 96 0 1 1 0 0 0
+( -896 1056 -416 ) ( -896 1056 -448 ) ( -896 1344 -448 ) rtz/c_mf_v3c 16 96 0 1 1 0 0 0
+}
+}
+)"}
+            }));
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            TestParserStatus status;
+
+            // the cache belongs to the map file as written by TrenchBroom
+            auto sourceWorld = WorldReader(data, mapFormat).read(worldBounds, status);
+            const auto mapContents = writeMap(*sourceWorld);
+
+            TestEnvironment env("MapCacheTest");
+            const auto mapPath = env.dir() + Path("test.map");
+            env.createFile(Path("test.map"), mapContents);
+
+            MapCache::write(*sourceWorld, worldBounds, mapPath);
+            CHECK(env.fileExists(MapCache::cachePath(Path("test.map"))));
+
+            SECTION("Reading the cache restores the parsed world") {
+                auto parsedWorld = WorldReader(mapContents, mapFormat).read(worldBounds, status);
+                auto cachedWorld = MapCache::read(mapPath, mapContents, mapFormat, worldBounds, status);
+                REQUIRE(cachedWorld != nullptr);
+                CHECK(cachedWorld->mapFormat() == mapFormat);
+                checkSameNodes(*parsedWorld, *cachedWorld, countLines(mapContents));
+
+                // writing updates the file positions of the nodes, so this must be checked last
+                CHECK(writeMap(*cachedWorld) == mapContents);
+            }
+
+            SECTION("The cache is ignored if the map file has changed") {
+                CHECK(MapCache::read(mapPath, mapContents + "\n", mapFormat, worldBounds, status) == nullptr);
+            }
+
+            SECTION("The cache is ignored for a different format or different world bounds") {
+                CHECK(MapCache::read(mapPath, mapContents, Model::MapFormat::Quake3_Valve, worldBounds, status) == nullptr);
+                CHECK(MapCache::read(mapPath, mapContents, mapFormat, vm::bbox3(4096.0), status) == nullptr);
+            }
+
+            SECTION("A truncated or corrupted cache is ignored with a warning") {
+                const auto cacheFilePath = env.dir() + MapCache::cachePath(Path("test.map"));
+                auto cacheContents = std::string();
+                {
+                    auto stream = openPathAsInputStream(cacheFilePath, std::ios::in | std::ios::binary);
+                    cacheContents = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+                }
+                REQUIRE(cacheContents.size() > 64u);
+
+                auto corrupted = cacheContents;
+                corrupted.back() = static_cast<char>(~corrupted.back());
+
+                const auto damagedContents = std::vector<std::string>({
+                    // truncated within the header
+                    cacheContents.substr(0u, 10u),
+                    // truncated within the objects
+                    cacheContents.substr(0u, cacheContents.size() - 16u),
+                    // the checksum of the objects does not match
+                    corrupted
+                });
+
+                for (const auto& damaged : damagedContents) {
+                    {
+                        auto stream = openPathAsOutputStream(cacheFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+                        stream << damaged;
+                    }
+
+                    TestParserStatus damagedStatus;
+                    CHECK(MapCache::read(mapPath, mapContents, mapFormat, worldBounds, damagedStatus) == nullptr);
+                    CHECK(damagedStatus.countStatus(LogLevel::Warn) == 1u);
+                }
+            }
+
+            SECTION("Missing cache") {
+                CHECK(MapCache::read(env.dir() + Path("other.map"), mapContents, mapFormat, worldBounds, status) == nullptr);
+            }
+        }
+    }
+}
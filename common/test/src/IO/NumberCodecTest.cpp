@@ -0,0 +1,131 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NumberCodec.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST_CASE("NumberCodecTest.parseDouble", "[NumberCodecTest]") {
+            CHECK(parseDouble("0") == 0.0);
+            CHECK(parseDouble("16") == 16.0);
+            CHECK(parseDouble("-16") == -16.0);
+            CHECK(parseDouble("+16") == 16.0);
+            CHECK(parseDouble("0.5") == 0.5);
+            CHECK(parseDouble("-.25") == -0.25);
+            CHECK(parseDouble("3.") == 3.0);
+            CHECK(parseDouble("1e-05") == 1e-05);
+            CHECK(parseDouble("2.5E+3") == 2500.0);
+            CHECK(parseDouble("0.1") == 0.1);
+            CHECK(parseDouble("-21.849932013225562") == -21.849932013225562);
+            CHECK(parseDouble("9007199254740993") == 9007199254740992.0);
+            CHECK(parseDouble("123456789012345678901234567890") == 123456789012345678901234567890.0);
+            CHECK(parseDouble("1e300") == 1e300);
+
+            const auto negativeZero = parseDouble("-0");
+            REQUIRE(negativeZero.has_value());
+            CHECK(*negativeZero == 0.0);
+            CHECK(std::signbit(*negativeZero));
+
+            // strings which are not plain decimal numbers are interpreted like std::stod would interpret them
+            CHECK(parseDouble("1.5abc") == 1.5);
+            CHECK(parseDouble("1e") == 1.0);
+            CHECK(parseDouble(" 2") == 2.0);
+            CHECK(parseDouble("") == std::nullopt);
+            CHECK(parseDouble(".") == std::nullopt);
+            CHECK(parseDouble("-") == std::nullopt);
+            CHECK(parseDouble("abc") == std::nullopt);
+            CHECK(parseDouble("1e400") == std::nullopt);
+            CHECK(parseDouble("1e-400") == std::nullopt);
+            CHECK(parseDouble("1e-310") == std::nullopt);
+            CHECK(parseDouble("-1.25e+2x") == -125.0);
+            CHECK(parseDouble("\t+3.5e") == 3.5);
+            CHECK(parseDouble("12345678901234567890.5e1,0") == 123456789012345678905.0);
+            CHECK(parseDouble("-inf") == -std::numeric_limits<double>::infinity());
+
+            const auto nan = parseDouble("nan");
+            REQUIRE(nan.has_value());
+            CHECK(std::isnan(*nan));
+        }
+
+        TEST_CASE("NumberCodecTest.parseLong", "[NumberCodecTest]") {
+            CHECK(parseLong("0") == 0l);
+            CHECK(parseLong("123") == 123l);
+            CHECK(parseLong("-123") == -123l);
+            CHECK(parseLong("+123") == 123l);
+            CHECK(parseLong("12a") == 12l);
+            CHECK(parseLong("1.5") == 1l);
+            CHECK(parseLong("") == std::nullopt);
+            CHECK(parseLong("+-1") == std::nullopt);
+            CHECK(parseLong("abc") == std::nullopt);
+            CHECK(parseLong("99999999999999999999999") == std::nullopt);
+        }
+
+        static std::string format(const double value) {
+            auto result = std::string();
+            appendNumber(result, value);
+            return result;
+        }
+
+        static std::string format(const float value) {
+            auto result = std::string();
+            appendNumber(result, value);
+            return result;
+        }
+
+        TEST_CASE("NumberCodecTest.appendDouble", "[NumberCodecTest]") {
+            CHECK(format(0.0) == "0");
+            CHECK(format(-0.0) == "-0");
+            CHECK(format(16.0) == "16");
+            CHECK(format(-4096.0) == "-4096");
+            CHECK(format(0.5) == "0.5");
+            CHECK(format(0.1) == "0.1");
+            CHECK(format(1e-05) == "1e-05");
+            CHECK(format(-21.849932013225562) == "-21.849932013225562");
+            CHECK(format(9007199254740991.0) == "9007199254740991");
+            CHECK(format(1e16) == "1e+16");
+            CHECK(format(std::numeric_limits<double>::infinity()) == "inf");
+
+            auto buffer = std::string("( ");
+            appendNumber(buffer, 1.0);
+            CHECK(buffer == "( 1");
+        }
+
+        TEST_CASE("NumberCodecTest.appendFloat", "[NumberCodecTest]") {
+            CHECK(format(0.0f) == "0");
+            CHECK(format(-0.0f) == "-0");
+            CHECK(format(22.5f) == "22.5");
+            CHECK(format(0.1f) == "0.1");
+            CHECK(format(16777215.0f) == "16777215");
+            // the float closest to 1e15 is 999999986991104, but fewer digits suffice to identify it
+            CHECK(format(1e15f) == "1000000000000000");
+        }
+
+        TEST_CASE("NumberCodecTest.roundTrip", "[NumberCodecTest]") {
+            for (const auto value : {0.1, -0.2, 1.0 / 3.0, 1e-7, 123456.789, -21.849932013225562, 1e22, 1e23}) {
+                CHECK(parseDouble(format(value)) == value);
+            }
+        }
+    }
+}
@@ -0,0 +1,244 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static const std::string TwoBrushesMap = R"(// Game: Quake
+// Format: Standard
+{
+"classname" "worldspawn"
+{
+( 16 16 16 ) ( 16 17 16 ) ( 16 16 17 ) tex1 0 0 0 1 1
+( 16 16 16 ) ( 16 16 17 ) ( 17 16 16 ) tex1 0 0 0 1 1
+( 16 16 16 ) ( 17 16 16 ) ( 16 17 16 ) tex1 0 0 0 1 1
+( 80 48 32 ) ( 80 49 32 ) ( 81 48 32 ) tex1 0 0 0 1 1
+( 80 48 32 ) ( 81 48 32 ) ( 80 48 33 ) tex1 0 0 0 1 1
+( 80 48 32 ) ( 80 48 33 ) ( 80 49 32 ) tex1 0 0 0 1 1
+}
+{
+( 144 16 16 ) ( 144 17 16 ) ( 144 16 17 ) tex1 0 0 0 1 1
+( 144 16 16 ) ( 144 16 17 ) ( 145 16 16 ) tex1 0 0 0 1 1
+( 144 16 16 ) ( 145 16 16 ) ( 144 17 16 ) tex1 0 0 0 1 1
+( 208 48 32 ) ( 208 49 32 ) ( 209 48 32 ) tex1 0 0 0 1 1
+( 208 48 32 ) ( 209 48 32 ) ( 208 48 33 ) tex1 0 0 0 1 1
+( 208 48 32 ) ( 208 48 33 ) ( 208 49 32 ) tex1 0 0 0 1 1
+}
+}
+)";
+
+        static std::string readFile(const Path& path) {
+            const auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+            return std::string(reader.stringView());
+        }
+
+        TEST_CASE("ObjSerializerTest.writeBrushes", "[ObjSerializerTest]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+            TestParserStatus status;
+            auto world = WorldReader(TwoBrushesMap, Model::MapFormat::Standard).read(worldBounds, status);
+            REQUIRE(world != nullptr);
+            REQUIRE(world->defaultLayer()->childCount() == 2u);
+
+            TestEnvironment env("ObjSerializerTest");
+            const auto objPath = env.dir() + Path("test.obj");
+
+            {
+                NodeWriter writer(*world, std::make_unique<ObjFileSerializer>(objPath));
+                writer.setExporting(true);
+                writer.writeMap();
+            }
+
+            // vertex positions are not shared between brushes, but texture coordinates and normals are
+            CHECK(readFile(objPath) == R"(mtllib test.mtl
+o entity0_brush0
+v 16 16 -48
+v 16 16 -16
+v 16 32 -16
+v 16 32 -48
+v 80 32 -16
+v 80 16 -16
+v 80 16 -48
+v 80 32 -48
+vt 48 16
+vt 16 16
+vt 16 32
+vt 48 32
+vt 80 32
+vt 80 16
+vt 16 48
+vt 80 48
+vn -1 0 -0
+vn 0 0 1
+vn 0 -1 -0
+vn 0 1 -0
+vn 0 0 -1
+vn 1 0 -0
+usemtl tex1
+f 1/1/1 2/2/1 3/3/1 4/4/1
+usemtl tex1
+f 5/5/2 3/3/2 2/2/2 6/6/2
+usemtl tex1
+f 6/6/3 2/2/3 1/7/3 7/8/3
+usemtl tex1
+f 8/8/4 4/7/4 3/2/4 5/6/4
+usemtl tex1
+f 7/6/5 1/2/5 4/3/5 8/5/5
+usemtl tex1
+f 8/4/6 5/3/6 6/2/6 7/1/6
+
+o entity0_brush1
+v 144 16 -48
+v 144 16 -16
+v 144 32 -16
+v 144 32 -48
+v 208 32 -16
+v 208 16 -16
+v 208 16 -48
+v 208 32 -48
+vt 208 32
+vt 144 32
+vt 144 16
+vt 208 16
+vt 144 48
+vt 208 48
+usemtl tex1
+f 9/1/1 10/2/1 11/3/1 12/4/1
+usemtl tex1
+f 13/9/2 11/10/2 10/11/2 14/12/2
+usemtl tex1
+f 14/12/3 10/11/3 9/13/3 15/14/3
+usemtl tex1
+f 16/14/4 12/13/4 11/11/4 13/12/4
+usemtl tex1
+f 15/12/5 9/11/5 12/10/5 16/9/5
+usemtl tex1
+f 16/4/6 13/3/6 14/2/6 15/1/6
+
+)");
+            CHECK(readFile(env.dir() + Path("test.mtl")) == "newmtl tex1\n");
+        }
+
+        TEST_CASE("ObjSerializerTest.writeBrushFaces", "[ObjSerializerTest]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+            TestParserStatus status;
+            auto world = WorldReader(TwoBrushesMap, Model::MapFormat::Standard).read(worldBounds, status);
+            REQUIRE(world != nullptr);
+
+            const auto* brushNode = dynamic_cast<const Model::BrushNode*>(world->defaultLayer()->children().front());
+            REQUIRE(brushNode != nullptr);
+
+            TestEnvironment env("ObjSerializerTest");
+            const auto objPath = env.dir() + Path("test.obj");
+
+            {
+                NodeWriter writer(*world, std::make_unique<ObjFileSerializer>(objPath));
+                writer.writeBrushFaces(brushNode->brush().faces());
+            }
+
+            // every face is written as an object of its own
+            CHECK(readFile(objPath) == R"(mtllib test.mtl
+o entity0_brush0
+v 16 16 -48
+v 16 16 -16
+v 16 32 -16
+v 16 32 -48
+vt 48 16
+vt 16 16
+vt 16 32
+vt 48 32
+vn -1 0 -0
+usemtl tex1
+f 1/1/1 2/2/1 3/3/1 4/4/1
+
+o entity0_brush0
+v 80 32 -16
+v 16 32 -16
+v 16 16 -16
+v 80 16 -16
+vt 80 32
+vt 80 16
+vn 0 0 1
+usemtl tex1
+f 5/5/2 6/3/2 7/2/2 8/6/2
+
+o entity0_brush0
+v 80 16 -16
+v 16 16 -16
+v 16 16 -48
+v 80 16 -48
+vt 16 48
+vt 80 48
+vn 0 -1 -0
+usemtl tex1
+f 9/6/3 10/2/3 11/7/3 12/8/3
+
+o entity0_brush0
+v 80 32 -48
+v 16 32 -48
+v 16 32 -16
+v 80 32 -16
+vn 0 1 -0
+usemtl tex1
+f 13/8/4 14/7/4 15/2/4 16/6/4
+
+o entity0_brush0
+v 80 16 -48
+v 16 16 -48
+v 16 32 -48
+v 80 32 -48
+vn 0 0 -1
+usemtl tex1
+f 17/6/5 18/2/5 19/3/5 20/5/5
+
+o entity0_brush0
+v 80 32 -48
+v 80 32 -16
+v 80 16 -16
+v 80 16 -48
+vn 1 0 -0
+usemtl tex1
+f 21/4/6 22/3/6 23/2/6 24/1/6
+
+)");
+        }
+    }
+}
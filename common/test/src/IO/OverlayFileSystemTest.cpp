@@ -0,0 +1,149 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Exceptions.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/FileMatcher.h"
+#include "IO/IdPakFileSystem.h"
+#include "IO/OverlayFileSystem.h"
+#include "IO/PackageIndex.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/ZipFileSystem.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::string readFile(const FileSystem& fs, const Path& path) {
+            auto reader = fs.openFile(path)->reader();
+            return reader.readString(reader.size());
+        }
+
+        TEST_CASE("OverlayFileSystemTest.packageIndex", "[OverlayFileSystemTest]") {
+            const auto fixturePath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO");
+            const auto pak1 = std::make_shared<IdPakFileSystem>(fixturePath + Path("Pak/pak1.pak"));
+            const auto pak3 = std::make_shared<IdPakFileSystem>(fixturePath + Path("Pak/pak3.pak"));
+            const auto zip = std::make_shared<ZipFileSystem>(fixturePath + Path("Zip/zip_test.zip"));
+
+            const auto index = PackageIndex({zip, pak1, pak3});
+            CHECK(index.directoryExists(Path("")));
+            CHECK(index.directoryExists(Path("GFX")));
+            CHECK(index.directoryExists(Path("textures/e1u1")));
+            CHECK_FALSE(index.directoryExists(Path("amnet.cfg")));
+
+            CHECK(index.fileExists(Path("gfx/palette.lmp")));
+            CHECK(index.fileExists(Path("Textures/E1U1/box1_3.WAL")));
+            CHECK_FALSE(index.fileExists(Path("textures")));
+
+            CHECK_THAT(index.directoryContents(Path("")), Catch::UnorderedEquals(std::vector<Path>{
+                Path("gfx"),
+                Path("pics"),
+                Path("textures"),
+                Path("amnet.cfg"),
+                Path("bear.cfg")
+            }));
+            CHECK(index.directoryContents(Path("asdf")).empty());
+
+            // the package that comes first wins
+            CHECK(index.findPackage(Path("AMNET.cfg")) == zip.get());
+            CHECK(index.findPackage(Path("gfx/palette.lmp")) == pak3.get());
+            CHECK(index.findPackage(Path("asdf.cfg")) == nullptr);
+
+            CHECK(PackageIndex({pak1, zip}).findPackage(Path("amnet.cfg")) == pak1.get());
+        }
+
+        TEST_CASE("OverlayFileSystemTest.overlayLayers", "[OverlayFileSystemTest]") {
+            const auto fixturePath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO");
+            const auto pak1 = std::make_shared<IdPakFileSystem>(fixturePath + Path("Pak/pak1.pak"));
+            const auto index = std::make_shared<PackageIndex>(std::vector<std::shared_ptr<FileSystem>>{pak1});
+
+            TestEnvironment env("OverlayFileSystemTest");
+            env.createDirectory(Path("pics"));
+            env.createFile(Path("amnet.cfg"), "from disk");
+            env.createFile(Path("pics/tag3.pcx"), "");
+
+            SECTION("Disk above packages") {
+                OverlayFileSystem fs;
+                fs.addPackages(index);
+                fs.addFileSystem(std::make_shared<DiskFileSystem>(env.dir()));
+
+                CHECK(readFile(fs, Path("amnet.cfg")) == "from disk");
+                CHECK(readFile(fs, Path("bear.cfg")) != "from disk");
+                CHECK(fs.makeAbsolute(Path("amnet.cfg")) == env.dir() + Path("amnet.cfg"));
+                CHECK_THROWS_AS(fs.makeAbsolute(Path("bear.cfg")), FileSystemException);
+            }
+
+            SECTION("Packages above disk") {
+                OverlayFileSystem fs;
+                fs.addFileSystem(std::make_shared<DiskFileSystem>(env.dir()));
+                fs.addPackages(index);
+
+                CHECK(readFile(fs, Path("amnet.cfg")) != "from disk");
+                CHECK_THROWS_AS(fs.makeAbsolute(Path("amnet.cfg")), FileSystemException);
+            }
+
+            SECTION("Merge contents") {
+                OverlayFileSystem fs;
+                fs.addPackages(index);
+                fs.addFileSystem(std::make_shared<DiskFileSystem>(env.dir()));
+
+                CHECK(fs.directoryExists(Path("textures/e1u2")));
+                CHECK_THAT(fs.findItems(Path("pics")), Catch::UnorderedEquals(std::vector<Path>{
+                    Path("pics/tag1.pcx"),
+                    Path("pics/tag2.pcx"),
+                    Path("pics/tag3.pcx")
+                }));
+                CHECK_THAT(fs.findItemsRecursively(Path("textures"), FileExtensionMatcher("wal")), Catch::UnorderedEquals(std::vector<Path>{
+                    Path("textures/e1u1/box1_3.wal"),
+                    Path("textures/e1u1/brlava.wal"),
+                    Path("textures/e1u2/angle1_1.wal"),
+                    Path("textures/e1u2/angle1_2.wal"),
+                    Path("textures/e1u2/basic1_7.wal"),
+                    Path("textures/e1u3/stairs1_3.wal"),
+                    Path("textures/e1u3/stflr1_5.wal"),
+                }));
+            }
+
+            SECTION("Disk changes are visible") {
+                OverlayFileSystem fs;
+                fs.addPackages(index);
+                fs.addFileSystem(std::make_shared<DiskFileSystem>(env.dir()));
+
+                CHECK_FALSE(fs.fileExists(Path("new.cfg")));
+                env.createFile(Path("new.cfg"), "new");
+                CHECK(readFile(fs, Path("new.cfg")) == "new");
+            }
+
+            SECTION("Missing files") {
+                OverlayFileSystem fs;
+                fs.addPackages(index);
+
+                CHECK_FALSE(fs.fileExists(Path("asdf.cfg")));
+                CHECK_THROWS_AS(fs.openFile(Path("asdf.cfg")), FileSystemException);
+            }
+        }
+    }
+}
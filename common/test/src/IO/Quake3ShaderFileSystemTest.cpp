@@ -21,6 +21,7 @@
 #include "Assets/Quake3Shader.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
 #include "IO/Quake3ShaderFileSystem.h"
@@ -82,5 +83,32 @@ namespace TrenchBroom {
                 texturePrefix + Path("test/not_existing2"),
             }));
         }
+
+        TEST_CASE("Quake3ShaderFileSystemTest.testResolveShaderImages", "[Quake3ShaderFileSystemTest]") {
+            NullLogger logger;
+
+            const auto workDir = IO::Disk::getCurrentWorkingDir();
+            const auto testDir = workDir + Path("fixture/test/IO/Shader/fs/editor_image");
+            const auto fallbackDir = testDir + Path("fallback");
+            const auto texturePrefix = Path("textures");
+            const auto shaderSearchPath = Path("scripts");
+            const auto textureSearchPaths = std::vector<Path> { texturePrefix };
+
+            std::shared_ptr<FileSystem> fs = std::make_shared<DiskFileSystem>(fallbackDir);
+            fs = std::make_shared<DiskFileSystem>(fs, testDir);
+            fs = std::make_shared<Quake3ShaderFileSystem>(fs, shaderSearchPath, textureSearchPaths, logger);
+
+            const auto editorImage = [&](const Path& shaderPath) {
+                const auto file = fs->openFile(shaderPath);
+                const auto* shaderFile = dynamic_cast<const ObjectFile<Assets::Quake3Shader>*>(file.get());
+                REQUIRE(shaderFile != nullptr);
+                return shaderFile->object().editorImage;
+            };
+
+            CHECK(editorImage(texturePrefix + Path("test/wrong_extension")) == texturePrefix + Path("test/image.jpg"));
+            CHECK(editorImage(texturePrefix + Path("test/correct_extension")) == texturePrefix + Path("test/image.jpg"));
+            CHECK(editorImage(texturePrefix + Path("test/missing")) == texturePrefix + Path("test/missing.tga"));
+            CHECK(editorImage(texturePrefix + Path("test/stage_map")) == texturePrefix + Path("test/image.jpg"));
+        }
     }
 }
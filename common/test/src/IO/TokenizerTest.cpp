@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "IO/StandardMapParser.h"
 #include "IO/Token.h"
 #include "IO/Tokenizer.h"
 
@@ -242,5 +243,102 @@ namespace TrenchBroom {
             CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
             CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
         }
+
+        TEST_CASE("TokenizerTest.quakeMapNumbers", "[TokenizerTest]") {
+            const std::string testString("( 12 -3 +4 ) 1.5 -.25 3. 1e5 2.5e-3 - 12a 1.5) 7");
+
+            QuakeMapTokenizer tokenizer(testString);
+            QuakeMapTokenizer::Token token;
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::OParenthesis);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.data() == "12");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.data() == "-3");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.data() == "+4");
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::CParenthesis);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "1.5");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "-.25");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "3.");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "1e5");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "2.5e-3");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.data() == "-");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "12a");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.data() == "1.5");
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::CParenthesis);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.data() == "7");
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::Eof);
+        }
+
+        TEST_CASE("TokenizerTest.quakeMapQuotedStrings", "[TokenizerTest]") {
+            const std::string testString("\"classname\" \"worldspawn\"\n"
+                                         "\"message\" \"say \\\"hi\\\"\"\n"
+                                         "\"wad\" \"c:\\quake\\\"\n"
+                                         "\"multi\nline\" \"\"");
+
+            QuakeMapTokenizer tokenizer(testString);
+            QuakeMapTokenizer::Token token;
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "classname");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "worldspawn");
+            CHECK(token.line() == 1u);
+            CHECK(token.column() == 13u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "message");
+            CHECK(token.line() == 2u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "say \\\"hi\\\"");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "wad");
+            // a trailing backslash followed by a line break does not escape the closing quotation mark
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "c:\\quake\\");
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "multi\nline");
+            CHECK(token.line() == 4u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::String);
+            CHECK(token.data() == "");
+            CHECK(token.line() == 5u);
+            CHECK(token.column() == 7u);
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::Eof);
+        }
+
+        TEST_CASE("TokenizerTest.quakeMapLinesAndColumns", "[TokenizerTest]") {
+            const std::string testString("// comment \\ with backslash\n"
+                                         "{\r\n"
+                                         "\t( 1 2.5 3 ) ; Heretic 2 comment\n"
+                                         "}");
+
+            QuakeMapTokenizer tokenizer(testString);
+            QuakeMapTokenizer::Token token;
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::OBrace);
+            CHECK(token.line() == 2u);
+            CHECK(token.column() == 1u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::OParenthesis);
+            CHECK(token.line() == 3u);
+            CHECK(token.column() == 2u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.column() == 4u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Decimal);
+            CHECK(token.column() == 6u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::Integer);
+            CHECK(token.column() == 10u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::CParenthesis);
+            CHECK(token.column() == 12u);
+            CHECK((token = tokenizer.nextToken()).type() == QuakeMapToken::CBrace);
+            CHECK(token.line() == 4u);
+            CHECK(token.column() == 1u);
+            CHECK(tokenizer.nextToken().type() == QuakeMapToken::Eof);
+        }
     }
 }
@@ -20,11 +20,18 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/File.h"
+#include "IO/FileCache.h"
 #include "IO/FileMatcher.h"
 #include "IO/ZipFileSystem.h"
 
+#include <kdl/parallel.h>
+
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -139,5 +146,44 @@ namespace TrenchBroom {
 
             CHECK(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST_CASE("ZipFileSystemTest.openFilesConcurrently", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            const auto paths = fs.findItemsRecursively(Path(""), FileExtensionMatcher("wal"));
+
+            auto expected = std::vector<std::string>{};
+            for (const auto& path : paths) {
+                auto reader = fs.openFile(path)->reader();
+                expected.push_back(reader.readString(reader.size()));
+            }
+
+            // open every file many times so that the extractions overlap
+            const auto repetitions = size_t(32);
+            auto actual = std::vector<std::string>(paths.size() * repetitions);
+            kdl::parallel_for(actual.size(), [&](const size_t i) {
+                auto reader = fs.openFile(paths[i % paths.size()])->reader();
+                actual[i] = reader.readString(reader.size());
+            });
+
+            for (size_t i = 0; i < actual.size(); ++i) {
+                CHECK(actual[i] == expected[i % paths.size()]);
+            }
+        }
+
+        TEST_CASE("ZipFileSystemTest.openCachedFile", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            auto cache = std::make_shared<FileCache>(1024u * 1024u);
+            const ZipFileSystem fs(zipPath, cache);
+
+            const auto file = fs.openFile(Path("amnet.cfg"));
+            CHECK(cache->misses() == 1u);
+            CHECK(cache->count() == 1u);
+
+            CHECK(fs.openFile(Path("amnet.cfg")) == file);
+            CHECK(cache->hits() == 1u);
+        }
     }
 }
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryUsage.h"
+
+#include <sstream>
+#include <utility>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    // the tests only check differences, since other tests may leave memory attributed to the subsystem
+    static const auto TestSubsystem = MemorySubsystem::UndoStack;
+
+    static size_t currentBytes() {
+        return memoryUsage(TestSubsystem).bytes;
+    }
+
+    TEST_CASE("MemoryUsageTest.counter", "[MemoryUsageTest]") {
+        const auto initialBytes = currentBytes();
+
+        {
+            auto counter = MemoryCounter(TestSubsystem, 100u);
+            CHECK(currentBytes() == initialBytes + 100u);
+
+            counter.setBytes(150u);
+            CHECK(currentBytes() == initialBytes + 150u);
+
+            counter.setBytes(50u);
+            CHECK(currentBytes() == initialBytes + 50u);
+        }
+
+        CHECK(currentBytes() == initialBytes);
+    }
+
+    TEST_CASE("MemoryUsageTest.copyAndMove", "[MemoryUsageTest]") {
+        const auto initialBytes = currentBytes();
+
+        {
+            auto original = MemoryCounter(TestSubsystem, 100u);
+
+            auto copy = original;
+            CHECK(copy.bytes() == 100u);
+            CHECK(currentBytes() == initialBytes + 200u);
+
+            auto moved = std::move(copy);
+            CHECK(moved.bytes() == 100u);
+            CHECK(currentBytes() == initialBytes + 200u);
+
+            moved = MemoryCounter(TestSubsystem, 10u);
+            CHECK(currentBytes() == initialBytes + 110u);
+        }
+
+        CHECK(currentBytes() == initialBytes);
+    }
+
+    TEST_CASE("MemoryUsageTest.peak", "[MemoryUsageTest]") {
+        resetPeakMemoryUsage();
+        const auto initialBytes = currentBytes();
+
+        {
+            auto counter = MemoryCounter(TestSubsystem, 1000u);
+            counter.setBytes(10u);
+        }
+
+        CHECK(memoryUsage(TestSubsystem).peakBytes == initialBytes + 1000u);
+
+        resetPeakMemoryUsage();
+        CHECK(memoryUsage(TestSubsystem).peakBytes == initialBytes);
+    }
+
+    TEST_CASE("MemoryUsageTest.writeMemoryReport", "[MemoryUsageTest]") {
+        auto str = std::stringstream();
+        writeMemoryReport(str);
+
+        const auto report = str.str();
+        for (size_t i = 0u; i < MemorySubsystemCount; ++i) {
+            CHECK(report.find(memorySubsystemName(static_cast<MemorySubsystem>(i)) + ": ") != std::string::npos);
+        }
+    }
+}
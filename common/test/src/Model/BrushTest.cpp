@@ -29,6 +29,7 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushGeometry.h"
+#include "Model/BrushHullCache.h"
 #include "Model/BrushBuilder.h"
 #include "Model/Entity.h"
 #include "Model/Polyhedron.h"
@@ -39,14 +40,18 @@
 #include <kdl/vector_utils.h>
 
 #include <vecmath/approx.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
 #include <vecmath/ray.h>
+#include <vecmath/scalar.h>
 #include <vecmath/segment.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
 
 #include <fstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Catch2.h"
@@ -505,6 +510,104 @@ namespace TrenchBroom {
             CHECK(brush1.expand(worldBounds, -64, true).is_error());
         }
 
+        TEST_CASE("BrushTest.transform", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+            const Brush cube = builder.createCube(64.0, "texture").value();
+
+            using T = std::tuple<std::string, vm::mat4x4>;
+            const auto [name, transformation] = GENERATE(values<T>({
+                { "translation", vm::translation_matrix(vm::vec3(16.0, -8.0, 32.0)) },
+                { "rotation",    vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(30.0)) },
+                { "scaling",     vm::scaling_matrix(vm::vec3(2.0, 1.0, 0.5)) },
+                { "mirroring",   vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0)) },
+            }));
+            CAPTURE(name);
+
+            auto transformed = cube;
+            REQUIRE(transformed.transform(worldBounds, transformation, false).is_success());
+
+            const auto expectedVertices = kdl::vec_transform(cube.vertexPositions(), [&](const auto& v) { return transformation * v; });
+            CHECK_THAT(transformed.vertexPositions(), UnorderedApproxVecMatches(expectedVertices, 0.001));
+            CHECK(transformed.faceCount() == 6u);
+            CHECK(transformed.edgeCount() == 12u);
+
+            for (const auto& face : transformed.faces()) {
+                for (const auto& vertex : face.vertexPositions()) {
+                    CHECK(face.boundary().point_status(vertex) == vm::plane_status::inside);
+                }
+            }
+        }
+
+        TEST_CASE("BrushTest.transformMatchesRebuild", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            // a cube with one corner cut off so that the faces have different shapes
+            const Brush brush = builder.createBrush(std::vector<vm::vec3>{
+                vm::vec3(-32.0, -32.0, -32.0),
+                vm::vec3(+32.0, -32.0, -32.0),
+                vm::vec3(-32.0, +32.0, -32.0),
+                vm::vec3(+32.0, +32.0, -32.0),
+                vm::vec3(-32.0, -32.0, +32.0),
+                vm::vec3(+32.0, -32.0, +32.0),
+                vm::vec3(-32.0, +32.0, +32.0),
+                vm::vec3(+16.0, +32.0, +32.0),
+                vm::vec3(+32.0, +16.0, +32.0),
+                vm::vec3(+32.0, +32.0, +16.0),
+            }, "texture").value();
+
+            using T = std::tuple<std::string, vm::mat4x4, bool>;
+            const auto [name, transformation, expectInPlace] = GENERATE(values<T>({
+                { "translation", vm::translation_matrix(vm::vec3(16.0, -8.0, 32.0)), true },
+                { "rotation",    vm::rotation_matrix(vm::vec3::pos_z(), vm::to_radians(30.0)), true },
+                { "scaling",     vm::scaling_matrix(vm::vec3(2.0, 1.0, 0.5)), true },
+                { "shearing",    vm::mat4x4(1.0, 0.5, 0.0, 8.0,
+                                            0.0, 1.0, 0.25, 0.0,
+                                            0.0, 0.0, 1.0, -4.0,
+                                            0.0, 0.0, 0.0, 1.0), true },
+                { "mirroring",   vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0)), false },
+                { "mirroring and translation", vm::translation_matrix(vm::vec3(8.0, 0.0, 0.0)) * vm::scaling_matrix(vm::vec3(1.0, 1.0, -1.0)), false },
+            }));
+            CAPTURE(name);
+
+            auto transformed = brush;
+            const auto geometriesBefore = kdl::vec_transform(transformed.faces(), [](const auto& face) { return face.geometry(); });
+            REQUIRE(transformed.transform(worldBounds, transformation, false).is_success());
+
+            // the in place transformation keeps the face geometries, a rebuild replaces all of them
+            for (const auto& face : transformed.faces()) {
+                CHECK(kdl::vec_contains(geometriesBefore, face.geometry()) == expectInPlace);
+            }
+
+            auto transformedFaces = brush.faces();
+            for (auto& face : transformedFaces) {
+                REQUIRE(face.transform(transformation, false).is_success());
+            }
+            const Brush rebuilt = Brush::create(worldBounds, std::move(transformedFaces)).value();
+
+            CHECK(transformed.faceCount() == rebuilt.faceCount());
+            CHECK(transformed.edgeCount() == rebuilt.edgeCount());
+            CHECK_THAT(transformed.vertexPositions(), UnorderedApproxVecMatches(rebuilt.vertexPositions(), 0.001));
+
+            for (const auto& rebuiltFace : rebuilt.faces()) {
+                const auto faceIndex = transformed.findFace(rebuiltFace.boundary().normal);
+                REQUIRE(faceIndex);
+
+                const auto& face = transformed.face(*faceIndex);
+                CHECK(face.boundary().distance == vm::approx(rebuiltFace.boundary().distance));
+                CHECK_THAT(face.vertexPositions(), UnorderedApproxVecMatches(rebuiltFace.vertexPositions(), 0.001));
+            }
+        }
+
+        TEST_CASE("BrushTest.transformOutOfWorldBounds", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            Brush brush = builder.createCube(64.0, "texture").value();
+            CHECK(brush.transform(worldBounds, vm::translation_matrix(vm::vec3(8192.0, 0.0, 0.0)), false).is_error());
+        }
+
         TEST_CASE("BrushTest.moveVertex", "[BrushTest]") {
             const vm::bbox3 worldBounds(4096.0);
 
@@ -576,6 +679,44 @@ namespace TrenchBroom {
             CHECK(brush.fullySpecified());
         }
 
+        TEST_CASE("BrushTest.moveVertexInSteps", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+
+            BrushBuilder builder(MapFormat::Standard, worldBounds);
+            const Brush cube = builder.createCube(64.0, "some_texture").value();
+
+            const auto step = vm::vec3(-4.0, -4.0, 0.0);
+            const auto stepCount = 4u;
+
+            // like a vertex drag, the brush is copied, checked and modified once per step
+            BrushHullCache hullCache;
+            auto brush = cube;
+            auto vertexPositions = std::vector<vm::vec3>({vm::vec3(32.0, 32.0, 32.0)});
+            for (size_t i = 0u; i < stepCount; ++i) {
+                auto copy = brush;
+                REQUIRE(copy.canMoveVertices(worldBounds, vertexPositions, step, &hullCache));
+                REQUIRE(copy.moveVertices(worldBounds, vertexPositions, step, false, &hullCache).is_success());
+                vertexPositions = copy.findClosestVertexPositions(vertexPositions + step);
+                brush = std::move(copy);
+
+                // only the hull of the remaining vertices is kept, the result hull is consumed by the move
+                CHECK(hullCache.size() == 1u);
+            }
+
+            auto expected = cube;
+            REQUIRE(expected.moveVertices(worldBounds, std::vector<vm::vec3>({vm::vec3(32.0, 32.0, 32.0)}), static_cast<FloatType>(stepCount) * step).is_success());
+
+            CHECK_THAT(brush.vertexPositions(), UnorderedApproxVecMatches(expected.vertexPositions(), 0.001));
+            CHECK(brush.faceCount() == expected.faceCount());
+            CHECK(brush.fullySpecified());
+
+            // a check for a different delta must not affect the move
+            auto other = cube;
+            REQUIRE(other.canMoveVertices(worldBounds, std::vector<vm::vec3>({vm::vec3(32.0, 32.0, 32.0)}), step, &hullCache));
+            REQUIRE(other.moveVertices(worldBounds, std::vector<vm::vec3>({vm::vec3(32.0, 32.0, 32.0)}), static_cast<FloatType>(stepCount) * step, false, &hullCache).is_success());
+            CHECK_THAT(other.vertexPositions(), UnorderedApproxVecMatches(expected.vertexPositions(), 0.001));
+        }
+
         TEST_CASE("BrushTest.moveVertexInwardWithoutMerges", "[BrushTest]") {
             const vm::vec3d p1(-64.0, -64.0, -64.0);
             const vm::vec3d p2(-64.0, -64.0, +64.0);
@@ -191,6 +191,19 @@ namespace TrenchBroom {
             CHECK(*entity.property("key") == "value");
         }
 
+        TEST_CASE("EntityTest.propertyWithInternedKey") {
+            Entity entity;
+
+            CHECK(entity.property(InternedPropertyKeys::Targetname) == nullptr);
+            CHECK(!entity.hasProperty(InternedPropertyKeys::Targetname));
+
+            entity.addOrUpdateProperty(PropertyKeys::Targetname, "value");
+            CHECK(entity.hasProperty(InternedPropertyKeys::Targetname));
+            CHECK(entity.property(InternedPropertyKeys::Targetname) != nullptr);
+            CHECK(*entity.property(InternedPropertyKeys::Targetname) == "value");
+            CHECK(findProperty(entity.properties(), InternedPropertyKeys::Targetname) == "value");
+        }
+
         TEST_CASE("EntityTest.classname") {
             Entity entity;
             REQUIRE(!entity.hasProperty(PropertyKeys::Classname));
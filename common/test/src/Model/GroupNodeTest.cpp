@@ -112,6 +112,64 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE("GroupNodeTest.updateLinkedGroupsWithChangedNodes", "[GroupNodeTest]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+
+            auto groupNode = GroupNode{Group{"name"}};
+            auto* entityNode1 = new EntityNode{};
+            auto* entityNode2 = new EntityNode{};
+            groupNode.addChildren({entityNode1, entityNode2});
+
+            auto groupNodeClone = std::unique_ptr<GroupNode>{static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+            transformNode(*groupNodeClone, vm::translation_matrix(vm::vec3(0.0, 2.0, 0.0)), worldBounds);
+
+            // mark the clone of the second entity so that we can tell whether it was copied or transformed from the source
+            auto* entityNode2Clone = static_cast<EntityNode*>(groupNodeClone->children().back());
+            auto entity2Clone = entityNode2Clone->entity();
+            entity2Clone.addOrUpdateProperty("marker", "value");
+            entityNode2Clone->setEntity(std::move(entity2Clone));
+
+            transformNode(*entityNode1, vm::translation_matrix(vm::vec3(0.0, 0.0, 3.0)), worldBounds);
+            REQUIRE(entityNode1->entity().origin() == vm::vec3(0.0, 0.0, 3.0));
+
+            const auto checkUpdate = [&](const std::vector<const Node*>& changedNodes, const bool expectMarker) {
+                const auto updateResult = updateLinkedGroups(groupNode, {groupNodeClone.get()}, changedNodes, worldBounds);
+                updateResult.visit(kdl::overload(
+                    [&](const UpdateLinkedGroupsResult& r) {
+                        REQUIRE(r.size() == 1u);
+                        const auto& [groupNodeToUpdate, newChildren] = r.front();
+
+                        CHECK(groupNodeToUpdate == groupNodeClone.get());
+                        REQUIRE(newChildren.size() == 2u);
+
+                        const auto* newEntityNode1 = dynamic_cast<EntityNode*>(newChildren.front().get());
+                        const auto* newEntityNode2 = dynamic_cast<EntityNode*>(newChildren.back().get());
+                        REQUIRE(newEntityNode1 != nullptr);
+                        REQUIRE(newEntityNode2 != nullptr);
+
+                        CHECK(newEntityNode1->entity().origin() == vm::vec3(0.0, 2.0, 3.0));
+                        CHECK(newEntityNode2->entity().origin() == vm::vec3(0.0, 2.0, 0.0));
+                        CHECK(newEntityNode2->entity().hasProperty("marker") == expectMarker);
+                    },
+                    [](const auto&) {
+                        FAIL();
+                    }
+                ));
+            };
+
+            SECTION("Unchanged nodes are copied from the target group") {
+                checkUpdate({entityNode1}, true);
+            }
+
+            SECTION("Nodes whose corresponding node has changed are transformed") {
+                checkUpdate({entityNode1, entityNode2Clone}, false);
+            }
+
+            SECTION("All nodes are transformed if the source group has changed") {
+                checkUpdate({&groupNode, entityNode1}, false);
+            }
+        }
+
         TEST_CASE("GroupNodeTest.updateNestedLinkedGroups", "[GroupNodeTest]") {
             const auto worldBounds = vm::bbox3(8192.0);
             
@@ -23,14 +23,21 @@
 #include "Model/Polyhedron_DefaultPayload.h"
 #include "Model/Polyhedron_Instantiation.h"
 
+#include <kdl/vector_utils.h>
+
+#include <vecmath/approx.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/plane.h>
 #include <vecmath/scalar.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
 #include <iterator>
+#include <string>
 #include <tuple>
 #include <set>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -1995,5 +2002,62 @@ TEST_CASE("PolyhedronTest.testWeaveSimpleCap", "[PolyhedronTest]") {
                 vm::vec3{22416.0, 18336.0, 16.0},
             }, 0.0));
         }
+
+        TEST_CASE("PolyhedronTest.transformMatchesRebuild", "[PolyhedronTest]") {
+            // a cube with one corner cut off so that the faces have different shapes
+            const auto points = std::vector<vm::vec3d>{
+                vm::vec3d(-32.0, -32.0, -32.0),
+                vm::vec3d(+32.0, -32.0, -32.0),
+                vm::vec3d(-32.0, +32.0, -32.0),
+                vm::vec3d(+32.0, +32.0, -32.0),
+                vm::vec3d(-32.0, -32.0, +32.0),
+                vm::vec3d(+32.0, -32.0, +32.0),
+                vm::vec3d(-32.0, +32.0, +32.0),
+                vm::vec3d(+16.0, +32.0, +32.0),
+                vm::vec3d(+32.0, +16.0, +32.0),
+                vm::vec3d(+32.0, +32.0, +16.0),
+            };
+
+            using T = std::tuple<std::string, vm::mat4x4d>;
+            const auto [name, transformation] = GENERATE(values<T>({
+                { "translation", vm::translation_matrix(vm::vec3d(16.0, -8.0, 32.0)) },
+                { "rotation",    vm::rotation_matrix(vm::vec3d::pos_z(), vm::to_radians(30.0)) },
+                { "scaling",     vm::scaling_matrix(vm::vec3d(2.0, 1.0, 0.5)) },
+                { "shearing",    vm::mat4x4d(1.0, 0.5, 0.0, 8.0,
+                                             0.0, 1.0, 0.25, 0.0,
+                                             0.0, 0.0, 1.0, -4.0,
+                                             0.0, 0.0, 0.0, 1.0) },
+            }));
+            CAPTURE(name);
+
+            auto transformed = Polyhedron3d(points);
+            transformed.transform(transformation);
+
+            const auto rebuilt = Polyhedron3d(kdl::vec_transform(points, [&](const auto& point) { return transformation * point; }));
+
+            CHECK(transformed.closed());
+            CHECK(transformed.vertexCount() == rebuilt.vertexCount());
+            CHECK(transformed.edgeCount() == rebuilt.edgeCount());
+            CHECK(transformed.faceCount() == rebuilt.faceCount());
+            CHECK(transformed.hasAllVertices(rebuilt.vertexPositions(), 0.0001));
+            CHECK(transformed.bounds().min == vm::approx(rebuilt.bounds().min));
+            CHECK(transformed.bounds().max == vm::approx(rebuilt.bounds().max));
+
+            for (const auto* face : rebuilt.faces()) {
+                CHECK(transformed.hasFace(face->vertexPositions(), 0.0001));
+            }
+
+            // the transformed planes must contain their faces and face away from the centroid, which is inside
+            auto centroid = vm::vec3d::zero();
+            for (const auto& position : transformed.vertexPositions()) {
+                centroid = centroid + position;
+            }
+            centroid = centroid / static_cast<double>(transformed.vertexCount());
+
+            for (const auto* face : transformed.faces()) {
+                CHECK(face->verticesOnPlane(face->plane(), 0.0001));
+                CHECK(face->plane().point_status(centroid) == vm::plane_status::below);
+            }
+        }
     }
 }
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/LabelDeclutterer.h"
+
+#include <vecmath/vec.h>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("LabelDecluttererTest.dropOverlappingLabels", "[LabelDecluttererTest]") {
+            LabelDeclutterer declutterer(16.0f);
+
+            CHECK(declutterer.add(vm::vec2f(0, 0), vm::vec2f(40, 10)));
+            CHECK_FALSE(declutterer.add(vm::vec2f(30, 5), vm::vec2f(40, 10)));
+            CHECK_FALSE(declutterer.add(vm::vec2f(-10, -5), vm::vec2f(100, 20)));
+
+            // touching labels do not overlap
+            CHECK(declutterer.add(vm::vec2f(40, 0), vm::vec2f(40, 10)));
+            CHECK(declutterer.add(vm::vec2f(0, 10), vm::vec2f(40, 10)));
+
+            // negative coordinates and labels spanning many cells
+            CHECK(declutterer.add(vm::vec2f(-100, -100), vm::vec2f(50, 50)));
+            CHECK_FALSE(declutterer.add(vm::vec2f(-60, -60), vm::vec2f(5, 5)));
+
+            CHECK(declutterer.count() == 5u);
+        }
+
+        TEST_CASE("LabelDecluttererTest.clear", "[LabelDecluttererTest]") {
+            LabelDeclutterer declutterer;
+
+            CHECK(declutterer.add(vm::vec2f(0, 0), vm::vec2f(40, 10)));
+            CHECK_FALSE(declutterer.add(vm::vec2f(0, 0), vm::vec2f(40, 10)));
+
+            declutterer.clear();
+            CHECK(declutterer.count() == 0u);
+            CHECK(declutterer.add(vm::vec2f(0, 0), vm::vec2f(40, 10)));
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/RenderSortKey.h"
+
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class ShaderConfig;
+
+        static RenderSortKey makeKey(const ShaderConfig* shader, const unsigned int texture, const bool depthTest = true, const bool blend = false) {
+            return RenderSortKey{depthTest, blend, shader, texture, 1.0f, 0.0};
+        }
+
+        TEST_CASE("RenderSortKeyTest.compare", "[RenderSortKeyTest]") {
+            const auto* s1 = reinterpret_cast<const ShaderConfig*>(0x10);
+            const auto* s2 = reinterpret_cast<const ShaderConfig*>(0x20);
+
+            CHECK(makeKey(s1, 1u) == makeKey(s1, 1u));
+            CHECK(makeKey(s1, 1u) != makeKey(s1, 2u));
+            CHECK(makeKey(s1, 1u) != makeKey(s2, 1u));
+
+            CHECK(makeKey(s1, 2u) < makeKey(s2, 1u));
+            CHECK(makeKey(s1, 1u) < makeKey(s1, 2u));
+
+            // renderables without depth testing and blended renderables are rendered last
+            CHECK(makeKey(s2, 2u) < makeKey(s1, 1u, false));
+            CHECK(makeKey(s2, 2u) < makeKey(s1, 1u, true, true));
+            CHECK(makeKey(s2, 2u, true, true) < makeKey(s1, 1u, false));
+        }
+
+        TEST_CASE("RenderSortKeyTest.sortRenderOrder", "[RenderSortKeyTest]") {
+            const auto* s1 = reinterpret_cast<const ShaderConfig*>(0x10);
+            const auto* s2 = reinterpret_cast<const ShaderConfig*>(0x20);
+
+            using Keys = std::vector<std::optional<RenderSortKey>>;
+            using Order = std::vector<size_t>;
+
+            CHECK(sortRenderOrder(Keys{}) == Order{});
+            CHECK(sortRenderOrder(Keys{std::nullopt, std::nullopt}) == Order{0u, 1u});
+
+            SECTION("Keyed renderables are sorted stably") {
+                const auto keys = Keys{makeKey(s2, 0u), makeKey(s1, 0u), makeKey(s2, 0u), makeKey(s1, 0u)};
+                CHECK(sortRenderOrder(keys) == Order{1u, 3u, 0u, 2u});
+            }
+
+            SECTION("Renderables without keys are barriers") {
+                const auto keys = Keys{
+                    makeKey(s2, 0u), makeKey(s1, 0u),
+                    std::nullopt,
+                    makeKey(s2, 0u), makeKey(s1, 0u), makeKey(s2, 0u),
+                    std::nullopt
+                };
+                CHECK(sortRenderOrder(keys) == Order{1u, 0u, 2u, 4u, 3u, 5u, 6u});
+            }
+        }
+
+        TEST_CASE("RenderSortKeyTest.countStateChanges", "[RenderSortKeyTest]") {
+            const auto* s1 = reinterpret_cast<const ShaderConfig*>(0x10);
+            const auto* s2 = reinterpret_cast<const ShaderConfig*>(0x20);
+
+            using Keys = std::vector<std::optional<RenderSortKey>>;
+
+            SECTION("Renderables without keys set up all of their state") {
+                const auto changes = countStateChanges(Keys{std::nullopt, std::nullopt});
+                CHECK(changes.draws == 2u);
+                CHECK(changes.stateChanges == 2u);
+                CHECK(changes.shaderChanges == 2u);
+            }
+
+            SECTION("Equal keys share their state") {
+                const auto changes = countStateChanges(Keys{makeKey(s1, 1u), makeKey(s1, 1u), makeKey(s1, 2u), makeKey(s2, 2u), makeKey(s2, 2u, false)});
+                CHECK(changes.draws == 5u);
+                CHECK(changes.stateChanges == 4u);
+                CHECK(changes.shaderChanges == 2u);
+                CHECK(changes.textureChanges == 2u);
+                CHECK(changes.blendChanges == 0u);
+                CHECK(changes.depthChanges == 1u);
+            }
+
+            SECTION("Sorting reduces state changes") {
+                const auto keys = Keys{makeKey(s1, 1u), makeKey(s2, 1u), makeKey(s1, 1u), makeKey(s2, 1u)};
+                CHECK(countStateChanges(keys).stateChanges == 4u);
+
+                auto sortedKeys = Keys{};
+                for (const auto i : sortRenderOrder(keys)) {
+                    sortedKeys.push_back(keys[i]);
+                }
+                CHECK(countStateChanges(sortedKeys).stateChanges == 2u);
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/StreamingBufferAllocator.h"
+
+#include <optional>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Index = StreamingBufferAllocator::Index;
+
+        TEST_CASE("StreamingBufferAllocatorTest.constructor", "[StreamingBufferAllocatorTest]") {
+            StreamingBufferAllocator a(100u, 3u);
+            CHECK(a.regionSize() == 100u);
+            CHECK(a.regionCount() == 3u);
+            CHECK(a.capacity() == 300u);
+            CHECK(a.currentRegion() == 2u);
+            CHECK(a.allocatedBytes() == 0u);
+        }
+
+        TEST_CASE("StreamingBufferAllocatorTest.beginFrameCyclesThroughRegions", "[StreamingBufferAllocatorTest]") {
+            StreamingBufferAllocator a(100u, 3u);
+            CHECK(a.beginFrame() == 0u);
+            CHECK(a.beginFrame() == 1u);
+            CHECK(a.beginFrame() == 2u);
+            CHECK(a.beginFrame() == 0u);
+            CHECK(a.currentRegion() == 0u);
+        }
+
+        TEST_CASE("StreamingBufferAllocatorTest.allocate", "[StreamingBufferAllocatorTest]") {
+            StreamingBufferAllocator a(100u, 3u);
+
+            a.beginFrame();
+            CHECK(a.allocate(10u) == std::optional<Index>(0u));
+            CHECK(a.allocate(20u) == std::optional<Index>(10u));
+            CHECK(a.allocatedBytes() == 30u);
+
+            // offsets are relative to the start of the buffer
+            a.beginFrame();
+            CHECK(a.allocatedBytes() == 0u);
+            CHECK(a.allocate(10u) == std::optional<Index>(100u));
+
+            a.beginFrame();
+            CHECK(a.allocate(100u) == std::optional<Index>(200u));
+            CHECK(a.allocatedBytes() == 100u);
+        }
+
+        TEST_CASE("StreamingBufferAllocatorTest.allocateAligned", "[StreamingBufferAllocatorTest]") {
+            StreamingBufferAllocator a(100u, 3u);
+
+            a.beginFrame();
+            a.beginFrame();
+            CHECK(a.allocate(3u, 4u) == std::optional<Index>(100u));
+            CHECK(a.allocate(8u, 4u) == std::optional<Index>(104u));
+            CHECK(a.allocate(1u, 16u) == std::optional<Index>(112u));
+            CHECK(a.allocate(1u, 16u) == std::optional<Index>(128u));
+
+            // padding counts towards the allocated bytes
+            CHECK(a.allocatedBytes() == 29u);
+        }
+
+        TEST_CASE("StreamingBufferAllocatorTest.allocateWhenRegionIsFull", "[StreamingBufferAllocatorTest]") {
+            StreamingBufferAllocator a(100u, 3u);
+
+            a.beginFrame();
+            CHECK(a.allocate(101u) == std::nullopt);
+            CHECK(a.allocatedBytes() == 0u);
+
+            CHECK(a.allocate(90u) == std::optional<Index>(0u));
+            CHECK(a.allocate(11u) == std::nullopt);
+            CHECK(a.allocate(8u, 8u) == std::nullopt);
+
+            // a failed allocation leaves the region unchanged
+            CHECK(a.allocate(10u) == std::optional<Index>(90u));
+            CHECK(a.allocate(1u) == std::nullopt);
+
+            // the next frame starts with an empty region
+            a.beginFrame();
+            CHECK(a.allocate(100u) == std::optional<Index>(100u));
+        }
+    }
+}
@@ -66,6 +66,8 @@
 #include <vecmath/ray_io.h>
 #include <vecmath/scalar.h>
 
+#include <sstream>
+
 #include "Catch2.h"
 #include "TestUtils.h"
 
@@ -1214,6 +1216,100 @@ namespace TrenchBroom {
             CHECK(document->selectionBounds() == box.translate(delta));
         }
 
+        static std::vector<const Model::EntityNode*> entityNodes(const std::vector<Model::Node*>& nodes) {
+            auto result = std::vector<const Model::EntityNode*>{};
+            for (const auto* node : nodes) {
+                if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(node)) {
+                    result.push_back(entityNode);
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.pasteCopiedNodes") {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world()->mapFormat(), document->worldBounds());
+            const auto box = vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64));
+
+            auto* brushNode1 = new Model::BrushNode(builder.createCuboid(box, "texture").value());
+            addNode(*document, document->parentForNodes(), brushNode1);
+
+            auto* brushNode2 = new Model::BrushNode(builder.createCuboid(box.translate(vm::vec3(64, 0, 0)), "texture").value());
+            addNode(*document, document->parentForNodes(), brushNode2);
+
+            auto* brushNode3 = new Model::BrushNode(builder.createCuboid(box.translate(vm::vec3(128, 0, 0)), "texture").value());
+            addNode(*document, document->parentForNodes(), brushNode3);
+
+            document->select(std::vector<Model::Node*>{ brushNode2, brushNode3 });
+            auto* brushEntityNode = document->createBrushEntity(m_brushEntityDef);
+            document->deselectAll();
+
+            // worldspawn {
+            //   brushEntityNode { brushNode2, brushNode3 },
+            //   brushNode1
+            // }
+
+            document->select(std::vector<Model::Node*>{ brushNode1, brushNode2 });
+
+            const auto copiedNodes = document->copySelectedNodes();
+            REQUIRE(copiedNodes != nullptr);
+            REQUIRE(copiedNodes->defaultLayer()->childCount() == 2u);
+
+            SECTION("Copied nodes serialize like the selected nodes") {
+                std::stringstream stream;
+                document->game()->writeNodesToStream(*copiedNodes, copiedNodes->defaultLayer()->children(), stream);
+                CHECK(stream.str() == document->serializeSelectedNodes());
+            }
+
+            SECTION("Pasting copied nodes adds clones of them") {
+                document->deselectAll();
+                CHECK(document->paste(*copiedNodes) == PasteType::Node);
+
+                const auto pastedBrushNodes = document->selectedNodes().brushes();
+                REQUIRE(pastedBrushNodes.size() == 2u);
+
+                const auto* pastedEntityBrushNode = pastedBrushNodes[0]->entity() != document->world() ? pastedBrushNodes[0] : pastedBrushNodes[1];
+                const auto* pastedWorldBrushNode = pastedBrushNodes[0]->entity() != document->world() ? pastedBrushNodes[1] : pastedBrushNodes[0];
+
+                CHECK(pastedWorldBrushNode->entity() == document->world());
+                CHECK(pastedWorldBrushNode->logicalBounds() == brushNode1->logicalBounds());
+
+                CHECK(pastedEntityBrushNode->entity() != brushEntityNode);
+                CHECK(pastedEntityBrushNode->entity()->childCount() == 1u);
+                CHECK(pastedEntityBrushNode->logicalBounds() == brushNode2->logicalBounds());
+
+                // the copy is left intact and can be pasted again
+                CHECK(copiedNodes->defaultLayer()->childCount() == 2u);
+                CHECK(document->paste(*copiedNodes) == PasteType::Node);
+                CHECK(document->selectedNodes().brushCount() == 2u);
+            }
+
+            SECTION("Copied nodes do not reference the document's assets") {
+                const auto copiedEntityNodes = entityNodes(copiedNodes->defaultLayer()->children());
+                REQUIRE(copiedEntityNodes.size() == 1u);
+                CHECK(copiedEntityNodes.front()->entity().definition() == nullptr);
+                CHECK(copiedEntityNodes.front()->entity().model() == nullptr);
+                CHECK(copiedNodes->entity().definition() == nullptr);
+            }
+
+            SECTION("Copied nodes can be pasted after the source document was closed") {
+                // destroys the source nodes and the entity definitions they refer to
+                document->newDocument(Model::MapFormat::Standard, vm::bbox3(8192.0), game);
+
+                auto* newBrushEntityDef = new Assets::BrushEntityDefinition("brush_entity", Color(), "this is a brush entity", {});
+                document->setEntityDefinitions(std::vector<Assets::EntityDefinition*>{ newBrushEntityDef });
+
+                CHECK(document->paste(*copiedNodes) == PasteType::Node);
+
+                const auto pastedEntityNodes = entityNodes(document->world()->defaultLayer()->children());
+                REQUIRE(pastedEntityNodes.size() == 1u);
+                CHECK(pastedEntityNodes.front()->entity().definition() == newBrushEntityDef);
+            }
+        }
+
         // https://github.com/TrenchBroom/TrenchBroom/issues/3784
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.translateLinkedGroup") {
             // delete default brush
@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "View/TextureNameIndex.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static std::vector<Assets::TextureCollection> makeCollections() {
+            auto textures = std::vector<Assets::Texture>{};
+            textures.emplace_back("base/Wall01", 16, 16);
+            textures.emplace_back("base/FLOOR02", 16, 16);
+            textures.emplace_back("tech/wall_panel", 16, 16);
+
+            auto collections = std::vector<Assets::TextureCollection>{};
+            collections.emplace_back(std::move(textures));
+            return collections;
+        }
+
+        static std::vector<const Assets::Texture*> allTextures(const std::vector<Assets::TextureCollection>& collections) {
+            auto result = std::vector<const Assets::Texture*>{};
+            for (const auto& collection : collections) {
+                for (const auto& texture : collection.textures()) {
+                    result.push_back(&texture);
+                }
+            }
+            return result;
+        }
+
+        static std::vector<std::string> names(const std::vector<const Assets::Texture*>& textures) {
+            return kdl::vec_transform(textures, [](const auto* texture) { return texture->name(); });
+        }
+
+        TEST_CASE("TextureNameIndexTest.update", "[TextureNameIndexTest]") {
+            const auto collections = makeCollections();
+
+            auto index = TextureNameIndex{};
+            index.update(collections, 1u);
+            CHECK(index.size() == 3u);
+
+            // the index is not rebuilt for the same generation
+            const auto otherCollections = std::vector<Assets::TextureCollection>{};
+            index.update(otherCollections, 1u);
+            CHECK(index.size() == 3u);
+
+            index.update(otherCollections, 2u);
+            CHECK(index.size() == 0u);
+        }
+
+        TEST_CASE("TextureNameIndexTest.displayName", "[TextureNameIndexTest]") {
+            const auto collections = makeCollections();
+            const auto textures = allTextures(collections);
+
+            auto index = TextureNameIndex{};
+            index.update(collections, 1u);
+            CHECK(index.displayName(textures[0]) == "Wall01");
+            CHECK(index.displayName(textures[2]) == "wall_panel");
+
+            // textures that are not indexed fall back to computing their names
+            const auto unindexed = Assets::Texture("other/Unindexed", 16, 16);
+            CHECK(index.displayName(&unindexed) == "Unindexed");
+        }
+
+        TEST_CASE("TextureNameIndexTest.filter", "[TextureNameIndexTest]") {
+            const auto collections = makeCollections();
+            const auto textures = allTextures(collections);
+
+            auto index = TextureNameIndex{};
+            index.update(collections, 1u);
+
+            CHECK(names(index.filter(textures, "")) == std::vector<std::string>{"base/Wall01", "base/FLOOR02", "tech/wall_panel"});
+            CHECK(names(index.filter(textures, "WALL")) == std::vector<std::string>{"base/Wall01", "tech/wall_panel"});
+            CHECK(names(index.filter(textures, "floor")) == std::vector<std::string>{"base/FLOOR02"});
+            CHECK(names(index.filter(textures, "base/")) == std::vector<std::string>{"base/Wall01", "base/FLOOR02"});
+            CHECK(names(index.filter(textures, "missing")).empty());
+
+            // textures that are not indexed are filtered by their names as well
+            const auto unindexed = Assets::Texture("other/WALL_Unindexed", 16, 16);
+            auto withUnindexed = textures;
+            withUnindexed.push_back(&unindexed);
+            CHECK(names(index.filter(withUnindexed, "wall")) == std::vector<std::string>{"base/Wall01", "tech/wall_panel", "other/WALL_Unindexed"});
+            CHECK(names(index.filter(withUnindexed, "unindexed")) == std::vector<std::string>{"other/WALL_Unindexed"});
+        }
+    }
+}
@@ -0,0 +1,266 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef KDL_INTERNED_STRING_H
+#define KDL_INTERNED_STRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace kdl {
+    namespace detail {
+        struct interned_string_entry {
+            std::atomic<std::size_t> ref_count;
+            const std::string str;
+
+            explicit interned_string_entry(const std::string_view i_str) :
+            ref_count(1u),
+            str(i_str) {}
+        };
+
+        /**
+         * Stores one entry for every distinct string that is referenced by at least one interned string. An entry is
+         * removed when its last reference is released.
+         */
+        class interned_string_pool {
+        private:
+            std::shared_mutex m_mutex;
+            std::unordered_map<std::string_view, interned_string_entry*> m_entries;
+        public:
+            interned_string_entry* acquire(const std::string_view str) {
+                if (auto* entry = find(str)) {
+                    return entry;
+                }
+
+                const auto lock = std::unique_lock<std::shared_mutex>(m_mutex);
+
+                // another thread may have inserted the string after the shared lock was released
+                const auto it = m_entries.find(str);
+                if (it != std::end(m_entries)) {
+                    it->second->ref_count.fetch_add(1u, std::memory_order_relaxed);
+                    return it->second;
+                }
+
+                auto* entry = new interned_string_entry(str);
+                m_entries.emplace(std::string_view(entry->str), entry);
+                return entry;
+            }
+
+            /**
+             * Acquires a reference to the entry for the given string if it exists, otherwise returns null. Lookups
+             * of existing strings only take a shared lock and do not block each other.
+             */
+            interned_string_entry* find(const std::string_view str) {
+                const auto lock = std::shared_lock<std::shared_mutex>(m_mutex);
+
+                // an entry that is in the map has at least one reference because its last reference is released
+                // under the exclusive lock
+                const auto it = m_entries.find(str);
+                if (it != std::end(m_entries)) {
+                    it->second->ref_count.fetch_add(1u, std::memory_order_relaxed);
+                    return it->second;
+                }
+                return nullptr;
+            }
+
+            void release(interned_string_entry* entry) {
+                // only the last reference must synchronize with acquire, which can revive the entry
+                auto count = entry->ref_count.load(std::memory_order_relaxed);
+                while (count > 1u) {
+                    if (entry->ref_count.compare_exchange_weak(count, count - 1u, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                        return;
+                    }
+                }
+
+                const auto lock = std::unique_lock<std::shared_mutex>(m_mutex);
+                if (entry->ref_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+                    m_entries.erase(std::string_view(entry->str));
+                    delete entry;
+                }
+            }
+
+            std::size_t size() {
+                const auto lock = std::shared_lock<std::shared_mutex>(m_mutex);
+                return m_entries.size();
+            }
+        };
+
+        inline interned_string_pool& global_interned_string_pool() {
+            // never destroyed so that interned strings with static storage duration can outlive it safely
+            static auto* pool = new interned_string_pool();
+            return *pool;
+        }
+
+        inline const std::string& empty_interned_string() {
+            static const auto empty = std::string();
+            return empty;
+        }
+    }
+
+    /**
+     * An immutable string that shares its storage with all other interned strings that are equal to it.
+     *
+     * Interning a string requires a lookup in a global, thread safe pool. Strings that are already interned are found
+     * under a shared lock; only adding a new string takes an exclusive lock. Use an interned_string_cache to avoid the
+     * pool altogether when the same strings are interned repeatedly. Afterwards, an interned string takes up
+     * the size of a pointer, copying it only increments a reference count, and comparing two interned strings for
+     * equality is a pointer comparison. This makes interned strings well suited for values that repeat very often,
+     * such as keys.
+     *
+     * The empty string is represented without accessing the pool.
+     */
+    class interned_string {
+    private:
+        detail::interned_string_entry* m_entry;
+
+        explicit interned_string(detail::interned_string_entry* entry) noexcept :
+        m_entry(entry) {}
+    public:
+        /**
+         * Creates an empty string.
+         */
+        interned_string() noexcept :
+        m_entry(nullptr) {}
+
+        /**
+         * Interns the given string.
+         */
+        explicit interned_string(const std::string_view str) :
+        m_entry(str.empty() ? nullptr : detail::global_interned_string_pool().acquire(str)) {}
+
+        interned_string(const interned_string& other) noexcept :
+        m_entry(other.m_entry) {
+            if (m_entry != nullptr) {
+                m_entry->ref_count.fetch_add(1u, std::memory_order_relaxed);
+            }
+        }
+
+        interned_string(interned_string&& other) noexcept :
+        m_entry(std::exchange(other.m_entry, nullptr)) {}
+
+        interned_string& operator=(interned_string other) noexcept {
+            std::swap(m_entry, other.m_entry);
+            return *this;
+        }
+
+        ~interned_string() {
+            if (m_entry != nullptr) {
+                detail::global_interned_string_pool().release(m_entry);
+            }
+        }
+
+        const std::string& str() const {
+            return m_entry != nullptr ? m_entry->str : detail::empty_interned_string();
+        }
+
+        bool empty() const {
+            return m_entry == nullptr;
+        }
+
+        /**
+         * Returns a value that identifies this string, i.e., two interned strings are equal if and only if their
+         * identities are equal.
+         */
+        const void* id() const {
+            return m_entry;
+        }
+
+        /**
+         * Returns the interned string that is equal to the given string if such a string is currently interned, and
+         * an empty optional otherwise. Unlike the constructor, this never adds a string to the pool, so it can be used
+         * to look up keys: if a string is not interned, no interned string can be equal to it.
+         */
+        static std::optional<interned_string> find(const std::string_view str) {
+            if (str.empty()) {
+                return interned_string();
+            }
+            if (auto* entry = detail::global_interned_string_pool().find(str)) {
+                return interned_string(entry);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * Returns the number of distinct non-empty strings that are currently interned.
+         */
+        static std::size_t pool_size() {
+            return detail::global_interned_string_pool().size();
+        }
+
+        friend bool operator==(const interned_string& lhs, const interned_string& rhs) {
+            return lhs.m_entry == rhs.m_entry;
+        }
+
+        friend bool operator!=(const interned_string& lhs, const interned_string& rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const interned_string& lhs, const interned_string& rhs) {
+            return lhs != rhs && lhs.str() < rhs.str();
+        }
+    };
+}
+
+namespace kdl {
+    /**
+     * Remembers the strings it has interned so that interning an equal string again does not access the global pool.
+     *
+     * A cache is not thread safe. It is meant to be owned by a single thread that interns many repeated strings, such
+     * as a parser that creates the property keys of all entities in a file. The cached strings are released when the
+     * cache is destroyed.
+     */
+    class interned_string_cache {
+    private:
+        // the keys view the strings of the cached interned strings, which do not move
+        std::unordered_map<std::string_view, interned_string> m_strings;
+    public:
+        const interned_string& intern(const std::string_view str) {
+            const auto it = m_strings.find(str);
+            if (it != std::end(m_strings)) {
+                return it->second;
+            }
+
+            auto interned = interned_string(str);
+            const auto key = std::string_view(interned.str());
+            return m_strings.emplace(key, std::move(interned)).first->second;
+        }
+
+        std::size_t size() const {
+            return m_strings.size();
+        }
+    };
+}
+
+namespace std {
+    template <>
+    struct hash<kdl::interned_string> {
+        std::size_t operator()(const kdl::interned_string& str) const noexcept {
+            return std::hash<const void*>{}(str.id());
+        }
+    };
+}
+
+#endif //KDL_INTERNED_STRING_H
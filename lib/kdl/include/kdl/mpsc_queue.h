@@ -0,0 +1,126 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef KDL_MPSC_QUEUE_H
+#define KDL_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace kdl {
+    /**
+     * A lock-free queue that supports any number of producers and a single consumer.
+     *
+     * Producers push values individually, and the consumer takes all values that were pushed so far at once. This
+     * makes the queue suitable for batching work from many threads into a single background thread, e.g. for
+     * writing log messages.
+     *
+     * Pushing allocates a node for each value. Taking the values requires only a single atomic exchange, after
+     * which the values are returned in the order in which they were pushed. The order of values pushed concurrently
+     * by different threads is unspecified, but the values pushed by any single thread retain their relative order.
+     *
+     * @tparam T the type of the values
+     */
+    template <typename T>
+    class mpsc_queue {
+    private:
+        struct node {
+            T value;
+            node* next;
+        };
+
+        std::atomic<node*> m_head;
+    public:
+        /**
+         * Creates an empty queue.
+         */
+        mpsc_queue() :
+        m_head(nullptr) {}
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+        /**
+         * Destroys all values remaining in this queue. Must not be called while other threads access this queue.
+         */
+        ~mpsc_queue() {
+            delete_nodes(m_head.exchange(nullptr, std::memory_order_acquire));
+        }
+
+        /**
+         * Indicates whether this queue is empty. The result may be outdated by the time it is returned if other
+         * threads push values concurrently.
+         */
+        bool empty() const {
+            return m_head.load(std::memory_order_acquire) == nullptr;
+        }
+
+        /**
+         * Adds the given value to this queue. May be called from any thread.
+         *
+         * @param value the value to add
+         */
+        void push(T value) {
+            node* new_node = new node{std::move(value), m_head.load(std::memory_order_relaxed)};
+            while (!m_head.compare_exchange_weak(new_node->next, new_node, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        /**
+         * Removes all values from this queue and returns them in the order in which they were pushed. Must only be
+         * called from the consumer thread.
+         *
+         * @return the removed values
+         */
+        std::vector<T> pop_all() {
+            node* head = m_head.exchange(nullptr, std::memory_order_acquire);
+
+            // the nodes are linked in reverse order of insertion
+            node* reversed = nullptr;
+            std::size_t count = 0u;
+            while (head != nullptr) {
+                node* next = head->next;
+                head->next = reversed;
+                reversed = head;
+                head = next;
+                ++count;
+            }
+
+            std::vector<T> result;
+            result.reserve(count);
+
+            while (reversed != nullptr) {
+                node* next = reversed->next;
+                result.push_back(std::move(reversed->value));
+                delete reversed;
+                reversed = next;
+            }
+
+            return result;
+        }
+    private:
+        static void delete_nodes(node* head) {
+            while (head != nullptr) {
+                node* next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+    };
+}
+
+#endif //KDL_MPSC_QUEUE_H
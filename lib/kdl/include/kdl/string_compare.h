@@ -169,6 +169,23 @@ namespace kdl {
             }
         };
 
+        /**
+         * Hashes strings without case sensitivity, so that strings which are equal according to string_equal have
+         * the same hash value. Does not allocate, so it can be used to look up strings in unordered containers
+         * without converting them to lower case first.
+         */
+        struct string_hash {
+            std::size_t operator()(const std::string_view str) const {
+                // FNV-1a
+                std::size_t result = static_cast<std::size_t>(14695981039346656037ull);
+                for (const char c : str) {
+                    result ^= static_cast<std::size_t>(static_cast<unsigned char>(std::tolower(c)));
+                    result *= static_cast<std::size_t>(1099511628211ull);
+                }
+                return result;
+            }
+        };
+
         /**
          * Returns the first position at which the given strings differ. Characters are compared without case
          * sensitivity.
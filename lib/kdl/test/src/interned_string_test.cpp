@@ -0,0 +1,150 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "kdl/interned_string.h"
+
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl {
+    TEST_CASE("interned_string_test.empty", "[interned_string_test]") {
+        const auto poolSize = interned_string::pool_size();
+
+        CHECK(interned_string().empty());
+        CHECK(interned_string("").empty());
+        CHECK(interned_string() == interned_string(""));
+        CHECK(interned_string().str() == "");
+        CHECK(interned_string::pool_size() == poolSize);
+    }
+
+    TEST_CASE("interned_string_test.equality", "[interned_string_test]") {
+        const auto a1 = interned_string("interned_string_test.a");
+        const auto a2 = interned_string(std::string("interned_string_test.") + "a");
+        const auto b = interned_string("interned_string_test.b");
+
+        CHECK(a1 == a2);
+        CHECK(a1.id() == a2.id());
+        CHECK(&a1.str() == &a2.str());
+        CHECK(a1 != b);
+        CHECK(a1 < b);
+        CHECK_FALSE(b < a1);
+        CHECK_FALSE(a1 < a2);
+        CHECK(a1.str() == "interned_string_test.a");
+    }
+
+    TEST_CASE("interned_string_test.release", "[interned_string_test]") {
+        const auto poolSize = interned_string::pool_size();
+        {
+            auto a = interned_string("interned_string_test.release");
+            CHECK(interned_string::pool_size() == poolSize + 1u);
+
+            auto copy = a;
+            auto moved = std::move(a);
+            CHECK(a.empty());
+            CHECK(copy == moved);
+            CHECK(interned_string::pool_size() == poolSize + 1u);
+
+            copy = interned_string();
+            CHECK(interned_string::pool_size() == poolSize + 1u);
+        }
+        CHECK(interned_string::pool_size() == poolSize);
+
+        // interning the string again after it was released creates a new entry
+        const auto b = interned_string("interned_string_test.release");
+        CHECK(b.str() == "interned_string_test.release");
+        CHECK(interned_string::pool_size() == poolSize + 1u);
+    }
+
+    TEST_CASE("interned_string_test.find", "[interned_string_test]") {
+        const auto poolSize = interned_string::pool_size();
+
+        CHECK(interned_string::find("") == interned_string());
+        CHECK(interned_string::find("interned_string_test.find") == std::nullopt);
+        CHECK(interned_string::pool_size() == poolSize);
+
+        const auto a = interned_string("interned_string_test.find");
+        const auto found = interned_string::find("interned_string_test.find");
+        REQUIRE(found.has_value());
+        CHECK(*found == a);
+        CHECK(interned_string::pool_size() == poolSize + 1u);
+    }
+
+    TEST_CASE("interned_string_test.cache", "[interned_string_test]") {
+        const auto poolSize = interned_string::pool_size();
+        {
+            auto cache = interned_string_cache();
+            const auto& a1 = cache.intern("interned_string_test.cache.a");
+            const auto& a2 = cache.intern(std::string("interned_string_test.cache.") + "a");
+            const auto& b = cache.intern("interned_string_test.cache.b");
+
+            CHECK(&a1 == &a2);
+            CHECK(a1 == interned_string("interned_string_test.cache.a"));
+            CHECK(a1 != b);
+            CHECK(cache.intern("").empty());
+            CHECK(cache.size() == 3u);
+            CHECK(interned_string::pool_size() == poolSize + 2u);
+        }
+        CHECK(interned_string::pool_size() == poolSize);
+    }
+
+    TEST_CASE("interned_string_test.hash", "[interned_string_test]") {
+        auto set = std::unordered_set<interned_string>();
+        set.insert(interned_string("interned_string_test.x"));
+        set.insert(interned_string("interned_string_test.y"));
+        set.insert(interned_string("interned_string_test.x"));
+
+        CHECK(set.size() == 2u);
+        CHECK(set.count(interned_string("interned_string_test.y")) == 1u);
+    }
+
+    TEST_CASE("interned_string_test.concurrent", "[interned_string_test]") {
+        const auto poolSize = interned_string::pool_size();
+
+        static constexpr std::size_t ThreadCount = 8u;
+        static constexpr std::size_t IterationCount = 10000u;
+
+        auto threads = std::vector<std::thread>();
+        auto results = std::vector<interned_string>(ThreadCount);
+        for (std::size_t t = 0u; t < ThreadCount; ++t) {
+            threads.emplace_back([t, &results]() {
+                for (std::size_t i = 0u; i < IterationCount; ++i) {
+                    // repeatedly intern and release a shared set of strings
+                    const auto str = interned_string("interned_string_test.concurrent." + std::to_string(i % 16u));
+                    auto copy = str;
+                    copy = interned_string();
+                }
+                results[t] = interned_string("interned_string_test.concurrent");
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& result : results) {
+            CHECK(result == results.front());
+        }
+        CHECK(interned_string::pool_size() == poolSize + 1u);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/mpsc_queue.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl {
+    TEST_CASE("mpsc_queue_test.empty", "[mpsc_queue_test]") {
+        mpsc_queue<int> q;
+        CHECK(q.empty());
+        CHECK(q.pop_all().empty());
+
+        q.push(1);
+        CHECK_FALSE(q.empty());
+        q.pop_all();
+        CHECK(q.empty());
+    }
+
+    TEST_CASE("mpsc_queue_test.pop_all_in_order", "[mpsc_queue_test]") {
+        mpsc_queue<std::string> q;
+        q.push("a");
+        q.push("b");
+        q.push("c");
+
+        CHECK(q.pop_all() == std::vector<std::string>{"a", "b", "c"});
+        CHECK(q.pop_all().empty());
+
+        q.push("d");
+        CHECK(q.pop_all() == std::vector<std::string>{"d"});
+    }
+
+    TEST_CASE("mpsc_queue_test.destroy_with_remaining_values", "[mpsc_queue_test]") {
+        auto q = std::make_unique<mpsc_queue<std::string>>();
+        q->push("a");
+        q->push("b");
+        q.reset();
+        CHECK(q == nullptr);
+    }
+
+    TEST_CASE("mpsc_queue_test.concurrent_producers", "[mpsc_queue_test]") {
+        constexpr int ProducerCount = 4;
+        constexpr int ValueCount = 10'000;
+
+        mpsc_queue<std::pair<int, int>> q;
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < ProducerCount; ++p) {
+            producers.emplace_back([&q, p]() {
+                for (int i = 0; i < ValueCount; ++i) {
+                    q.push({p, i});
+                }
+            });
+        }
+
+        std::vector<std::pair<int, int>> values;
+        bool done = false;
+        while (!done) {
+            done = values.size() == ProducerCount * ValueCount;
+            for (auto& value : q.pop_all()) {
+                values.push_back(value);
+            }
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        // the values of each producer must be in order
+        std::vector<int> next(ProducerCount, 0);
+        for (const auto& [p, i] : values) {
+            CHECK(i == next[static_cast<size_t>(p)]);
+            ++next[static_cast<size_t>(p)];
+        }
+        CHECK(next == std::vector<int>(ProducerCount, ValueCount));
+    }
+}
@@ -289,6 +289,16 @@ namespace kdl {
             CHECK_FALSE(str_is_equal("dfdd", "Asdf"));
         }
 
+        TEST_CASE("string_utils_ci_test.string_hash", "[string_utils_ci_test]") {
+            const auto hash = string_hash();
+            CHECK(hash("") == hash(""));
+            CHECK(hash("asdf") == hash("asdf"));
+            CHECK(hash("asdf") == hash("ASDF"));
+            CHECK(hash("AsdF") == hash("aSDf"));
+            CHECK(hash("asdf") != hash("asdg"));
+            CHECK(hash("asdf") != hash("asd"));
+        }
+
         TEST_CASE("string_utils_ci_test.str_matches_glob", "[string_utils_ci_test]") {
             CHECK(str_matches_glob("ASdf", "asdf"));
             CHECK(str_matches_glob("AsdF", "*"));